@@ -0,0 +1,417 @@
+/*
+ * main.cpp
+ * 
+ * Copyright (C) 2018, Gabriel Mariano Marcelino <gabriel.mm8@gmail.com>
+ * 
+ * This file is part of MT9D111-Driver.
+ * 
+ * MT9D111-Driver is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ * 
+ * MT9D111-Driver is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ * 
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with MT9D111-Driver. If not, see <http://www.gnu.org/licenses/>.
+ * 
+ */
+
+/**
+ * \brief Benchmark of the configuration, mode switch and register access paths of the driver.
+ * 
+ * Usage: benchmark.x [-d device] [-n iterations] [-l transaction_us byte_ns] [-s seq_latency_us] [-j file]
+ *      - -d: I2C adapter of a real sensor (ex.: "/dev/i2c-1"). The simulator (MT9D111Sim) is used by default.
+ *      - -n: number of iterations of each operation (default: BENCH_DEFAULT_ITERATIONS).
+ *      - -l: simulated bus latency (ex.: "-l 0 22500" for a 400 kHz bus).
+ *      - -s: simulated execution time of the sequencer commands.
+ *      - -j: writes the results as JSON (for regression tracking).
+ *      .
+ * 
+ * For each operation it reports the wall time (mean, min. and max.), and the bus transactions, ioctl() calls and
+ * bytes on the wire (slave addresses included) per call.
+ * 
+ * \author Gabriel Mariano Marcelino <gabriel.mm8@gmail.com>
+ * 
+ * \version 1.0-dev
+ * 
+ * \date 17/10/2026
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+
+#include <mt9d111.h>
+#include <mt9d111_pins.h>
+#include <mt9d111_sim.h>
+#include <transport.h>
+#include <logger.h>
+
+using namespace std;
+
+#define BENCH_DEFAULT_ITERATIONS    100
+#define BENCH_MAX_RESULTS           32
+
+/**
+ * \brief Transport that counts the transactions and the bytes on the wire of another transport.
+ */
+class CountingTransport: public Transport
+{
+    private:
+        Transport *bus;                 /**< Counted transport. */
+        unsigned long transactions;     /**< Number of transactions. */
+        unsigned long bytes;            /**< Number of bytes (slave addresses included). */
+
+    public:
+        CountingTransport(Transport *b)
+        {
+            this->bus = b;
+            this->transactions = 0;
+            this->bytes = 0;
+        }
+
+        I2CResult<uint16_t> Read16(uint8_t adr)
+        {
+            // Address + register, address + 2 bytes
+            this->transactions++;
+            this->bytes += 5;
+
+            return this->bus->Read16(adr);
+        }
+
+        bool Write16(uint8_t adr, uint16_t val)
+        {
+            // Address + register + 2 bytes
+            this->transactions++;
+            this->bytes += 4;
+
+            return this->bus->Write16(adr, val);
+        }
+
+        bool Transfer(I2C_Msg *msgs, unsigned int len)
+        {
+            this->transactions++;
+
+            for(unsigned int i=0; i<len; i++)
+            {
+                this->bytes += 1 + msgs[i].len;
+            }
+
+            return this->bus->Transfer(msgs, len);
+        }
+
+        uint8_t GetSlaveID()
+        {
+            return this->bus->GetSlaveID();
+        }
+
+        int GetLastError()
+        {
+            return this->bus->GetLastError();
+        }
+
+        unsigned long GetTransactions()
+        {
+            return this->transactions;
+        }
+
+        unsigned long GetBytes()
+        {
+            return this->bytes;
+        }
+};
+
+/**
+ * \brief Result of an operation.
+ */
+struct BenchResult
+{
+    char name[48];                  /**< Operation name. */
+    unsigned int iterations;        /**< Number of calls. */
+    unsigned int failures;          /**< Number of failed calls. */
+    uint64_t total_ns;              /**< Total wall time. */
+    uint64_t min_ns;                /**< Min. wall time of a call. */
+    uint64_t max_ns;                /**< Max. wall time of a call. */
+    unsigned long transactions;     /**< Total number of bus transactions. */
+    unsigned long syscalls;         /**< Total number of ioctl() calls. */
+    unsigned long bytes;            /**< Total number of bytes on the wire. */
+};
+
+static CountingTransport *counter = NULL;
+static BenchResult results[BENCH_MAX_RESULTS];
+static size_t results_len = 0;
+
+/**
+ * \brief Measures an operation.
+ *
+ * \param[in] name is the operation name.
+ * \param[in] n is the number of calls.
+ * \param[in] op is the operation (called with the iteration number, returns TRUE/FALSE if successful or not).
+ *
+ * \return None.
+ */
+template<typename Op>
+static void Measure(const char *name, unsigned int n, Op op)
+{
+    if (results_len == BENCH_MAX_RESULTS)
+    {
+        return;
+    }
+
+    BenchResult &res = results[results_len++];
+
+    snprintf(res.name, sizeof(res.name), "%s", name);
+    res.iterations  = n;
+    res.failures    = 0;
+    res.total_ns    = 0;
+    res.min_ns      = UINT64_MAX;
+    res.max_ns      = 0;
+
+    unsigned long transactions = counter->GetTransactions();
+    unsigned long bytes = counter->GetBytes();
+    unsigned long syscalls = I2C::GetIOCtlCount();
+
+    for(unsigned int i=0; i<n; i++)
+    {
+        uint64_t start = I2CStats::Now();
+
+        bool ok = op(i);
+
+        uint64_t dt = I2CStats::Now() - start;
+
+        res.total_ns += dt;
+        res.min_ns = (dt < res.min_ns)? dt : res.min_ns;
+        res.max_ns = (dt > res.max_ns)? dt : res.max_ns;
+
+        if (!ok)
+        {
+            res.failures++;
+        }
+    }
+
+    res.transactions    = counter->GetTransactions() - transactions;
+    res.bytes           = counter->GetBytes() - bytes;
+    res.syscalls        = I2C::GetIOCtlCount() - syscalls;
+}
+
+/**
+ * \brief Prints the results as a table.
+ *
+ * \return None.
+ */
+static void PrintResults()
+{
+    printf("%-36s %6s %12s %12s %12s %8s %8s %8s\n", "operation", "fails", "mean (ns)", "min (ns)", "max (ns)",
+           "trans.", "ioctls", "bytes");
+
+    for(size_t i=0; i<results_len; i++)
+    {
+        const BenchResult &res = results[i];
+
+        printf("%-36s %6u %12lu %12lu %12lu %8.1f %8.1f %8.1f\n", res.name, res.failures,
+               (unsigned long)(res.total_ns/res.iterations), (unsigned long)res.min_ns, (unsigned long)res.max_ns,
+               (double)res.transactions/res.iterations, (double)res.syscalls/res.iterations,
+               (double)res.bytes/res.iterations);
+    }
+}
+
+/**
+ * \brief Writes the results as JSON.
+ *
+ * \param[in] file is the output file.
+ * \param[in] bus is the name of the bus ("sim" or the I2C adapter).
+ * \param[in] transaction_us is the simulated transaction latency.
+ * \param[in] byte_ns is the simulated byte latency.
+ *
+ * \return TRUE/FALSE if the file was written or not.
+ */
+static bool WriteJSON(const char *file, const char *bus, uint32_t transaction_us, uint32_t byte_ns)
+{
+    FILE *f = fopen(file, "w");
+
+    if (f == NULL)
+    {
+        return false;
+    }
+
+    fprintf(f, "{\n");
+    fprintf(f, "  \"bus\": \"%s\",\n", bus);
+    fprintf(f, "  \"transaction_us\": %u,\n", transaction_us);
+    fprintf(f, "  \"byte_ns\": %u,\n", byte_ns);
+    fprintf(f, "  \"results\": [\n");
+
+    for(size_t i=0; i<results_len; i++)
+    {
+        const BenchResult &res = results[i];
+
+        fprintf(f, "    {\"name\": \"%s\", \"iterations\": %u, \"failures\": %u, \"mean_ns\": %lu, \"min_ns\": %lu, "
+                   "\"max_ns\": %lu, \"transactions\": %.2f, \"syscalls\": %.2f, \"bytes\": %.2f}%s\n",
+                res.name, res.iterations, res.failures, (unsigned long)(res.total_ns/res.iterations),
+                (unsigned long)res.min_ns, (unsigned long)res.max_ns, (double)res.transactions/res.iterations,
+                (double)res.syscalls/res.iterations, (double)res.bytes/res.iterations,
+                (i + 1 < results_len)? "," : "");
+    }
+
+    fprintf(f, "  ]\n");
+    fprintf(f, "}\n");
+
+    return fclose(f) == 0;
+}
+
+int main(int argc, char **argv)
+{
+    const char *dev = NULL;
+    const char *json = NULL;
+    unsigned int n = BENCH_DEFAULT_ITERATIONS;
+    uint32_t transaction_us = MT9D111_SIM_DEFAULT_TRANSACTION_US;
+    uint32_t byte_ns = MT9D111_SIM_DEFAULT_BYTE_NS;
+    uint32_t seq_latency_us = MT9D111_SIM_DEFAULT_SEQ_LATENCY_US;
+
+    for(int i=1; i<argc; i++)
+    {
+        if ((strcmp(argv[i], "-d") == 0) and (i + 1 < argc))
+        {
+            dev = argv[++i];
+        }
+        else if ((strcmp(argv[i], "-n") == 0) and (i + 1 < argc))
+        {
+            n = strtoul(argv[++i], NULL, 0);
+        }
+        else if ((strcmp(argv[i], "-l") == 0) and (i + 2 < argc))
+        {
+            transaction_us = strtoul(argv[++i], NULL, 0);
+            byte_ns = strtoul(argv[++i], NULL, 0);
+        }
+        else if ((strcmp(argv[i], "-s") == 0) and (i + 1 < argc))
+        {
+            seq_latency_us = strtoul(argv[++i], NULL, 0);
+        }
+        else if ((strcmp(argv[i], "-j") == 0) and (i + 1 < argc))
+        {
+            json = argv[++i];
+        }
+        else
+        {
+            fprintf(stderr, "Usage: %s [-d device] [-n iterations] [-l transaction_us byte_ns] [-s seq_latency_us] "
+                            "[-j file]\n", argv[0]);
+
+            return 1;
+        }
+    }
+
+    // The mode switches must end in preview
+    n = (n < 2)? 2 : (n & ~1U);
+
+    Transport *bus;
+    Pin *rst;
+    Pin *stby;
+    MT9D111Sim *sim = NULL;
+
+    if (dev == NULL)
+    {
+        sim = new MT9D111Sim;
+
+        sim->SetLatency(transaction_us, byte_ns);
+        sim->SetSequencerLatency(seq_latency_us);
+
+        bus = sim;
+        rst = sim->GetResetPin();
+        stby = sim->GetStandbyPin();
+    }
+    else
+    {
+        I2CTransport *i2c = new I2CTransport;
+        GPIOPin *rst_pin = new GPIOPin;
+        GPIOPin *stby_pin = new GPIOPin;
+
+        if (!i2c->Open(dev, MT9D111_CONFIG_I2C_ID) or
+            !rst_pin->Open(MT9D111_GPIO_RESET, GPIO_DIR_OUTPUT, MT9D111_GPIO_BACKEND, MT9D111_GPIO_CHIP) or
+            !stby_pin->Open(MT9D111_GPIO_STANDBY, GPIO_DIR_OUTPUT, MT9D111_GPIO_BACKEND, MT9D111_GPIO_CHIP))
+        {
+            fprintf(stderr, "Error opening \"%s\" or the RESET/STANDBY pins!\n", dev);
+
+            return 1;
+        }
+
+        bus = i2c;
+        rst = rst_pin;
+        stby = stby_pin;
+    }
+
+    counter = new CountingTransport(bus);
+
+    // The driver progress lines (Debug) are compiled out by LOGGER_MIN_LEVEL (see the Makefile), so they do not
+    // count in the measurements
+    MT9D111 cam;
+
+    Measure("open_hard_reset", n, [&](unsigned int) { cam.Close(); return cam.Open(counter, rst, stby); });
+
+    if (!cam.CheckDevice())
+    {
+        Logger::Instance().Drain();
+
+        fprintf(stderr, "MT9D111 not found!\n");
+
+        return 1;
+    }
+
+    Measure("config", n, [&](unsigned int) { return cam.Config(); });
+
+    static const struct
+    {
+        const char *name;
+        uint8_t format;
+    } formats[] =
+    {
+        {"set_output_format_ycbcr",     MT9D111_OUTPUT_FORMAT_YCbCr},
+        {"set_output_format_rgb565",    MT9D111_OUTPUT_FORMAT_RGB565},
+        {"set_output_format_rgb555",    MT9D111_OUTPUT_FORMAT_RGB555},
+        {"set_output_format_rgb444x",   MT9D111_OUTPUT_FORMAT_RGB444x},
+        {"set_output_format_rgbx444",   MT9D111_OUTPUT_FORMAT_RGBx444},
+        {"set_output_format_jpeg",      MT9D111_OUTPUT_FORMAT_JPEG},
+        {"set_output_format_raw8",      MT9D111_OUTPUT_FORMAT_RAW_8},
+        {"set_output_format_raw10",     MT9D111_OUTPUT_FORMAT_RAW_10},
+    };
+
+    for(size_t f=0; f<sizeof(formats)/sizeof(formats[0]); f++)
+    {
+        Measure(formats[f].name, n, [&](unsigned int) { return cam.SetOutputFormat(formats[f].format); });
+    }
+
+    Measure("set_resolution_preview_640x480", n,
+            [&](unsigned int) { return cam.SetResolution(MT9D111_MODE_PREVIEW, 640, 480); });
+    Measure("set_resolution_capture_1600x1200", n,
+            [&](unsigned int) { return cam.SetResolution(MT9D111_MODE_CAPTURE, 1600, 1200); });
+
+    Measure("set_mode_preview_capture", n,
+            [&](unsigned int i) { return cam.SetMode((i % 2 == 0)? MT9D111_MODE_CAPTURE : MT9D111_MODE_PREVIEW); });
+
+    // Raw register access (R0x0D:0 is never cached, R0x01:0 is)
+    cam.WriteReg(MT9D111_REG_PAGE_REGISTER, MT9D111_REG_PAGE_0);
+
+    uint16_t val;
+
+    Measure("read_reg", n, [&](unsigned int) { return cam.ReadReg(MT9D111_REG_RESET, &val); });
+    Measure("read_reg_cached", n, [&](unsigned int) { return cam.ReadReg(MT9D111_REG_ROW_START, &val); });
+    Measure("write_reg", n, [&](unsigned int) { return cam.WriteReg(MT9D111_REG_ROW_START, 0x001C); });
+
+    cam.Close();
+
+    Logger::Instance().Drain();
+
+    PrintResults();
+
+    if ((json != NULL) and !WriteJSON(json, (dev == NULL)? "sim" : dev, transaction_us, byte_ns))
+    {
+        fprintf(stderr, "Error writing \"%s\"!\n", json);
+
+        return 1;
+    }
+
+    return 0;
+}
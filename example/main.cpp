@@ -1,9 +1,15 @@
+#include <stdio.h>
 #include <mt9d111.h>
+#include <mt9d111_capture.h>
+#include <logger.h>
 
 using namespace std;
 
-int main()
+int main(int argc, char **argv)
 {
+    // The driver messages are written by a background thread
+    Logger::Instance().Start();
+
     MT9D111 mt9d111;
 
     if (!mt9d111.Open("/dev/i2c-1"))
@@ -23,6 +29,28 @@ int main()
         mt9d111.EnablePLL(0x1000, 0x0500);  // ref = 10 MHz, output = 80 MHz
         mt9d111.SetOutputFormat(MT9D111_OUTPUT_FORMAT_RAW_8);
         mt9d111.SetResolution(MT9D111_MODE_PREVIEW, 640, 480);
+
+        // Optional frame capture through a V4L2 node (ex.: ./example.x /dev/video0)
+        if (argc > 1)
+        {
+            MT9D111Capture capture;
+
+            if (capture.Open(argv[1]) and
+                capture.Configure(mt9d111, MT9D111_MODE_PREVIEW, MT9D111_OUTPUT_FORMAT_RAW_8, 640, 480) and
+                capture.Start())
+            {
+                CaptureFrame frame;
+
+                if (capture.Dequeue(frame, 1000))
+                {
+                    printf("Frame %u: %zu bytes\n", frame.sequence, frame.len);
+
+                    capture.Queue(frame);
+                }
+
+                capture.Stop();
+            }
+        }
     }
 
     mt9d111.Close();
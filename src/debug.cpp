@@ -33,11 +33,7 @@
  * \{
  */
 
-#include <iostream>
-#include <chrono>
 #include <sstream>
-#include <ctime>
-#include <iomanip>
 
 #include "debug.h"
 
@@ -60,7 +56,10 @@ Debug::Debug(string n, bool s)
 
 Debug::~Debug()
 {
-
+    if (!this->line.empty())
+    {
+        this->NewLine();
+    }
 }
 
 void Debug::Setup(const char *n, bool s)
@@ -106,7 +105,7 @@ void Debug::WriteMsg(const char *msg)
 {
     if (this->enabled)
     {
-        cout << msg;
+        this->line += msg;
     }
 }
 
@@ -114,7 +113,7 @@ void Debug::WriteMsg(string msg)
 {
     if (this->enabled)
     {
-        cout << msg;
+        this->line += msg;
     }
 }
 
@@ -127,9 +126,13 @@ void Debug::WriteEvent(string msg)
 {
     if (this->enabled)
     {
-        this->WriteTime();
+        // An unterminated line is written before the new event
+        if (!this->line.empty())
+        {
+            this->NewLine();
+        }
 
-        cout << this->name << ": " << msg;
+        this->line = msg;
     }
 }
 
@@ -137,7 +140,7 @@ void Debug::WriteDec(unsigned int n)
 {
     if (this->enabled)
     {
-        cout << dec << n;
+        this->line += to_string(n);
     }
 }
 
@@ -145,8 +148,10 @@ void Debug::WriteHex(uint32_t n)
 {
     if (this->enabled)
     {
-        cout << "0x" << hex << n;
-        cout << dec;
+        stringstream ss;
+        ss << "0x" << hex << n;
+
+        this->line += ss.str();
     }
 }
 
@@ -154,26 +159,9 @@ void Debug::NewLine()
 {
     if (this->enabled)
     {
-        cout << endl;
-    }
-}
-
-string Debug::GetTime()
-{
-    auto now = chrono::system_clock::now();
-    auto now_time_t = chrono::system_clock::to_time_t(now);
-
-    stringstream ss;
-    ss << put_time(localtime(&now_time_t), "%X");
-
-    return ss.str();
-}
+        Logger::Instance().WriteText(LOGGER_LEVEL_INFO, this->name.c_str(), this->line.c_str());
 
-void Debug::WriteTime()
-{
-    if (this->enabled)
-    {
-        cout << "[ " << this->GetTime() << " ] ";
+        this->line.clear();
     }
 }
 
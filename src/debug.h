@@ -39,8 +39,33 @@
 #include <string>
 #include <stdint.h>
 
+#include "logger.h"
+
+/**
+ * \brief Debug messages facade.
+ *
+ * The Debug messages are INFO level progress messages. Errors and warnings must use LOG_ERROR and LOG_WARNING (see
+ * logger.h), so they are kept when the Debug messages are removed. When LOGGER_MIN_LEVEL is above LOGGER_LEVEL_INFO,
+ * the macros expand to nothing: the arguments are not evaluated (no strings are built) and no code is generated.
+ */
+#if LOGGER_MIN_LEVEL <= LOGGER_LEVEL_INFO
+#define DEBUG_EVENT(dbg, msg)       (dbg)->WriteEvent(msg)
+#define DEBUG_MSG(dbg, msg)         (dbg)->WriteMsg(msg)
+#define DEBUG_DEC(dbg, n)           (dbg)->WriteDec(n)
+#define DEBUG_HEX(dbg, n)           (dbg)->WriteHex(n)
+#define DEBUG_NEWLINE(dbg)          (dbg)->NewLine()
+#else
+#define DEBUG_EVENT(dbg, msg)       do {} while(0)
+#define DEBUG_MSG(dbg, msg)         do {} while(0)
+#define DEBUG_DEC(dbg, n)           do {} while(0)
+#define DEBUG_HEX(dbg, n)           do {} while(0)
+#define DEBUG_NEWLINE(dbg)          do {} while(0)
+#endif // LOGGER_MIN_LEVEL
+
 /**
  * \brief Debug class.
+ *
+ * The messages are assembled in a line and written by the logger (see "Logger::WriteText") at each "NewLine".
  */
 class Debug
 {
@@ -56,18 +81,9 @@ class Debug
         bool enabled;
 
         /**
-         * \brief Gets the system time.
-         *
-         * \return The system time as an string.
-         */
-        std::string GetTime();
-
-        /**
-         * \brief Writes the system time in the format: HH:MM:SS.
-         *
-         * \return None.
+         * \brief Line being written (sent to the logger at each new line).
          */
-        void WriteTime();
+        std::string line;
 
     public:
         /**
@@ -220,7 +236,7 @@ class Debug
         void WriteHex(uint32_t n);
 
         /**
-         * \brief Goes to the next line.
+         * \brief Goes to the next line (writes the current line to the logger).
          *
          * \return None.
          */
@@ -36,6 +36,14 @@
 #include <fstream>
 #include <sstream>
 #include <string>
+#include <string.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <time.h>
+#include <poll.h>
+#include <sys/ioctl.h>
+#include <sys/eventfd.h>
+#include <linux/gpio.h>
 
 #include "gpio.h"
 
@@ -43,12 +51,23 @@ using namespace std;
 
 GPIO::GPIO()
 {
-
+    this->fd        = -1;
+    this->chip_fd   = -1;
+    this->stop_fd   = -1;
+    this->state     = false;
+    this->edge      = GPIO_EDGE_NONE;
+    this->backend   = GPIO_BACKEND_SYSFS;
 }
 
-GPIO::GPIO(uint8_t p, bool d)
+GPIO::GPIO(uint8_t p, bool d, uint8_t b, const char *chip)
 {
-    this->Open(p, d);
+    this->fd        = -1;
+    this->chip_fd   = -1;
+    this->stop_fd   = -1;
+    this->state     = false;
+    this->edge      = GPIO_EDGE_NONE;
+
+    this->Open(p, d, b, chip);
 }
 
 GPIO::~GPIO()
@@ -56,14 +75,37 @@ GPIO::~GPIO()
     this->Close();
 }
 
-bool GPIO::Open(uint8_t p, bool d)
+bool GPIO::Open(uint8_t p, bool d, uint8_t b, const char *chip)
 {
-    this->pin = p;
+    this->pin       = p;
+    this->backend   = b;
+    this->state     = false;
+    this->edge      = GPIO_EDGE_NONE;
 
-    if (this->Export() and this->SetDir(d) and this->Set(false))
+    if (this->backend == GPIO_BACKEND_CHARDEV)
     {
+        this->chip_fd = open(chip, O_RDWR | O_CLOEXEC);
+        if (this->chip_fd < 0)
+        {
+            return false;
+        }
+
+        // The line is requested with the initial state (LOW)
+        if (!this->SetDir(d))
+        {
+            close(this->chip_fd);
+            this->chip_fd = -1;
+
+            return false;
+        }
+
         return true;
     }
+
+    if (this->Export() and this->SetDir(d) and this->OpenValue())
+    {
+        return (d == GPIO_DIR_INPUT) or this->Set(false);
+    }
     else
     {
         return false;
@@ -72,7 +114,61 @@ bool GPIO::Open(uint8_t p, bool d)
 
 bool GPIO::Close()
 {
-    return (this->Set(false) and this->Unexport());
+    this->ClearCallback();
+
+    if (this->fd < 0)
+    {
+        return false;
+    }
+
+    bool res = (this->dir == GPIO_DIR_INPUT) or this->Set(false);
+
+    close(this->fd);
+    this->fd = -1;
+
+    if (this->backend == GPIO_BACKEND_CHARDEV)
+    {
+        close(this->chip_fd);
+        this->chip_fd = -1;
+
+        return res;
+    }
+
+    return res and this->Unexport();
+}
+
+bool GPIO::OpenValue()
+{
+    this->fd = open(string("/sys/class/gpio/gpio" + to_string(this->pin) + "/value").c_str(), O_RDWR | O_CLOEXEC);
+
+    return this->fd >= 0;
+}
+
+bool GPIO::RequestLine()
+{
+    if (this->fd >= 0)
+    {
+        close(this->fd);
+        this->fd = -1;
+    }
+
+    struct gpiohandle_request req;
+    memset(&req, 0, sizeof(req));
+
+    req.lineoffsets[0]      = this->pin;
+    req.lines               = 1;
+    req.flags               = (this->dir == GPIO_DIR_OUTPUT)? GPIOHANDLE_REQUEST_OUTPUT : GPIOHANDLE_REQUEST_INPUT;
+    req.default_values[0]   = this->state? 1 : 0;
+    strncpy(req.consumer_label, "mt9d111-driver", sizeof(req.consumer_label) - 1);
+
+    if (ioctl(this->chip_fd, GPIO_GET_LINEHANDLE_IOCTL, &req) < 0)
+    {
+        return false;
+    }
+
+    this->fd = req.fd;
+
+    return true;
 }
 
 bool GPIO::Export()
@@ -113,6 +209,14 @@ bool GPIO::Unexport()
 
 bool GPIO::SetDir(bool d)
 {
+    if (this->backend == GPIO_BACKEND_CHARDEV)
+    {
+        this->dir = d;
+
+        // The direction of a line handle can only be set on the request
+        return this->RequestLine();
+    }
+
     // Open direction file for gpio
     ofstream setdir(string("/sys/class/gpio/gpio" + to_string(this->pin) + "/direction").c_str());
     if (!setdir.is_open())
@@ -143,28 +247,29 @@ bool GPIO::Set(bool s)
 {
     if (this->dir == GPIO_DIR_OUTPUT)
     {
-        // Open value file for gpio
-        ofstream setval(string("/sys/class/gpio/gpio" + to_string(this->pin) + "/value").c_str());
-        if (!setval.is_open())
+        if (this->backend == GPIO_BACKEND_CHARDEV)
         {
-            return false;
-        }
+            struct gpiohandle_data data;
+            memset(&data, 0, sizeof(data));
 
-        // Write value to value file
-        if (s)
-        {
-            state = true;
-            setval << "1";
+            data.values[0] = s? 1 : 0;
+
+            if (ioctl(this->fd, GPIOHANDLE_SET_LINE_VALUES_IOCTL, &data) < 0)
+            {
+                return false;
+            }
         }
         else
         {
-            state = false;
-            setval << "0";
+            // Write value to the (already opened) value file
+            if (pwrite(this->fd, s? "1" : "0", 1, 0) != 1)
+            {
+                return false;
+            }
         }
 
-        // Close value file
-        setval.close();
-        
+        this->state = s;
+
         return true;
     }
     else
@@ -189,35 +294,287 @@ bool GPIO::Get(bool &s)
 {
     if (this->dir == GPIO_DIR_INPUT)
     {
-        // Open value file for gpio
-        ifstream getval(string("/sys/class/gpio/gpio" + to_string(this->pin) + "/value").c_str());
-        if (!getval.is_open())
+        if (this->backend == GPIO_BACKEND_CHARDEV)
+        {
+            struct gpiohandle_data data;
+
+            if (ioctl(this->fd, GPIOHANDLE_GET_LINE_VALUES_IOCTL, &data) < 0)
+            {
+                return false;
+            }
+
+            s = (data.values[0] != 0);
+        }
+        else
+        {
+            // Read gpio value from the (already opened) value file
+            char val;
+            if (pread(this->fd, &val, 1, 0) != 1)
+            {
+                return false;
+            }
+
+            s = (val != '0');
+        }
+
+        return true;
+    }
+    else
+    {
+        return false;
+    }
+}
+
+bool GPIO::SetEdge(uint8_t e)
+{
+    if (this->dir != GPIO_DIR_INPUT)
+    {
+        return false;
+    }
+
+    if (this->backend == GPIO_BACKEND_CHARDEV)
+    {
+        this->edge = e;
+
+        if (e == GPIO_EDGE_NONE)
+        {
+            return this->RequestLine();
+        }
+
+        if (this->fd >= 0)
+        {
+            close(this->fd);
+            this->fd = -1;
+        }
+
+        struct gpioevent_request req;
+        memset(&req, 0, sizeof(req));
+
+        req.lineoffset  = this->pin;
+        req.handleflags = GPIOHANDLE_REQUEST_INPUT;
+        req.eventflags  = ((e & GPIO_EDGE_RISING)? GPIOEVENT_REQUEST_RISING_EDGE : 0) |
+                          ((e & GPIO_EDGE_FALLING)? GPIOEVENT_REQUEST_FALLING_EDGE : 0);
+        strncpy(req.consumer_label, "mt9d111-driver", sizeof(req.consumer_label) - 1);
+
+        if (ioctl(this->chip_fd, GPIO_GET_LINEEVENT_IOCTL, &req) < 0)
         {
             return false;
         }
 
-        // Read gpio value
-        string val;
-        getval >> val;
+        this->fd = req.fd;
 
-        if (val != "0")
+        return true;
+    }
+
+    // Open edge file for gpio
+    ofstream setedge(string("/sys/class/gpio/gpio" + to_string(this->pin) + "/edge").c_str());
+    if (!setedge.is_open())
+    {
+        return false;
+    }
+
+    switch(e)
+    {
+        case GPIO_EDGE_RISING:
+            setedge << "rising";
+            break;
+        case GPIO_EDGE_FALLING:
+            setedge << "falling";
+            break;
+        case GPIO_EDGE_BOTH:
+            setedge << "both";
+            break;
+        default:
+            setedge << "none";
+            break;
+    }
+
+    setedge.close();
+
+    this->edge = e;
+
+    // Clear the pending notification (the value file is always "ready" until it is read)
+    char val;
+    pread(this->fd, &val, 1, 0);
+
+    return true;
+}
+
+bool GPIO::WaitEdge(uint8_t e, int timeout_ms, GPIOEvent *event)
+{
+    if ((this->edge & e) != e)
+    {
+        if (!this->SetEdge(this->edge | e))
+        {
+            return false;
+        }
+    }
+
+    struct timespec start, now;
+    clock_gettime(CLOCK_MONOTONIC, &start);
+
+    int remaining = timeout_ms;
+
+    while(1)
+    {
+        GPIOEvent ev;
+        if (this->WaitEvent(remaining, &ev, -1) <= 0)
         {
-            s = true;
+            return false;
         }
-        else
+
+        // Events of other enabled edges are discarded
+        if (ev.edge & e)
+        {
+            if (event != NULL)
+            {
+                *event = ev;
+            }
+
+            return true;
+        }
+
+        if (timeout_ms >= 0)
+        {
+            clock_gettime(CLOCK_MONOTONIC, &now);
+
+            remaining = timeout_ms - ((now.tv_sec - start.tv_sec)*1000 + (now.tv_nsec - start.tv_nsec)/1000000);
+            if (remaining <= 0)
+            {
+                return false;
+            }
+        }
+    }
+}
+
+bool GPIO::SetCallback(uint8_t e, function<void(const GPIOEvent&)> cb)
+{
+    this->ClearCallback();
+
+    if (!this->SetEdge(e))
+    {
+        return false;
+    }
+
+    this->stop_fd = eventfd(0, EFD_CLOEXEC);
+    if (this->stop_fd < 0)
+    {
+        return false;
+    }
+
+    this->callback = cb;
+
+    this->cb_thread = thread([this, e]
+    {
+        while(1)
+        {
+            GPIOEvent ev;
+            int res = this->WaitEvent(-1, &ev, this->stop_fd);
+            if (res < 0)
+            {
+                break;
+            }
+
+            if ((res > 0) and (ev.edge & e))
+            {
+                this->callback(ev);
+            }
+        }
+    });
+
+    return true;
+}
+
+void GPIO::ClearCallback()
+{
+    if (this->cb_thread.joinable())
+    {
+        uint64_t val = 1;
+        write(this->stop_fd, &val, sizeof(val));
+
+        this->cb_thread.join();
+    }
+
+    if (this->stop_fd >= 0)
+    {
+        close(this->stop_fd);
+        this->stop_fd = -1;
+    }
+
+    this->callback = nullptr;
+}
+
+int GPIO::GetEventFD()
+{
+    return this->fd;
+}
+
+bool GPIO::ReadEvent(GPIOEvent *event)
+{
+    if (this->backend == GPIO_BACKEND_CHARDEV)
+    {
+        struct gpioevent_data data;
+        if (read(this->fd, &data, sizeof(data)) != sizeof(data))
         {
-            s = false;
+            return false;
         }
 
-        // Close the value file
-        getval.close();
+        event->timestamp    = data.timestamp;
+        event->edge         = (data.id == GPIOEVENT_EVENT_RISING_EDGE)? GPIO_EDGE_RISING : GPIO_EDGE_FALLING;
 
         return true;
     }
-    else
+
+    // sysfs has no event timestamps: the time of the reading is used
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+
+    char val;
+    if (pread(this->fd, &val, 1, 0) != 1)
     {
         return false;
     }
+
+    event->timestamp    = (uint64_t)now.tv_sec*1000000000ULL + now.tv_nsec;
+
+    if ((this->edge == GPIO_EDGE_RISING) or (this->edge == GPIO_EDGE_FALLING))
+    {
+        // Only one edge is armed, the level may have changed again since the interrupt
+        event->edge = this->edge;
+    }
+    else
+    {
+        // Both edges armed: the current level is a best guess of the edge
+        event->edge = (val != '0')? GPIO_EDGE_RISING : GPIO_EDGE_FALLING;
+    }
+
+    return true;
+}
+
+int GPIO::WaitEvent(int timeout_ms, GPIOEvent *event, int wake_fd)
+{
+    struct pollfd fds[2];
+
+    fds[0].fd       = this->fd;
+    fds[0].events   = (this->backend == GPIO_BACKEND_CHARDEV)? POLLIN : (POLLPRI | POLLERR);
+    fds[0].revents  = 0;
+
+    fds[1].fd       = wake_fd;
+    fds[1].events   = POLLIN;
+    fds[1].revents  = 0;
+
+    int res = poll(fds, (wake_fd >= 0)? 2 : 1, timeout_ms);
+    if (res <= 0)
+    {
+        return res;
+    }
+
+    if (fds[1].revents & POLLIN)
+    {
+        return -1;
+    }
+
+    return this->ReadEvent(event)? 1 : -1;
 }
 
 uint8_t GPIO::GetPinNumber()
@@ -230,4 +587,9 @@ bool GPIO::GetDir()
     return this->dir;
 }
 
+uint8_t GPIO::GetBackend()
+{
+    return this->backend;
+}
+
 //! \} End of gpio group
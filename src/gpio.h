@@ -37,18 +37,73 @@
 #define GPIO_H_
 
 #include <stdint.h>
+#include <thread>
+#include <functional>
 
 #define GPIO_DIR_OUTPUT         0
 #define GPIO_DIR_INPUT          1
 
+// Backends
+#define GPIO_BACKEND_SYSFS      0               // /sys/class/gpio (value file kept opened)
+#define GPIO_BACKEND_CHARDEV    1               // GPIO character device (line handle)
+
+#define GPIO_DEFAULT_CHIP       "/dev/gpiochip0"
+
+// Edges
+#define GPIO_EDGE_NONE          0
+#define GPIO_EDGE_RISING        (1 << 0)
+#define GPIO_EDGE_FALLING       (1 << 1)
+#define GPIO_EDGE_BOTH          (GPIO_EDGE_RISING | GPIO_EDGE_FALLING)
+
+/**
+ * \brief Edge event of an input GPIO.
+ */
+struct GPIOEvent
+{
+    uint64_t timestamp;     /**< Event time in nanoseconds (kernel timestamp with the chardev backend). */
+    uint8_t edge;           /**< Detected edge (GPIO_EDGE_RISING or GPIO_EDGE_FALLING). */
+};
+
 /**
  * \brief Class for a GPIO pin of the Raspberry Pi.
  */
 class GPIO
 {
-        uint8_t pin;    /**< GPIO pin number. */
-        bool dir;       /**< GPIO direction (output or input). */
-        bool state;     /**< GPIO state (HIGH or LOW). */
+        uint8_t pin;        /**< GPIO pin number. */
+        bool dir;           /**< GPIO direction (output or input). */
+        bool state;         /**< GPIO state (HIGH or LOW). */
+        uint8_t backend;    /**< GPIO backend (GPIO_BACKEND_SYSFS or GPIO_BACKEND_CHARDEV). */
+        int fd;             /**< Value file (sysfs) or line handle (chardev) file descriptor. */
+        int chip_fd;        /**< GPIO chip file descriptor (chardev). */
+        uint8_t edge;       /**< Edges that generate events (GPIO_EDGE_*). */
+        int stop_fd;        /**< Event file to stop the callback thread. */
+        std::thread cb_thread;                          /**< Callback thread. */
+        std::function<void(const GPIOEvent&)> callback; /**< Edge event callback. */
+
+        /**
+         * \brief Waits for the next event of the pin.
+         *
+         * \param[in] timeout_ms is the maximum waiting time in milliseconds (-1 to wait forever).
+         * \param[in,out] event is a pointer to store the event.
+         * \param[in] wake_fd is an additional file descriptor that interrupts the waiting (-1 if not used).
+         *
+         * \return 1 if an event was received, 0 on timeout and -1 on error or interruption.
+         */
+        int WaitEvent(int timeout_ms, GPIOEvent *event, int wake_fd);
+
+        /**
+         * \brief Opens the value file of the GPIO (sysfs backend).
+         *
+         * \return TRUE/FALSE if it was successful or not.
+         */
+        bool OpenValue();
+
+        /**
+         * \brief Requests a line handle with the current direction (chardev backend).
+         *
+         * \return TRUE/FALSE if it was successful or not.
+         */
+        bool RequestLine();
 
         /**
          * \brief Export GPIO.
@@ -77,10 +132,12 @@ class GPIO
          *
          * \param[in] p is the GPIO pin number.
          * \param[in] d is the GPIO direction (GPIO_DIR_OUTPUT or GPIO_DIR_INPUT).
+         * \param[in] b is the GPIO backend (GPIO_BACKEND_SYSFS or GPIO_BACKEND_CHARDEV).
+         * \param[in] chip is the GPIO chip device (only used by the chardev backend).
          *
          * \return None
          */
-        GPIO(uint8_t p, bool d=GPIO_DIR_OUTPUT);
+        GPIO(uint8_t p, bool d=GPIO_DIR_OUTPUT, uint8_t b=GPIO_BACKEND_SYSFS, const char *chip=GPIO_DEFAULT_CHIP);
 
         /**
          * \brief Class destructor.
@@ -92,12 +149,17 @@ class GPIO
         /**
          * \brief GPIO initialization.
          *
-         * \param[in] p is the GPIO pin number.
+         * The value file (sysfs) or the line handle (chardev) is opened once here and kept until "Close", so
+         * "Set" and "Get" are a single system call.
+         *
+         * \param[in] p is the GPIO pin number (line offset for the chardev backend).
          * \param[in] d is the GPIO direction (GPIO_DIR_OUTPUT or GPIO_DIR_INPUT).
+         * \param[in] b is the GPIO backend (GPIO_BACKEND_SYSFS or GPIO_BACKEND_CHARDEV).
+         * \param[in] chip is the GPIO chip device (only used by the chardev backend).
          *
          * \return TRUE/FALSE if it was successful or not.
          */
-        bool Open(uint8_t p, bool d);
+        bool Open(uint8_t p, bool d, uint8_t b=GPIO_BACKEND_SYSFS, const char *chip=GPIO_DEFAULT_CHIP);
 
         /**
          * \brief Closes the GPIO pin (deinitialization).
@@ -140,6 +202,71 @@ class GPIO
          */
         bool Get(bool &s);
 
+        /**
+         * \brief Selects the edges of an input GPIO that generate events.
+         *
+         * With the sysfs backend the "edge" file is configured and the events are detected with poll(POLLPRI) on
+         * the value file (sysfs reports no edge, so with GPIO_EDGE_BOTH the edge is guessed from the level read after
+         * the event). With the chardev backend the line handle is replaced by a line event request.
+         *
+         * \param[in] e is the edges to detect (GPIO_EDGE_NONE, GPIO_EDGE_RISING, GPIO_EDGE_FALLING or GPIO_EDGE_BOTH).
+         *
+         * \return TRUE/FALSE if it was successful or not.
+         */
+        bool SetEdge(uint8_t e);
+
+        /**
+         * \brief Waits for an edge of an input GPIO.
+         *
+         * If the requested edge is not enabled, the events are configured first (see "SetEdge").
+         *
+         * \param[in] e is the edge to wait (GPIO_EDGE_RISING, GPIO_EDGE_FALLING or GPIO_EDGE_BOTH).
+         * \param[in] timeout_ms is the maximum waiting time in milliseconds (-1 to wait forever).
+         * \param[in,out] event is a pointer to store the event (can be NULL).
+         *
+         * \return TRUE/FALSE if the edge was detected or not (timeout or error).
+         */
+        bool WaitEdge(uint8_t e, int timeout_ms, GPIOEvent *event=NULL);
+
+        /**
+         * \brief Registers a function to be called on every edge event.
+         *
+         * The events are received in a dedicated thread, where the callback is executed. "WaitEdge" must not be used
+         * while a callback is registered.
+         *
+         * \param[in] e is the edges to detect (GPIO_EDGE_RISING, GPIO_EDGE_FALLING or GPIO_EDGE_BOTH).
+         * \param[in] cb is the function to call.
+         *
+         * \return TRUE/FALSE if it was successful or not.
+         */
+        bool SetCallback(uint8_t e, std::function<void(const GPIOEvent&)> cb);
+
+        /**
+         * \brief Removes the registered callback and stops its thread.
+         *
+         * \return None
+         */
+        void ClearCallback();
+
+        /**
+         * \brief Returns the file descriptor that becomes ready on edge events (to be used with poll or epoll).
+         *
+         * The file descriptor signals POLLPRI with the sysfs backend and POLLIN with the chardev backend. After it
+         * becomes ready, "ReadEvent" must be called.
+         *
+         * \return The file descriptor or -1 if the pin is not opened.
+         */
+        int GetEventFD();
+
+        /**
+         * \brief Reads a pending edge event (after "GetEventFD" became ready).
+         *
+         * \param[in,out] event is a pointer to store the event.
+         *
+         * \return TRUE/FALSE if it was successful or not.
+         */
+        bool ReadEvent(GPIOEvent *event);
+
         /**
          * \brief Returns the GPIO pin number.
          *
@@ -153,6 +280,13 @@ class GPIO
          * \return The direction of the GPIO pin.
          */
         bool GetDir();
+
+        /**
+         * \brief Returns the GPIO backend.
+         *
+         * \return The backend of the GPIO pin (GPIO_BACKEND_SYSFS or GPIO_BACKEND_CHARDEV).
+         */
+        uint8_t GetBackend();
 };
 
 #endif // GPIO_H_
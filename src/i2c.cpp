@@ -37,22 +37,167 @@
 #include <fcntl.h>
 #include <sys/ioctl.h>
 #include <unistd.h>
+#include <errno.h>
 
 #include "i2c.h"
 
+using namespace std;
+
+mutex I2CBus::registry_mutex;
+I2CBus *I2CBus::registry[I2C_BUS_MAX_ADAPTERS] = {NULL};
+
+static atomic<unsigned long> ioctl_count(0);    /**< Number of ioctl() calls (see I2C::GetIOCtlCount). */
+
+I2CBus::I2CBus()
+{
+    this->fd    = -1;
+    this->refs  = 0;
+
+    this->next_ticket = 0;
+    this->now_serving = 0;
+}
+
+I2CBus* I2CBus::Acquire(const char *dev_adr)
+{
+    lock_guard<mutex> lock(I2CBus::registry_mutex);
+
+    int free_slot = -1;
+
+    for(unsigned int i=0; i<I2C_BUS_MAX_ADAPTERS; i++)
+    {
+        if (I2CBus::registry[i] == NULL)
+        {
+            if (free_slot < 0)
+            {
+                free_slot = i;
+            }
+        }
+        else if (I2CBus::registry[i]->dev == dev_adr)
+        {
+            I2CBus::registry[i]->refs++;
+
+            return I2CBus::registry[i];
+        }
+    }
+
+    if (free_slot < 0)
+    {
+        return NULL;
+    }
+
+    int fd = open(dev_adr, O_RDWR);
+    if (fd < 0)
+    {
+        return NULL;
+    }
+
+    I2CBus *bus = new I2CBus;
+
+    bus->fd     = fd;
+    bus->dev    = dev_adr;
+    bus->refs   = 1;
+
+    I2CBus::registry[free_slot] = bus;
+
+    return bus;
+}
+
+void I2CBus::Release(I2CBus *bus)
+{
+    lock_guard<mutex> lock(I2CBus::registry_mutex);
+
+    if ((bus == NULL) or (--bus->refs > 0))
+    {
+        return;
+    }
+
+    for(unsigned int i=0; i<I2C_BUS_MAX_ADAPTERS; i++)
+    {
+        if (I2CBus::registry[i] == bus)
+        {
+            I2CBus::registry[i] = NULL;
+        }
+    }
+
+    close(bus->fd);
+
+    delete bus;
+}
+
+void I2CBus::Lock()
+{
+    unique_lock<mutex> lock(this->lock_mutex);
+
+    unsigned int ticket = this->next_ticket++;
+
+    this->lock_cond.wait(lock, [this, ticket]{ return this->now_serving == ticket; });
+}
+
+void I2CBus::Unlock()
+{
+    {
+        lock_guard<mutex> lock(this->lock_mutex);
+
+        this->now_serving++;
+    }
+
+    // Every waiter checks if its ticket is the next one
+    this->lock_cond.notify_all();
+}
+
+bool I2CBus::Transfer(I2C_Msg *msgs, unsigned int len)
+{
+    I2C_RDWR_IOCtl_Data args;
+
+    for(unsigned int i=0; i<len; i+=I2C_RDWR_IOCTL_MAX_MSGS)
+    {
+        args.msgs   = &msgs[i];
+        args.nmsgs  = ((len - i) < I2C_RDWR_IOCTL_MAX_MSGS)? (len - i) : I2C_RDWR_IOCTL_MAX_MSGS;
+
+        this->Lock();
+
+        ioctl_count.fetch_add(1, memory_order_relaxed);
+
+        int res = ioctl(this->fd, I2C_RDWR, &args);
+
+        this->Unlock();
+
+        if (res < 0)
+        {
+            return false;
+        }
+    }
+
+    return true;
+}
+
 I2C::I2C()
 {
-    
+    this->fd    = -1;
+    this->id    = 0;
+    this->bus   = NULL;
+
+    this->last_error = 0;
 }
 
 I2C::I2C(const char* dev_adr, uint8_t dev_id)
 {
+    this->fd    = -1;
+    this->id    = 0;
+    this->bus   = NULL;
+
+    this->last_error = 0;
+
     this->Setup(dev_adr, dev_id);
 }
 
 I2C::~I2C()
 {
-    if (fd >= 0)
+    if (this->bus != NULL)
+    {
+        I2CBus::Release(this->bus);
+    }
+    else if (fd >= 0)
     {
         close(fd);
     }
@@ -65,6 +210,10 @@ bool I2C::Setup(const char* dev_adr, uint8_t dev_id)
         return false;
     }
 
+    this->id = dev_id;
+
+    ioctl_count.fetch_add(1, memory_order_relaxed);
+
     if (ioctl(fd, I2C_SLAVE, dev_id) < 0)
     {
         return false;
@@ -75,63 +224,223 @@ bool I2C::Setup(const char* dev_adr, uint8_t dev_id)
     }
 }
 
+bool I2C::SetupShared(const char* dev_adr, uint8_t dev_id)
+{
+    this->bus = I2CBus::Acquire(dev_adr);
+
+    this->id = dev_id;
+
+    return this->bus != NULL;
+}
+
 int I2C::SMBusAccess(int8_t rw, uint8_t command, uint16_t len, I2C_SMBus_Data *data)
 {
-    I2C_SMBus_IOCtl_Data args;
+    int res;
 
-    args.read_write = rw;
-    args.command    = command;
-    args.size       = len;
-    args.data       = data;
-    
-    return ioctl(fd, I2C_SMBUS, &args);
+    if (this->bus != NULL)
+    {
+        res = this->RDWRAccess(rw, command, len, data);
+    }
+    else
+    {
+        I2C_SMBus_IOCtl_Data args;
+
+        args.read_write = rw;
+        args.command    = command;
+        args.size       = len;
+        args.data       = data;
+
+        ioctl_count.fetch_add(1, memory_order_relaxed);
+
+        res = ioctl(fd, I2C_SMBUS, &args);
+    }
+
+    this->last_error = (res < 0)? errno : 0;
+
+    return res;
 }
 
-uint8_t I2C::Read()
+int I2C::RDWRAccess(int8_t rw, uint8_t command, uint16_t len, I2C_SMBus_Data *data)
+{
+    I2C_Msg msgs[2];
+    uint8_t wr_buf[3];
+    uint8_t rd_buf[2];
+    unsigned int n = 0;
+
+    wr_buf[0] = command;
+
+    msgs[0].addr    = this->id;
+    msgs[0].flags   = 0;
+    msgs[0].len     = 1;
+    msgs[0].buf     = wr_buf;
+
+    msgs[1].addr    = this->id;
+    msgs[1].flags   = I2C_M_RD;
+    msgs[1].buf     = rd_buf;
+
+    switch(len)
+    {
+        case I2C_SMBUS_BYTE:
+            if (rw == I2C_SMBUS_READ)
+            {
+                msgs[0] = msgs[1];
+                msgs[0].len = 1;
+            }
+
+            n = 1;
+
+            break;
+        case I2C_SMBUS_BYTE_DATA:
+            if (rw == I2C_SMBUS_READ)
+            {
+                msgs[1].len = 1;
+                n = 2;
+            }
+            else
+            {
+                wr_buf[1] = data->byte;
+                msgs[0].len = 2;
+                n = 1;
+            }
+
+            break;
+        case I2C_SMBUS_WORD_DATA:
+            // SMBus words are transfered LSB first
+            if (rw == I2C_SMBUS_READ)
+            {
+                msgs[1].len = 2;
+                n = 2;
+            }
+            else
+            {
+                wr_buf[1] = data->word & 0xFF;
+                wr_buf[2] = (data->word >> 8) & 0xFF;
+                msgs[0].len = 3;
+                n = 1;
+            }
+
+            break;
+        default:
+            return -1;
+    }
+
+    if (!this->bus->Transfer(msgs, n))
+    {
+        return -1;
+    }
+
+    if (rw == I2C_SMBUS_READ)
+    {
+        if (len == I2C_SMBUS_WORD_DATA)
+        {
+            data->word = rd_buf[0] | (rd_buf[1] << 8);
+        }
+        else
+        {
+            data->byte = rd_buf[0];
+        }
+    }
+
+    return 0;
+}
+
+I2CResult<uint8_t> I2C::TryRead()
 {
     I2C_SMBus_Data data;
+    I2CResult<uint8_t> res;
+
+    res.error = 0;
+    res.value = 0xFF;
 
     if (this->SMBusAccess(I2C_SMBUS_READ, 0, I2C_SMBUS_BYTE, &data))
     {
-        return -1;
+        res.error = this->last_error;
     }
     else
     {
-        return data.byte & 0xFF;
+        res.value = data.byte & 0xFF;
     }
+
+    return res;
 }
 
-uint8_t I2C::ReadReg8(uint8_t reg_adr)
+I2CResult<uint8_t> I2C::TryReadReg8(uint8_t reg_adr)
 {
     I2C_SMBus_Data data;
+    I2CResult<uint8_t> res;
+
+    res.error = 0;
+    res.value = 0xFF;
 
     if (this->SMBusAccess(I2C_SMBUS_READ, reg_adr, I2C_SMBUS_BYTE_DATA, &data))
     {
-        return -1;
+        res.error = this->last_error;
     }
     else
     {
-        return data.byte & 0xFF;
+        res.value = data.byte & 0xFF;
     }
+
+    return res;
 }
 
-uint16_t I2C::ReadReg16(uint8_t reg_adr)
+I2CResult<uint16_t> I2C::TryReadReg16(uint8_t reg_adr)
 {
     I2C_SMBus_Data data;
+    I2CResult<uint16_t> res;
+
+    res.error = 0;
+    res.value = 0xFFFF;
 
     if (this->SMBusAccess(I2C_SMBUS_READ, reg_adr, I2C_SMBUS_WORD_DATA, &data))
     {
-        return -1;
+        res.error = this->last_error;
     }
     else
     {
-        return data.word & 0xFFFF;
+        res.value = data.word & 0xFFFF;
+    }
+
+    return res;
+}
+
+uint8_t I2C::ClassifyError(int err)
+{
+    switch(err)
+    {
+        case 0:
+            return I2C_ERROR_NONE;
+        case EAGAIN:        // Arbitration lost
+        case EREMOTEIO:     // NAK from the slave
+        case ETIMEDOUT:
+        case EBUSY:
+        case EIO:
+        case EINTR:
+        case EPROTO:
+            return I2C_ERROR_TRANSIENT;
+        default:            // ENODEV, ENXIO, EBADF, ENOTTY, EINVAL, ...
+            return I2C_ERROR_FATAL;
     }
 }
 
+uint8_t I2C::Read()
+{
+    return this->TryRead().value;
+}
+
+uint8_t I2C::ReadReg8(uint8_t reg_adr)
+{
+    return this->TryReadReg8(reg_adr).value;
+}
+
+uint16_t I2C::ReadReg16(uint8_t reg_adr)
+{
+    return this->TryReadReg16(reg_adr).value;
+}
+
 bool I2C::Write(uint8_t byte)
 {
-    return this->SMBusAccess(I2C_SMBUS_WRITE, byte, I2C_SMBUS_BYTE, NULL);
+    return this->SMBusAccess(I2C_SMBUS_WRITE, byte, I2C_SMBUS_BYTE, NULL) == 0;
 }
 
 bool I2C::WriteReg8(uint8_t reg_adr, uint8_t value)
@@ -140,7 +449,7 @@ bool I2C::WriteReg8(uint8_t reg_adr, uint8_t value)
 
     data.byte = value;
     
-    return this->SMBusAccess(I2C_SMBUS_WRITE, reg_adr, I2C_SMBUS_BYTE_DATA, &data);
+    return this->SMBusAccess(I2C_SMBUS_WRITE, reg_adr, I2C_SMBUS_BYTE_DATA, &data) == 0;
 }
 
 bool I2C::WriteReg16(uint8_t reg_adr, uint16_t value)
@@ -149,7 +458,58 @@ bool I2C::WriteReg16(uint8_t reg_adr, uint16_t value)
 
     data.word = value;
     
-    return this->SMBusAccess(I2C_SMBUS_WRITE, reg_adr, I2C_SMBUS_WORD_DATA, &data);
+    return this->SMBusAccess(I2C_SMBUS_WRITE, reg_adr, I2C_SMBUS_WORD_DATA, &data) == 0;
+}
+
+bool I2C::Transfer(I2C_Msg *msgs, unsigned int len)
+{
+    this->last_error = 0;
+
+    if (this->bus != NULL)
+    {
+        if (!this->bus->Transfer(msgs, len))
+        {
+            this->last_error = errno;
+
+            return false;
+        }
+
+        return true;
+    }
+
+    I2C_RDWR_IOCtl_Data args;
+
+    for(unsigned int i=0; i<len; i+=I2C_RDWR_IOCTL_MAX_MSGS)
+    {
+        args.msgs   = &msgs[i];
+        args.nmsgs  = ((len - i) < I2C_RDWR_IOCTL_MAX_MSGS)? (len - i) : I2C_RDWR_IOCTL_MAX_MSGS;
+
+        ioctl_count.fetch_add(1, memory_order_relaxed);
+
+        if (ioctl(fd, I2C_RDWR, &args) < 0)
+        {
+            this->last_error = errno;
+
+            return false;
+        }
+    }
+
+    return true;
+}
+
+uint8_t I2C::GetSlaveID()
+{
+    return this->id;
+}
+
+int I2C::GetLastError()
+{
+    return this->last_error;
+}
+
+unsigned long I2C::GetIOCtlCount()
+{
+    return ioctl_count.load(memory_order_relaxed);
 }
 
 //! \} End of i2c group
@@ -37,6 +37,10 @@
 #define I2C_H_
 
 #include <stdint.h>
+#include <atomic>
+#include <mutex>
+#include <condition_variable>
+#include <string>
 
 #define I2C_DEV_ADR_RPI_1                   "/dev/i2c-0"
 #define I2C_DEV_ADR_RPI_2                   "/dev/i2c-1"
@@ -45,6 +49,14 @@
 // I2C definitions
 #define I2C_SLAVE                           0x0703
 #define I2C_SMBUS                           0x0720  // SMBus-level access
+#define I2C_RDWR                            0x0707  // Combined R/W transfer (one STOP only)
+
+// I2C message flags
+#define I2C_M_RD                            0x0001  // Read data, from slave to master
+
+#define I2C_RDWR_IOCTL_MAX_MSGS             42      // Max. number of messages per I2C_RDWR call
+
+#define I2C_BUS_MAX_ADAPTERS                8       // Max. number of opened adapters (shared buses)
 
 #define I2C_SMBUS_READ                      1
 #define I2C_SMBUS_WRITE                     0
@@ -64,6 +76,31 @@
 #define I2C_SMBUS_BLOCK_MAX                 32      // As specified in SMBus standard	
 #define I2C_SMBUS_I2C_BLOCK_MAX             32      // Not specified but we use same structure
 
+// Error classes
+#define I2C_ERROR_NONE                      0       // No error
+#define I2C_ERROR_TRANSIENT                 1       // The transaction can be retried (EAGAIN, EREMOTEIO, ...)
+#define I2C_ERROR_FATAL                     2       // The adapter or the device is not usable (ENODEV, ...)
+
+/**
+ * \brief Result of a read transaction (value plus errno).
+ */
+template<typename T>
+struct I2CResult
+{
+    T value;                /**< Read value (only valid if error is 0). */
+    int error;              /**< errno of the transaction (0 if successful). */
+
+    /**
+     * \brief Checks if the transaction was successful.
+     *
+     * \return TRUE/FALSE if the value is valid or not.
+     */
+    bool Ok() const
+    {
+        return this->error == 0;
+    }
+};
+
 /**
  * \brief Structure used in the ioctl() calls.
  */
@@ -85,6 +122,105 @@ struct I2C_SMBus_IOCtl_Data
     I2C_SMBus_Data *data;   /**< Data to transfer. */
 };
 
+/**
+ * \brief I2C message (one segment of a combined transfer).
+ */
+struct I2C_Msg
+{
+    uint16_t addr;          /**< Slave address (7-bit). */
+    uint16_t flags;         /**< Message flags (I2C_M_RD for reading). */
+    uint16_t len;           /**< Message length. */
+    uint8_t *buf;           /**< Pointer to the message data. */
+};
+
+/**
+ * \brief Structure used in the I2C_RDWR ioctl() calls.
+ */
+struct I2C_RDWR_IOCtl_Data
+{
+    I2C_Msg *msgs;          /**< Array of messages. */
+    uint32_t nmsgs;         /**< Number of messages in the array. */
+};
+
+/**
+ * \brief Shared I2C adapter.
+ *
+ * One file descriptor is opened per adapter and shared by all the devices connected to it. All the transfers use
+ * I2C_RDWR with the slave address in each message, so no I2C_SLAVE selection is needed between devices. The access
+ * to the adapter is arbitrated with a ticket lock, so the devices are served in request order (each I2C_RDWR call
+ * is an atomic unit). The waiting threads sleep on a condition variable until their ticket is served.
+ */
+class I2CBus
+{
+    private:
+        int fd;                                 /**< File descriptor of the adapter. */
+        std::string dev;                        /**< Adapter device path. */
+        unsigned int refs;                      /**< Number of users of the adapter. */
+        unsigned int next_ticket;               /**< Next ticket of the access lock. */
+        unsigned int now_serving;               /**< Ticket being served. */
+        std::mutex lock_mutex;                  /**< Lock of the tickets counters. */
+        std::condition_variable lock_cond;      /**< Signaled when a ticket is released. */
+
+        static std::mutex registry_mutex;                   /**< Lock of the opened adapters list. */
+        static I2CBus *registry[I2C_BUS_MAX_ADAPTERS];      /**< Opened adapters. */
+
+        /**
+         * \brief Class constructor (use "Acquire" to get an adapter).
+         *
+         * \return None
+         */
+        I2CBus();
+
+        /**
+         * \brief Waits for the access to the adapter.
+         *
+         * \return None
+         */
+        void Lock();
+
+        /**
+         * \brief Releases the access to the adapter.
+         *
+         * \return None
+         */
+        void Unlock();
+
+    public:
+        /**
+         * \brief Gets a shared adapter, opening it if necessary.
+         *
+         * \param[in] dev_adr is the I2C device address (ex.: I2C_DEV_ADR_RPI_2).
+         *
+         * \return A pointer to the adapter or NULL on error.
+         */
+        static I2CBus* Acquire(const char *dev_adr);
+
+        /**
+         * \brief Releases a shared adapter. The adapter is closed when it has no more users.
+         *
+         * \param[in] bus is the adapter to release.
+         *
+         * \return None
+         */
+        static void Release(I2CBus *bus);
+
+        /**
+         * \brief Executes a sequence of I2C messages with the I2C_RDWR ioctl().
+         *
+         * The messages are sent in groups of up to I2C_RDWR_IOCTL_MAX_MSGS messages. The lock is taken for each
+         * group, so the transfers of other devices can be interleaved between groups.
+         *
+         * \param[in,out] msgs is an array of messages.
+         * \param[in] len is the number of messages in the array.
+         *
+         * \return It returns:
+         *          -\b TRUE if no error occurred during the transfer.
+         *          -\b FALSE if an error occurred during the transfer.
+         *          .
+         */
+        bool Transfer(I2C_Msg *msgs, unsigned int len);
+};
+
 /**
  * \brief I2C master driver.
  * 
@@ -93,7 +229,10 @@ struct I2C_SMBus_IOCtl_Data
 class I2C
 {
     private:
-        int fd;     /**< File descriptor. */
+        int fd;         /**< File descriptor. */
+        uint8_t id;     /**< Slave ID (7-bit I2C address). */
+        I2CBus *bus;    /**< Shared adapter (NULL if the device has its own file descriptor). */
+        int last_error; /**< errno of the last transaction (0 if successful). */
 
         /**
          * \brief 
@@ -106,6 +245,18 @@ class I2C
          * \return The ioctl() function error code.
          */
         int SMBusAccess(int8_t rw, uint8_t command, uint16_t len, I2C_SMBus_Data *data);
+
+        /**
+         * \brief Executes an SMBus-like access with I2C_RDWR messages (shared adapter).
+         *
+         * \param rw indicates a read (I2C_SMBUS_READ) or write (I2C_SMBUS_WRITE) operation.
+         * \param command is a byte written before the data stream.
+         * \param len is the length of the data (I2C_SMBUS_BYTE, I2C_SMBUS_BYTE_DATA or I2C_SMBUS_WORD_DATA).
+         * \param data is the data to be transfered.
+         *
+         * \return 0 on success or -1 on error.
+         */
+        int RDWRAccess(int8_t rw, uint8_t command, uint16_t len, I2C_SMBus_Data *data);
     public:
 
         /**
@@ -145,9 +296,67 @@ class I2C
          */
         bool Setup(const char* dev_adr, uint8_t dev_id);
 
+        /**
+         * \brief Configures the I2C communication with an I2C device through a shared adapter.
+         *
+         * The adapter is opened only once for all the devices connected to it (see I2CBus).
+         *
+         * \param[in] dev_adr is the I2C device address.
+         * \param[in] dev_id is the I2C slave ID (7-bit I2C address).
+         *
+         * \return It returns:
+         *          -\b TRUE if no error occurred during the configuration.
+         *          -\b FALSE if an error occurred during the configuration.
+         *          .
+         */
+        bool SetupShared(const char* dev_adr, uint8_t dev_id);
+
+        /**
+         * \brief Reads a byte from the device.
+         *
+         * \return The byte read from the slave and the error of the transaction.
+         */
+        I2CResult<uint8_t> TryRead();
+
+        /**
+         * \brief Reads a byte from a register of the device.
+         *
+         * \param[in] reg_adr is the device register address.
+         *
+         * \return The byte from the slave register and the error of the transaction.
+         */
+        I2CResult<uint8_t> TryReadReg8(uint8_t reg_adr);
+
+        /**
+         * \brief Reads a word (16-bit) from a register of the device.
+         *
+         * \param[in] reg_adr is the device register address.
+         *
+         * \return The word (16-bit) from the slave register and the error of the transaction.
+         */
+        I2CResult<uint16_t> TryReadReg16(uint8_t reg_adr);
+
+        /**
+         * \brief Classifies an errno value of a transaction.
+         *
+         * \param[in] err is the errno value.
+         *
+         * \return The error class (I2C_ERROR_NONE, I2C_ERROR_TRANSIENT or I2C_ERROR_FATAL).
+         */
+        static uint8_t ClassifyError(int err);
+
+        /**
+         * \brief Gets the number of ioctl() calls done by all the I2C devices and adapters of the process.
+         *
+         * \return The number of ioctl() calls.
+         */
+        static unsigned long GetIOCtlCount();
+
         /**
          * \brief Reads a byte from the device.
          * 
+         * \note On error, 0xFF is returned (use "TryRead" to check errors).
+         *
          * \return The byte read from the slave.
          */
         uint8_t Read();
@@ -155,6 +364,8 @@ class I2C
         /**
          * \brief Reads a byte from a register of the device.
          * 
+         * \note On error, 0xFF is returned (use "TryReadReg8" to check errors).
+         *
          * \param[in] reg_adr is the device register address.
          * 
          * \return The byte from the slave register.
@@ -164,6 +375,8 @@ class I2C
         /**
          * \brief Reads a word (16-bit) from a register of the device.
          * 
+         * \note On error, 0xFFFF is returned (use "TryReadReg16" to check errors).
+         *
          * \param[in] reg_adr is the device register address.
          * 
          * \return The word (16-bit) from the slave register.
@@ -207,6 +420,35 @@ class I2C
          *          .
          */
         bool WriteReg16(uint8_t reg_adr, uint16_t value);
+
+        /**
+         * \brief Executes a sequence of I2C messages with the I2C_RDWR ioctl().
+         *
+         * The messages are sent in groups of up to I2C_RDWR_IOCTL_MAX_MSGS messages per system call.
+         *
+         * \param[in,out] msgs is an array of messages.
+         * \param[in] len is the number of messages in the array.
+         *
+         * \return It returns:
+         *          -\b TRUE if no error occurred during the transfer.
+         *          -\b FALSE if an error occurred during the transfer.
+         *          .
+         */
+        bool Transfer(I2C_Msg *msgs, unsigned int len);
+
+        /**
+         * \brief Gets the slave ID configured in the setup.
+         *
+         * \return The slave ID (7-bit I2C address).
+         */
+        uint8_t GetSlaveID();
+
+        /**
+         * \brief Gets the error of the last transaction.
+         *
+         * \return The errno value of the last transaction (0 if it was successful).
+         */
+        int GetLastError();
 };
 
 #endif // I2C_H_
@@ -0,0 +1,339 @@
+/*
+ * i2c_stats.cpp
+ * 
+ * Copyright (C) 2018, Gabriel Mariano Marcelino <gabriel.mm8@gmail.com>
+ * 
+ * This file is part of MT9D111-Driver.
+ * 
+ * MT9D111-Driver is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ * 
+ * MT9D111-Driver is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ * 
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with MT9D111-Driver. If not, see <http://www.gnu.org/licenses/>.
+ * 
+ */
+
+/**
+ * \brief I2C transactions statistics implementation.
+ * 
+ * \author Gabriel Mariano Marcelino <gabriel.mm8@gmail.com>
+ * 
+ * \version 1.0-dev
+ * 
+ * \date 17/10/2026
+ * 
+ * \addtogroup i2c
+ * \{
+ */
+
+#include <string.h>
+#include <time.h>
+
+#include "i2c_stats.h"
+
+using namespace std;
+
+I2CStats::I2CStats()
+{
+    this->trace         = NULL;
+    this->trace_len     = 0;
+    this->trace_count   = 0;
+
+    this->Reset();
+}
+
+I2CStats::~I2CStats()
+{
+    delete[] this->trace;
+}
+
+uint64_t I2CStats::Now()
+{
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+
+    return (uint64_t)now.tv_sec*1000000000ULL + now.tv_nsec;
+}
+
+unsigned int I2CStats::Bucket(uint32_t us)
+{
+    // The first 2 powers of 2 are linear
+    if (us < 2*I2C_STATS_HIST_SUB_BUCKETS)
+    {
+        return us;
+    }
+
+    unsigned int e = 31 - __builtin_clz(us);
+    unsigned int sub = (us >> (e - I2C_STATS_HIST_SUB_BUCKET_BITS)) & (I2C_STATS_HIST_SUB_BUCKETS - 1);
+
+    return 2*I2C_STATS_HIST_SUB_BUCKETS + (e - I2C_STATS_HIST_SUB_BUCKET_BITS - 1)*I2C_STATS_HIST_SUB_BUCKETS + sub;
+}
+
+uint32_t I2CStats::BucketValue(unsigned int bucket)
+{
+    if (bucket < 2*I2C_STATS_HIST_SUB_BUCKETS)
+    {
+        return bucket;
+    }
+
+    unsigned int e = (bucket - 2*I2C_STATS_HIST_SUB_BUCKETS)/I2C_STATS_HIST_SUB_BUCKETS + I2C_STATS_HIST_SUB_BUCKET_BITS + 1;
+    unsigned int sub = (bucket - 2*I2C_STATS_HIST_SUB_BUCKETS) % I2C_STATS_HIST_SUB_BUCKETS;
+
+    return (I2C_STATS_HIST_SUB_BUCKETS + sub) << (e - I2C_STATS_HIST_SUB_BUCKET_BITS);
+}
+
+I2CRegCounters& I2CStats::Counters(uint8_t page, uint8_t adr)
+{
+    if (page >= I2C_STATS_MAX_PAGES)
+    {
+        page = I2C_STATS_MAX_PAGES - 1;
+    }
+
+    return this->regs[page][adr];
+}
+
+void I2CStats::Record(uint8_t op, uint8_t slave, uint8_t page, uint8_t adr, uint16_t val, uint64_t start, int error)
+{
+    uint64_t end = I2CStats::Now();
+    uint64_t duration = (end - start)/1000;
+    uint32_t us = (duration > 0xFFFFFFFF)? 0xFFFFFFFF : duration;
+
+    lock_guard<mutex> guard(this->lock);
+
+    if (op != I2C_STATS_OP_TRANSFER)
+    {
+        I2CRegCounters &cnt = this->Counters(page, adr);
+
+        if (op == I2C_STATS_OP_READ)
+        {
+            cnt.reads++;
+        }
+        else
+        {
+            cnt.writes++;
+        }
+
+        if (error != 0)
+        {
+            cnt.failures++;
+        }
+    }
+
+    if (op < I2C_STATS_OPS)
+    {
+        I2CLatencyHistogram &h = this->hist[op];
+
+        h.counts[I2CStats::Bucket(us)]++;
+        h.total++;
+        h.sum_us += us;
+
+        if (us < h.min_us)
+        {
+            h.min_us = us;
+        }
+
+        if (us > h.max_us)
+        {
+            h.max_us = us;
+        }
+    }
+
+    if (this->trace != NULL)
+    {
+        I2CTraceEntry &entry = this->trace[this->trace_count % this->trace_len];
+
+        entry.timestamp     = start;
+        entry.slave         = slave;
+        entry.op            = op;
+        entry.page          = page;
+        entry.address       = adr;
+        entry.value         = val;
+        entry.duration_us   = us;
+        entry.error         = error;
+
+        this->trace_count++;
+    }
+}
+
+void I2CStats::Count(uint8_t page, uint8_t adr, bool write, bool failed)
+{
+    lock_guard<mutex> guard(this->lock);
+
+    I2CRegCounters &cnt = this->Counters(page, adr);
+
+    if (write)
+    {
+        cnt.writes++;
+    }
+    else
+    {
+        cnt.reads++;
+    }
+
+    if (failed)
+    {
+        cnt.failures++;
+    }
+}
+
+void I2CStats::CountRetry(uint8_t page, uint8_t adr)
+{
+    lock_guard<mutex> guard(this->lock);
+
+    this->Counters(page, adr).retries++;
+}
+
+void I2CStats::EnableTrace(size_t len)
+{
+    lock_guard<mutex> guard(this->lock);
+
+    delete[] this->trace;
+
+    this->trace         = (len > 0)? new I2CTraceEntry[len] : NULL;
+    this->trace_len     = len;
+    this->trace_count   = 0;
+}
+
+I2CRegCounters I2CStats::GetCounters(uint8_t page, uint8_t adr) const
+{
+    lock_guard<mutex> guard(this->lock);
+
+    if (page >= I2C_STATS_MAX_PAGES)
+    {
+        page = I2C_STATS_MAX_PAGES - 1;
+    }
+
+    return this->regs[page][adr];
+}
+
+I2CLatencyHistogram I2CStats::GetHistogram(uint8_t op) const
+{
+    lock_guard<mutex> guard(this->lock);
+
+    if (op >= I2C_STATS_OPS)
+    {
+        I2CLatencyHistogram empty;
+        memset(&empty, 0, sizeof(empty));
+
+        return empty;
+    }
+
+    return this->hist[op];
+}
+
+uint32_t I2CStats::GetPercentile(uint8_t op, double p) const
+{
+    I2CLatencyHistogram h = this->GetHistogram(op);
+
+    if (h.total == 0)
+    {
+        return 0;
+    }
+
+    uint64_t target = (uint64_t)((p/100.0)*h.total + 0.5);
+    if (target < 1)
+    {
+        target = 1;
+    }
+
+    uint64_t acc = 0;
+    for(unsigned int i=0; i<I2C_STATS_HIST_BUCKETS; i++)
+    {
+        acc += h.counts[i];
+
+        if (acc >= target)
+        {
+            return I2CStats::BucketValue(i);
+        }
+    }
+
+    return h.max_us;
+}
+
+size_t I2CStats::GetTrace(I2CTraceEntry *entries, size_t len) const
+{
+    lock_guard<mutex> guard(this->lock);
+
+    if (this->trace == NULL)
+    {
+        return 0;
+    }
+
+    uint64_t n = (this->trace_count < this->trace_len)? this->trace_count : this->trace_len;
+    if (n > len)
+    {
+        n = len;
+    }
+
+    // Oldest entry still in the ring
+    uint64_t first = this->trace_count - n;
+
+    for(uint64_t i=0; i<n; i++)
+    {
+        entries[i] = this->trace[(first + i) % this->trace_len];
+    }
+
+    return n;
+}
+
+void I2CStats::Reset()
+{
+    lock_guard<mutex> guard(this->lock);
+
+    memset(this->regs, 0, sizeof(this->regs));
+    memset(this->hist, 0, sizeof(this->hist));
+
+    for(unsigned int i=0; i<I2C_STATS_OPS; i++)
+    {
+        this->hist[i].min_us = 0xFFFFFFFF;
+    }
+
+    this->trace_count = 0;
+}
+
+void I2CStats::Dump(FILE *out) const
+{
+    static const char *op_names[I2C_STATS_OPS] = {"READ", "WRITE", "TRANSFER"};
+
+    fprintf(out, "I2C latency (us):\n");
+
+    for(uint8_t op=0; op<I2C_STATS_OPS; op++)
+    {
+        I2CLatencyHistogram h = this->GetHistogram(op);
+
+        if (h.total == 0)
+        {
+            continue;
+        }
+
+        fprintf(out, "    %-8s n=%llu min=%u p50=%u p90=%u p99=%u max=%u mean=%llu\n", op_names[op],
+                (unsigned long long)h.total, h.min_us, this->GetPercentile(op, 50.0), this->GetPercentile(op, 90.0),
+                this->GetPercentile(op, 99.0), h.max_us, (unsigned long long)(h.sum_us/h.total));
+    }
+
+    fprintf(out, "I2C registers (page:address reads writes retries failures):\n");
+
+    for(unsigned int page=0; page<I2C_STATS_MAX_PAGES; page++)
+    {
+        for(unsigned int adr=0; adr<I2C_STATS_PAGE_SIZE; adr++)
+        {
+            I2CRegCounters cnt = this->GetCounters(page, adr);
+
+            if ((cnt.reads | cnt.writes | cnt.retries | cnt.failures) == 0)
+            {
+                continue;
+            }
+
+            fprintf(out, "    %u:0x%02X %u %u %u %u\n", page, adr, cnt.reads, cnt.writes, cnt.retries, cnt.failures);
+        }
+    }
+}
+
+//! \} End of i2c group
@@ -0,0 +1,265 @@
+/*
+ * i2c_stats.h
+ * 
+ * Copyright (C) 2018, Gabriel Mariano Marcelino <gabriel.mm8@gmail.com>
+ * 
+ * This file is part of MT9D111-Driver.
+ * 
+ * MT9D111-Driver is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ * 
+ * MT9D111-Driver is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ * 
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with MT9D111-Driver. If not, see <http://www.gnu.org/licenses/>.
+ * 
+ */
+
+/**
+ * \brief I2C transactions statistics (counters, latency histograms and trace).
+ * 
+ * \author Gabriel Mariano Marcelino <gabriel.mm8@gmail.com>
+ * 
+ * \version 1.0-dev
+ * 
+ * \date 17/10/2026
+ * 
+ * \ingroup i2c
+ * \{
+ */
+
+#ifndef I2C_STATS_H_
+#define I2C_STATS_H_
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdio.h>
+#include <mutex>
+
+// Operation types
+#define I2C_STATS_OP_READ                   0   // Single register read
+#define I2C_STATS_OP_WRITE                  1   // Single register write
+#define I2C_STATS_OP_TRANSFER               2   // Batched transfer (I2C_RDWR with several messages)
+#define I2C_STATS_OPS                       3
+
+#define I2C_STATS_MAX_PAGES                 4   // Last page counts the unknown/other pages
+#define I2C_STATS_PAGE_SIZE                 256
+
+// Latency histograms (log-linear buckets, as in HdrHistogram)
+#define I2C_STATS_HIST_SUB_BUCKET_BITS      3   // 8 linear sub-buckets per power of 2 (12.5 % resolution)
+#define I2C_STATS_HIST_SUB_BUCKETS          (1 << I2C_STATS_HIST_SUB_BUCKET_BITS)
+#define I2C_STATS_HIST_BUCKETS              (2*I2C_STATS_HIST_SUB_BUCKETS + (32 - I2C_STATS_HIST_SUB_BUCKET_BITS - 1)*I2C_STATS_HIST_SUB_BUCKETS)
+
+/**
+ * \brief Counters of a register.
+ */
+struct I2CRegCounters
+{
+    uint32_t reads;         /**< Number of reads. */
+    uint32_t writes;        /**< Number of writes. */
+    uint32_t retries;       /**< Number of repeated writes (failed verification). */
+    uint32_t failures;      /**< Number of failed transactions. */
+};
+
+/**
+ * \brief Latency histogram of an operation type (in microseconds).
+ */
+struct I2CLatencyHistogram
+{
+    uint32_t counts[I2C_STATS_HIST_BUCKETS];    /**< Number of samples per bucket. */
+    uint64_t total;                             /**< Number of samples. */
+    uint64_t sum_us;                            /**< Sum of all samples. */
+    uint32_t min_us;                            /**< Min. sample. */
+    uint32_t max_us;                            /**< Max. sample. */
+};
+
+/**
+ * \brief Trace entry of a transaction.
+ */
+struct I2CTraceEntry
+{
+    uint64_t timestamp;     /**< Start time (CLOCK_MONOTONIC, in nanoseconds). */
+    uint8_t  slave;         /**< Slave address. */
+    uint8_t  op;            /**< Operation type (I2C_STATS_OP_*). */
+    uint8_t  page;          /**< Register page. */
+    uint8_t  address;       /**< Register address (first register of a transfer). */
+    uint16_t value;         /**< Register value (number of messages of a transfer). */
+    uint32_t duration_us;   /**< Duration in microseconds. */
+    int      error;         /**< errno (0 if successful). */
+};
+
+/**
+ * \brief Statistics of the I2C transactions of a device.
+ *
+ * All methods are thread-safe.
+ */
+class I2CStats
+{
+    private:
+        I2CRegCounters regs[I2C_STATS_MAX_PAGES][I2C_STATS_PAGE_SIZE];  /**< Per register counters. */
+        I2CLatencyHistogram hist[I2C_STATS_OPS];                        /**< Latency histograms per operation type. */
+        I2CTraceEntry *trace;                                           /**< Trace ring (NULL if disabled). */
+        size_t trace_len;                                               /**< Capacity of the trace ring. */
+        uint64_t trace_count;                                           /**< Total number of traced transactions. */
+        mutable std::mutex lock;                                        /**< Access lock. */
+
+        /**
+         * \brief Gets the counters of a register.
+         *
+         * \param[in] page is the register page.
+         * \param[in] adr is the register address.
+         *
+         * \return A reference to the counters.
+         */
+        I2CRegCounters& Counters(uint8_t page, uint8_t adr);
+
+    public:
+        /**
+         * \brief Constructor.
+         *
+         * \return None.
+         */
+        I2CStats();
+
+        /**
+         * \brief Destructor.
+         *
+         * \return None.
+         */
+        ~I2CStats();
+
+        /**
+         * \brief Gets the current time to measure a transaction.
+         *
+         * \return The CLOCK_MONOTONIC time in nanoseconds.
+         */
+        static uint64_t Now();
+
+        /**
+         * \brief Gets the histogram bucket of a latency.
+         *
+         * \param[in] us is the latency in microseconds.
+         *
+         * \return The bucket index.
+         */
+        static unsigned int Bucket(uint32_t us);
+
+        /**
+         * \brief Gets the lowest latency of a histogram bucket.
+         *
+         * \param[in] bucket is the bucket index.
+         *
+         * \return The lowest latency of the bucket in microseconds.
+         */
+        static uint32_t BucketValue(unsigned int bucket);
+
+        /**
+         * \brief Records a transaction.
+         *
+         * \param[in] op is the operation type (I2C_STATS_OP_*).
+         * \param[in] slave is the slave address.
+         * \param[in] page is the register page.
+         * \param[in] adr is the register address.
+         * \param[in] val is the register value (or number of messages of a transfer).
+         * \param[in] start is the start time of the transaction (see "Now").
+         * \param[in] error is the errno of the transaction (0 if successful).
+         *
+         * \return None.
+         */
+        void Record(uint8_t op, uint8_t slave, uint8_t page, uint8_t adr, uint16_t val, uint64_t start, int error);
+
+        /**
+         * \brief Counts a register access of a batched transfer (the transfer itself is recorded with "Record").
+         *
+         * \param[in] page is the register page.
+         * \param[in] adr is the register address.
+         * \param[in] write indicates a write (TRUE) or a read (FALSE).
+         * \param[in] failed indicates if the transfer failed.
+         *
+         * \return None.
+         */
+        void Count(uint8_t page, uint8_t adr, bool write, bool failed);
+
+        /**
+         * \brief Counts a retry of a register write.
+         *
+         * \param[in] page is the register page.
+         * \param[in] adr is the register address.
+         *
+         * \return None.
+         */
+        void CountRetry(uint8_t page, uint8_t adr);
+
+        /**
+         * \brief Enables the trace ring (the oldest entries are overwritten when it is full).
+         *
+         * \param[in] len is the number of entries of the ring (0 disables the trace).
+         *
+         * \return None.
+         */
+        void EnableTrace(size_t len);
+
+        /**
+         * \brief Gets the counters of a register.
+         *
+         * \param[in] page is the register page.
+         * \param[in] adr is the register address.
+         *
+         * \return A copy of the counters.
+         */
+        I2CRegCounters GetCounters(uint8_t page, uint8_t adr) const;
+
+        /**
+         * \brief Gets the latency histogram of an operation type.
+         *
+         * \param[in] op is the operation type (I2C_STATS_OP_*).
+         *
+         * \return A copy of the histogram.
+         */
+        I2CLatencyHistogram GetHistogram(uint8_t op) const;
+
+        /**
+         * \brief Gets a percentile of the latency of an operation type.
+         *
+         * \param[in] op is the operation type (I2C_STATS_OP_*).
+         * \param[in] p is the percentile (0.0 to 100.0).
+         *
+         * \return The latency (lowest value of the bucket) in microseconds.
+         */
+        uint32_t GetPercentile(uint8_t op, double p) const;
+
+        /**
+         * \brief Copies the trace entries, from the oldest to the newest.
+         *
+         * \param[in,out] entries is the array to store the entries.
+         * \param[in] len is the capacity of the array.
+         *
+         * \return The number of copied entries.
+         */
+        size_t GetTrace(I2CTraceEntry *entries, size_t len) const;
+
+        /**
+         * \brief Clears all the counters, histograms and trace entries.
+         *
+         * \return None.
+         */
+        void Reset();
+
+        /**
+         * \brief Writes a human readable report of the statistics.
+         *
+         * \param[in] out is the output file.
+         *
+         * \return None.
+         */
+        void Dump(FILE *out) const;
+};
+
+#endif // I2C_STATS_H_
+
+//! \} End of i2c group
@@ -0,0 +1,266 @@
+/*
+ * logger.cpp
+ * 
+ * Copyright (C) 2018, Gabriel Mariano Marcelino <gabriel.mm8@gmail.com>
+ * 
+ * This file is part of MT9D111-Driver.
+ * 
+ * MT9D111-Driver is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ * 
+ * MT9D111-Driver is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ * 
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with MT9D111-Driver. If not, see <http://www.gnu.org/licenses/>.
+ * 
+ */
+
+/**
+ * \brief Binary ring buffer logger implementation.
+ * 
+ * \author Gabriel Mariano Marcelino <gabriel.mm8@gmail.com>
+ * 
+ * \version 1.0-dev
+ * 
+ * \date 17/10/2026
+ * 
+ * \addtogroup logger
+ * \{
+ */
+
+#include <time.h>
+#include <chrono>
+#include <system_error>
+
+#include "logger.h"
+
+using namespace std;
+
+static_assert((LOGGER_RING_SIZE & (LOGGER_RING_SIZE - 1)) == 0, "LOGGER_RING_SIZE must be a power of 2!");
+
+Logger::Logger()
+{
+    for(uint64_t i=0; i<LOGGER_RING_SIZE; i++)
+    {
+        this->ring[i].seq.store(i, memory_order_relaxed);
+    }
+
+    this->write_idx.store(0);
+    this->read_idx = 0;
+    this->dropped.store(0);
+    this->running.store(false);
+    this->out = stdout;
+}
+
+Logger::~Logger()
+{
+    this->Stop();
+}
+
+Logger& Logger::Instance()
+{
+    static Logger logger;
+
+    return logger;
+}
+
+bool Logger::Start(FILE *o)
+{
+    if (this->running.exchange(true))
+    {
+        return true;
+    }
+
+    this->out = o;
+
+    try
+    {
+        this->drainer = thread(&Logger::Drainer, this);
+    }
+    catch(const system_error &)
+    {
+        this->running.store(false);
+
+        return false;
+    }
+
+    return true;
+}
+
+void Logger::Stop()
+{
+    this->running.store(false);
+
+    if (this->drainer.joinable())
+    {
+        this->drainer.join();
+    }
+
+    this->Drain();
+}
+
+unsigned int Logger::Drain()
+{
+    return this->Consume();
+}
+
+unsigned int Logger::Consume()
+{
+    lock_guard<mutex> lock(this->consume_mutex);
+
+    return this->ConsumeLocked();
+}
+
+unsigned int Logger::ConsumeLocked()
+{
+    unsigned int n = 0;
+
+    while(1)
+    {
+        LogRecord &rec = this->ring[this->read_idx & (LOGGER_RING_SIZE - 1)];
+
+        // The record is not written yet
+        if (rec.seq.load(memory_order_acquire) != this->read_idx + 1)
+        {
+            break;
+        }
+
+        this->Print(rec);
+
+        // Release the slot for the next lap of the producers
+        rec.seq.store(this->read_idx + LOGGER_RING_SIZE, memory_order_release);
+
+        this->read_idx++;
+        n++;
+    }
+
+    if (n > 0)
+    {
+        fflush(this->out);
+    }
+
+    return n;
+}
+
+void Logger::Write(const LogFormat *fmt, const uint32_t *args, uint8_t nargs)
+{
+    uint64_t pos = this->write_idx.load(memory_order_relaxed);
+    LogRecord *rec;
+
+    while(1)
+    {
+        rec = &this->ring[pos & (LOGGER_RING_SIZE - 1)];
+
+        int64_t diff = (int64_t)rec->seq.load(memory_order_acquire) - (int64_t)pos;
+
+        if (diff == 0)
+        {
+            if (this->write_idx.compare_exchange_weak(pos, pos + 1, memory_order_relaxed))
+            {
+                break;
+            }
+        }
+        else if (diff < 0)
+        {
+            // Full ring: never block the caller
+            this->dropped.fetch_add(1, memory_order_relaxed);
+
+            return;
+        }
+        else
+        {
+            pos = this->write_idx.load(memory_order_relaxed);
+        }
+    }
+
+    rec->timestamp  = Logger::Now();
+    rec->fmt        = fmt;
+    rec->nargs      = (nargs > LOGGER_MAX_ARGS)? LOGGER_MAX_ARGS : nargs;
+
+    for(uint8_t i=0; i<rec->nargs; i++)
+    {
+        rec->args[i] = args[i];
+    }
+
+    rec->seq.store(pos + 1, memory_order_release);
+}
+
+void Logger::WriteText(uint8_t level, const char *module, const char *text)
+{
+    if (level < LOGGER_MIN_LEVEL)
+    {
+        return;
+    }
+
+    uint64_t timestamp = Logger::Now();
+
+    lock_guard<mutex> lock(this->consume_mutex);
+
+    // The records written before this line go first
+    this->ConsumeLocked();
+
+    this->PrintLine(timestamp, level, module, text);
+
+    fflush(this->out);
+}
+
+unsigned long Logger::GetDropped()
+{
+    return this->dropped.load();
+}
+
+void Logger::Drainer()
+{
+    while(1)
+    {
+        bool run = this->running.load();
+
+        if (this->Consume() == 0)
+        {
+            if (!run)
+            {
+                break;
+            }
+
+            this_thread::sleep_for(chrono::milliseconds(LOGGER_DRAIN_INTERVAL_MS));
+        }
+    }
+}
+
+void Logger::Print(const LogRecord &rec)
+{
+    uint32_t a[LOGGER_MAX_ARGS] = {0};
+    for(uint8_t i=0; i<rec.nargs; i++)
+    {
+        a[i] = rec.args[i];
+    }
+
+    char msg[LOGGER_LINE_MAX_LEN];
+    snprintf(msg, sizeof(msg), rec.fmt->text, a[0], a[1], a[2], a[3], a[4], a[5]);
+
+    this->PrintLine(rec.timestamp, rec.fmt->level, rec.fmt->module, msg);
+}
+
+void Logger::PrintLine(uint64_t timestamp, uint8_t level, const char *module, const char *msg)
+{
+    static const char *levels[] = {"DEBUG", "INFO", "WARNING", "ERROR"};
+
+    fprintf(this->out, "[ %llu.%06llu ] %s (%s): %s\n", (unsigned long long)(timestamp/1000000000ULL),
+            (unsigned long long)((timestamp % 1000000000ULL)/1000), module,
+            (level < LOGGER_LEVEL_NONE)? levels[level] : "?", msg);
+}
+
+uint64_t Logger::Now()
+{
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+
+    return (uint64_t)now.tv_sec*1000000000ULL + now.tv_nsec;
+}
+
+//! \} End of logger group
@@ -0,0 +1,278 @@
+/*
+ * logger.h
+ * 
+ * Copyright (C) 2018, Gabriel Mariano Marcelino <gabriel.mm8@gmail.com>
+ * 
+ * This file is part of MT9D111-Driver.
+ * 
+ * MT9D111-Driver is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ * 
+ * MT9D111-Driver is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ * 
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with MT9D111-Driver. If not, see <http://www.gnu.org/licenses/>.
+ * 
+ */
+
+/**
+ * \brief Binary ring buffer logger.
+ * 
+ * The log sites store a pointer to a static format descriptor and the raw arguments (up to LOGGER_MAX_ARGS 32-bit
+ * integers) in a lock-free ring buffer. The text is only formatted later by a background thread.
+ * 
+ * \author Gabriel Mariano Marcelino <gabriel.mm8@gmail.com>
+ * 
+ * \version 1.0-dev
+ * 
+ * \date 17/10/2026
+ * 
+ * \defgroup logger Logger
+ * \{
+ */
+
+#ifndef LOGGER_H_
+#define LOGGER_H_
+
+#include <stdint.h>
+#include <stdio.h>
+#include <atomic>
+#include <thread>
+#include <mutex>
+
+// Log levels
+#define LOGGER_LEVEL_DEBUG          0
+#define LOGGER_LEVEL_INFO           1
+#define LOGGER_LEVEL_WARNING        2
+#define LOGGER_LEVEL_ERROR          3
+#define LOGGER_LEVEL_NONE           4
+
+// Log sites below this level are removed at compile time
+#ifndef LOGGER_MIN_LEVEL
+#define LOGGER_MIN_LEVEL            LOGGER_LEVEL_INFO
+#endif // LOGGER_MIN_LEVEL
+
+#define LOGGER_RING_SIZE            4096    // Number of records (must be a power of 2)
+#define LOGGER_MAX_ARGS             6       // Max. number of arguments per record
+#define LOGGER_LINE_MAX_LEN         256     // Max. length of a formatted message
+#define LOGGER_DRAIN_INTERVAL_MS    10      // Period of the background thread when the ring is empty
+
+/**
+ * \brief Static description of a log site.
+ */
+struct LogFormat
+{
+    uint8_t     level;      /**< Log level (LOGGER_LEVEL_*). */
+    const char  *module;    /**< Name of the device or module. */
+    const char  *text;      /**< printf-like format of the message (only integer conversions, ex.: %u, %X). */
+};
+
+/**
+ * \brief Record of the ring buffer.
+ */
+struct LogRecord
+{
+    std::atomic<uint64_t>   seq;                        /**< Sequence number (slot state). */
+    uint64_t                timestamp;                  /**< CLOCK_MONOTONIC time in nanoseconds. */
+    const LogFormat         *fmt;                       /**< Log site. */
+    uint8_t                 nargs;                      /**< Number of arguments. */
+    uint32_t                args[LOGGER_MAX_ARGS];      /**< Raw arguments. */
+};
+
+/**
+ * \brief Binary ring buffer logger (single instance).
+ *
+ * Any thread can write records without locks or allocations. When the ring is full, the new records are dropped
+ * (and counted) instead of blocking the caller.
+ *
+ * The logger is the only output of the driver messages: the text lines of the Debug class are written to the same
+ * output (see "WriteText"), after the pending records, so all the messages keep their order and format.
+ *
+ * The background thread must be started explicitly (see "Start"). Until then, the records are only written by
+ * "Drain", "WriteText" or when the program exits.
+ */
+class Logger
+{
+    private:
+        LogRecord ring[LOGGER_RING_SIZE];   /**< Records. */
+        std::atomic<uint64_t> write_idx;    /**< Next record to write (producers). */
+        uint64_t read_idx;                  /**< Next record to read (drain). */
+        std::atomic<unsigned long> dropped; /**< Number of dropped records. */
+        std::atomic<bool> running;          /**< The background thread is running. */
+        std::thread drainer;                /**< Background thread. */
+        std::mutex consume_mutex;           /**< Lock of the drain side (background thread and text lines). */
+        FILE *out;                          /**< Output of the formatted messages. */
+
+        /**
+         * \brief Constructor.
+         *
+         * \return None.
+         */
+        Logger();
+
+        /**
+         * \brief Destructor (stops the background thread and drains the pending records).
+         *
+         * \return None.
+         */
+        ~Logger();
+
+        /**
+         * \brief Background thread main loop.
+         *
+         * \return None.
+         */
+        void Drainer();
+
+        /**
+         * \brief Formats and writes all the complete records (takes the drain lock).
+         *
+         * \return The number of written records.
+         */
+        unsigned int Consume();
+
+        /**
+         * \brief Formats and writes all the complete records (the drain lock must be held).
+         *
+         * \return The number of written records.
+         */
+        unsigned int ConsumeLocked();
+
+        /**
+         * \brief Formats and writes a record.
+         *
+         * \param[in] rec is the record to write.
+         *
+         * \return None.
+         */
+        void Print(const LogRecord &rec);
+
+        /**
+         * \brief Writes a formatted line.
+         *
+         * \param[in] timestamp is the CLOCK_MONOTONIC time in nanoseconds.
+         * \param[in] level is the log level (LOGGER_LEVEL_*).
+         * \param[in] module is the name of the device or module.
+         * \param[in] msg is the message.
+         *
+         * \return None.
+         */
+        void PrintLine(uint64_t timestamp, uint8_t level, const char *module, const char *msg);
+
+        /**
+         * \brief Gets the current CLOCK_MONOTONIC time.
+         *
+         * \return The time in nanoseconds.
+         */
+        static uint64_t Now();
+
+    public:
+        /**
+         * \brief Gets the logger instance.
+         *
+         * \return The logger.
+         */
+        static Logger& Instance();
+
+        /**
+         * \brief Starts the background thread (nothing is done if it is already running).
+         *
+         * \param[in] o is the output of the formatted messages.
+         *
+         * \return TRUE/FALSE if the thread is running or not.
+         */
+        bool Start(FILE *o=stdout);
+
+        /**
+         * \brief Stops the background thread after writing the pending records.
+         *
+         * \return None.
+         */
+        void Stop();
+
+        /**
+         * \brief Formats and writes the pending records (can be called while the background thread is running).
+         *
+         * \return The number of written records.
+         */
+        unsigned int Drain();
+
+        /**
+         * \brief Writes a record.
+         *
+         * \param[in] fmt is the log site.
+         * \param[in] args is the array of arguments.
+         * \param[in] nargs is the number of arguments.
+         *
+         * \return None.
+         */
+        void Write(const LogFormat *fmt, const uint32_t *args, uint8_t nargs);
+
+        /**
+         * \brief Writes a text line (slow path, used by the Debug class).
+         *
+         * The pending records are written first, then the line is written with the same format.
+         *
+         * \param[in] level is the log level (LOGGER_LEVEL_*).
+         * \param[in] module is the name of the device or module.
+         * \param[in] text is the line to write.
+         *
+         * \return None.
+         */
+        void WriteText(uint8_t level, const char *module, const char *text);
+
+        /**
+         * \brief Gets the number of records dropped because the ring was full.
+         *
+         * \return The number of dropped records.
+         */
+        unsigned long GetDropped();
+};
+
+/**
+ * \brief Writes a record with any number (up to LOGGER_MAX_ARGS) of integer arguments.
+ *
+ * \param[in] fmt is the log site.
+ * \param[in] args are the arguments.
+ *
+ * \return None.
+ */
+template<typename... Args>
+inline void LoggerWrite(const LogFormat *fmt, Args... args)
+{
+    static_assert(sizeof...(Args) <= LOGGER_MAX_ARGS, "Too many log arguments!");
+
+    const uint32_t a[sizeof...(Args) + 1] = {static_cast<uint32_t>(args)..., 0};
+
+    Logger::Instance().Write(fmt, a, sizeof...(Args));
+}
+
+/**
+ * \brief Log sites.
+ *
+ * The level check is a constant expression, so the sites below LOGGER_MIN_LEVEL (and their arguments) are removed by
+ * the compiler.
+ */
+#define LOG_EVENT(level, module, text, ...)                                         \
+    do                                                                              \
+    {                                                                               \
+        if ((level) >= LOGGER_MIN_LEVEL)                                            \
+        {                                                                           \
+            static const LogFormat log_fmt_ = {(level), (module), (text)};          \
+            LoggerWrite(&log_fmt_, ##__VA_ARGS__);                                  \
+        }                                                                           \
+    } while(0)
+
+#define LOG_DEBUG(module, text, ...)        LOG_EVENT(LOGGER_LEVEL_DEBUG, module, text, ##__VA_ARGS__)
+#define LOG_INFO(module, text, ...)         LOG_EVENT(LOGGER_LEVEL_INFO, module, text, ##__VA_ARGS__)
+#define LOG_WARNING(module, text, ...)      LOG_EVENT(LOGGER_LEVEL_WARNING, module, text, ##__VA_ARGS__)
+#define LOG_ERROR(module, text, ...)        LOG_EVENT(LOGGER_LEVEL_ERROR, module, text, ##__VA_ARGS__)
+
+#endif // LOGGER_H_
+
+//! \} End of logger group
@@ -34,44 +34,89 @@
  */
 
 #include <unistd.h>
+#include <string.h>
+#include <time.h>
 #include <string>
 
 #include "mt9d111.h"
 #include "mt9d111_pins.h"
 #include "mt9d111_reg.h"
+#include "mt9d111_reg_desc.h"
 #include "mt9d111_config.h"
 #include "mt9d111_driver.h"
+#include "logger.h"
 
 using namespace std;
 
 MT9D111::MT9D111()
 {
-    this->is_open = false;
+    this->Init();
 
-    this->debug = new Debug("MT9D111");
+    DEBUG_EVENT(this->debug, "Object created!");
+    DEBUG_NEWLINE(this->debug);
+}
+
+MT9D111::MT9D111(const char *dev_adr, uint8_t i2c_adr)
+{
+    this->Init();
+
+    DEBUG_EVENT(this->debug, "Initializing...");
+    DEBUG_NEWLINE(this->debug);
+
+    this->Open(dev_adr, i2c_adr);
+}
 
-    this->debug->WriteEvent("Object created!");
-    this->debug->NewLine();
+MT9D111::MT9D111(Transport *bus, Pin *rst, Pin *stby)
+{
+    this->Init();
+
+    DEBUG_EVENT(this->debug, "Initializing...");
+    DEBUG_NEWLINE(this->debug);
+
+    this->Open(bus, rst, stby);
 }
 
-MT9D111::MT9D111(const char *dev_adr)
+void MT9D111::Init()
 {
     this->debug = new Debug("MT9D111");
 
-    this->debug->WriteEvent("Initializing...");
-    this->debug->NewLine();
+    this->is_open = false;
+
+    this->InvalidateRegCache();
+
+    this->page_switches_saved = 0;
+
+    this->frame_period_us = MT9D111_DEFAULT_FRAME_PERIOD_US;
+    this->pixel_clock_hz = MT9D111_DEFAULT_PIXEL_CLOCK_HZ;
+    this->standby_mode = MT9D111_MODE_PREVIEW;
+
+    this->gpio_backend = MT9D111_GPIO_BACKEND;
 
-    this->Open(dev_adr);
+    this->verify_policy = MT9D111_DEFAULT_VERIFY_POLICY;
+    this->verify_count = 0;
+
+    this->i2c = NULL;
+    this->reset = NULL;
+    this->standby = NULL;
+    this->owns_io = false;
+    this->frame_valid = NULL;
 }
 
 MT9D111::~MT9D111()
 {
-    this->debug->WriteEvent("Destroying object...");
-    this->debug->NewLine();
+    DEBUG_EVENT(this->debug, "Destroying object...");
+    DEBUG_NEWLINE(this->debug);
 
-    if (this->is_open)
+    if (this->owns_io)
     {
         delete this->i2c;
+        delete this->reset;
+        delete this->standby;
+    }
+
+    if (this->frame_valid != NULL)
+    {
+        delete this->frame_valid;
     }
 
     this->is_open = false;
@@ -79,20 +124,27 @@ MT9D111::~MT9D111()
     delete debug;
 }
 
-bool MT9D111::Open(const char *dev_adr)
+bool MT9D111::Open(const char *dev_adr, uint8_t i2c_adr)
 {
-    this->debug->WriteEvent(string("Opening device \"") + string(dev_adr) + string("\"..."));
+    DEBUG_EVENT(this->debug, string("Opening device \"") + string(dev_adr) + string("\" (address "));
+    DEBUG_HEX(this->debug, i2c_adr);
+    DEBUG_MSG(this->debug, ")...");
 
-    this->i2c     = new I2C;
-    this->reset   = new GPIO;
-    this->standby = new GPIO;
+    I2CTransport *bus = new I2CTransport;
+    GPIOPin *rst = new GPIOPin;
+    GPIOPin *stby = new GPIOPin;
 
-    if (i2c->Setup(dev_adr, MT9D111_CONFIG_I2C_ID) and
-       reset->Open(MT9D111_GPIO_RESET, GPIO_DIR_OUTPUT) and
-       standby->Open(MT9D111_GPIO_STANDBY, GPIO_DIR_OUTPUT))
+    if (bus->Open(dev_adr, i2c_adr) and
+       rst->Open(MT9D111_GPIO_RESET, GPIO_DIR_OUTPUT, this->gpio_backend, MT9D111_GPIO_CHIP) and
+       stby->Open(MT9D111_GPIO_STANDBY, GPIO_DIR_OUTPUT, this->gpio_backend, MT9D111_GPIO_CHIP))
     {
-        this->debug->WriteMsg("SUCCESS!");
-        this->debug->NewLine();
+        DEBUG_MSG(this->debug, "SUCCESS!");
+        DEBUG_NEWLINE(this->debug);
+
+        this->i2c       = bus;
+        this->reset     = rst;
+        this->standby   = stby;
+        this->owns_io   = true;
 
         if (this->HardReset())
         {
@@ -107,8 +159,13 @@ bool MT9D111::Open(const char *dev_adr)
     }
     else
     {
-        this->debug->WriteMsg("FAILURE!");
-        this->debug->NewLine();
+        DEBUG_NEWLINE(this->debug);
+
+        LOG_ERROR("MT9D111", "Error opening the device!");
+
+        delete bus;
+        delete rst;
+        delete stby;
 
         this->is_open = false;
 
@@ -116,17 +173,110 @@ bool MT9D111::Open(const char *dev_adr)
     }
 }
 
+bool MT9D111::Open(Transport *bus, Pin *rst, Pin *stby)
+{
+    DEBUG_EVENT(this->debug, "Opening device (address ");
+    DEBUG_HEX(this->debug, bus->GetSlaveID());
+    DEBUG_MSG(this->debug, ")...");
+    DEBUG_NEWLINE(this->debug);
+
+    this->i2c       = bus;
+    this->reset     = rst;
+    this->standby   = stby;
+    this->owns_io   = false;
+
+    this->is_open = this->HardReset();
+
+    return this->is_open;
+}
+
+void MT9D111::SetGPIOBackend(uint8_t backend)
+{
+    this->gpio_backend = backend;
+}
+
+bool MT9D111::OpenFrameValid(uint8_t pin)
+{
+    DEBUG_EVENT(this->debug, "Opening FRAME_VALID pin...");
+
+    if (this->frame_valid != NULL)
+    {
+        delete this->frame_valid;
+    }
+
+    GPIOPin *fv = new GPIOPin;
+
+    this->frame_valid = fv;
+
+    if (fv->Open(pin, GPIO_DIR_INPUT, this->gpio_backend, MT9D111_GPIO_CHIP) and
+        fv->GetGPIO()->SetEdge(GPIO_EDGE_FALLING))
+    {
+        DEBUG_MSG(this->debug, "SUCCESS!");
+        DEBUG_NEWLINE(this->debug);
+
+        return true;
+    }
+    else
+    {
+        DEBUG_NEWLINE(this->debug);
+
+        LOG_ERROR("MT9D111", "Error opening the FRAME_VALID pin %u!", pin);
+
+        delete this->frame_valid;
+        this->frame_valid = NULL;
+
+        return false;
+    }
+}
+
+bool MT9D111::WaitVerticalBlanking(int timeout_ms, uint64_t *timestamp)
+{
+    if (this->frame_valid == NULL)
+    {
+        return false;
+    }
+
+    GPIOEvent event;
+    if (!this->frame_valid->WaitEdge(GPIO_EDGE_FALLING, timeout_ms, &event))
+    {
+        return false;
+    }
+
+    if (timestamp != NULL)
+    {
+        *timestamp = event.timestamp;
+    }
+
+    return true;
+}
+
 bool MT9D111::Close()
 {
-    this->debug->WriteEvent("Closing device...");
-    this->debug->NewLine();
+    DEBUG_EVENT(this->debug, "Closing device...");
+    DEBUG_NEWLINE(this->debug);
+
+    if (this->owns_io)
+    {
+        delete this->i2c;
+        delete this->reset;
+        delete this->standby;
+    }
 
-    delete this->i2c;
-    delete this->reset;
-    delete this->standby;
+    this->i2c = NULL;
+    this->reset = NULL;
+    this->standby = NULL;
+    this->owns_io = false;
+
+    if (this->frame_valid != NULL)
+    {
+        delete this->frame_valid;
+        this->frame_valid = NULL;
+    }
 
     this->is_open = false;
 
+    this->InvalidateRegCache();
+
     return true;
 }
 
@@ -160,7 +310,7 @@ bool MT9D111::WriteRegBit(uint8_t adr, uint8_t bit, bool state)
     }
     else
     {
-        reg_val &= (1 << bit);
+        reg_val &= ~(1 << bit);
     }
 
     return this->WriteReg(adr, reg_val);
@@ -168,48 +318,49 @@ bool MT9D111::WriteRegBit(uint8_t adr, uint8_t bit, bool state)
 
 bool MT9D111::HardReset()
 {
-    this->debug->WriteEvent("Executing hard reset...");
-    this->debug->NewLine();
+    DEBUG_EVENT(this->debug, "Executing hard reset...");
+    DEBUG_NEWLINE(this->debug);
 
     if (!this->standby->Set(false))
     {
-        this->debug->WriteEvent("Error during hard reset!");
-        this->debug->NewLine();
+        LOG_ERROR("MT9D111", "Error during hard reset!");
 
         return false;
     }
 
     if (!this->reset->Set(false))
     {
-        this->debug->WriteEvent("Error during hard reset!");
-        this->debug->NewLine();
+        LOG_ERROR("MT9D111", "Error during hard reset!");
 
         return false;
     }
 
     usleep(100);    // 100 us
 
+    // All registers go to their default values
+    this->InvalidateRegCache();
+
     if (!this->reset->Set(true))
     {
-        this->debug->WriteEvent("Error during hard reset!");
-        this->debug->NewLine();
+        LOG_ERROR("MT9D111", "Error during hard reset!");
 
         return false;
     }
 
+    this->LoadRegCache(reg_default_vals, sizeof(reg_default_vals)/sizeof(Register));
+
     return true;
 }
 
 bool MT9D111::SoftReset()
 {
-    this->debug->WriteEvent("Executing soft reset...");
-    this->debug->NewLine();
+    DEBUG_EVENT(this->debug, "Executing soft reset...");
+    DEBUG_NEWLINE(this->debug);
 
     // Bypass the PLL
-    if (!this->WriteAndCheckReg(MT9D111_REG_CLOCK_CONTROL, 0xA000))
+    if (!this->WriteAndVerifyReg(MT9D111_REG_CLOCK_CONTROL, 0xA000, this->verify_policy))
     {
-        this->debug->WriteEvent("Error during soft reset!");
-        this->debug->NewLine();
+        LOG_ERROR("MT9D111", "Error during soft reset!");
 
         return false;
     }
@@ -217,8 +368,7 @@ bool MT9D111::SoftReset()
     // Perform MCU reset
     if (!this->WriteReg(MT9D111_REG_ASSERT_STROBE_T3, 0x0501))
     {
-        this->debug->WriteEvent("Error during soft reset!");
-        this->debug->NewLine();
+        LOG_ERROR("MT9D111", "Error during soft reset!");
 
         return false;
     }
@@ -226,21 +376,24 @@ bool MT9D111::SoftReset()
     // Enable soft reset
     if (!this->WriteReg(MT9D111_REG_RESET, 0x0021))
     {
-        this->debug->WriteEvent("Error during soft reset!");
-        this->debug->NewLine();
+        LOG_ERROR("MT9D111", "Error during soft reset!");
 
         return false;
     }
 
+    // All registers go to their default values
+    this->InvalidateRegCache();
+
     // Disable soft reset
     if (!this->WriteReg(MT9D111_REG_RESET, 0x0000))
     {
-        this->debug->WriteEvent("Error during soft reset!");
-        this->debug->NewLine();
+        LOG_ERROR("MT9D111", "Error during soft reset!");
 
         return false;
     }
 
+    this->LoadRegCache(reg_default_vals, sizeof(reg_default_vals)/sizeof(Register));
+
     return true;
 }
 
@@ -248,19 +401,21 @@ bool MT9D111::HardStandby(bool s)
 {
     if (s)
     {
-        this->debug->WriteEvent("Enabling hard standby...");
+        DEBUG_EVENT(this->debug, "Enabling hard standby...");
     }
     else
     {
-        this->debug->WriteEvent("Disabling hard standby...");
+        DEBUG_EVENT(this->debug, "Disabling hard standby...");
     }
 
-    this->debug->NewLine();
+    DEBUG_NEWLINE(this->debug);
+
+    // The page register is not guaranteed to be kept across standby transitions
+    this->active_page = MT9D111_REG_PAGE_UNKNOWN;
 
     if (!this->standby->Set(s))
     {
-        this->debug->WriteEvent("Error during hard standby!");
-        this->debug->NewLine();
+        LOG_ERROR("MT9D111", "Error during hard standby!");
 
         return false;
     }
@@ -272,299 +427,1640 @@ bool MT9D111::SoftStandby(bool s)
 {
     if (s)
     {
-        this->debug->WriteEvent("Enabling soft standby...");
+        DEBUG_EVENT(this->debug, "Enabling soft standby...");
     }
     else
     {
-        this->debug->WriteEvent("Disabling soft standby...");
+        DEBUG_EVENT(this->debug, "Disabling soft standby...");
     }
 
-    this->debug->NewLine();
+    DEBUG_NEWLINE(this->debug);
 
     // Changing the STANDBY bit state
     if (!this->WriteRegBit(MT9D111_REG_RESET, 2, s))
     {
-        this->debug->WriteEvent("Error during soft standby!");
-        this->debug->NewLine();
+        LOG_ERROR("MT9D111", "Error during soft standby!");
 
         return false;
     }
 
+    this->active_page = MT9D111_REG_PAGE_UNKNOWN;
+
     return true;
 }
 
 bool MT9D111::EnablePLL(uint16_t val_1, uint16_t val_2)
 {
-    this->debug->WriteEvent("Enabling PLL with ");
-    this->debug->WriteHex(val_1);
-    this->debug->WriteMsg(" and ");
-    this->debug->WriteHex(val_2);
-    this->debug->WriteMsg("...");
-    this->debug->NewLine();
+    DEBUG_EVENT(this->debug, "Enabling PLL with ");
+    DEBUG_HEX(this->debug, val_1);
+    DEBUG_MSG(this->debug, " and ");
+    DEBUG_HEX(this->debug, val_2);
+    DEBUG_MSG(this->debug, "...");
+    DEBUG_NEWLINE(this->debug);
 
     this->SetRegisterPage(MT9D111_REG_PAGE_0);
 
     // Program PLL frequency settings
-    if (!this->WriteAndCheckReg(MT9D111_REG_PLL_CONTROL_1, val_1))
+    if (!this->WriteAndVerifyReg(MT9D111_REG_PLL_CONTROL_1, val_1, this->verify_policy))
+    {
+        LOG_ERROR("MT9D111", "Error enabling the PLL!");
+
+        return false;
+    }
+
+    if (!this->WriteAndVerifyReg(MT9D111_REG_PLL_CONTROL_2, val_2, this->verify_policy))
+    {
+        LOG_ERROR("MT9D111", "Error enabling the PLL!");
+
+        return false;
+    }
+
+    // Power up PLL
+    if (!this->WriteRegBit(MT9D111_REG_CLOCK_CONTROL, 14, false))
+    {
+        LOG_ERROR("MT9D111", "Error enabling the PLL!");
+
+        return false;
+    }
+
+    // Wait for PLL settling time (> 150 us)
+    usleep(500);
+
+    // Turn off PLL bypass
+    if (!this->WriteRegBit(MT9D111_REG_CLOCK_CONTROL, 15, false))
+    {
+        LOG_ERROR("MT9D111", "Error enabling the PLL!");
+
+        return false;
+    }
+
+    return true;
+}
+
+bool MT9D111::SetRegisterPage(uint16_t page)
+{
+    if (page == this->active_page)
+    {
+        this->page_switches_saved++;
+
+        return true;
+    }
+
+    if (this->WriteAndVerifyReg(MT9D111_REG_PAGE_REGISTER, page, this->verify_policy))
+    {
+        return true;
+    }
+    else
+    {
+        LOG_ERROR("MT9D111", "Error configuring register page to %u!", page);
+
+        return false;
+    }
+}
+
+bool MT9D111::GetRegisterPage(uint16_t *page)
+{
+    return this->ReadReg(MT9D111_REG_PAGE_REGISTER, page);
+}
+
+void MT9D111::InvalidateRegCache()
+{
+    for(unsigned int i=0; i<MT9D111_REG_PAGES; i++)
+    {
+        for(unsigned int j=0; j<MT9D111_REG_PAGE_SIZE; j++)
+        {
+            this->reg_cache_valid[i][j] = false;
+        }
+    }
+
+    this->active_page = MT9D111_REG_PAGE_UNKNOWN;
+}
+
+void MT9D111::LoadRegCache(const Register *regs, unsigned int len)
+{
+    for(unsigned int i=0; i<len; i++)
+    {
+        if ((regs[i].page >= MT9D111_REG_PAGES) or (regs[i].address == MT9D111_REG_PAGE_REGISTER) or
+            this->IsVolatileReg(regs[i].page, regs[i].address))
+        {
+            continue;
+        }
+
+        this->reg_cache[regs[i].page][regs[i].address]         = regs[i].value;
+        this->reg_cache_valid[regs[i].page][regs[i].address]   = true;
+    }
+}
+
+void MT9D111::UpdateRegCache(uint8_t adr, uint16_t val)
+{
+    // The page register is the same in all pages
+    if (adr == MT9D111_REG_PAGE_REGISTER)
+    {
+        this->active_page = (val < MT9D111_REG_PAGES)? val : MT9D111_REG_PAGE_UNKNOWN;
+
+        return;
+    }
+
+    uint8_t page;
+    if (!this->GetCachedPage(&page) or this->IsVolatileReg(page, adr))
     {
-        this->debug->WriteEvent("Error enabling the PLL!");
-        this->debug->NewLine();
+        return;
+    }
 
+    this->reg_cache[page][adr]          = val;
+    this->reg_cache_valid[page][adr]    = true;
+}
+
+bool MT9D111::GetCachedPage(uint8_t *page)
+{
+    if (this->active_page == MT9D111_REG_PAGE_UNKNOWN)
+    {
         return false;
     }
 
-    if (!this->WriteAndCheckReg(MT9D111_REG_PLL_CONTROL_2, val_2))
+    *page = this->active_page;
+
+    return true;
+}
+
+bool MT9D111::IsVolatileReg(uint8_t page, uint8_t adr)
+{
+    // Read-only, self-clearing and sensor/firmware updated registers (see mt9d111_reg_desc.h)
+    return !RegIsCacheable(page, adr);
+}
+
+bool MT9D111::Reset(uint8_t type)
+{
+    switch(type)
+    {
+        case MT9D111_RESET_HARD:
+            return this->HardReset();
+        case MT9D111_RESET_SOFT:
+            return this->SoftReset();
+        default:
+            return this->HardReset();
+    }
+}
+
+bool MT9D111::Config()
+{
+    DEBUG_EVENT(this->debug, "Loading configuration parameters from \"Register Wizard\"...");
+    DEBUG_NEWLINE(this->debug);
+
+    unsigned int len = sizeof(reg_default_vals)/sizeof(Register);
+
+    // Write all the registers at once and verify them later
+    bool batch = this->WriteRegs(reg_default_vals, len);
+
+    bool *mismatch = NULL;
+    if (!batch)
+    {
+        LOG_WARNING("MT9D111", "Error writing the configuration registers in a batch! Writing them one by one");
+
+        // The state of the device is unknown, so every register is written again
+        mismatch = new bool[len];
+
+        for(unsigned int i=0; i<len; i++)
+        {
+            mismatch[i] = true;
+        }
+    }
+    else if (this->verify_policy == MT9D111_VERIFY_DEFERRED)
+    {
+        mismatch = new bool[len];
+
+        unsigned int mismatches = 0;
+        if (!this->VerifyRegs(reg_default_vals, len, mismatch, &mismatches))
+        {
+            delete[] mismatch;
+
+            LOG_ERROR("MT9D111", "Error loading configuration parameters!");
+
+            return false;
+        }
+
+        if (mismatches > 0)
+        {
+            LOG_WARNING("MT9D111", "%u of %u configuration registers were not written! Trying again", mismatches, len);
+        }
+    }
+
+    bool res = true;
+
+    for(unsigned int i=0; i<len; i++)
+    {
+        if (reg_default_vals[i].address == MT9D111_REG_PAGE_REGISTER)
+        {
+            continue;
+        }
+
+        if (mismatch != NULL)
+        {
+            if (!mismatch[i])
+            {
+                continue;
+            }
+        }
+        else if (!this->NeedsVerify(reg_default_vals[i].page, reg_default_vals[i].address, this->verify_policy))
+        {
+            continue;
+        }
+
+        if (!this->SetRegisterPage(reg_default_vals[i].page))
+        {
+            res = false;
+
+            break;
+        }
+
+        if ((mismatch == NULL) and this->CheckReg(reg_default_vals[i].address, reg_default_vals[i].value))
+        {
+            continue;
+        }
+
+        // After a failed batch, the volatile and self-clearing registers are written again without reading them back
+        if (!batch and !this->NeedsVerify(reg_default_vals[i].page, reg_default_vals[i].address, this->verify_policy))
+        {
+            if (!this->WriteReg(reg_default_vals[i].address, reg_default_vals[i].value))
+            {
+                res = false;
+
+                break;
+            }
+
+            continue;
+        }
+
+        if (!this->WriteAndCheckReg(reg_default_vals[i].address, reg_default_vals[i].value))
+        {
+            res = false;
+
+            break;
+        }
+    }
+
+    delete[] mismatch;
+
+    if (!res)
+    {
+        LOG_ERROR("MT9D111", "Error loading configuration parameters!");
+    }
+
+    return res;
+}
+
+bool MT9D111::EnterStandby(uint8_t type)
+{
+    // Remember the current mode to restore it when leaving the standby mode
+    uint8_t mode;
+    if (this->GetMode(&mode) and (mode == MT9D111_MODE_CAPTURE))
+    {
+        this->standby_mode = MT9D111_MODE_CAPTURE;
+    }
+    else
+    {
+        this->standby_mode = MT9D111_MODE_PREVIEW;
+    }
+
+    // Standby must be entered through the firmware before stopping the sensor
+    bool res = this->SequencerCmd(MT9D111_DRIVER_VAR_SEQUENCER_CMD_DO_STANDBY) and this->WaitSequencerState(MT9D111_STATE_STANDBY);
+
+    if (!res)
+    {
+        LOG_WARNING("MT9D111", "The firmware did not enter the standby state! Asserting standby anyway...");
+    }
+
+    switch(type)
+    {
+        case MT9D111_STANDBY_SOFT:
+            return this->SoftStandby(true) and res;
+        case MT9D111_STANDBY_HARD:
+        default:
+            return this->HardStandby(true) and res;
+    }
+}
+
+bool MT9D111::LeaveStandby(uint8_t type)
+{
+    bool res;
+
+    switch(type)
+    {
+        case MT9D111_STANDBY_HARD:
+            res = this->HardStandby(false);
+            break;
+        case MT9D111_STANDBY_SOFT:
+            res = this->SoftStandby(false);
+            break;
+        default:
+            res = this->HardStandby(false);
+            break;
+    }
+
+    if (!res)
+    {
+        return false;
+    }
+
+    // Go back to the mode recorded by EnterStandby
+    if (this->standby_mode == MT9D111_MODE_CAPTURE)
+    {
+        if (!this->SequencerCmd(MT9D111_DRIVER_VAR_SEQUENCER_CMD_DO_CAPTURE))
+        {
+            return false;
+        }
+
+        return this->WaitSequencerState(MT9D111_STATE_CAPTURE);
+    }
+
+    if (!this->SequencerCmd(MT9D111_DRIVER_VAR_SEQUENCER_CMD_DO_PREVIEW))
+    {
+        return false;
+    }
+
+    return this->WaitSequencerState(MT9D111_STATE_PREVIEW);
+}
+
+bool MT9D111::ReadReg(uint8_t adr, uint16_t *val)
+{
+    uint8_t page;
+    if (this->GetCachedPage(&page))
+    {
+        if (adr == MT9D111_REG_PAGE_REGISTER)
+        {
+            *val = page;
+
+            return true;
+        }
+
+        if (this->reg_cache_valid[page][adr] and !this->IsVolatileReg(page, adr))
+        {
+            *val = this->reg_cache[page][adr];
+
+            return true;
+        }
+    }
+
+    return this->ReadRegDirect(adr, val);
+}
+
+bool MT9D111::ReadRegDirect(uint8_t adr, uint16_t *val)
+{
+    if (this->is_open)
+    {
+        uint64_t start = I2CStats::Now();
+
+        I2CResult<uint16_t> res = this->i2c->Read16(adr);
+
+        uint16_t reg_val = res.value;
+
+        this->stats.Record(I2C_STATS_OP_READ, this->i2c->GetSlaveID(), this->active_page, adr, reg_val, start,
+                           res.error);
+
+        if (!res.Ok())
+        {
+            LOG_ERROR("MT9D111", "Error reading register 0x%X! (errno=%u)", adr, res.error);
+
+            return false;
+        }
+
+        *val = reg_val;
+
+        this->UpdateRegCache(adr, reg_val);
+
+        return true;
+    }
+    else
+    {
+        return false;
+    }
+}
+
+bool MT9D111::CheckReg(uint8_t adr, uint16_t val)
+{
+    uint16_t reg_val = 0xFFFF;
+
+    if (this->ReadRegDirect(adr, &reg_val))
+    {
+        if (reg_val == val)
+        {
+            return true;
+        }
+        else
+        {
+            LOG_ERROR("MT9D111", "Error checking register 0x%X! (read=0x%X, expected=0x%X)", adr, reg_val, val);
+
+            return false;
+        }
+    }
+    else
+    {
+        return false;
+    }
+}
+
+bool MT9D111::WriteReg(uint8_t adr, uint16_t val)
+{
+    if (this->is_open)
+    {
+        uint64_t start = I2CStats::Now();
+
+        bool res = this->i2c->Write16(adr, val);
+
+        this->stats.Record(I2C_STATS_OP_WRITE, this->i2c->GetSlaveID(), this->active_page, adr, val, start,
+                           this->i2c->GetLastError());
+
+        if (res)
+        {
+            this->UpdateRegCache(adr, val);
+
+            return true;
+        }
+        else
+        {
+            // After a bus error the state of the device is uncertain
+            this->active_page = MT9D111_REG_PAGE_UNKNOWN;
+
+            return false;
+        }
+    }
+    else
+    {
+        return false;
+    }
+}
+
+bool MT9D111::WriteAndCheckReg(uint8_t adr, uint16_t val, unsigned int attempts)
+{
+    if (!this->is_open)
+    {
+        return false;
+    }
+
+    unsigned int backoff_us = MT9D111_RETRY_BACKOFF_MIN_US;
+
+    for(unsigned int i=0; i<attempts; i++)
+    {
+        if (i > 0)
+        {
+            this->stats.CountRetry(this->active_page, adr);
+        }
+
+        if (!this->WriteReg(adr, val))
+        {
+            if (!this->BackoffAfterError(&backoff_us))
+            {
+                return false;
+            }
+
+            continue;
+        }
+
+        if (this->CheckReg(adr, val))
+        {
+            return true;
+        }
+
+        // The read back failed (bus error), it is not a mismatch
+        if (this->i2c->GetLastError() != 0)
+        {
+            if (!this->BackoffAfterError(&backoff_us))
+            {
+                return false;
+            }
+
+            continue;
+        }
+
+        LOG_WARNING("MT9D111", "Error writing 0x%X to address 0x%X! Trying again (%u of %u)", val, adr, i+1, attempts);
+    }
+
+    return false;
+}
+
+bool MT9D111::BackoffAfterError(unsigned int *backoff_us)
+{
+    int err = this->i2c->GetLastError();
+
+    if (I2C::ClassifyError(err) != I2C_ERROR_TRANSIENT)
+    {
+        LOG_ERROR("MT9D111", "Fatal bus error! (errno=%u)", err);
+
+        return false;
+    }
+
+    usleep(*backoff_us);
+
+    *backoff_us *= 2;
+
+    if (*backoff_us > MT9D111_RETRY_BACKOFF_MAX_US)
+    {
+        *backoff_us = MT9D111_RETRY_BACKOFF_MAX_US;
+    }
+
+    return true;
+}
+
+bool MT9D111::WriteRegs(const Register *regs, size_t len)
+{
+    if (!this->is_open)
+    {
+        return false;
+    }
+
+    size_t i = 0;
+    while(i < len)
+    {
+        if (regs[i].page == MT9D111_REG_PAGE_DELAY)
+        {
+            usleep(1000*regs[i].value);
+
+            i++;
+
+            continue;
+        }
+
+        // Find the last register of the same page
+        size_t j = i;
+        while((j < len) and (regs[j].page == regs[i].page))
+        {
+            j++;
+        }
+
+        if (!this->SetRegisterPage(regs[i].page))
+        {
+            return false;
+        }
+
+        I2C_Msg *msgs = new I2C_Msg[j - i];
+        uint8_t *buf = new uint8_t[3*(j - i)];
+        unsigned int n = 0;
+
+        for(size_t k=i; k<j; k++)
+        {
+            if (regs[k].address == MT9D111_REG_PAGE_REGISTER)
+            {
+                continue;
+            }
+
+            buf[3*n]        = regs[k].address;
+            buf[3*n + 1]    = (regs[k].value >> 8) & 0xFF;     // MSB first
+            buf[3*n + 2]    = regs[k].value & 0xFF;
+
+            msgs[n].addr    = this->i2c->GetSlaveID();
+            msgs[n].flags   = 0;
+            msgs[n].len     = 3;
+            msgs[n].buf     = &buf[3*n];
+
+            n++;
+        }
+
+        uint64_t start = I2CStats::Now();
+
+        bool res = this->i2c->Transfer(msgs, n);
+
+        this->stats.Record(I2C_STATS_OP_TRANSFER, this->i2c->GetSlaveID(), regs[i].page, regs[i].address, n, start,
+                           this->i2c->GetLastError());
+
+        for(size_t k=i; k<j; k++)
+        {
+            if (regs[k].address != MT9D111_REG_PAGE_REGISTER)
+            {
+                this->stats.Count(regs[k].page, regs[k].address, true, !res);
+            }
+        }
+
+        delete[] msgs;
+        delete[] buf;
+
+        if (!res)
+        {
+            LOG_ERROR("MT9D111", "Error writing a list of registers!");
+
+            // After a bus error the state of the device is uncertain
+            this->InvalidateRegCache();
+
+            return false;
+        }
+
+        for(size_t k=i; k<j; k++)
+        {
+            if (regs[k].address != MT9D111_REG_PAGE_REGISTER)
+            {
+                this->UpdateRegCache(regs[k].address, regs[k].value);
+            }
+        }
+
+        i = j;
+    }
+
+    return true;
+}
+
+bool MT9D111::WriteAndVerifyReg(uint8_t adr, uint16_t val, uint8_t policy)
+{
+    uint8_t page;
+    if (!this->GetCachedPage(&page))
+    {
+        // The register class is unknown without the current page
+        if (policy != MT9D111_VERIFY_NEVER)
+        {
+            return this->WriteAndCheckReg(adr, val);
+        }
+
+        return this->WriteReg(adr, val);
+    }
+
+    if (this->NeedsVerify(page, adr, policy))
+    {
+        return this->WriteAndCheckReg(adr, val);
+    }
+
+    return this->WriteReg(adr, val);
+}
+
+bool MT9D111::NeedsVerify(uint8_t page, uint8_t adr, uint8_t policy)
+{
+    if ((adr != MT9D111_REG_PAGE_REGISTER) and this->IsVolatileReg(page, adr))
+    {
+        return false;
+    }
+
+    switch(policy)
+    {
+        case MT9D111_VERIFY_NEVER:
+            return false;
+        case MT9D111_VERIFY_SAMPLED:
+            return (this->verify_count++ % MT9D111_VERIFY_SAMPLE_PERIOD) == 0;
+        default:
+            return true;
+    }
+}
+
+bool MT9D111::ReadRegsDirect(const Register *regs, size_t len, uint16_t *vals)
+{
+    if (!this->is_open)
+    {
+        return false;
+    }
+
+    size_t i = 0;
+    while(i < len)
+    {
+        if (regs[i].page == MT9D111_REG_PAGE_DELAY)
+        {
+            i++;
+
+            continue;
+        }
+
+        // Find the last register of the same page
+        size_t j = i;
+        while((j < len) and (regs[j].page == regs[i].page))
+        {
+            j++;
+        }
+
+        if (!this->SetRegisterPage(regs[i].page))
+        {
+            return false;
+        }
+
+        // Each register is read with an address write followed by a 2 bytes read (repeated start)
+        I2C_Msg *msgs = new I2C_Msg[2*(j - i)];
+        uint8_t *buf = new uint8_t[3*(j - i)];
+
+        for(size_t k=i; k<j; k++)
+        {
+            size_t n = k - i;
+
+            buf[3*n] = regs[k].address;
+
+            msgs[2*n].addr      = this->i2c->GetSlaveID();
+            msgs[2*n].flags     = 0;
+            msgs[2*n].len       = 1;
+            msgs[2*n].buf       = &buf[3*n];
+
+            msgs[2*n + 1].addr  = this->i2c->GetSlaveID();
+            msgs[2*n + 1].flags = I2C_M_RD;
+            msgs[2*n + 1].len   = 2;
+            msgs[2*n + 1].buf   = &buf[3*n + 1];
+        }
+
+        uint64_t start = I2CStats::Now();
+
+        bool res = this->i2c->Transfer(msgs, 2*(j - i));
+
+        this->stats.Record(I2C_STATS_OP_TRANSFER, this->i2c->GetSlaveID(), regs[i].page, regs[i].address, 2*(j - i),
+                           start, this->i2c->GetLastError());
+
+        for(size_t k=i; k<j; k++)
+        {
+            size_t n = k - i;
+
+            this->stats.Count(regs[k].page, regs[k].address, false, !res);
+
+            if (res)
+            {
+                vals[k] = (buf[3*n + 1] << 8) | buf[3*n + 2];     // MSB first
+
+                this->UpdateRegCache(regs[k].address, vals[k]);
+            }
+        }
+
+        delete[] msgs;
+        delete[] buf;
+
+        if (!res)
+        {
+            LOG_ERROR("MT9D111", "Error reading a list of registers!");
+
+            return false;
+        }
+
+        i = j;
+    }
+
+    return true;
+}
+
+bool MT9D111::VerifyRegs(const Register *regs, size_t len, bool *mismatch, unsigned int *mismatches)
+{
+    if (!this->is_open)
+    {
+        return false;
+    }
+
+    // Only the registers that keep the written value can be verified
+    Register *check = new Register[len];
+    size_t *idx = new size_t[len];
+    uint16_t *vals = new uint16_t[len];
+    size_t n = 0;
+
+    for(size_t i=0; i<len; i++)
+    {
+        if (mismatch != NULL)
+        {
+            mismatch[i] = false;
+        }
+
+        if ((regs[i].page == MT9D111_REG_PAGE_DELAY) or (regs[i].address == MT9D111_REG_PAGE_REGISTER) or
+            this->IsVolatileReg(regs[i].page, regs[i].address))
+        {
+            continue;
+        }
+
+        check[n] = regs[i];
+        idx[n++] = i;
+    }
+
+    bool res = this->ReadRegsDirect(check, n, vals);
+
+    unsigned int n_mismatches = 0;
+
+    for(size_t k=0; res and (k<n); k++)
+    {
+        if (vals[k] != check[k].value)
+        {
+            LOG_ERROR("MT9D111", "Error checking register 0x%X! (read=0x%X, expected=0x%X)", check[k].address, vals[k],
+                      check[k].value);
+
+            if (mismatch != NULL)
+            {
+                mismatch[idx[k]] = true;
+            }
+
+            n_mismatches++;
+        }
+    }
+
+    delete[] check;
+    delete[] idx;
+    delete[] vals;
+
+    if (!res)
+    {
+        return false;
+    }
+
+    if (mismatches != NULL)
+    {
+        *mismatches = n_mismatches;
+    }
+
+    return true;
+}
+
+bool MT9D111::ApplyProfile(const Register *regs, size_t len)
+{
+    if (!this->is_open)
+    {
+        return false;
+    }
+
+    // Expected value of each register after the writes (starts from the shadow registers)
+    uint16_t (*val)[MT9D111_REG_PAGE_SIZE] = new uint16_t[MT9D111_REG_PAGES][MT9D111_REG_PAGE_SIZE];
+    bool (*valid)[MT9D111_REG_PAGE_SIZE] = new bool[MT9D111_REG_PAGES][MT9D111_REG_PAGE_SIZE];
+
+    Register *missing = new Register[len];
+    uint16_t *missing_vals = new uint16_t[len];
+    size_t n_missing = 0;
+
+    for(uint8_t p=0; p<MT9D111_REG_PAGES; p++)
+    {
+        for(unsigned int a=0; a<MT9D111_REG_PAGE_SIZE; a++)
+        {
+            valid[p][a] = false;
+        }
+
+        // Bulk read-back (one transfer per page) of the unknown registers of the table
+        for(size_t i=0; i<len; i++)
+        {
+            if ((regs[i].page != p) or OpIsDropped(regs[i]) or !OpIsDedupable(regs[i]) or
+                !RegIsCacheable(p, regs[i].address) or this->reg_cache_valid[p][regs[i].address] or
+                valid[p][regs[i].address])
+            {
+                continue;
+            }
+
+            valid[p][regs[i].address] = true;   // Read-back requested
+
+            missing[n_missing++] = regs[i];
+        }
+    }
+
+    if ((n_missing > 0) and !this->ReadRegsDirect(missing, n_missing, missing_vals))
+    {
+        LOG_WARNING("MT9D111", "Error reading back the registers of a profile! Writing all of them");
+    }
+
+    for(uint8_t p=0; p<MT9D111_REG_PAGES; p++)
+    {
+        for(unsigned int a=0; a<MT9D111_REG_PAGE_SIZE; a++)
+        {
+            val[p][a]   = this->reg_cache[p][a];
+            valid[p][a] = this->reg_cache_valid[p][a] and RegIsCacheable(p, a);
+        }
+    }
+
+    // Writes of the changed registers, split in segments at delays and barriers
+    Op *ops = new Op[2*len];
+    size_t n_ops = 0;
+    size_t n_writes = 0;
+    uint8_t page = this->active_page;
+    uint16_t var_adr = 0;
+    size_t start = 0;
+
+    for(size_t i=0; i<=len; i++)
+    {
+        bool delay = (i < len) and (regs[i].page == MT9D111_REG_PAGE_DELAY);
+        bool barrier = (i < len) and !delay and OpIsBarrier(regs[i], var_adr);
+
+        if ((i < len) and (regs[i].page == MT9D111_REG_PAGE_1) and
+            (regs[i].address == MT9D111_REG_MICROCONTROLLER_VARIABLE_ADDRESS))
+        {
+            var_adr = regs[i].value;
+        }
+
+        if ((i < len) and !delay and !barrier)
+        {
+            continue;
+        }
+
+        n_writes += OpEmitSegment(ops, n_ops, regs, start, i, page, val, valid);
+
+        if (delay)
+        {
+            ops[n_ops++] = Op MT9D111_OP_WAIT(regs[i].value);
+        }
+        else if (barrier)
+        {
+            // Barriers are always written
+            ops[n_ops++] = Op MT9D111_OP_WR(regs[i].page, regs[i].address, regs[i].value);
+            ops[n_ops++] = Op MT9D111_OP_FENCE;
+
+            page = regs[i].page;
+            n_writes++;
+
+            // Resets, clock changes and sequencer commands may change any register
+            OpForgetValues(valid);
+        }
+
+        start = i + 1;
+    }
+
+    bool res = this->Run(ops, n_ops);
+
+    LOG_DEBUG("MT9D111", "Profile applied with %u of %u registers writes", n_writes, len);
+
+    delete[] val;
+    delete[] valid;
+    delete[] missing;
+    delete[] missing_vals;
+    delete[] ops;
+
+    return res;
+}
+
+void MT9D111::SetVerifyPolicy(uint8_t policy)
+{
+    this->verify_policy = policy;
+}
+
+uint8_t MT9D111::GetVerifyPolicy()
+{
+    return this->verify_policy;
+}
+
+bool MT9D111::Run(const Op *ops, size_t len)
+{
+    // A driver variable write takes two registers writes
+    Register regs[MT9D111_OP_RUN_BATCH_LEN];
+    size_t n = 0;
+    bool res = true;
+
+    for(size_t i=0; (i<len) and res; i++)
+    {
+        // Flush the pending writes if the next operation does not fit in the batch
+        if ((n + 2) > MT9D111_OP_RUN_BATCH_LEN)
+        {
+            res = this->WriteRegs(regs, n);
+            n = 0;
+
+            if (!res)
+            {
+                break;
+            }
+        }
+
+        switch(ops[i].code)
+        {
+            case MT9D111_OP_WRITE:
+                regs[n].address = ops[i].address;
+                regs[n].page    = ops[i].page;
+                regs[n].value   = ops[i].value;
+
+                n++;
+
+                break;
+            case MT9D111_OP_WRITE_VAR:
+                regs[n].address = MT9D111_REG_MICROCONTROLLER_VARIABLE_ADDRESS;
+                regs[n].page    = MT9D111_REG_PAGE_1;
+                regs[n].value   = MT9D111_DRIVER_PHYSICAL_ACCESS_ADDRESS_LOGICAL | (ops[i].page << 8) | ops[i].address;
+
+                if (!(ops[i].flags & MT9D111_OP_FLAG_16_BIT))
+                {
+                    regs[n].value |= MT9D111_DRIVER_VARIABLE_8_BIT_ACCESS;
+                }
+
+                regs[n+1].address   = MT9D111_REG_MICROCONTROLLER_VARIABLE_DATA;
+                regs[n+1].page      = MT9D111_REG_PAGE_1;
+                regs[n+1].value     = ops[i].value;
+
+                n += 2;
+
+                break;
+            case MT9D111_OP_DELAY:
+                res = this->WriteRegs(regs, n);
+                n = 0;
+
+                if (!res)
+                {
+                    break;
+                }
+
+                // A delay followed by a poll is an upper bound: poll right away and add the delay to the timeout
+                if (((i + 1) < len) and ((ops[i+1].code == MT9D111_OP_POLL_EQ) or (ops[i+1].code == MT9D111_OP_POLL_MASK)))
+                {
+                    Op poll = ops[i+1];
+                    unsigned int timeout = ((poll.timeout > 0)? poll.timeout : MT9D111_OP_POLL_DEFAULT_TIMEOUT_MS) + ops[i].value;
+
+                    poll.timeout = (timeout > 0xFFFF)? 0xFFFF : timeout;
+
+                    res = this->Poll(poll);
+
+                    i++;
+                }
+                else
+                {
+                    usleep(1000*ops[i].value);
+                }
+
+                break;
+            case MT9D111_OP_POLL_EQ:
+            case MT9D111_OP_POLL_MASK:
+                res = this->WriteRegs(regs, n);
+                n = 0;
+
+                if (res)
+                {
+                    res = this->Poll(ops[i]);
+                }
+
+                break;
+            case MT9D111_OP_BARRIER:
+                res = this->WriteRegs(regs, n);
+                n = 0;
+
+                break;
+            default:
+                LOG_ERROR("MT9D111", "Unknown operation code! (%u)", ops[i].code);
+
+                res = false;
+        }
+    }
+
+    if (res)
+    {
+        res = this->WriteRegs(regs, n);
+    }
+
+    return res;
+}
+
+bool MT9D111::ReadOpTarget(const Op &op, uint16_t *val)
+{
+    if (op.flags & MT9D111_OP_FLAG_VAR)
+    {
+        uint8_t buf[2] = {0};
+        size_t len = (op.flags & MT9D111_OP_FLAG_16_BIT)? 2 : 1;
+
+        if (!this->ReadDriverVars(op.page << 8, op.address, buf, len))
+        {
+            return false;
+        }
+
+        *val = (len == 2)? ((buf[0] << 8) | buf[1]) : buf[0];
+
+        return true;
+    }
+
+    if (!this->SetRegisterPage(op.page))
+    {
+        return false;
+    }
+
+    return this->ReadRegDirect(op.address, val);
+}
+
+bool MT9D111::Poll(const Op &op, uint32_t *latency_us, unsigned int min_interval_us, unsigned int max_interval_us)
+{
+    uint16_t mask = (op.code == MT9D111_OP_POLL_MASK)? op.mask : 0xFFFF;
+    uint16_t timeout = (op.timeout > 0)? op.timeout : MT9D111_OP_POLL_DEFAULT_TIMEOUT_MS;
+    unsigned int interval = (min_interval_us > 0)? min_interval_us : MT9D111_OP_POLL_MIN_INTERVAL_US;
+
+    struct timespec start, now;
+    clock_gettime(CLOCK_MONOTONIC, &start);
+
+    while(1)
+    {
+        uint16_t val;
+        if (!this->ReadOpTarget(op, &val))
+        {
+            return false;
+        }
+
+        clock_gettime(CLOCK_MONOTONIC, &now);
+
+        unsigned int elapsed = (now.tv_sec - start.tv_sec)*1000000 + (now.tv_nsec - start.tv_nsec)/1000;
+
+        if ((val & mask) == (op.value & mask))
+        {
+            LOG_DEBUG("MT9D111", "Poll condition reached after %u us", elapsed);
+
+            if (latency_us != NULL)
+            {
+                *latency_us = elapsed;
+            }
+
+            return true;
+        }
+
+        if (elapsed >= 1000*(unsigned int)timeout)
+        {
+            LOG_ERROR("MT9D111", "Timeout polling 0x%X! (read=0x%X, expected=0x%X)", op.address, val, op.value);
+
+            return false;
+        }
+
+        // Exponential backoff
+        usleep(interval);
+
+        interval *= 2;
+        if (interval > max_interval_us)
+        {
+            interval = max_interval_us;
+        }
+    }
+}
+
+bool MT9D111::LoadProfile(uint8_t profile)
+{
+    DEBUG_EVENT(this->debug, "Loading profile ");
+
+    switch(profile)
+    {
+        case MT9D111_PROFILE_QVGA_30FPS:
+            DEBUG_MSG(this->debug, "QVGA at 30 FPS...");
+            DEBUG_NEWLINE(this->debug);
+
+            return this->Run(ops_qvga_30fps);
+        default:
+            DEBUG_NEWLINE(this->debug);
+
+            LOG_ERROR("MT9D111", "Unknown profile! (%u)", profile);
+
+            return false;
+    }
+}
+
+bool MT9D111::LoadProfile(const MT9D111Profile &profile)
+{
+    if (!profile.IsOpen())
+    {
+        return false;
+    }
+
+    DEBUG_EVENT(this->debug, string("Loading profile \"") +
+                string(profile.GetHeader()->name, strnlen(profile.GetHeader()->name, MT9D111_PROFILE_NAME_MAX_LEN)) +
+                string("\"..."));
+    DEBUG_NEWLINE(this->debug);
+
+    bool res = true;
+
+    for(const ProfileRecord *rec=profile.GetRecord(NULL); res and (rec != NULL); rec=profile.GetRecord(rec))
+    {
+        switch(rec->type)
+        {
+            case MT9D111_PROFILE_REC_RUN:
+                res = this->ApplyProfile(MT9D111Profile::GetRegisters(rec), rec->len);
+
+                break;
+            case MT9D111_PROFILE_REC_VARS:
+                res = this->WriteDriverVars(rec->page << 8, rec->offset, MT9D111Profile::GetPayload(rec), rec->len);
+
+                break;
+            case MT9D111_PROFILE_REC_DELAY:
+                usleep(1000*rec->len);
+
+                break;
+            case MT9D111_PROFILE_REC_POLL_VAR:
+            {
+                Op op = MT9D111_OP_POLL_VAR8(0, rec->offset, rec->value, rec->len);
+                op.page = rec->page;
+
+                res = this->Poll(op);
+
+                break;
+            }
+            default:
+                res = false;
+        }
+    }
+
+    if (!res)
+    {
+        LOG_ERROR("MT9D111", "Error loading the profile!");
+    }
+
+    return res;
+}
+
+bool MT9D111::WriteDriverVars(uint16_t driver_id, uint8_t offset, const uint8_t *data, size_t len)
+{
+    if (!this->is_open)
+    {
+        return false;
+    }
+
+    if (offset + len > MT9D111_DRIVER_VARS_SIZE)
+    {
+        LOG_ERROR("MT9D111", "Driver variables out of range! (offset=%u, len=%u)", offset, len);
+
+        return false;
+    }
+
+    if (len == 0)
+    {
+        return true;
+    }
+
+    // The driver variables registers are in page 1
+    if (!this->SetRegisterPage(MT9D111_REG_PAGE_1))
+    {
+        return false;
+    }
+
+    // Driver variable address (incremented by the microcontroller after each byte)
+    if (!this->WriteReg(MT9D111_REG_MICROCONTROLLER_VARIABLE_ADDRESS, MT9D111_DRIVER_VARIABLE_8_BIT_ACCESS |
+                                                                      MT9D111_DRIVER_PHYSICAL_ACCESS_ADDRESS_LOGICAL |
+                                                                      driver_id | offset))
+    {
+        return false;
+    }
+
+    // The burst registers are 16-bit wide
+    size_t n = len & ~1;
+
+    if (n > 0)
+    {
+        uint8_t buf[1 + MT9D111_DRIVER_VARS_SIZE];
+
+        buf[0] = MT9D111_REG_MICROCONTROLLER_VARIABLE_DATA_USING_BURST_TWO_WIRE_SERIAL_INTERFACE_ACCESS;
+        memcpy(&buf[1], data, n);
+
+        I2C_Msg msg;
+
+        msg.addr    = this->i2c->GetSlaveID();
+        msg.flags   = 0;
+        msg.len     = 1 + n;
+        msg.buf     = buf;
+
+        uint64_t start = I2CStats::Now();
+
+        bool res = this->i2c->Transfer(&msg, 1);
+
+        this->stats.Record(I2C_STATS_OP_TRANSFER, this->i2c->GetSlaveID(), MT9D111_REG_PAGE_1, buf[0], n, start,
+                           this->i2c->GetLastError());
+        this->stats.Count(MT9D111_REG_PAGE_1, buf[0], true, !res);
+
+        if (!res)
+        {
+            LOG_ERROR("MT9D111", "Error writing driver variables!");
+
+            // After a bus error the state of the device is uncertain
+            this->active_page = MT9D111_REG_PAGE_UNKNOWN;
+
+            return false;
+        }
+    }
+
+    // An odd last byte is written through the variable data register
+    if (n < len)
+    {
+        return this->WriteReg(MT9D111_REG_MICROCONTROLLER_VARIABLE_DATA, data[n]);
+    }
+
+    return true;
+}
+
+bool MT9D111::ReadDriverVars(uint16_t driver_id, uint8_t offset, uint8_t *data, size_t len)
+{
+    if (!this->is_open)
+    {
+        return false;
+    }
+
+    if (offset + len > MT9D111_DRIVER_VARS_SIZE)
+    {
+        LOG_ERROR("MT9D111", "Driver variables out of range! (offset=%u, len=%u)", offset, len);
+
+        return false;
+    }
+
+    if (len == 0)
+    {
+        return true;
+    }
+
+    // The driver variables registers are in page 1
+    if (!this->SetRegisterPage(MT9D111_REG_PAGE_1))
+    {
+        return false;
+    }
+
+    // Driver variable address (incremented by the microcontroller after each byte)
+    if (!this->WriteReg(MT9D111_REG_MICROCONTROLLER_VARIABLE_ADDRESS, MT9D111_DRIVER_VARIABLE_8_BIT_ACCESS |
+                                                                      MT9D111_DRIVER_PHYSICAL_ACCESS_ADDRESS_LOGICAL |
+                                                                      driver_id | offset))
+    {
+        return false;
+    }
+
+    // The burst registers are 16-bit wide
+    size_t n = len & ~1;
+
+    if (n > 0)
+    {
+        uint8_t adr = MT9D111_REG_MICROCONTROLLER_VARIABLE_DATA_USING_BURST_TWO_WIRE_SERIAL_INTERFACE_ACCESS;
+
+        I2C_Msg msgs[2];
+
+        msgs[0].addr    = this->i2c->GetSlaveID();
+        msgs[0].flags   = 0;
+        msgs[0].len     = 1;
+        msgs[0].buf     = &adr;
+
+        msgs[1].addr    = this->i2c->GetSlaveID();
+        msgs[1].flags   = I2C_M_RD;
+        msgs[1].len     = n;
+        msgs[1].buf     = data;
+
+        uint64_t start = I2CStats::Now();
+
+        bool res = this->i2c->Transfer(msgs, 2);
+
+        this->stats.Record(I2C_STATS_OP_TRANSFER, this->i2c->GetSlaveID(), MT9D111_REG_PAGE_1, adr, n, start,
+                           this->i2c->GetLastError());
+        this->stats.Count(MT9D111_REG_PAGE_1, adr, false, !res);
+
+        if (!res)
+        {
+            LOG_ERROR("MT9D111", "Error reading driver variables!");
+
+            // After a bus error the state of the device is uncertain
+            this->active_page = MT9D111_REG_PAGE_UNKNOWN;
+
+            return false;
+        }
+    }
+
+    // An odd last byte is read through the variable data register
+    if (n < len)
+    {
+        uint16_t val;
+        if (!this->ReadRegDirect(MT9D111_REG_MICROCONTROLLER_VARIABLE_DATA, &val))
+        {
+            return false;
+        }
+
+        data[n] = val & 0xFF;
+    }
+
+    return true;
+}
+
+void MT9D111::SwapDriverFields(uint8_t *data, const DriverVarField *fields, size_t fields_len)
+{
+#if __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__
+    for(size_t i=0; i<fields_len; i++)
+    {
+        for(uint8_t j=0; j<fields[i].count; j++)
+        {
+            uint8_t *field = &data[fields[i].offset + j*fields[i].size];
+
+            for(uint8_t k=0; k<fields[i].size/2; k++)
+            {
+                uint8_t tmp = field[k];
+                field[k] = field[fields[i].size - 1 - k];
+                field[fields[i].size - 1 - k] = tmp;
+            }
+        }
+    }
+#endif // __BYTE_ORDER__
+}
+
+bool MT9D111::ReadDriverBlock(uint16_t driver_id, uint8_t *data, size_t len, const DriverVarField *fields, size_t fields_len)
+{
+    if (!this->ReadDriverVars(driver_id, 0, data, len))
+    {
+        return false;
+    }
+
+    this->SwapDriverFields(data, fields, fields_len);
+
+    return true;
+}
+
+bool MT9D111::WriteDriverBlock(uint16_t driver_id, const uint8_t *data, size_t len, const DriverVarField *fields, size_t fields_len,
+                               const DriverVarRange *skip, size_t skip_len)
+{
+    uint8_t *buf = new uint8_t[len];
+
+    memcpy(buf, data, len);
+
+    this->SwapDriverFields(buf, fields, fields_len);
+
+    // The first variable is the pointer to the driver VMT and must not be changed
+    bool *writable = new bool[len];
+
+    for(size_t i=0; i<len; i++)
     {
-        this->debug->WriteEvent("Error enabling the PLL!");
-        this->debug->NewLine();
-
-        return false;
+        writable[i] = (i >= 2);
     }
 
-    // Power up PLL
-    if (!this->WriteRegBit(MT9D111_REG_CLOCK_CONTROL, 14, false))
+    for(size_t i=0; i<skip_len; i++)
     {
-        this->debug->WriteEvent("Error enabling the PLL!");
-        this->debug->NewLine();
-
-        return false;
+        for(size_t j=skip[i].offset; (j < (size_t)skip[i].offset + skip[i].len) and (j < len); j++)
+        {
+            writable[j] = false;
+        }
     }
 
-    // Wait for PLL settling time (> 150 us)
-    usleep(500);
+    // Each run of writable variables is written with a single burst
+    bool res = true;
 
-    // Turn off PLL bypass
-    if (!this->WriteRegBit(MT9D111_REG_CLOCK_CONTROL, 15, false))
+    size_t i = 0;
+    while(res and (i < len))
     {
-        this->debug->WriteEvent("Error enabling the PLL!");
-        this->debug->NewLine();
+        if (!writable[i])
+        {
+            i++;
 
-        return false;
+            continue;
+        }
+
+        size_t n = 1;
+        while((i + n < len) and writable[i + n])
+        {
+            n++;
+        }
+
+        res = this->WriteDriverVars(driver_id, i, &buf[i], n);
+
+        i += n;
     }
 
-    return true;
+    delete[] writable;
+    delete[] buf;
+
+    return res;
 }
 
-bool MT9D111::SetRegisterPage(uint16_t page)
+bool MT9D111::ReadDriver(Monitor &mon)
 {
-    if (this->WriteAndCheckReg(MT9D111_REG_PAGE_REGISTER, page))
-    {
-        return true;
-    }
-    else
-    {
-        this->debug->WriteEvent("Error configuring register page to ");
-        this->debug->WriteDec(page);
-        this->debug->WriteMsg("!");
-        this->debug->NewLine();
+    return this->ReadDriverBlock(MT9D111_DRIVER_ID_MONITOR, (uint8_t*)&mon, sizeof(Monitor),
+                                 driver_fields_monitor, sizeof(driver_fields_monitor)/sizeof(DriverVarField));
+}
 
-        return false;
-    }
+bool MT9D111::WriteDriver(const Monitor &mon)
+{
+    return this->WriteDriverBlock(MT9D111_DRIVER_ID_MONITOR, (const uint8_t*)&mon, sizeof(Monitor),
+                                  driver_fields_monitor, sizeof(driver_fields_monitor)/sizeof(DriverVarField),
+                                  driver_skip_monitor, sizeof(driver_skip_monitor)/sizeof(DriverVarRange));
 }
 
-bool MT9D111::GetRegisterPage(uint16_t *page)
+bool MT9D111::ReadDriver(Sequencer &seq)
 {
-    return this->ReadReg(MT9D111_REG_PAGE_REGISTER, page);
+    return this->ReadDriverBlock(MT9D111_DRIVER_ID_SEQUENCER, (uint8_t*)&seq, sizeof(Sequencer),
+                                 driver_fields_sequencer, sizeof(driver_fields_sequencer)/sizeof(DriverVarField));
 }
 
-bool MT9D111::Reset(uint8_t type)
+bool MT9D111::WriteDriver(const Sequencer &seq)
 {
-    switch(type)
-    {
-        case MT9D111_RESET_HARD:
-            return this->HardReset();
-        case MT9D111_RESET_SOFT:
-            return this->SoftReset();
-        default:
-            return this->HardReset();
-    }
+    return this->WriteDriverBlock(MT9D111_DRIVER_ID_SEQUENCER, (const uint8_t*)&seq, sizeof(Sequencer),
+                                  driver_fields_sequencer, sizeof(driver_fields_sequencer)/sizeof(DriverVarField),
+                                  driver_skip_sequencer, sizeof(driver_skip_sequencer)/sizeof(DriverVarRange));
 }
 
-bool MT9D111::Config()
+bool MT9D111::ReadDriver(AutoExposure &ae)
 {
-    this->debug->WriteEvent("Loading configuration parameters from \"Register Wizard\"...");
-    this->debug->NewLine();
+    return this->ReadDriverBlock(MT9D111_DRIVER_ID_AUTO_EXPOSURE, (uint8_t*)&ae, sizeof(AutoExposure),
+                                 driver_fields_auto_exposure, sizeof(driver_fields_auto_exposure)/sizeof(DriverVarField));
+}
 
-    for(uint8_t i=0; i<(sizeof(reg_default_vals)/sizeof(Register)); i++)
-    {
-        if (!this->WriteAndCheckReg(reg_default_vals[i].address, reg_default_vals[i].value))
-        {
-            this->debug->WriteEvent("Error loading configuration parameters!");
-            this->debug->NewLine();
+bool MT9D111::WriteDriver(const AutoExposure &ae)
+{
+    return this->WriteDriverBlock(MT9D111_DRIVER_ID_AUTO_EXPOSURE, (const uint8_t*)&ae, sizeof(AutoExposure),
+                                  driver_fields_auto_exposure, sizeof(driver_fields_auto_exposure)/sizeof(DriverVarField));
+}
 
-            return false;
-        }
-    }
+bool MT9D111::ReadDriver(AutoWhiteBalance &awb)
+{
+    return this->ReadDriverBlock(MT9D111_DRIVER_ID_AUTO_WHITE_BALANCE, (uint8_t*)&awb, sizeof(AutoWhiteBalance),
+                                 driver_fields_auto_white_balance, sizeof(driver_fields_auto_white_balance)/sizeof(DriverVarField));
+}
 
-    return true;
+bool MT9D111::WriteDriver(const AutoWhiteBalance &awb)
+{
+    return this->WriteDriverBlock(MT9D111_DRIVER_ID_AUTO_WHITE_BALANCE, (const uint8_t*)&awb, sizeof(AutoWhiteBalance),
+                                  driver_fields_auto_white_balance, sizeof(driver_fields_auto_white_balance)/sizeof(DriverVarField));
 }
 
-bool MT9D111::EnterStandby(uint8_t type)
+bool MT9D111::ReadDriver(FlickerDetection &fd)
 {
-    switch(type)
-    {
-        case MT9D111_STANDBY_HARD:
-            return this->HardStandby(true);
-        case MT9D111_STANDBY_SOFT:
-            return this->SoftStandby(true);
-        default:
-            return this->HardStandby(true);
-    }
+    return this->ReadDriverBlock(MT9D111_DRIVER_ID_FLICKER_DETECTION, (uint8_t*)&fd, sizeof(FlickerDetection),
+                                 driver_fields_flicker_detection, sizeof(driver_fields_flicker_detection)/sizeof(DriverVarField));
 }
 
-bool MT9D111::LeaveStandby(uint8_t type)
+bool MT9D111::WriteDriver(const FlickerDetection &fd)
 {
-    switch(type)
-    {
-        case MT9D111_STANDBY_HARD:
-            return this->HardStandby(false);
-        case MT9D111_STANDBY_SOFT:
-            return this->SoftStandby(false);
-        default:
-            return this->HardStandby(false);
-    }
+    return this->WriteDriverBlock(MT9D111_DRIVER_ID_FLICKER_DETECTION, (const uint8_t*)&fd, sizeof(FlickerDetection),
+                                  driver_fields_flicker_detection, sizeof(driver_fields_flicker_detection)/sizeof(DriverVarField));
 }
 
-bool MT9D111::ReadReg(uint8_t adr, uint16_t *val)
+bool MT9D111::ReadDriver(AutoFocus &af)
 {
-    if (this->is_open)
-    {
-        uint16_t reg_val = this->i2c->ReadReg16(adr);
+    return this->ReadDriverBlock(MT9D111_DRIVER_ID_AUTO_FOCUS, (uint8_t*)&af, sizeof(AutoFocus),
+                                 driver_fields_auto_focus, sizeof(driver_fields_auto_focus)/sizeof(DriverVarField));
+}
 
-        reg_val = ((reg_val & 0xFF00) >> 8) + ((reg_val & 0x00FF) << 8);
+bool MT9D111::WriteDriver(const AutoFocus &af)
+{
+    return this->WriteDriverBlock(MT9D111_DRIVER_ID_AUTO_FOCUS, (const uint8_t*)&af, sizeof(AutoFocus),
+                                  driver_fields_auto_focus, sizeof(driver_fields_auto_focus)/sizeof(DriverVarField));
+}
 
-        *val = reg_val;
+bool MT9D111::ReadDriver(AutoFocusMechanics &afm)
+{
+    return this->ReadDriverBlock(MT9D111_DRIVER_ID_AUTO_FOCUS_MECHANICS, (uint8_t*)&afm, sizeof(AutoFocusMechanics),
+                                 driver_fields_auto_focus_mechanics, sizeof(driver_fields_auto_focus_mechanics)/sizeof(DriverVarField));
+}
 
-        return true;
-    }
-    else
-    {
-        return false;
-    }
+bool MT9D111::WriteDriver(const AutoFocusMechanics &afm)
+{
+    return this->WriteDriverBlock(MT9D111_DRIVER_ID_AUTO_FOCUS_MECHANICS, (const uint8_t*)&afm, sizeof(AutoFocusMechanics),
+                                  driver_fields_auto_focus_mechanics, sizeof(driver_fields_auto_focus_mechanics)/sizeof(DriverVarField));
 }
 
-bool MT9D111::CheckReg(uint8_t adr, uint16_t val)
+bool MT9D111::ReadDriver(Mode &mode)
 {
-    uint16_t reg_val = 0xFFFF;
+    return this->ReadDriverBlock(MT9D111_DRIVER_ID_MODE, (uint8_t*)&mode, sizeof(Mode),
+                                 driver_fields_mode, sizeof(driver_fields_mode)/sizeof(DriverVarField));
+}
 
-    if (this->ReadReg(adr, &reg_val))
-    {
-        if (reg_val == val)
-        {
-            return true;
-        }
-        else
-        {
-            this->debug->WriteEvent("Error checking register ");
-            this->debug->WriteHex(adr);
-            this->debug->WriteMsg("! (read=");
-            this->debug->WriteHex(reg_val);
-            this->debug->WriteMsg(", expected=");
-            this->debug->WriteHex(val);
-            this->debug->WriteMsg(")");
-            this->debug->NewLine();
+bool MT9D111::WriteDriver(const Mode &mode)
+{
+    return this->WriteDriverBlock(MT9D111_DRIVER_ID_MODE, (const uint8_t*)&mode, sizeof(Mode),
+                                  driver_fields_mode, sizeof(driver_fields_mode)/sizeof(DriverVarField),
+                                  driver_skip_mode, sizeof(driver_skip_mode)/sizeof(DriverVarRange));
+}
 
-            return false;
-        }
-    }
-    else
-    {
-        return false;
-    }
+bool MT9D111::ReadDriver(JPEG &jpeg)
+{
+    return this->ReadDriverBlock(MT9D111_DRIVER_ID_JPEG, (uint8_t*)&jpeg, sizeof(JPEG),
+                                 driver_fields_jpeg, sizeof(driver_fields_jpeg)/sizeof(DriverVarField));
 }
 
-bool MT9D111::WriteReg(uint8_t adr, uint16_t val)
+bool MT9D111::WriteDriver(const JPEG &jpeg)
 {
-    if (this->is_open)
-    {
-        val = ((val & 0xFF00) >> 8) + ((val & 0x00FF) << 8);
+    return this->WriteDriverBlock(MT9D111_DRIVER_ID_JPEG, (const uint8_t*)&jpeg, sizeof(JPEG),
+                                  driver_fields_jpeg, sizeof(driver_fields_jpeg)/sizeof(DriverVarField),
+                                  driver_skip_jpeg, sizeof(driver_skip_jpeg)/sizeof(DriverVarRange));
+}
 
-        return this->i2c->WriteReg16(adr, val);
-    }
-    else
-    {
-        return false;
-    }
+bool MT9D111::ReadDriver(Histogram &hg)
+{
+    return this->ReadDriverBlock(MT9D111_DRIVER_ID_HISTOGRAM, (uint8_t*)&hg, sizeof(Histogram),
+                                 driver_fields_histogram, sizeof(driver_fields_histogram)/sizeof(DriverVarField));
 }
 
-bool MT9D111::WriteAndCheckReg(uint8_t adr, uint16_t val, unsigned int attempts)
+bool MT9D111::WriteDriver(const Histogram &hg)
 {
-    for(unsigned int i=0; i<attempts; i++)
-    {
-        if (this->WriteReg(adr, val))
-        {
-            if (this->CheckReg(adr, val))
-            {
-                return true;
-            }
-            else
-            {
-                this->debug->WriteEvent("Error writing ");
-                this->debug->WriteHex(val);
-                this->debug->WriteMsg(" to address ");
-                this->debug->WriteHex(adr);
-                this->debug->WriteMsg("! Trying again (");
-                this->debug->WriteDec(i+1);
-                this->debug->WriteMsg(" of ");
-                this->debug->WriteDec(attempts);
-                this->debug->WriteMsg(")");
-                this->debug->NewLine();
-            }
-        }
-        else
-        {
-            return false;
-        }
-    }
+    return this->WriteDriverBlock(MT9D111_DRIVER_ID_HISTOGRAM, (const uint8_t*)&hg, sizeof(Histogram),
+                                  driver_fields_histogram, sizeof(driver_fields_histogram)/sizeof(DriverVarField));
+}
 
-    return false;
+bool MT9D111::ReadDriver(Driver &drv)
+{
+    DEBUG_EVENT(this->debug, "Reading all driver variables...");
+    DEBUG_NEWLINE(this->debug);
+
+    return this->ReadDriver(drv.mon) and this->ReadDriver(drv.seq) and this->ReadDriver(drv.ae) and
+           this->ReadDriver(drv.awb) and this->ReadDriver(drv.fd) and this->ReadDriver(drv.af) and
+           this->ReadDriver(drv.afm) and this->ReadDriver(drv.mode) and this->ReadDriver(drv.jpeg) and
+           this->ReadDriver(drv.hg);
+}
+
+bool MT9D111::WriteDriver(const Driver &drv)
+{
+    DEBUG_EVENT(this->debug, "Writing all driver variables...");
+    DEBUG_NEWLINE(this->debug);
+
+    return this->WriteDriver(drv.mon) and this->WriteDriver(drv.seq) and this->WriteDriver(drv.ae) and
+           this->WriteDriver(drv.awb) and this->WriteDriver(drv.fd) and this->WriteDriver(drv.af) and
+           this->WriteDriver(drv.afm) and this->WriteDriver(drv.mode) and this->WriteDriver(drv.jpeg) and
+           this->WriteDriver(drv.hg);
 }
 
 bool MT9D111::CheckDevice()
 {
-    this->debug->WriteEvent("Checking device...");
+    DEBUG_EVENT(this->debug, "Checking device...");
 
     if (this->is_open)
     {
         uint16_t reg_val;
 
-        if (!this->ReadReg(MT9D111_REG_RESERVED, &reg_val))
+        if (!this->ReadRegDirect(MT9D111_REG_RESERVED, &reg_val))
         {
-            this->debug->WriteMsg("FAILURE!");
-            this->debug->NewLine();
+            DEBUG_NEWLINE(this->debug);
+
+            LOG_ERROR("MT9D111", "Error reading the device ID!");
 
             return false;
         }
 
         if (reg_val == MT9D111_ID_CODE)
         {
-            this->debug->WriteMsg("SUCCESS!");
-            this->debug->NewLine();
+            DEBUG_MSG(this->debug, "SUCCESS!");
+            DEBUG_NEWLINE(this->debug);
 
             return true;
         }
         else
         {
-            this->debug->WriteMsg("FAILURE!");
-            this->debug->NewLine();
+            DEBUG_NEWLINE(this->debug);
 
-            this->debug->WriteEvent("Wrong device ID! (read=");
-            this->debug->WriteHex(reg_val);
-            this->debug->WriteMsg(", expected=");
-            this->debug->WriteHex(MT9D111_ID_CODE);
-            this->debug->WriteMsg(")");
-            this->debug->NewLine();
+            LOG_ERROR("MT9D111", "Wrong device ID! (read=0x%X, expected=0x%X)", reg_val, MT9D111_ID_CODE);
 
             return false;
         }
     }
     else
     {
-        this->debug->WriteMsg("FAILURE!");
-        this->debug->NewLine();
+        DEBUG_NEWLINE(this->debug);
 
-        this->debug->WriteEvent("Communication bus not opened!");
-        this->debug->NewLine();
+        LOG_ERROR("MT9D111", "Communication bus not opened!");
 
         return false;
     }
@@ -572,54 +2068,86 @@ bool MT9D111::CheckDevice()
 
 bool MT9D111::SetMode(uint8_t mode)
 {
-    this->debug->WriteEvent("Configuring mode to ");
+    DEBUG_EVENT(this->debug, "Configuring mode to ");
+
+    uint8_t var;
+    uint8_t state;
 
     switch(mode)
     {
         case MT9D111_MODE_PREVIEW:
-            this->debug->WriteMsg("PREVIEW...");
+            DEBUG_MSG(this->debug, "PREVIEW...");
+            DEBUG_NEWLINE(this->debug);
+
+            var = 1;
+            if (!this->WriteDriverVars(MT9D111_DRIVER_ID_SEQUENCER, MT9D111_DRIVER_VAR_SEQUENCER_CAPTURE_PARAMS_MODE, &var, 1))
+            {
+                LOG_ERROR("MT9D111", "Error writing the capture parameters mode!");
 
-            this->WriteReg(MT9D111_REG_MICROCONTROLLER_VARIABLE_ADDRESS, MT9D111_DRIVER_VARIABLE_8_BIT_ACCESS |
-                                                                         MT9D111_DRIVER_PHYSICAL_ACCESS_ADDRESS_LOGICAL |
-                                                                         MT9D111_DRIVER_ID_SEQUENCER |
-                                                                         MT9D111_DRIVER_VAR_SEQUENCER_CAPTURE_PARAMS_MODE);
+                return false;
+            }
 
-            this->WriteReg(MT9D111_REG_MICROCONTROLLER_VARIABLE_DATA, 1);
+            if (!this->SequencerCmd(MT9D111_DRIVER_VAR_SEQUENCER_CMD_DO_PREVIEW))
+            {
+                return false;
+            }
 
-            this->SequencerCmd(MT9D111_DRIVER_VAR_SEQUENCER_CMD_DO_PREVIEW);
+            state = MT9D111_STATE_PREVIEW;
 
             break;
         case MT9D111_MODE_CAPTURE:
-            this->debug->WriteMsg("PREVIEW...");
+            DEBUG_MSG(this->debug, "CAPTURE...");
+            DEBUG_NEWLINE(this->debug);
+
+            var = 0;
+            if (!this->WriteDriverVars(MT9D111_DRIVER_ID_SEQUENCER, MT9D111_DRIVER_VAR_SEQUENCER_CAPTURE_PARAMS_MODE, &var, 1))
+            {
+                LOG_ERROR("MT9D111", "Error writing the capture parameters mode!");
 
-            this->WriteReg(MT9D111_REG_MICROCONTROLLER_VARIABLE_ADDRESS, MT9D111_DRIVER_VARIABLE_8_BIT_ACCESS |
-                                                                         MT9D111_DRIVER_PHYSICAL_ACCESS_ADDRESS_LOGICAL |
-                                                                         MT9D111_DRIVER_ID_SEQUENCER |
-                                                                         MT9D111_DRIVER_VAR_SEQUENCER_CAPTURE_PARAMS_MODE);
+                return false;
+            }
 
-            this->WriteReg(MT9D111_REG_MICROCONTROLLER_VARIABLE_DATA, 0);
+            if (!this->SequencerCmd(MT9D111_DRIVER_VAR_SEQUENCER_CMD_DO_CAPTURE))
+            {
+                return false;
+            }
 
-            this->SequencerCmd(MT9D111_DRIVER_VAR_SEQUENCER_CMD_DO_CAPTURE);
+            state = MT9D111_STATE_CAPTURE;
 
             break;
         default:
-            this->debug->WriteMsg("UNKNOWN!");
-            this->debug->NewLine();
+            DEBUG_NEWLINE(this->debug);
+
+            LOG_ERROR("MT9D111", "Invalid mode! (%u)", mode);
 
             return false;
     }
 
-    if (this->GetMode() == mode)
+    // The context only changes after the sequencer completes the transition
+    uint32_t latency;
+    if (!this->WaitSequencerState(state, MT9D111_SEQUENCER_STATE_TIMEOUT_MS, &latency))
+    {
+        LOG_ERROR("MT9D111", "Mode transition FAILURE!");
+
+        return false;
+    }
+
+    uint8_t cur_mode;
+    if (this->GetMode(&cur_mode) and (cur_mode == mode))
     {
-        this->debug->WriteMsg("SUCCESS!");
-        this->debug->NewLine();
+        // Pace the next sequencer polls with the frame period of the new context
+        this->UpdateFramePeriod(mode);
+
+        DEBUG_EVENT(this->debug, "Mode transition SUCCESS! (");
+        DEBUG_DEC(this->debug, latency);
+        DEBUG_MSG(this->debug, " us)");
+        DEBUG_NEWLINE(this->debug);
 
         return true;
     }
     else
     {
-        this->debug->WriteMsg("FAILURE!");
-        this->debug->NewLine();
+        LOG_ERROR("MT9D111", "Mode transition FAILURE!");
 
         return false;
     }
@@ -627,270 +2155,236 @@ bool MT9D111::SetMode(uint8_t mode)
 
 uint8_t MT9D111::GetMode()
 {
-    this->WriteReg(MT9D111_REG_MICROCONTROLLER_VARIABLE_ADDRESS, MT9D111_DRIVER_VARIABLE_8_BIT_ACCESS |
-                                                                 MT9D111_DRIVER_PHYSICAL_ACCESS_ADDRESS_LOGICAL |
-                                                                 MT9D111_DRIVER_ID_MODE |
-                                                                 MT9D111_DRIVER_VAR_MODE_CONTEXT);
+    uint8_t mode = 0xFF;
+
+    if (!this->GetMode(&mode))
+    {
+        return 0xFF;
+    }
+
+    return mode;
+}
+
+bool MT9D111::GetMode(uint8_t *mode)
+{
+    return this->ReadDriverVars(MT9D111_DRIVER_ID_MODE, MT9D111_DRIVER_VAR_MODE_CONTEXT, mode, 1);
+}
 
-    uint16_t mode = 0xFF;
-    this->ReadReg(MT9D111_REG_MICROCONTROLLER_VARIABLE_DATA, &mode);
+unsigned long MT9D111::GetPageSwitchesSaved()
+{
+    return this->page_switches_saved;
+}
 
-    return (uint8_t)(mode);
+I2CStats* MT9D111::GetStats()
+{
+    return &this->stats;
 }
 
 bool MT9D111::SetOutputFormat(uint8_t format)
 {
-    this->debug->WriteEvent("Configuring output format as ");
+    DEBUG_EVENT(this->debug, "Configuring output format as ");
 
-    this->SetRegisterPage(MT9D111_REG_PAGE_1);
+    bool res = this->SetRegisterPage(MT9D111_REG_PAGE_1);
+
+    // mode.out_format_A and mode.out_format_B
+    uint8_t out_format[2];
 
     switch(format)
     {
         case MT9D111_OUTPUT_FORMAT_YCbCr:
-            this->debug->WriteMsg("YCbCr...");
-            this->debug->NewLine();
+            DEBUG_MSG(this->debug, "YCbCr...");
+            DEBUG_NEWLINE(this->debug);
 
-            this->WriteReg(MT9D111_REG_MICROCONTROLLER_VARIABLE_ADDRESS, MT9D111_DRIVER_VARIABLE_8_BIT_ACCESS |
-                                                                         MT9D111_DRIVER_PHYSICAL_ACCESS_ADDRESS_LOGICAL |
-                                                                         MT9D111_DRIVER_ID_MODE |
-                                                                         MT9D111_DRIVER_VAR_MODE_OUT_FORMAT_A);
+            out_format[0] = 0;
+            out_format[1] = out_format[0];
 
-            this->WriteReg(MT9D111_REG_MICROCONTROLLER_VARIABLE_DATA, 0);
-
-            this->WriteReg(MT9D111_REG_MICROCONTROLLER_VARIABLE_ADDRESS, MT9D111_DRIVER_VARIABLE_8_BIT_ACCESS |
-                                                                         MT9D111_DRIVER_PHYSICAL_ACCESS_ADDRESS_LOGICAL |
-                                                                         MT9D111_DRIVER_ID_MODE |
-                                                                         MT9D111_DRIVER_VAR_MODE_OUT_FORMAT_B);
-
-            this->WriteReg(MT9D111_REG_MICROCONTROLLER_VARIABLE_DATA, 0);
+            res = res and this->WriteDriverVars(MT9D111_DRIVER_ID_MODE, MT9D111_DRIVER_VAR_MODE_OUT_FORMAT_A, out_format, 2);
 
             break;
         case MT9D111_OUTPUT_FORMAT_RGB565:
-            this->debug->WriteMsg("RGB565...");
-            this->debug->NewLine();
-
-            this->WriteReg(MT9D111_REG_MICROCONTROLLER_VARIABLE_ADDRESS, MT9D111_DRIVER_VARIABLE_8_BIT_ACCESS |
-                                                                         MT9D111_DRIVER_PHYSICAL_ACCESS_ADDRESS_LOGICAL |
-                                                                         MT9D111_DRIVER_ID_MODE |
-                                                                         MT9D111_DRIVER_VAR_MODE_OUT_FORMAT_A);
-
-            this->WriteReg(MT9D111_REG_MICROCONTROLLER_VARIABLE_DATA, (1 << 5));
+            DEBUG_MSG(this->debug, "RGB565...");
+            DEBUG_NEWLINE(this->debug);
 
-            this->WriteReg(MT9D111_REG_MICROCONTROLLER_VARIABLE_ADDRESS, MT9D111_DRIVER_VARIABLE_8_BIT_ACCESS |
-                                                                         MT9D111_DRIVER_PHYSICAL_ACCESS_ADDRESS_LOGICAL |
-                                                                         MT9D111_DRIVER_ID_MODE |
-                                                                         MT9D111_DRIVER_VAR_MODE_OUT_FORMAT_B);
+            out_format[0] = (1 << 5);
+            out_format[1] = out_format[0];
 
-            this->WriteReg(MT9D111_REG_MICROCONTROLLER_VARIABLE_DATA, (1 << 5));
+            res = res and this->WriteDriverVars(MT9D111_DRIVER_ID_MODE, MT9D111_DRIVER_VAR_MODE_OUT_FORMAT_A, out_format, 2);
 
             break;
         case MT9D111_OUTPUT_FORMAT_RGB555:
-            this->debug->WriteMsg("RGB555...");
-            this->debug->NewLine();
+            DEBUG_MSG(this->debug, "RGB555...");
+            DEBUG_NEWLINE(this->debug);
 
-            this->WriteReg(MT9D111_REG_MICROCONTROLLER_VARIABLE_ADDRESS, MT9D111_DRIVER_VARIABLE_8_BIT_ACCESS |
-                                                                         MT9D111_DRIVER_PHYSICAL_ACCESS_ADDRESS_LOGICAL |
-                                                                         MT9D111_DRIVER_ID_MODE |
-                                                                         MT9D111_DRIVER_VAR_MODE_OUT_FORMAT_A);
+            out_format[0] = (1 << 5) | (1 << 6);
+            out_format[1] = out_format[0];
 
-            this->WriteReg(MT9D111_REG_MICROCONTROLLER_VARIABLE_DATA, (1 << 5) | (1 << 6));
-
-            this->WriteReg(MT9D111_REG_MICROCONTROLLER_VARIABLE_ADDRESS, MT9D111_DRIVER_VARIABLE_8_BIT_ACCESS |
-                                                                         MT9D111_DRIVER_PHYSICAL_ACCESS_ADDRESS_LOGICAL |
-                                                                         MT9D111_DRIVER_ID_MODE |
-                                                                         MT9D111_DRIVER_VAR_MODE_OUT_FORMAT_B);
-
-            this->WriteReg(MT9D111_REG_MICROCONTROLLER_VARIABLE_DATA, (1 << 5) | (1 << 6));
+            res = res and this->WriteDriverVars(MT9D111_DRIVER_ID_MODE, MT9D111_DRIVER_VAR_MODE_OUT_FORMAT_A, out_format, 2);
 
             break;
         case MT9D111_OUTPUT_FORMAT_RGB444x:
-            this->debug->WriteMsg("RGB444x...");
-            this->debug->NewLine();
-
-            this->WriteReg(MT9D111_REG_MICROCONTROLLER_VARIABLE_ADDRESS, MT9D111_DRIVER_VARIABLE_8_BIT_ACCESS |
-                                                                         MT9D111_DRIVER_PHYSICAL_ACCESS_ADDRESS_LOGICAL |
-                                                                         MT9D111_DRIVER_ID_MODE |
-                                                                         MT9D111_DRIVER_VAR_MODE_OUT_FORMAT_A);
-
-            this->WriteReg(MT9D111_REG_MICROCONTROLLER_VARIABLE_ADDRESS, MT9D111_DRIVER_VARIABLE_8_BIT_ACCESS |
-                                                                         MT9D111_DRIVER_PHYSICAL_ACCESS_ADDRESS_LOGICAL |
-                                                                         MT9D111_DRIVER_ID_MODE |
-                                                                         MT9D111_DRIVER_VAR_MODE_OUT_FORMAT_B);
+            DEBUG_MSG(this->debug, "RGB444x...");
+            DEBUG_NEWLINE(this->debug);
 
-            this->WriteReg(MT9D111_REG_MICROCONTROLLER_VARIABLE_DATA, (1 << 5) | (1 << 7));
+            out_format[0] = (1 << 5) | (1 << 7);
+            out_format[1] = out_format[0];
 
-            this->WriteReg(MT9D111_REG_MICROCONTROLLER_VARIABLE_DATA, (1 << 5) | (1 << 7));
+            res = res and this->WriteDriverVars(MT9D111_DRIVER_ID_MODE, MT9D111_DRIVER_VAR_MODE_OUT_FORMAT_A, out_format, 2);
 
             break;
         case MT9D111_OUTPUT_FORMAT_RGBx444:
-            this->debug->WriteMsg("RGBx444...");
-            this->debug->NewLine();
+            DEBUG_MSG(this->debug, "RGBx444...");
+            DEBUG_NEWLINE(this->debug);
 
-            this->WriteReg(MT9D111_REG_MICROCONTROLLER_VARIABLE_ADDRESS, MT9D111_DRIVER_VARIABLE_8_BIT_ACCESS |
-                                                                         MT9D111_DRIVER_PHYSICAL_ACCESS_ADDRESS_LOGICAL |
-                                                                         MT9D111_DRIVER_ID_MODE |
-                                                                         MT9D111_DRIVER_VAR_MODE_OUT_FORMAT_A);
+            out_format[0] = (1 << 5) | (1 << 6) | (1 << 7);
+            out_format[1] = out_format[0];
 
-            this->WriteReg(MT9D111_REG_MICROCONTROLLER_VARIABLE_DATA, (1 << 5) | (1 << 6) | (1 << 7));
-
-            this->WriteReg(MT9D111_REG_MICROCONTROLLER_VARIABLE_ADDRESS, MT9D111_DRIVER_VARIABLE_8_BIT_ACCESS |
-                                                                         MT9D111_DRIVER_PHYSICAL_ACCESS_ADDRESS_LOGICAL |
-                                                                         MT9D111_DRIVER_ID_MODE |
-                                                                         MT9D111_DRIVER_VAR_MODE_OUT_FORMAT_B);
-
-            this->WriteReg(MT9D111_REG_MICROCONTROLLER_VARIABLE_DATA, (1 << 5) | (1 << 6) | (1 << 7));
+            res = res and this->WriteDriverVars(MT9D111_DRIVER_ID_MODE, MT9D111_DRIVER_VAR_MODE_OUT_FORMAT_A, out_format, 2);
 
             break;
         case MT9D111_OUTPUT_FORMAT_JPEG:
-            this->debug->WriteMsg("JPEG...");
-            this->debug->NewLine();
+            DEBUG_MSG(this->debug, "JPEG...");
+            DEBUG_NEWLINE(this->debug);
 
-            this->WriteReg(MT9D111_REG_FACTORY_BYPASS, 0x02);
-            this->WriteReg(MT9D111_REG_OUTPUT_FORMAT_TEST, 0x00);
+            res = res and this->WriteReg(MT9D111_REG_FACTORY_BYPASS, 0x02);
+            res = res and this->WriteReg(MT9D111_REG_OUTPUT_FORMAT_TEST, 0x00);
             break;
         case MT9D111_OUTPUT_FORMAT_RAW_8:
-            this->debug->WriteMsg("RAW8...");
-            this->debug->NewLine();
+            DEBUG_MSG(this->debug, "RAW8...");
+            DEBUG_NEWLINE(this->debug);
 
-            this->WriteReg(MT9D111_REG_MICROCONTROLLER_BOOT_MODE, 0x01);
-            this->WriteReg(MT9D111_REG_FACTORY_BYPASS, 0x00);
-            this->WriteReg(MT9D111_REG_OUTPUT_FORMAT_TEST, 0x00);
+            res = res and this->WriteReg(MT9D111_REG_MICROCONTROLLER_BOOT_MODE, 0x01);
+            res = res and this->WriteReg(MT9D111_REG_FACTORY_BYPASS, 0x00);
+            res = res and this->WriteReg(MT9D111_REG_OUTPUT_FORMAT_TEST, 0x00);
             break;
         case MT9D111_OUTPUT_FORMAT_RAW_10:
-            this->debug->WriteMsg("RAW10...");
-            this->debug->NewLine();
+            DEBUG_MSG(this->debug, "RAW10...");
+            DEBUG_NEWLINE(this->debug);
 
-            this->WriteReg(MT9D111_REG_MICROCONTROLLER_BOOT_MODE, 0x01);
-            this->WriteReg(MT9D111_REG_FACTORY_BYPASS, 0x01);
-            this->WriteReg(MT9D111_REG_OUTPUT_FORMAT_TEST, (1 << 6));
+            res = res and this->WriteReg(MT9D111_REG_MICROCONTROLLER_BOOT_MODE, 0x01);
+            res = res and this->WriteReg(MT9D111_REG_FACTORY_BYPASS, 0x01);
+            res = res and this->WriteReg(MT9D111_REG_OUTPUT_FORMAT_TEST, (1 << 6));
             break;
         default:
-            this->debug->WriteMsg("UNKNOWN...");
-            this->debug->NewLine();
+            DEBUG_NEWLINE(this->debug);
+
+            LOG_ERROR("MT9D111", "Invalid output format! (%u)", format);
 
             return false;
     }
 
     if (format != MT9D111_OUTPUT_FORMAT_JPEG)
     {
-        this->SetRegisterPage(MT9D111_REG_PAGE_2);
-
-        this->WriteReg(MT9D111_REG_JPEG_ENCODER_BYPASS, 0);
+        res = res and this->SetRegisterPage(MT9D111_REG_PAGE_2);
+        res = res and this->WriteReg(MT9D111_REG_JPEG_ENCODER_BYPASS, 0);
     }
 
-    this->SequencerCmd(MT9D111_DRIVER_VAR_SEQUENCER_CMD_REFRESH);
+    res = res and this->SequencerCmd(MT9D111_DRIVER_VAR_SEQUENCER_CMD_REFRESH);
 
-    return true;
+    if (!res)
+    {
+        LOG_ERROR("MT9D111", "Error configuring the output format!");
+    }
+
+    return res;
 }
 
 bool MT9D111::SetResolution(uint8_t mode, uint16_t width, uint16_t height)
 {
-    this->debug->WriteEvent("Configuring resolution as ");
-    this->debug->WriteDec(width);
-    this->debug->WriteMsg("x");
-    this->debug->WriteDec(height);
+    DEBUG_EVENT(this->debug, "Configuring resolution as ");
+    DEBUG_DEC(this->debug, width);
+    DEBUG_MSG(this->debug, "x");
+    DEBUG_DEC(this->debug, height);
 
     if ((width > MT9D111_OUTPUT_MAX_WIDTH) or (height > MT9D111_OUTPUT_MAX_HEIGHT))
     {
         return false;
     }
 
-    this->SetRegisterPage(MT9D111_REG_PAGE_1);
+    bool res = this->SetRegisterPage(MT9D111_REG_PAGE_1);
+
+    // Consecutive 16-bit variables (MSB first)
+    uint8_t vars[] = {(uint8_t)(width >> 8), (uint8_t)(width & 0xFF), (uint8_t)(height >> 8), (uint8_t)(height & 0xFF)};
 
-    this->debug->WriteMsg(" for ");
+    DEBUG_MSG(this->debug, " for ");
 
     switch(mode)
     {
         case MT9D111_MODE_PREVIEW:
-            this->debug->WriteMsg("PREVIEW mode...");
-            this->debug->NewLine();
-
-            // Output width
-            this->WriteReg(MT9D111_REG_MICROCONTROLLER_VARIABLE_ADDRESS, MT9D111_DRIVER_VARIABLE_16_BIT_ACCESS |
-                                                                         MT9D111_DRIVER_PHYSICAL_ACCESS_ADDRESS_LOGICAL |
-                                                                         MT9D111_DRIVER_ID_MODE |
-                                                                         MT9D111_DRIVER_VAR_MODE_OUTPUT_WIDTH_A);
-            this->WriteReg(MT9D111_REG_MICROCONTROLLER_VARIABLE_DATA, width);
-
-            // Output height
-            this->WriteReg(MT9D111_REG_MICROCONTROLLER_VARIABLE_ADDRESS, MT9D111_DRIVER_VARIABLE_16_BIT_ACCESS |
-                                                                         MT9D111_DRIVER_PHYSICAL_ACCESS_ADDRESS_LOGICAL |
-                                                                         MT9D111_DRIVER_ID_MODE |
-                                                                         MT9D111_DRIVER_VAR_MODE_OUTPUT_HEIGHT_A);
-            this->WriteReg(MT9D111_REG_MICROCONTROLLER_VARIABLE_DATA, height);
+            DEBUG_MSG(this->debug, "PREVIEW mode...");
+            DEBUG_NEWLINE(this->debug);
+
+            // Output width and height
+            res = res and this->WriteDriverVars(MT9D111_DRIVER_ID_MODE, MT9D111_DRIVER_VAR_MODE_OUTPUT_WIDTH_A, vars, sizeof(vars));
 
             break;
         case MT9D111_MODE_CAPTURE:
-            this->debug->WriteMsg("CAPTURE mode...");
-            this->debug->NewLine();
-
-            // Output width
-            this->WriteReg(MT9D111_REG_MICROCONTROLLER_VARIABLE_ADDRESS, MT9D111_DRIVER_VARIABLE_16_BIT_ACCESS |
-                                                                         MT9D111_DRIVER_PHYSICAL_ACCESS_ADDRESS_LOGICAL |
-                                                                         MT9D111_DRIVER_ID_MODE |
-                                                                         MT9D111_DRIVER_VAR_MODE_OUTPUT_WIDTH_B);
-            this->WriteReg(MT9D111_REG_MICROCONTROLLER_VARIABLE_DATA, width);
-
-            // Output height
-            this->WriteReg(MT9D111_REG_MICROCONTROLLER_VARIABLE_ADDRESS, MT9D111_DRIVER_VARIABLE_16_BIT_ACCESS |
-                                                                         MT9D111_DRIVER_PHYSICAL_ACCESS_ADDRESS_LOGICAL |
-                                                                         MT9D111_DRIVER_ID_MODE |
-                                                                         MT9D111_DRIVER_VAR_MODE_OUTPUT_HEIGHT_B);
-            this->WriteReg(MT9D111_REG_MICROCONTROLLER_VARIABLE_DATA, height);
+            DEBUG_MSG(this->debug, "CAPTURE mode...");
+            DEBUG_NEWLINE(this->debug);
+
+            // Output width and height
+            res = res and this->WriteDriverVars(MT9D111_DRIVER_ID_MODE, MT9D111_DRIVER_VAR_MODE_OUTPUT_WIDTH_B, vars, sizeof(vars));
 
             break;
         default:
-            this->debug->WriteMsg("UNKNONW mode");
-            this->debug->NewLine();
+            DEBUG_MSG(this->debug, "UNKNONW mode");
+            DEBUG_NEWLINE(this->debug);
 
             return false;
     }
 
     // Sequencer command
-    this->SequencerCmd(MT9D111_DRIVER_VAR_SEQUENCER_CMD_REFRESH);
+    res = res and this->SequencerCmd(MT9D111_DRIVER_VAR_SEQUENCER_CMD_REFRESH);
 
-    return true;
+    if (!res)
+    {
+        LOG_ERROR("MT9D111", "Error configuring the resolution!");
+    }
+
+    return res;
 }
 
 bool MT9D111::SetSpecialEffects(uint8_t effect)
 {
-    this->debug->WriteEvent("Configuring special effects as ");
+    DEBUG_EVENT(this->debug, "Configuring special effects as ");
 
     this->SetRegisterPage(MT9D111_REG_PAGE_1);
 
     switch(effect)
     {
         case MT9D111_SPECIAL_EFFECTS_DISABLED:
-            this->debug->WriteMsg("DISABLED");
+            DEBUG_MSG(this->debug, "DISABLED");
             this->WriteReg(MT9D111_REG_SPECIAL_EFFECTS, MT9D111_SPECIAL_EFFECTS_DISABLED | (1 << 6));
             break;
         case MT9D111_SPECIAL_EFFECTS_MONOCHROME:
-            this->debug->WriteMsg("MONOCHROME");
+            DEBUG_MSG(this->debug, "MONOCHROME");
             this->WriteReg(MT9D111_REG_SPECIAL_EFFECTS, MT9D111_SPECIAL_EFFECTS_MONOCHROME | (1 << 6));
             break;
         case MT9D111_SPECIAL_EFFECTS_SEPIA:
-            this->debug->WriteMsg("SEPIA");
+            DEBUG_MSG(this->debug, "SEPIA");
             this->WriteReg(MT9D111_REG_SPECIAL_EFFECTS, MT9D111_SPECIAL_EFFECTS_SEPIA | (1 << 6));
             break;
         case MT9D111_SPECIAL_EFFECTS_NEGATIVE:
-            this->debug->WriteMsg("NEGATIVE");
+            DEBUG_MSG(this->debug, "NEGATIVE");
             this->WriteReg(MT9D111_REG_SPECIAL_EFFECTS, MT9D111_SPECIAL_EFFECTS_NEGATIVE | (1 << 6));
             break;
         case MT9D111_SPECIAL_EFFECTS_SOLARIZATION_WITH_UNMODIFIED_UV:
-            this->debug->WriteMsg("SOLARIZATION WITH UNMODIFIED UV");
+            DEBUG_MSG(this->debug, "SOLARIZATION WITH UNMODIFIED UV");
             this->WriteReg(MT9D111_REG_SPECIAL_EFFECTS, MT9D111_SPECIAL_EFFECTS_SOLARIZATION_WITH_UNMODIFIED_UV | (1 << 6));
             break;
         case MT9D111_SPECIAL_EFFECTS_SOLARIZATION_WITH_UV:
-            this->debug->WriteMsg("SOLARIZATION WITH UV");
+            DEBUG_MSG(this->debug, "SOLARIZATION WITH UV");
             this->WriteReg(MT9D111_REG_SPECIAL_EFFECTS, MT9D111_SPECIAL_EFFECTS_SOLARIZATION_WITH_UV | (1 << 6));
             break;
         default:
-            this->debug->WriteMsg("UNKNOWN");
+            DEBUG_NEWLINE(this->debug);
+
+            LOG_ERROR("MT9D111", "Invalid special effect! (%u)", effect);
+
             return false;
     }
 
-    this->debug->WriteMsg("...");
-    this->debug->NewLine();
+    DEBUG_MSG(this->debug, "...");
+    DEBUG_NEWLINE(this->debug);
 
     this->SetRegisterPage(MT9D111_REG_PAGE_1);
 
@@ -899,7 +2393,7 @@ bool MT9D111::SetSpecialEffects(uint8_t effect)
 
 bool MT9D111::SetAutoExposure(uint8_t state, uint8_t config)
 {
-    this->debug->WriteEvent("Configuring auto-exposure for ");
+    DEBUG_EVENT(this->debug, "Configuring auto-exposure for ");
 
     this->SetRegisterPage(MT9D111_REG_PAGE_1);
 
@@ -908,54 +2402,55 @@ bool MT9D111::SetAutoExposure(uint8_t state, uint8_t config)
     switch(state)
     {
         case MT9D111_STATE_PREVIEW_ENTER:
-            this->debug->WriteMsg("PREVIEW ENTER state as ");
+            DEBUG_MSG(this->debug, "PREVIEW ENTER state as ");
             seq_state = MT9D111_DRIVER_VAR_SEQUENCER_PREVIEW_PARAMS_0_AE;
             break;
         case MT9D111_STATE_PREVIEW:
-            this->debug->WriteMsg("PREVIEW state as ");
+            DEBUG_MSG(this->debug, "PREVIEW state as ");
             seq_state = MT9D111_DRIVER_VAR_SEQUENCER_PREVIEW_PARAMS_1_AE;
             break;
         case MT9D111_STATE_PREVIEW_LEAVE:
-            this->debug->WriteMsg("PREVIEW LEAVE state as ");
+            DEBUG_MSG(this->debug, "PREVIEW LEAVE state as ");
             seq_state = MT9D111_DRIVER_VAR_SEQUENCER_PREVIEW_PARAMS_2_AE;
             break;
         case MT9D111_STATE_CAPTURE_ENTER:
-            this->debug->WriteMsg("PREVIEW ENTER state as ");
+            DEBUG_MSG(this->debug, "PREVIEW ENTER state as ");
             seq_state = MT9D111_DRIVER_VAR_SEQUENCER_PREVIEW_PARAMS_3_AE;
             break;
         default:
-            this->debug->WriteMsg("UNKNOWN state as ");
+            DEBUG_NEWLINE(this->debug);
+
+            LOG_ERROR("MT9D111", "Invalid auto-exposure state! (%u)", state);
+
             return false;
     }
 
-    this->WriteReg(MT9D111_REG_MICROCONTROLLER_VARIABLE_ADDRESS, MT9D111_DRIVER_VARIABLE_8_BIT_ACCESS |
-                                                                 MT9D111_DRIVER_PHYSICAL_ACCESS_ADDRESS_LOGICAL |
-                                                                 MT9D111_DRIVER_ID_SEQUENCER |
-                                                                 seq_state);
-
     switch(config)
     {
         case MT9D111_AUTO_EXPOSURE_OFF:
-            this->debug->WriteMsg("OFF...");
+            DEBUG_MSG(this->debug, "OFF...");
             break;
         case MT9D111_AUTO_EXPOSURE_FAST_SETTLING:
-            this->debug->WriteMsg("FAST SETTLING...");
+            DEBUG_MSG(this->debug, "FAST SETTLING...");
             break;
         case MT9D111_AUTO_EXPOSURE_MANUAL:
-            this->debug->WriteMsg("MANUAL...");
+            DEBUG_MSG(this->debug, "MANUAL...");
             break;
         case MT9D111_AUTO_EXPOSURE_CONTINUOUS:
-            this->debug->WriteMsg("CONTINUOUS...");
+            DEBUG_MSG(this->debug, "CONTINUOUS...");
             break;
         case MT9D111_AUTO_EXPOSURE_FAST_SETTLING_PLUS_METERING:
-            this->debug->WriteMsg("FAST SETTLING + METERING...");
+            DEBUG_MSG(this->debug, "FAST SETTLING + METERING...");
             break;
         default:
-            this->debug->WriteMsg("UNKNOWN...");
+            DEBUG_NEWLINE(this->debug);
+
+            LOG_ERROR("MT9D111", "Invalid auto-exposure configuration! (%u)", config);
+
             return false;
     }
 
-    this->WriteReg(MT9D111_REG_MICROCONTROLLER_VARIABLE_DATA, config);
+    this->WriteDriverVars(MT9D111_DRIVER_ID_SEQUENCER, seq_state, &config, 1);
 
     // Sequencer command
     this->SequencerCmd(MT9D111_DRIVER_VAR_SEQUENCER_CMD_REFRESH);
@@ -1001,50 +2496,132 @@ bool MT9D111::SetSpoofFrames(bool en, uint16_t width, uint16_t height)
 
 bool MT9D111::SequencerCmd(uint8_t cmd)
 {
-    this->debug->WriteEvent("Executing sequencer command ");
+    DEBUG_EVENT(this->debug, "Executing sequencer command ");
 
     // Checking if the cmd is valid
     switch(cmd)
     {
         case MT9D111_DRIVER_VAR_SEQUENCER_CMD_RUN:
-            this->debug->WriteMsg("RUN");
+            DEBUG_MSG(this->debug, "RUN");
             break;
         case MT9D111_DRIVER_VAR_SEQUENCER_CMD_DO_PREVIEW:
-            this->debug->WriteMsg("DO PREVIEW");
+            DEBUG_MSG(this->debug, "DO PREVIEW");
             break;
         case MT9D111_DRIVER_VAR_SEQUENCER_CMD_DO_CAPTURE:
-            this->debug->WriteMsg("DO CAPTURE");
+            DEBUG_MSG(this->debug, "DO CAPTURE");
             break;
         case MT9D111_DRIVER_VAR_SEQUENCER_CMD_DO_STANDBY:
-            this->debug->WriteMsg("DO STANDBY");
+            DEBUG_MSG(this->debug, "DO STANDBY");
             break;
         case MT9D111_DRIVER_VAR_SEQUENCER_CMD_DO_LOCK:
-            this->debug->WriteMsg("DO LOCK");
+            DEBUG_MSG(this->debug, "DO LOCK");
             break;
         case MT9D111_DRIVER_VAR_SEQUENCER_CMD_REFRESH:
-            this->debug->WriteMsg("REFRESH");
+            DEBUG_MSG(this->debug, "REFRESH");
             break;
         case MT9D111_DRIVER_VAR_SEQUENCER_CMD_REFRESH_MODE:
-            this->debug->WriteMsg("REFRESH MODE");
+            DEBUG_MSG(this->debug, "REFRESH MODE");
             break;
         default:
-            this->debug->WriteMsg("UNKNOWN");
+            DEBUG_NEWLINE(this->debug);
+
+            LOG_ERROR("MT9D111", "Invalid sequencer command! (%u)", cmd);
+
             return false;
     }
 
-    this->debug->WriteMsg("...");
-    this->debug->NewLine();
+    DEBUG_MSG(this->debug, "...");
+    DEBUG_NEWLINE(this->debug);
 
-    this->SetRegisterPage(MT9D111_REG_PAGE_0);
+    return this->WriteDriverVars(MT9D111_DRIVER_ID_SEQUENCER, MT9D111_DRIVER_VAR_SEQUENCER_CMD, &cmd, 1);
+}
+
+bool MT9D111::WaitSequencerState(uint8_t state, unsigned int timeout_ms, uint32_t *latency_us)
+{
+    DEBUG_EVENT(this->debug, "Waiting for sequencer state ");
+    DEBUG_DEC(this->debug, state);
+    DEBUG_MSG(this->debug, "...");
+    DEBUG_NEWLINE(this->debug);
+
+    if (timeout_ms > 0xFFFF)
+    {
+        timeout_ms = 0xFFFF;
+    }
+
+    Op op = MT9D111_OP_POLL_VAR8(MT9D111_DRIVER_ID_SEQUENCER, MT9D111_DRIVER_VAR_SEQUENCER_STATE, state, (uint16_t)timeout_ms);
+
+    // The state can only change on a frame boundary (a null frame period must not disable the backoff)
+    unsigned int min_interval_us = this->frame_period_us/8;
+    if (min_interval_us < MT9D111_OP_POLL_MIN_INTERVAL_US)
+    {
+        min_interval_us = MT9D111_OP_POLL_MIN_INTERVAL_US;
+    }
+
+    unsigned int max_interval_us = this->frame_period_us;
+    if (max_interval_us < min_interval_us)
+    {
+        max_interval_us = min_interval_us;
+    }
+
+    return this->Poll(op, latency_us, min_interval_us, max_interval_us);
+}
 
-    // Driver variable address
-    this->WriteReg(MT9D111_REG_MICROCONTROLLER_VARIABLE_ADDRESS, MT9D111_DRIVER_VARIABLE_8_BIT_ACCESS |
-                                                                 MT9D111_DRIVER_PHYSICAL_ACCESS_ADDRESS_LOGICAL |
-                                                                 MT9D111_DRIVER_ID_SEQUENCER |
-                                                                 MT9D111_DRIVER_VAR_SEQUENCER_CMD);
+void MT9D111::SetFramePeriod(uint32_t period_us)
+{
+    this->frame_period_us = period_us;
+}
+
+uint32_t MT9D111::GetFramePeriod()
+{
+    return this->frame_period_us;
+}
+
+void MT9D111::SetPixelClock(uint32_t hz)
+{
+    this->pixel_clock_hz = hz;
+}
+
+bool MT9D111::UpdateFramePeriod(uint8_t mode)
+{
+    bool ctx_b = (mode == MT9D111_MODE_CAPTURE);
+
+    uint16_t height, width, hblank, vblank, read_mode;
+
+    if (!this->SetRegisterPage(MT9D111_REG_PAGE_0))
+    {
+        return false;
+    }
+
+    if (!(this->ReadReg(MT9D111_REG_ROW_WIDTH, &height) and
+          this->ReadReg(MT9D111_REG_COL_WIDTH, &width) and
+          this->ReadReg(ctx_b? MT9D111_REG_HORIZONTAL_BLANKING_B : MT9D111_REG_HORIZONTAL_BLANKING_A, &hblank) and
+          this->ReadReg(ctx_b? MT9D111_REG_VERTICAL_BLANKING_B : MT9D111_REG_VERTICAL_BLANKING_A, &vblank) and
+          this->ReadReg(ctx_b? MT9D111_REG_READ_MODE_B : MT9D111_REG_READ_MODE_A, &read_mode)))
+    {
+        return false;
+    }
+
+    // Skip factors: 2^(field + 1) when enabled
+    if (read_mode & (1 << 7))
+    {
+        width >>= ((read_mode >> 5) & 0x03) + 1;
+    }
+
+    if (read_mode & (1 << 4))
+    {
+        height >>= ((read_mode >> 2) & 0x03) + 1;
+    }
+
+    uint64_t clocks = (uint64_t)(width + (hblank & 0x3FFF))*(uint64_t)(height + (vblank & 0x7FFF));
+
+    if ((clocks == 0) or (this->pixel_clock_hz == 0))
+    {
+        return false;
+    }
 
-    // Driver variable data
-    this->WriteReg(MT9D111_REG_MICROCONTROLLER_VARIABLE_DATA, cmd);
+    this->frame_period_us = (uint32_t)((clocks*1000000ULL)/this->pixel_clock_hz);
+
+    LOG_DEBUG("MT9D111", "Frame period: %u us", this->frame_period_us);
 
     return true;
 }
@@ -1193,15 +2770,15 @@ bool MT9D111::SetColSkipping(uint8_t context, uint8_t skip)
 
 bool MT9D111::SetNumberOfADCs(uint8_t context, uint8_t adcs)
 {
-    this->debug->WriteEvent("Configuring the number of ADCs for ");
+    DEBUG_EVENT(this->debug, "Configuring the number of ADCs for ");
 
     switch(context)
     {
         case MT9D111_MODE_PREVIEW:
-            this->debug->WriteMsg("PREVIEW mode as ");
-            this->debug->WriteDec(adcs);
-            this->debug->WriteMsg("...");
-            this->debug->NewLine();
+            DEBUG_MSG(this->debug, "PREVIEW mode as ");
+            DEBUG_DEC(this->debug, adcs);
+            DEBUG_MSG(this->debug, "...");
+            DEBUG_NEWLINE(this->debug);
 
             switch(adcs)
             {
@@ -1217,10 +2794,10 @@ bool MT9D111::SetNumberOfADCs(uint8_t context, uint8_t adcs)
 
             break;
         case MT9D111_MODE_CAPTURE:
-            this->debug->WriteMsg("CAPTURE mode as ");
-            this->debug->WriteDec(adcs);
-            this->debug->WriteMsg("...");
-            this->debug->NewLine();
+            DEBUG_MSG(this->debug, "CAPTURE mode as ");
+            DEBUG_DEC(this->debug, adcs);
+            DEBUG_MSG(this->debug, "...");
+            DEBUG_NEWLINE(this->debug);
 
             switch(adcs)
             {
@@ -1236,8 +2813,9 @@ bool MT9D111::SetNumberOfADCs(uint8_t context, uint8_t adcs)
 
             break;
         default:
-            this->debug->WriteMsg("UNKNOWN mode!");
-            this->debug->NewLine();
+            DEBUG_NEWLINE(this->debug);
+
+            LOG_ERROR("MT9D111", "Invalid context! (%u)", context);
 
             return false;
     }
@@ -37,14 +37,21 @@
 #define MT9D111_H_
 
 #include <stdint.h>
+#include <stddef.h>
 
 #include "debug.h"
 #include "i2c.h"
+#include "i2c_stats.h"
 #include "gpio.h"
+#include "transport.h"
+#include "mt9d111_reg.h"
+#include "mt9d111_driver.h"
+#include "mt9d111_op.h"
+#include "mt9d111_profile.h"
 
 // I2C addresses
 #define MT9D111_CONFIG_I2C_ADR_LOW                                  0x48
-#define MT9D111_CONFIG_I2C_ADR_HIGH                                 0xBA
+#define MT9D111_CONFIG_I2C_ADR_HIGH                                 0x5D
 
 #define MT9D111_CONFIG_I2C_ID                                       MT9D111_CONFIG_I2C_ADR_LOW
 
@@ -110,6 +117,28 @@
 #define MT9D111_SKIP_8X                                             2
 #define MT9D111_SKIP_16X                                            3
 
+// Profiles
+#define MT9D111_PROFILE_QVGA_30FPS                                  0
+
+// Driver variables
+#define MT9D111_DRIVER_VARS_SIZE                                    256     // Variables offsets per driver (8-bit offset)
+#define MT9D111_DRIVER_IDS                                          32      // Number of driver IDs (5-bit ID)
+
+// Sequencer
+#define MT9D111_DEFAULT_FRAME_PERIOD_US                             33333   // 30 fps
+#define MT9D111_DEFAULT_PIXEL_CLOCK_HZ                              80000000    // PLL target (see "EnablePLL")
+#define MT9D111_SEQUENCER_STATE_TIMEOUT_MS                          1000
+#define MT9D111_RETRY_BACKOFF_MIN_US                                100     // First wait after a transient bus error
+#define MT9D111_RETRY_BACKOFF_MAX_US                                10000
+
+// Write verification policies
+#define MT9D111_VERIFY_NEVER                                        0       // No read back
+#define MT9D111_VERIFY_ALWAYS                                       1       // Read back every write
+#define MT9D111_VERIFY_SAMPLED                                      2       // Read back one of each MT9D111_VERIFY_SAMPLE_PERIOD writes
+#define MT9D111_VERIFY_DEFERRED                                     3       // Read back a whole list of registers in a single transfer
+#define MT9D111_VERIFY_SAMPLE_PERIOD                                8
+#define MT9D111_DEFAULT_VERIFY_POLICY                               MT9D111_VERIFY_DEFERRED
+
 /**
  * \brief Class to implement the Micron MT9D111 image sensor.
  */
@@ -117,10 +146,193 @@ class MT9D111
 {
     private:
         Debug *debug;   /**< Debug class. */
-        I2C *i2c;       /**< I2C device. */
+        Transport *i2c; /**< Registers bus. */
         bool is_open;   /**< Flag to indicate if the I2C communication is open or not. */
-        GPIO *reset;    /**< RESET pin. */
-        GPIO *standby;  /**< STANDBY pin. */
+        bool owns_io;   /**< Flag to indicate if the bus and the pins were created (and must be deleted) by the object. */
+        Pin *reset;     /**< RESET pin. */
+        Pin *standby;   /**< STANDBY pin. */
+        Pin *frame_valid;   /**< FRAME_VALID pin (optional, input). */
+
+        uint16_t reg_cache[MT9D111_REG_PAGES][MT9D111_REG_PAGE_SIZE];       /**< Shadow copy of the registers values. */
+        bool reg_cache_valid[MT9D111_REG_PAGES][MT9D111_REG_PAGE_SIZE];     /**< Valid flags of the shadow registers. */
+        uint8_t active_page;                                                /**< Currently selected registers page. */
+        unsigned long page_switches_saved;                                  /**< Number of skipped page selections. */
+        uint32_t frame_period_us;                                           /**< Current frame period, in microseconds. */
+        uint32_t pixel_clock_hz;                                            /**< Pixel clock frequency, in Hz. */
+        uint8_t standby_mode;                                               /**< Mode to restore when leaving the standby mode. */
+        uint8_t gpio_backend;                                               /**< Backend of the RESET and STANDBY pins. */
+        I2CStats stats;                                                     /**< I2C transactions statistics. */
+        uint8_t verify_policy;                                              /**< Default write verification policy. */
+        unsigned long verify_count;                                         /**< Number of writes with the sampled policy. */
+
+        /**
+         * \brief Initializes the members (common part of the constructors).
+         *
+         * \return None.
+         */
+        void Init();
+
+        /**
+         * \brief Invalidates all the shadow registers.
+         *
+         * \return None.
+         */
+        void InvalidateRegCache();
+
+        /**
+         * \brief Loads a list of known registers values into the shadow registers.
+         *
+         * \param[in] regs is an array of registers (address, page and value).
+         * \param[in] len is the number of registers in the array.
+         *
+         * \return None.
+         */
+        void LoadRegCache(const Register *regs, unsigned int len);
+
+        /**
+         * \brief Updates the shadow copy of a register of the current page.
+         *
+         * \param[in] adr is the address of the register.
+         * \param[in] val is the new value of the register.
+         *
+         * \return None.
+         */
+        void UpdateRegCache(uint8_t adr, uint16_t val);
+
+        /**
+         * \brief Gets the currently selected registers page.
+         *
+         * \param[in,out] page is a pointer to store the current page.
+         *
+         * \return TRUE/FALSE if the current page is known or not.
+         */
+        bool GetCachedPage(uint8_t *page);
+
+        /**
+         * \brief Checks if a register can change without a write from the host.
+         *
+         * Read-only and status registers (frame and line counters, JPEG status, statistics, etc.), registers updated
+         * by the firmware (AE, AWB) and self-clearing registers are never cached (see mt9d111_reg_desc.h).
+         *
+         * \param[in] page is the page of the register.
+         * \param[in] adr is the address of the register.
+         *
+         * \return TRUE/FALSE if the register is volatile or not.
+         */
+        bool IsVolatileReg(uint8_t page, uint8_t adr);
+
+        /**
+         * \brief Reads the value of a register directly from the device (bypassing the shadow registers).
+         *
+         * \param[in] adr is the address of the register.
+         * \param[in,out] val is a pointer to store the value of the register.
+         *
+         * \return TRUE/FALSE if the reading was successful or not.
+         */
+        bool ReadRegDirect(uint8_t adr, uint16_t *val);
+
+        /**
+         * \brief Waits before retrying a failed transaction, according to the class of the last bus error.
+         *
+         * \param[in,out] backoff_us is the current wait time (doubled at each call, up to MT9D111_RETRY_BACKOFF_MAX_US).
+         *
+         * \return TRUE if the error is transient and the transaction can be retried, FALSE otherwise.
+         */
+        bool BackoffAfterError(unsigned int *backoff_us);
+
+        /**
+         * \brief Reads a list of registers directly from the device.
+         *
+         * Consecutive entries of the same page are read with a single combined I2C transfer (I2C_RDWR). The shadow
+         * registers are updated with the read values.
+         *
+         * \param[in] regs is an array of registers (only the address and the page are used).
+         * \param[in] len is the number of registers in the array.
+         * \param[in,out] vals is an array of len values to store the registers values.
+         *
+         * \return TRUE/FALSE if the reading was successful or not.
+         */
+        bool ReadRegsDirect(const Register *regs, size_t len, uint16_t *vals);
+
+        /**
+         * \brief Checks if a write must be read back, according to a verification policy.
+         *
+         * The volatile and self-clearing registers (see "IsVolatileReg"), as MT9D111_REG_RESET or the driver variables
+         * data register (used to write the sequencer commands), are never verified.
+         *
+         * \param[in] page is the page of the register.
+         * \param[in] adr is the address of the register.
+         * \param[in] policy is the verification policy (MT9D111_VERIFY_*).
+         *
+         * \return TRUE/FALSE if the write must be verified or not.
+         */
+        bool NeedsVerify(uint8_t page, uint8_t adr, uint8_t policy);
+
+        /**
+         * \brief Swaps the byte order of the multi-byte fields of a driver structure (big-endian <-> host).
+         *
+         * \param[in,out] data is the raw content of the structure.
+         * \param[in] fields is the list of multi-byte fields of the structure.
+         * \param[in] fields_len is the number of entries in the list of fields.
+         *
+         * \return None.
+         */
+        void SwapDriverFields(uint8_t *data, const DriverVarField *fields, size_t fields_len);
+
+        /**
+         * \brief Reads a whole driver structure with burst transfers.
+         *
+         * \param[in] driver_id is the driver ID.
+         * \param[in,out] data is the structure to store the variables.
+         * \param[in] len is the size of the structure.
+         * \param[in] fields is the list of multi-byte fields of the structure.
+         * \param[in] fields_len is the number of entries in the list of fields.
+         *
+         * \return TRUE/FALSE if the reading was successful or not.
+         */
+        bool ReadDriverBlock(uint16_t driver_id, uint8_t *data, size_t len, const DriverVarField *fields, size_t fields_len);
+
+        /**
+         * \brief Writes a whole driver structure with burst transfers (skipping the VMT pointer).
+         *
+         * \param[in] driver_id is the driver ID.
+         * \param[in] data is the structure with the variables.
+         * \param[in] len is the size of the structure.
+         * \param[in] fields is the list of multi-byte fields of the structure.
+         * \param[in] fields_len is the number of entries in the list of fields.
+         * \param[in] skip is the list of variables that are not written (commands, states and status), or NULL.
+         * \param[in] skip_len is the number of entries in the list of skipped variables.
+         *
+         * \return TRUE/FALSE if the writing was successful or not.
+         */
+        bool WriteDriverBlock(uint16_t driver_id, const uint8_t *data, size_t len, const DriverVarField *fields, size_t fields_len,
+                              const DriverVarRange *skip=NULL, size_t skip_len=0);
+
+        /**
+         * \brief Reads the register or driver variable targeted by an operation.
+         *
+         * \param[in] op is the operation.
+         * \param[in,out] val is a pointer to store the read value.
+         *
+         * \return TRUE/FALSE if the reading was successful or not.
+         */
+        bool ReadOpTarget(const Op &op, uint16_t *val);
+
+        /**
+         * \brief Executes a polling operation (MT9D111_OP_POLL_EQ or MT9D111_OP_POLL_MASK).
+         *
+         * The target is read with an exponential backoff interval (from min_interval_us to max_interval_us)
+         * until the condition is reached or the timeout expires.
+         *
+         * \param[in] op is the polling operation.
+         * \param[in,out] latency_us is a pointer to store the elapsed time until the condition was reached (can be NULL).
+         * \param[in] min_interval_us is the first polling interval, in microseconds.
+         * \param[in] max_interval_us is the maximum polling interval, in microseconds.
+         *
+         * \return TRUE/FALSE if the condition was reached or not.
+         */
+        bool Poll(const Op &op, uint32_t *latency_us=NULL, unsigned int min_interval_us=MT9D111_OP_POLL_MIN_INTERVAL_US,
+                  unsigned int max_interval_us=MT9D111_OP_POLL_MAX_INTERVAL_US);
 
         /**
          * \brief Reads the value of a bit from a register.
@@ -254,10 +466,22 @@ class MT9D111
          * With this constructor, the I2C communication is enable and the device becomes ready to work.
          *
          * \param[in] dev_adr is the I2C device address.
+         * \param[in] i2c_adr is the I2C slave address (MT9D111_CONFIG_I2C_ADR_LOW or MT9D111_CONFIG_I2C_ADR_HIGH).
+         *
+         * \return None.
+         */
+        MT9D111(const char *dev_adr, uint8_t i2c_adr=MT9D111_CONFIG_I2C_ID);
+
+        /**
+         * \brief Constructor with an external bus and external pins.
+         *
+         * \param[in] bus is the registers bus of the sensor.
+         * \param[in] rst is the RESET pin.
+         * \param[in] stby is the STANDBY pin.
          *
          * \return None.
          */
-        MT9D111(const char *dev_adr);
+        MT9D111(Transport *bus, Pin *rst, Pin *stby);
 
         /**
          * \brief Destructor.
@@ -269,11 +493,64 @@ class MT9D111
         /**
          * \brief Opens the communication with the sensor.
          *
+         * The I2C adapter is shared with the other sensors opened on the same device (see I2CBus), so two sensors
+         * with different slave addresses can be used at the same time from different threads.
+         *
          * \param[in] dev_adr is the I2C device address.
+         * \param[in] i2c_adr is the I2C slave address (MT9D111_CONFIG_I2C_ADR_LOW or MT9D111_CONFIG_I2C_ADR_HIGH).
+         *
+         * \return TRUE/FALSE if successful or not.
+         */
+        bool Open(const char *dev_adr, uint8_t i2c_adr=MT9D111_CONFIG_I2C_ID);
+
+        /**
+         * \brief Opens the communication with the sensor over an external bus and external pins.
+         *
+         * It allows to use other transports than the Linux I2C and GPIO drivers (ex.: MT9D111Sim). The bus and the
+         * pins are not deleted by the object, and must be valid until "Close" is called.
+         *
+         * \param[in] bus is the registers bus of the sensor.
+         * \param[in] rst is the RESET pin.
+         * \param[in] stby is the STANDBY pin.
+         *
+         * \return TRUE/FALSE if successful or not.
+         */
+        bool Open(Transport *bus, Pin *rst, Pin *stby);
+
+        /**
+         * \brief Selects the backend of the RESET and STANDBY pins.
+         *
+         * The new backend is used in the next call to "Open".
+         *
+         * \param[in] backend is the GPIO backend (GPIO_BACKEND_SYSFS or GPIO_BACKEND_CHARDEV).
+         *
+         * \return None.
+         */
+        void SetGPIOBackend(uint8_t backend);
+
+        /**
+         * \brief Opens a GPIO connected to the FRAME_VALID output of the sensor.
+         *
+         * FRAME_VALID is HIGH while the rows of a frame are being read out, so its falling edge marks the start of
+         * the vertical blanking interval.
+         *
+         * \param[in] pin is the GPIO pin number.
          *
          * \return TRUE/FALSE if successful or not.
          */
-        bool Open(const char *dev_adr);
+        bool OpenFrameValid(uint8_t pin);
+
+        /**
+         * \brief Waits for the start of the vertical blanking (falling edge of FRAME_VALID).
+         *
+         * It can be used to apply register updates between frames. "OpenFrameValid" must be called first.
+         *
+         * \param[in] timeout_ms is the maximum waiting time in milliseconds (-1 to wait forever).
+         * \param[in,out] timestamp is a pointer to store the time of the edge in nanoseconds (can be NULL).
+         *
+         * \return TRUE/FALSE if the edge was detected or not.
+         */
+        bool WaitVerticalBlanking(int timeout_ms, uint64_t *timestamp=NULL);
 
         /**
          * \brief Closes the communication with the sensor.
@@ -351,6 +628,9 @@ class MT9D111
          *          R0x0D:0[2] = 1 instead.
          *     .
          *
+         * The current mode is recorded before issuing the DO_STANDBY command, to be restored by "LeaveStandby".
+         * The standby (pin or register) is always asserted, even if the firmware does not reach the standby state.
+         *
          * \see MT9D131 Developer Guide. Standby Sequence. Page 13.
          *
          * \param[in] type is the type of standby to enter (MT9D111_STANDBY_HARD or MT9D111_STANDBY_SOFT).
@@ -371,9 +651,9 @@ class MT9D111
          *                   standby was used.
          *              .
          *     - 2) Reconfiguring output pads:
-         *              - a) Go to preview.
-         *              - b) Issue a GO_PREVIEW command to the firmware by setting seq.cmd = 1.
-         *              - c) Poll seq.state until the current state is preview (seq.state = 3).
+         *              - a) Go back to the mode recorded by "EnterStandby" (preview or capture).
+         *              - b) Issue a GO_PREVIEW (seq.cmd = 1) or GO_CAPTURE (seq.cmd = 2) command to the firmware.
+         *              - c) Poll seq.state until the current state is preview (seq.state = 3) or capture (seq.state = 7).
          *              .
          *     - 3) The following timing requirements should be met to turn off EXTCLK during hard standby:
          *              - a) After the asserting standby, wait 10 clock cycles before stopping the clock.
@@ -392,6 +672,9 @@ class MT9D111
         /**
          * \brief Reads the value of a register of the device.
          *
+         * If the register is not volatile and its shadow copy is valid, the value is returned without
+         * accessing the bus.
+         *
          * \param[in] adr is the address of the register.
          * \param[in,out] val is a pointer to store the value of the register.
          *
@@ -400,7 +683,7 @@ class MT9D111
         bool ReadReg(uint8_t adr, uint16_t *val);
 
         /**
-         * \brief Verifies the value of a register.
+         * \brief Verifies the value of a register (always reading it from the device).
          *
          * \param[in] adr is the address of the register.
          * \param[in] val is the expected value of the register.
@@ -422,6 +705,9 @@ class MT9D111
         /**
          * \brief Writes a value to a register of the device and verifies its value.
          *
+         * Only the transient bus errors (EAGAIN, EREMOTEIO, ...) and real mismatches are retried. Fatal errors (ENODEV,
+         * ...) abort immediately.
+         *
          * \param[in] adr is the address of the register.
          * \param[in] val is the value to write into the register.
          * \param[in] attempts is the number of attempts to try writing to a register in case of failure.
@@ -430,6 +716,367 @@ class MT9D111
          */
         bool WriteAndCheckReg(uint8_t adr, uint16_t val, unsigned int attempts=5);
 
+        /**
+         * \brief Writes a list of registers values (without verification).
+         *
+         * Consecutive entries of the same page are sent as a single combined I2C transfer (I2C_RDWR). Entries of
+         * the page register are ignored, since the page of each entry is selected automatically.
+         *
+         * \param[in] regs is an array of registers (address, page and value).
+         * \param[in] len is the number of registers in the array.
+         *
+         * \return TRUE/FALSE if the writing was successful or not.
+         */
+        bool WriteRegs(const Register *regs, size_t len);
+
+        /**
+         * \brief Writes a value to a register of the device, verifying it according to a policy.
+         *
+         * A single write has no batch to be deferred to, so MT9D111_VERIFY_DEFERRED verifies it immediately.
+         *
+         * \param[in] adr is the address of the register.
+         * \param[in] val is the value to write into the register.
+         * \param[in] policy is the verification policy (MT9D111_VERIFY_*).
+         *
+         * \return TRUE/FALSE if the writing was successful or not.
+         */
+        bool WriteAndVerifyReg(uint8_t adr, uint16_t val, uint8_t policy);
+
+        /**
+         * \brief Reads back a list of registers and compares them with the expected values.
+         *
+         * The registers of each page are read in a single combined I2C transfer (I2C_RDWR). The volatile registers
+         * and the entries of the page register are skipped.
+         *
+         * \param[in] regs is an array of registers (address, page and expected value).
+         * \param[in] len is the number of registers in the array.
+         * \param[in,out] mismatch is an array of len flags to mark the registers with a different value (can be NULL).
+         * \param[in,out] mismatches is a pointer to store the number of registers with a different value (can be NULL).
+         *
+         * \return TRUE/FALSE if the reading was successful or not (a mismatch is not an error).
+         */
+        bool VerifyRegs(const Register *regs, size_t len, bool *mismatch=NULL, unsigned int *mismatches=NULL);
+
+        /**
+         * \brief Sets the default write verification policy.
+         *
+         * This policy is used by "Config", "SetRegisterPage", "EnablePLL" and "SoftReset".
+         *
+         * \param[in] policy is the verification policy (MT9D111_VERIFY_*).
+         *
+         * \return None.
+         */
+        void SetVerifyPolicy(uint8_t policy);
+
+        /**
+         * \brief Gets the default write verification policy.
+         *
+         * \return The verification policy (MT9D111_VERIFY_*).
+         */
+        uint8_t GetVerifyPolicy();
+
+        /**
+         * \brief Executes a list of operations (usually generated by "CompileRegs").
+         *
+         * The consecutive write operations (registers and driver variables) are sent together with "WriteRegs",
+         * in batches of up to MT9D111_OP_RUN_BATCH_LEN registers (no memory is allocated).
+         * Delays, polls and barriers flush the pending writes before being executed. A delay immediately
+         * followed by a poll is not slept: the poll starts at once and the delay is added to its timeout.
+         *
+         * \param[in] ops is an array of operations.
+         * \param[in] len is the number of operations in the array.
+         *
+         * \return TRUE/FALSE if the execution was successful or not.
+         */
+        bool Run(const Op *ops, size_t len);
+
+        /**
+         * \brief Executes a compiled list of operations.
+         *
+         * \param[in] list is the list of operations.
+         *
+         * \return TRUE/FALSE if the execution was successful or not.
+         */
+        template<size_t N>
+        bool Run(const OpList<N> &list)
+        {
+            return this->Run(list.ops, list.len);
+        }
+
+        /**
+         * \brief Loads a predefined configuration profile.
+         *
+         * \param[in] profile is the profile to load. It can be:
+         * \parblock
+         *      - MT9D111_PROFILE_QVGA_30FPS
+         *      .
+         * \endparblock
+         *
+         * \return TRUE/FALSE if successful or not.
+         */
+        bool LoadProfile(uint8_t profile);
+
+        /**
+         * \brief Applies a registers table, writing only the registers that differ from the current values.
+         *
+         * The table is compared with the shadow registers. The cacheable registers of the table that are not in the
+         * shadow copy are read back first, with one combined I2C transfer per page. The changed registers are then
+         * grouped by page (between delays and barriers) and sent with the fewest transfers. Volatile registers,
+         * driver variables accesses and barriers (see "OpIsBarrier") are always written.
+         *
+         * \param[in] regs is the registers table (the same format of "WriteRegs").
+         * \param[in] len is the number of entries of the table.
+         *
+         * \return TRUE/FALSE if successful or not.
+         */
+        bool ApplyProfile(const Register *regs, size_t len);
+
+        /**
+         * \brief Loads a binary configuration profile (see mt9d111_profile.h).
+         *
+         * The records are used directly from the memory mapping of the profile. The runs of registers are applied with
+         * "ApplyProfile" (only the changed registers are written) and the driver variables blocks with
+         * "WriteDriverVars".
+         *
+         * \param[in] profile is an opened profile.
+         *
+         * \return TRUE/FALSE if successful or not.
+         */
+        bool LoadProfile(const MT9D111Profile &profile);
+
+        /**
+         * \brief Writes a sequence of consecutive driver variables (firmware variables).
+         *
+         * The variable address is written once to R198:1 and the data is streamed through the burst register
+         * (R201:1) in a single transfer (the microcontroller increments the variable address after each byte). An odd
+         * last byte is written through R200:1. Multi-byte variables must be given in big-endian order (MSB first), as
+         * they are stored in the microcontroller memory.
+         *
+         * The block cannot cross the end of the driver structure ("offset" + "len" <= MT9D111_DRIVER_VARS_SIZE).
+         *
+         * \see MT9D111 Datasheet. Registers R198:1, R200:1 and R201:1.
+         *
+         * \param[in] driver_id is the driver ID (MT9D111_DRIVER_ID_MONITOR, MT9D111_DRIVER_ID_SEQUENCER, etc.).
+         * \param[in] offset is the offset of the first variable in the driver structure.
+         * \param[in] data is the data to write.
+         * \param[in] len is the number of bytes to write.
+         *
+         * \return TRUE/FALSE if the writing was successful or not.
+         */
+        bool WriteDriverVars(uint16_t driver_id, uint8_t offset, const uint8_t *data, size_t len);
+
+        /**
+         * \brief Reads a sequence of consecutive driver variables (firmware variables).
+         *
+         * \note See "WriteDriverVars" for more details about the burst access.
+         *
+         * \param[in] driver_id is the driver ID (MT9D111_DRIVER_ID_MONITOR, MT9D111_DRIVER_ID_SEQUENCER, etc.).
+         * \param[in] offset is the offset of the first variable in the driver structure.
+         * \param[in,out] data is a pointer to store the read data.
+         * \param[in] len is the number of bytes to read.
+         *
+         * \return TRUE/FALSE if the reading was successful or not.
+         */
+        bool ReadDriverVars(uint16_t driver_id, uint8_t offset, uint8_t *data, size_t len);
+
+        /**
+         * \brief Reads all the variables of the monitor driver.
+         *
+         * \param[in,out] mon is the structure to store the variables.
+         *
+         * \return TRUE/FALSE if the reading was successful or not.
+         */
+        bool ReadDriver(Monitor &mon);
+
+        /**
+         * \brief Writes all the variables of the monitor driver (except the VMT pointer, mon.cmd and the status).
+         *
+         * \param[in] mon is the structure with the variables (usually obtained with "ReadDriver").
+         *
+         * \return TRUE/FALSE if the writing was successful or not.
+         */
+        bool WriteDriver(const Monitor &mon);
+
+        /**
+         * \brief Reads all the variables of the sequencer driver.
+         *
+         * \param[in,out] seq is the structure to store the variables.
+         *
+         * \return TRUE/FALSE if the reading was successful or not.
+         */
+        bool ReadDriver(Sequencer &seq);
+
+        /**
+         * \brief Writes all the variables of the sequencer driver (except the VMT pointer, seq.cmd and seq.state).
+         *
+         * \param[in] seq is the structure with the variables (usually obtained with "ReadDriver").
+         *
+         * \return TRUE/FALSE if the writing was successful or not.
+         */
+        bool WriteDriver(const Sequencer &seq);
+
+        /**
+         * \brief Reads all the variables of the auto exposure driver.
+         *
+         * \param[in,out] ae is the structure to store the variables.
+         *
+         * \return TRUE/FALSE if the reading was successful or not.
+         */
+        bool ReadDriver(AutoExposure &ae);
+
+        /**
+         * \brief Writes all the variables of the auto exposure driver (except the VMT pointer).
+         *
+         * \param[in] ae is the structure with the variables (usually obtained with "ReadDriver").
+         *
+         * \return TRUE/FALSE if the writing was successful or not.
+         */
+        bool WriteDriver(const AutoExposure &ae);
+
+        /**
+         * \brief Reads all the variables of the auto white balance driver.
+         *
+         * \param[in,out] awb is the structure to store the variables.
+         *
+         * \return TRUE/FALSE if the reading was successful or not.
+         */
+        bool ReadDriver(AutoWhiteBalance &awb);
+
+        /**
+         * \brief Writes all the variables of the auto white balance driver (except the VMT pointer).
+         *
+         * \param[in] awb is the structure with the variables (usually obtained with "ReadDriver").
+         *
+         * \return TRUE/FALSE if the writing was successful or not.
+         */
+        bool WriteDriver(const AutoWhiteBalance &awb);
+
+        /**
+         * \brief Reads all the variables of the flicker detection driver.
+         *
+         * \param[in,out] fd is the structure to store the variables.
+         *
+         * \return TRUE/FALSE if the reading was successful or not.
+         */
+        bool ReadDriver(FlickerDetection &fd);
+
+        /**
+         * \brief Writes all the variables of the flicker detection driver (except the VMT pointer).
+         *
+         * \param[in] fd is the structure with the variables (usually obtained with "ReadDriver").
+         *
+         * \return TRUE/FALSE if the writing was successful or not.
+         */
+        bool WriteDriver(const FlickerDetection &fd);
+
+        /**
+         * \brief Reads all the variables of the auto focus driver.
+         *
+         * \param[in,out] af is the structure to store the variables.
+         *
+         * \return TRUE/FALSE if the reading was successful or not.
+         */
+        bool ReadDriver(AutoFocus &af);
+
+        /**
+         * \brief Writes all the variables of the auto focus driver (except the VMT pointer).
+         *
+         * \param[in] af is the structure with the variables (usually obtained with "ReadDriver").
+         *
+         * \return TRUE/FALSE if the writing was successful or not.
+         */
+        bool WriteDriver(const AutoFocus &af);
+
+        /**
+         * \brief Reads all the variables of the auto focus mechanics driver.
+         *
+         * \param[in,out] afm is the structure to store the variables.
+         *
+         * \return TRUE/FALSE if the reading was successful or not.
+         */
+        bool ReadDriver(AutoFocusMechanics &afm);
+
+        /**
+         * \brief Writes all the variables of the auto focus mechanics driver (except the VMT pointer).
+         *
+         * \param[in] afm is the structure with the variables (usually obtained with "ReadDriver").
+         *
+         * \return TRUE/FALSE if the writing was successful or not.
+         */
+        bool WriteDriver(const AutoFocusMechanics &afm);
+
+        /**
+         * \brief Reads all the variables of the mode driver.
+         *
+         * \param[in,out] mode is the structure to store the variables.
+         *
+         * \return TRUE/FALSE if the reading was successful or not.
+         */
+        bool ReadDriver(Mode &mode);
+
+        /**
+         * \brief Writes all the variables of the mode driver (except the VMT pointer and mode.context).
+         *
+         * \param[in] mode is the structure with the variables (usually obtained with "ReadDriver").
+         *
+         * \return TRUE/FALSE if the writing was successful or not.
+         */
+        bool WriteDriver(const Mode &mode);
+
+        /**
+         * \brief Reads all the variables of the JPEG driver.
+         *
+         * \param[in,out] jpeg is the structure to store the variables.
+         *
+         * \return TRUE/FALSE if the reading was successful or not.
+         */
+        bool ReadDriver(JPEG &jpeg);
+
+        /**
+         * \brief Writes all the variables of the JPEG driver (except the VMT pointer, the state and the status).
+         *
+         * \param[in] jpeg is the structure with the variables (usually obtained with "ReadDriver").
+         *
+         * \return TRUE/FALSE if the writing was successful or not.
+         */
+        bool WriteDriver(const JPEG &jpeg);
+
+        /**
+         * \brief Reads all the variables of the histogram driver.
+         *
+         * \param[in,out] hg is the structure to store the variables.
+         *
+         * \return TRUE/FALSE if the reading was successful or not.
+         */
+        bool ReadDriver(Histogram &hg);
+
+        /**
+         * \brief Writes all the variables of the histogram driver (except the VMT pointer).
+         *
+         * \param[in] hg is the structure with the variables (usually obtained with "ReadDriver").
+         *
+         * \return TRUE/FALSE if the writing was successful or not.
+         */
+        bool WriteDriver(const Histogram &hg);
+
+        /**
+         * \brief Reads all the variables of all the firmware drivers (snapshot).
+         *
+         * \param[in,out] drv is the structure to store the variables.
+         *
+         * \return TRUE/FALSE if the reading was successful or not.
+         */
+        bool ReadDriver(Driver &drv);
+
+        /**
+         * \brief Writes all the variables of all the firmware drivers (restore).
+         *
+         * \param[in] drv is the structure with the variables (usually obtained with "ReadDriver").
+         *
+         * \return TRUE/FALSE if the writing was successful or not.
+         */
+        bool WriteDriver(const Driver &drv);
+
         /**
          * \brief Checks if the sensor is connected and/or working.
          *
@@ -491,6 +1138,9 @@ class MT9D111
          * of configurable options are: output resolution, crop sizes, data format, output FIFO, spoof mode,
          * slew rate, special effects, and gamma table.
          *
+         * After issuing the command, seq.state is polled (see "WaitSequencerState") until the requested state is
+         * reached, and only then mode.context is checked.
+         *
          * \see MT9D131 Developer Guide. Context Switching and Output Configuration. Page 16.
          *
          * \param[in] mode is the operation mode. It can be:
@@ -513,10 +1163,37 @@ class MT9D111
          *
          * \see MT9D131 Developer Guide. Context Switching and Output Configuration. Page 16.
          *
-         * \return The current mode (MT9D111_MODE_PREVIEW or MT9D111_MODE_CAPTURE).
+         * \return The current mode (MT9D111_MODE_PREVIEW or MT9D111_MODE_CAPTURE), or 0xFF on error.
          */
         uint8_t GetMode();
 
+        /**
+         * \brief Gets the current mode (or context) of the sensor.
+         *
+         * \param[in,out] mode is a pointer to store the current mode (MT9D111_MODE_PREVIEW or MT9D111_MODE_CAPTURE).
+         *
+         * \return TRUE/FALSE if the reading was successful or not.
+         */
+        bool GetMode(uint8_t *mode);
+
+        /**
+         * \brief Gets the number of page selections that were skipped because the page was already selected.
+         *
+         * \return The number of saved page switches.
+         */
+        unsigned long GetPageSwitchesSaved();
+
+        /**
+         * \brief Gets the statistics of the I2C transactions of the sensor.
+         *
+         * Each register access is counted (reads, writes, retries and failures per page and address) and timed
+         * (latency histograms per operation type). A trace of the last transactions can be enabled with
+         * I2CStats::EnableTrace, and I2CStats::Dump writes a report.
+         *
+         * \return A pointer to the statistics.
+         */
+        I2CStats* GetStats();
+
         /**
          * \brief Sets the output format of the frames.
          *
@@ -719,6 +1396,64 @@ class MT9D111
          */
         bool SequencerCmd(uint8_t cmd);
 
+        /**
+         * \brief Waits until the sequencer reaches a given state.
+         *
+         * The seq.state variable is polled with an exponential backoff interval. The first interval is 1/8 of
+         * the frame period and the maximum interval is one frame period, since the sequencer only changes its
+         * state on frame boundaries.
+         *
+         * \param[in] state is the expected state (MT9D111_STATE_*).
+         * \param[in] timeout_ms is the maximum waiting time in milliseconds.
+         * \param[in,out] latency_us is a pointer to store the observed transition latency (can be NULL).
+         *
+         * \return TRUE/FALSE if the state was reached or not.
+         */
+        bool WaitSequencerState(uint8_t state, unsigned int timeout_ms=MT9D111_SEQUENCER_STATE_TIMEOUT_MS,
+                                uint32_t *latency_us=NULL);
+
+        /**
+         * \brief Sets the frame period used to pace the sequencer state polling.
+         *
+         * \param[in] period_us is the frame period in microseconds.
+         *
+         * \return None.
+         */
+        void SetFramePeriod(uint32_t period_us);
+
+        /**
+         * \brief Gets the frame period used to pace the sequencer state polling.
+         *
+         * \return The frame period in microseconds.
+         */
+        uint32_t GetFramePeriod();
+
+        /**
+         * \brief Sets the pixel clock frequency used to derive the frame period.
+         *
+         * \param[in] hz is the pixel clock frequency in Hz.
+         *
+         * \return None.
+         */
+        void SetPixelClock(uint32_t hz);
+
+        /**
+         * \brief Derives the frame period of a mode from the sensor configuration.
+         *
+         * The frame period is computed from the window size (R0x03:0 and R0x04:0), the row and column skipping of
+         * the context read mode (R0x20:0 or R0x21:0), the context blanking (R0x05:0 to R0x08:0) and the pixel clock
+         * (see "SetPixelClock"):
+         *
+         *     period = (width/col_skip + HBLANK)*(height/row_skip + VBLANK)/pixel_clock
+         *
+         * It is called by "SetMode" after each successful transition.
+         *
+         * \param[in] mode is the mode whose context is used (MT9D111_MODE_PREVIEW or MT9D111_MODE_CAPTURE).
+         *
+         * \return TRUE/FALSE if the frame period was updated or not.
+         */
+        bool UpdateFramePeriod(uint8_t mode);
+
         /**
          * \brief Sets the row skipping.
          *
@@ -0,0 +1,452 @@
+/*
+ * mt9d111_async.cpp
+ * 
+ * Copyright (C) 2018, Gabriel Mariano Marcelino <gabriel.mm8@gmail.com>
+ * 
+ * This file is part of MT9D111-Driver.
+ * 
+ * MT9D111-Driver is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ * 
+ * MT9D111-Driver is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ * 
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with MT9D111-Driver. If not, see <http://www.gnu.org/licenses/>.
+ * 
+ */
+
+/**
+ * \brief MT9D111 asynchronous commands queue implementation.
+ * 
+ * \author Gabriel Mariano Marcelino <gabriel.mm8@gmail.com>
+ * 
+ * \version 1.0-dev
+ * 
+ * \date 17/10/2026
+ * 
+ * \addtogroup async
+ * \{
+ */
+
+#include <system_error>
+
+#include "mt9d111_async.h"
+#include "logger.h"
+
+using namespace std;
+
+AsyncQueue::AsyncQueue()
+{
+    this->stub.next.store(NULL, memory_order_relaxed);
+
+    this->head.store(&this->stub, memory_order_relaxed);
+    this->tail = &this->stub;
+}
+
+void AsyncQueue::Push(AsyncCmd *cmd)
+{
+    cmd->next.store(NULL, memory_order_relaxed);
+
+    AsyncCmd *prev = this->head.exchange(cmd, memory_order_acq_rel);
+
+    // Until this store, the list is temporarily broken (see Pop)
+    prev->next.store(cmd, memory_order_release);
+}
+
+AsyncCmd* AsyncQueue::Pop()
+{
+    AsyncCmd *tail = this->tail;
+    AsyncCmd *next = tail->next.load(memory_order_acquire);
+
+    if (tail == &this->stub)
+    {
+        if (next == NULL)
+        {
+            return NULL;
+        }
+
+        this->tail = next;
+        tail = next;
+        next = next->next.load(memory_order_acquire);
+    }
+
+    if (next != NULL)
+    {
+        this->tail = next;
+
+        return tail;
+    }
+
+    // A producer is between the exchange and the link of its command
+    if (tail != this->head.load(memory_order_acquire))
+    {
+        return NULL;
+    }
+
+    // Last command: re-insert the stub node to be able to remove it
+    this->Push(&this->stub);
+
+    next = tail->next.load(memory_order_acquire);
+
+    if (next != NULL)
+    {
+        this->tail = next;
+
+        return tail;
+    }
+
+    return NULL;
+}
+
+MT9D111Async::MT9D111Async(MT9D111 *c)
+{
+    this->debug = new Debug("MT9D111Async");
+
+    this->cam = c;
+
+    this->running.store(false);
+    this->sleeping.store(false);
+    this->pending.store(0);
+    this->coalesced_writes.store(0);
+}
+
+MT9D111Async::~MT9D111Async()
+{
+    this->Stop();
+
+    delete this->debug;
+}
+
+bool MT9D111Async::Start()
+{
+    if (this->running.load())
+    {
+        return false;
+    }
+
+    this->running.store(true);
+
+    try
+    {
+        this->worker = thread(&MT9D111Async::Worker, this);
+    }
+    catch(const system_error &)
+    {
+        this->running.store(false);
+
+        LOG_ERROR("MT9D111Async", "Error starting the bus thread!");
+
+        return false;
+    }
+
+    DEBUG_EVENT(this->debug, "Bus thread started!");
+    DEBUG_NEWLINE(this->debug);
+
+    return true;
+}
+
+void MT9D111Async::Stop()
+{
+    this->running.store(false);
+
+    {
+        lock_guard<mutex> lock(this->wake_mutex);
+        this->wake_cond.notify_all();
+    }
+
+    if (this->worker.joinable())
+    {
+        this->worker.join();
+
+        DEBUG_EVENT(this->debug, "Bus thread stopped! (");
+        DEBUG_DEC(this->debug, this->coalesced_writes.load());
+        DEBUG_MSG(this->debug, " coalesced writes)");
+        DEBUG_NEWLINE(this->debug);
+    }
+}
+
+future<bool> MT9D111Async::Submit(const Op &op)
+{
+    AsyncCmd *cmd = MT9D111Async::NewOpCmd(op);
+
+    future<bool> res = cmd->promise.get_future();
+
+    this->Enqueue(cmd);
+
+    return res;
+}
+
+void MT9D111Async::Submit(const Op &op, function<void(bool)> callback)
+{
+    AsyncCmd *cmd = MT9D111Async::NewOpCmd(op);
+
+    cmd->callback = callback;
+
+    this->Enqueue(cmd);
+}
+
+future<bool> MT9D111Async::WriteReg(uint8_t page, uint8_t adr, uint16_t val)
+{
+    Op op = MT9D111_OP_WR(page, adr, val);
+
+    return this->Submit(op);
+}
+
+future<bool> MT9D111Async::WriteDriverVar8(uint16_t driver_id, uint8_t offset, uint8_t val)
+{
+    Op op = MT9D111_OP_WR_VAR8(0, offset, val);
+    op.page = driver_id >> 8;
+
+    return this->Submit(op);
+}
+
+future<bool> MT9D111Async::WriteDriverVar16(uint16_t driver_id, uint8_t offset, uint16_t val)
+{
+    Op op = MT9D111_OP_WR_VAR16(0, offset, val);
+    op.page = driver_id >> 8;
+
+    return this->Submit(op);
+}
+
+future<bool> MT9D111Async::Call(function<bool(MT9D111*)> func)
+{
+    AsyncCmd *cmd = new AsyncCmd;
+
+    cmd->type       = MT9D111_ASYNC_CMD_CALL;
+    cmd->func       = func;
+    cmd->coalesced  = false;
+
+    future<bool> res = cmd->promise.get_future();
+
+    this->Enqueue(cmd);
+
+    return res;
+}
+
+unsigned long MT9D111Async::GetCoalescedWrites()
+{
+    return this->coalesced_writes.load();
+}
+
+void MT9D111Async::Worker()
+{
+    AsyncCmd *batch[MT9D111_ASYNC_BATCH_MAX_LEN];
+
+    while(1)
+    {
+        size_t len = 0;
+        while(len < MT9D111_ASYNC_BATCH_MAX_LEN)
+        {
+            AsyncCmd *cmd = this->queue.Pop();
+            if (cmd == NULL)
+            {
+                break;
+            }
+
+            batch[len++] = cmd;
+        }
+
+        if (len > 0)
+        {
+            this->pending.fetch_sub(len);
+
+            this->Execute(batch, len);
+
+            continue;
+        }
+
+        // The running flag must be read before the pending counter (see Enqueue)
+        bool stop = !this->running.load();
+
+        // A command is being pushed
+        if (this->pending.load() > 0)
+        {
+            this_thread::yield();
+
+            continue;
+        }
+
+        if (stop)
+        {
+            break;
+        }
+
+        this->sleeping.store(true);
+
+        {
+            unique_lock<mutex> lock(this->wake_mutex);
+            this->wake_cond.wait(lock, [this]{ return (this->pending.load() > 0) or !this->running.load(); });
+        }
+
+        this->sleeping.store(false);
+    }
+}
+
+void MT9D111Async::Enqueue(AsyncCmd *cmd)
+{
+    this->pending.fetch_add(1);
+
+    // Commands counted before the bus thread reads the running flag are always executed
+    if (!this->running.load())
+    {
+        this->pending.fetch_sub(1);
+
+        LOG_WARNING("MT9D111Async", "Bus thread not running! Command rejected.");
+
+        this->Complete(cmd, false);
+
+        return;
+    }
+
+    this->queue.Push(cmd);
+
+    // The lock is only taken if the bus thread is idle
+    if (this->sleeping.load())
+    {
+        lock_guard<mutex> lock(this->wake_mutex);
+        this->wake_cond.notify_one();
+    }
+}
+
+void MT9D111Async::Execute(AsyncCmd **cmds, size_t len)
+{
+    size_t i = 0;
+    while(i < len)
+    {
+        if ((cmds[i]->type == MT9D111_ASYNC_CMD_OP) and MT9D111Async::IsCoalescable(cmds[i]->op))
+        {
+            size_t end = i + 1;
+            while((end < len) and (cmds[end]->type == MT9D111_ASYNC_CMD_OP) and MT9D111Async::IsCoalescable(cmds[end]->op))
+            {
+                end++;
+            }
+
+            this->ExecuteWrites(cmds, i, end);
+
+            i = end;
+        }
+        else if (cmds[i]->type == MT9D111_ASYNC_CMD_OP)
+        {
+            this->Complete(cmds[i], this->cam->Run(&cmds[i]->op, 1));
+
+            i++;
+        }
+        else
+        {
+            bool res = false;
+            try
+            {
+                if (cmds[i]->func)
+                {
+                    res = cmds[i]->func(this->cam);
+                }
+            }
+            catch(...)
+            {
+                LOG_ERROR("MT9D111Async", "Exception in a submitted call!");
+
+                // The exception is delivered to the caller through the future
+                cmds[i]->promise.set_exception(current_exception());
+
+                delete cmds[i];
+
+                i++;
+
+                continue;
+            }
+
+            this->Complete(cmds[i], res);
+
+            i++;
+        }
+    }
+}
+
+void MT9D111Async::ExecuteWrites(AsyncCmd **cmds, size_t start, size_t end)
+{
+    Op *ops = new Op[end - start];
+    size_t n = 0;
+
+    for(size_t i=start; i<end; i++)
+    {
+        const Op &op = cmds[i]->op;
+
+        for(size_t j=i+1; j<end; j++)
+        {
+            const Op &later = cmds[j]->op;
+
+            if ((later.code == op.code) and (later.flags == op.flags) and (later.page == op.page) and (later.address == op.address))
+            {
+                cmds[i]->coalesced = true;
+
+                this->coalesced_writes.fetch_add(1);
+
+                break;
+            }
+        }
+
+        if (!cmds[i]->coalesced)
+        {
+            ops[n++] = op;
+        }
+    }
+
+    bool res = this->cam->Run(ops, n);
+
+    delete[] ops;
+
+    for(size_t i=start; i<end; i++)
+    {
+        this->Complete(cmds[i], res);
+    }
+}
+
+void MT9D111Async::Complete(AsyncCmd *cmd, bool res)
+{
+    if (cmd->callback)
+    {
+        cmd->callback(res);
+    }
+    else
+    {
+        cmd->promise.set_value(res);
+    }
+
+    delete cmd;
+}
+
+bool MT9D111Async::IsCoalescable(const Op &op)
+{
+    Register reg = {op.address, op.page, op.value};
+
+    switch(op.code)
+    {
+        case MT9D111_OP_WRITE:
+            return OpIsDedupable(reg) and !OpIsBarrier(reg, 0);
+        case MT9D111_OP_WRITE_VAR:
+            reg.address = MT9D111_REG_MICROCONTROLLER_VARIABLE_DATA;
+            reg.page    = MT9D111_REG_PAGE_1;
+
+            return !OpIsBarrier(reg, (op.page << 8) | op.address);
+        default:
+            return false;
+    }
+}
+
+AsyncCmd* MT9D111Async::NewOpCmd(const Op &op)
+{
+    AsyncCmd *cmd = new AsyncCmd;
+
+    cmd->type       = MT9D111_ASYNC_CMD_OP;
+    cmd->op         = op;
+    cmd->coalesced  = false;
+
+    return cmd;
+}
+
+//! \} End of async group
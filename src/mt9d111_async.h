@@ -0,0 +1,312 @@
+/*
+ * mt9d111_async.h
+ * 
+ * Copyright (C) 2018, Gabriel Mariano Marcelino <gabriel.mm8@gmail.com>
+ * 
+ * This file is part of MT9D111-Driver.
+ * 
+ * MT9D111-Driver is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ * 
+ * MT9D111-Driver is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ * 
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with MT9D111-Driver. If not, see <http://www.gnu.org/licenses/>.
+ * 
+ */
+
+/**
+ * \brief MT9D111 asynchronous commands queue definition.
+ * 
+ * \author Gabriel Mariano Marcelino <gabriel.mm8@gmail.com>
+ * 
+ * \version 1.0-dev
+ * 
+ * \date 17/10/2026
+ * 
+ * \defgroup async Asynchronous commands
+ * \ingroup mt9d111
+ * \{
+ */
+
+#ifndef MT9D111_ASYNC_H_
+#define MT9D111_ASYNC_H_
+
+#include <stdint.h>
+#include <stddef.h>
+#include <atomic>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <future>
+#include <functional>
+
+#include "debug.h"
+#include "mt9d111.h"
+#include "mt9d111_op.h"
+
+// Commands types
+#define MT9D111_ASYNC_CMD_OP                        0   /**< Single operation (see mt9d111_op.h). */
+#define MT9D111_ASYNC_CMD_CALL                      1   /**< Generic call executed in the bus thread. */
+
+#define MT9D111_ASYNC_BATCH_MAX_LEN                 64  /**< Max. number of commands dequeued at once. */
+
+/**
+ * \brief A command of the asynchronous queue.
+ */
+struct AsyncCmd
+{
+    std::atomic<AsyncCmd*>          next;       /**< Next command of the queue. */
+    uint8_t                         type;       /**< Command type (MT9D111_ASYNC_CMD_OP or MT9D111_ASYNC_CMD_CALL). */
+    Op                              op;         /**< Operation (MT9D111_ASYNC_CMD_OP). */
+    std::function<bool(MT9D111*)>   func;       /**< Function to call (MT9D111_ASYNC_CMD_CALL). */
+    std::function<void(bool)>       callback;   /**< Completion callback (can be empty). */
+    std::promise<bool>              promise;    /**< Completion promise (used when there is no callback). */
+    bool                            coalesced;  /**< The command was replaced by a later write to the same target. */
+};
+
+/**
+ * \brief Lock-free multiple producers, single consumer commands queue (intrusive linked list).
+ *
+ * Any thread can push commands, but only the bus thread can pop them.
+ */
+class AsyncQueue
+{
+    private:
+        std::atomic<AsyncCmd*> head;    /**< Last pushed command (producers side). */
+        AsyncCmd *tail;                 /**< Next command to pop (consumer side). */
+        AsyncCmd stub;                  /**< Empty node, to never let the list empty. */
+
+    public:
+        /**
+         * \brief Constructor.
+         *
+         * \return None.
+         */
+        AsyncQueue();
+
+        /**
+         * \brief Pushes a command to the queue (wait-free, any thread).
+         *
+         * \param[in] cmd is the command to push.
+         *
+         * \return None.
+         */
+        void Push(AsyncCmd *cmd);
+
+        /**
+         * \brief Pops the oldest command of the queue (consumer thread only).
+         *
+         * \return The oldest command or NULL if the queue is empty (or a push is not complete yet).
+         */
+        AsyncCmd* Pop();
+};
+
+/**
+ * \brief Asynchronous front end of the MT9D111 class.
+ *
+ * All the bus accesses are executed by a single thread (the bus owner) in the order of submission. Register and
+ * driver variable writes to the same target that are pending at the same time are coalesced: only the last value is
+ * written, and all the coalesced commands complete with its result. Writes are never moved across barriers (resets,
+ * clock changes, sequencer commands), polls, delays or calls.
+ *
+ * While the bus thread is running, the MT9D111 object must not be accessed directly (use "Call" instead).
+ *
+ * Commands are only accepted while the bus thread is running: any command submitted before "Start" or after "Stop"
+ * completes immediately with FALSE.
+ */
+class MT9D111Async
+{
+    private:
+        Debug *debug;                       /**< Debug class. */
+        MT9D111 *cam;                       /**< Sensor object (owned by the bus thread). */
+        AsyncQueue queue;                   /**< Commands queue. */
+        std::thread worker;                 /**< Bus thread. */
+        std::atomic<bool> running;          /**< The bus thread is running. */
+        std::atomic<bool> sleeping;         /**< The bus thread is waiting for new commands. */
+        std::atomic<unsigned long> pending; /**< Number of pushed commands not popped yet. */
+        std::mutex wake_mutex;              /**< Wake-up mutex (only used when the bus thread is sleeping). */
+        std::condition_variable wake_cond;  /**< Wake-up condition. */
+        std::atomic<unsigned long> coalesced_writes;    /**< Number of writes removed by coalescing. */
+
+        /**
+         * \brief Bus thread main loop.
+         *
+         * \return None.
+         */
+        void Worker();
+
+        /**
+         * \brief Pushes a command and wakes up the bus thread if necessary.
+         *
+         * \param[in] cmd is the command to push.
+         *
+         * \return None.
+         */
+        void Enqueue(AsyncCmd *cmd);
+
+        /**
+         * \brief Executes a batch of commands in order.
+         *
+         * \param[in] cmds is the batch of commands.
+         * \param[in] len is the number of commands of the batch.
+         *
+         * \return None.
+         */
+        void Execute(AsyncCmd **cmds, size_t len);
+
+        /**
+         * \brief Executes a segment of coalescable writes, keeping only the last write to each target.
+         *
+         * \param[in] cmds is the batch of commands.
+         * \param[in] start is the first command of the segment.
+         * \param[in] end is the command after the last command of the segment.
+         *
+         * \return None.
+         */
+        void ExecuteWrites(AsyncCmd **cmds, size_t start, size_t end);
+
+        /**
+         * \brief Completes a command and releases it.
+         *
+         * \param[in] cmd is the command to complete.
+         * \param[in] res is the result of the command.
+         *
+         * \return None.
+         */
+        void Complete(AsyncCmd *cmd, bool res);
+
+        /**
+         * \brief Checks if an operation is a write that can be replaced by a later write to the same target.
+         *
+         * Barriers and the raw accesses to the microcontroller variables registers are never coalesced.
+         *
+         * \param[in] op is the operation to check.
+         *
+         * \return TRUE/FALSE if the write can be coalesced or not.
+         */
+        static bool IsCoalescable(const Op &op);
+
+        /**
+         * \brief Allocates a command for an operation.
+         *
+         * \param[in] op is the operation of the command.
+         *
+         * \return The new command.
+         */
+        static AsyncCmd* NewOpCmd(const Op &op);
+
+    public:
+        /**
+         * \brief Constructor.
+         *
+         * \param[in] c is the sensor object to drive.
+         *
+         * \return None.
+         */
+        MT9D111Async(MT9D111 *c);
+
+        /**
+         * \brief Destructor (stops the bus thread).
+         *
+         * \return None.
+         */
+        ~MT9D111Async();
+
+        /**
+         * \brief Starts the bus thread.
+         *
+         * \return TRUE/FALSE if the thread was started or not.
+         */
+        bool Start();
+
+        /**
+         * \brief Stops the bus thread after executing all the pending commands.
+         *
+         * The commands submitted after this call are rejected.
+         *
+         * \return None.
+         */
+        void Stop();
+
+        /**
+         * \brief Submits an operation.
+         *
+         * \param[in] op is the operation to execute.
+         *
+         * \return A future with the result of the operation.
+         */
+        std::future<bool> Submit(const Op &op);
+
+        /**
+         * \brief Submits an operation with a completion callback.
+         *
+         * The callback is executed in the bus thread, so it must not block.
+         *
+         * \param[in] op is the operation to execute.
+         * \param[in] callback is the function to call with the result of the operation.
+         *
+         * \return None.
+         */
+        void Submit(const Op &op, std::function<void(bool)> callback);
+
+        /**
+         * \brief Submits a register write.
+         *
+         * \param[in] page is the register page.
+         * \param[in] adr is the register address.
+         * \param[in] val is the new value of the register.
+         *
+         * \return A future with the result of the write.
+         */
+        std::future<bool> WriteReg(uint8_t page, uint8_t adr, uint16_t val);
+
+        /**
+         * \brief Submits an 8-bit driver variable write.
+         *
+         * \param[in] driver_id is the driver ID (MT9D111_DRIVER_ID_*).
+         * \param[in] offset is the variable offset.
+         * \param[in] val is the new value of the variable.
+         *
+         * \return A future with the result of the write.
+         */
+        std::future<bool> WriteDriverVar8(uint16_t driver_id, uint8_t offset, uint8_t val);
+
+        /**
+         * \brief Submits a 16-bit driver variable write.
+         *
+         * \param[in] driver_id is the driver ID (MT9D111_DRIVER_ID_*).
+         * \param[in] offset is the variable offset.
+         * \param[in] val is the new value of the variable.
+         *
+         * \return A future with the result of the write.
+         */
+        std::future<bool> WriteDriverVar16(uint16_t driver_id, uint8_t offset, uint16_t val);
+
+        /**
+         * \brief Submits a generic call to be executed in the bus thread (ex.: any MT9D111 method).
+         *
+         * An exception thrown by the function is caught in the bus thread and rethrown by the "get" method of the future.
+         *
+         * \param[in] func is the function to call.
+         *
+         * \return A future with the value returned by the function.
+         */
+        std::future<bool> Call(std::function<bool(MT9D111*)> func);
+
+        /**
+         * \brief Gets the number of writes removed by coalescing.
+         *
+         * \return The number of coalesced writes.
+         */
+        unsigned long GetCoalescedWrites();
+};
+
+#endif // MT9D111_ASYNC_H_
+
+//! \} End of async group
@@ -0,0 +1,909 @@
+/*
+ * mt9d111_capture.cpp
+ * 
+ * Copyright (C) 2018, Gabriel Mariano Marcelino <gabriel.mm8@gmail.com>
+ * 
+ * This file is part of MT9D111-Driver.
+ * 
+ * MT9D111-Driver is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ * 
+ * MT9D111-Driver is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ * 
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with MT9D111-Driver. If not, see <http://www.gnu.org/licenses/>.
+ * 
+ */
+
+/**
+ * \brief V4L2 frame capture implementation.
+ * 
+ * \author Gabriel Mariano Marcelino <gabriel.mm8@gmail.com>
+ * 
+ * \version 1.0-dev
+ * 
+ * \date 17/10/2026
+ * 
+ * \addtogroup capture
+ * \{
+ */
+
+#include <fcntl.h>
+#include <unistd.h>
+#include <errno.h>
+#include <string.h>
+#include <poll.h>
+#include <sys/ioctl.h>
+#include <sys/mman.h>
+#include <linux/videodev2.h>
+#include <linux/dma-buf.h>
+
+#include "mt9d111_capture.h"
+#include "logger.h"
+
+using namespace std;
+
+MT9D111Capture::MT9D111Capture()
+{
+    this->fd                = -1;
+    this->last_error        = 0;
+
+    this->pixel_format      = 0;
+    this->width             = 0;
+    this->height            = 0;
+    this->bytes_per_line    = 0;
+    this->frame_size        = 0;
+
+    this->buffers_len       = 0;
+    this->streaming         = false;
+
+    this->generation        = 0;
+
+    this->link              = new CaptureLink;
+
+    this->link->refs.store(1);
+    this->link->capture     = this;
+
+    this->sequence_valid    = false;
+    this->last_sequence     = 0;
+    this->dropped_frames    = 0;
+}
+
+MT9D111Capture::~MT9D111Capture()
+{
+    // Waits the releases in progress, the next ones do not queue their buffers
+    {
+        lock_guard<mutex> lock(this->link->lock);
+
+        this->link->capture = NULL;
+    }
+
+    if (this->link->refs.fetch_sub(1, memory_order_acq_rel) == 1)
+    {
+        delete this->link;
+    }
+
+    this->Close();
+}
+
+bool MT9D111Capture::IOCtl(unsigned long req, void *arg)
+{
+    int res;
+
+    do
+    {
+        res = ioctl(this->fd, req, arg);
+    } while((res < 0) and (errno == EINTR));
+
+    if (res < 0)
+    {
+        this->last_error = errno;
+
+        return false;
+    }
+
+    return true;
+}
+
+void MT9D111Capture::ReleaseBuffers()
+{
+    for(unsigned int i=0; i<this->buffers_len; i++)
+    {
+        if (this->buffers[i].start != MAP_FAILED)
+        {
+            munmap(this->buffers[i].start, this->buffers[i].length);
+        }
+
+        if (this->buffers[i].dmabuf_fd >= 0)
+        {
+            close(this->buffers[i].dmabuf_fd);
+        }
+    }
+
+    if (this->buffers_len > 0)
+    {
+        struct v4l2_requestbuffers req;
+        memset(&req, 0, sizeof(req));
+
+        req.count   = 0;
+        req.type    = V4L2_BUF_TYPE_VIDEO_CAPTURE;
+        req.memory  = V4L2_MEMORY_MMAP;
+
+        this->IOCtl(VIDIOC_REQBUFS, &req);
+    }
+
+    this->buffers_len = 0;
+}
+
+bool MT9D111Capture::Open(const char *dev)
+{
+    if (this->fd >= 0)
+    {
+        this->Close();
+    }
+
+    // Non-blocking, so a DQBUF never waits (the wait is done by "Dequeue")
+    this->fd = open(dev, O_RDWR | O_NONBLOCK | O_CLOEXEC);
+    if (this->fd < 0)
+    {
+        this->last_error = errno;
+
+        LOG_ERROR("MT9D111Capture", "Error opening the V4L2 device! (errno=%u)", this->last_error);
+
+        return false;
+    }
+
+    struct v4l2_capability cap;
+    memset(&cap, 0, sizeof(cap));
+
+    if (!this->IOCtl(VIDIOC_QUERYCAP, &cap))
+    {
+        LOG_ERROR("MT9D111Capture", "The device is not a V4L2 device! (errno=%u)", this->last_error);
+
+        this->Close();
+
+        return false;
+    }
+
+    uint32_t caps = (cap.capabilities & V4L2_CAP_DEVICE_CAPS)? cap.device_caps : cap.capabilities;
+
+    if (!(caps & V4L2_CAP_VIDEO_CAPTURE) or !(caps & V4L2_CAP_STREAMING))
+    {
+        LOG_ERROR("MT9D111Capture", "The device does not support video capture with streaming I/O! (caps=0x%X)", caps);
+
+        this->Close();
+
+        this->last_error = ENOTTY;
+
+        return false;
+    }
+
+    return true;
+}
+
+bool MT9D111Capture::Close()
+{
+    if (this->fd < 0)
+    {
+        return false;
+    }
+
+    this->Stop();
+
+    close(this->fd);
+
+    this->fd = -1;
+
+    return true;
+}
+
+uint32_t MT9D111Capture::GetPixelFormat(uint8_t format)
+{
+    switch(format)
+    {
+        case MT9D111_OUTPUT_FORMAT_YCbCr:       return V4L2_PIX_FMT_UYVY;       // Cb Y Cr Y
+        case MT9D111_OUTPUT_FORMAT_RGB565:      return V4L2_PIX_FMT_RGB565X;    // MSB first
+        case MT9D111_OUTPUT_FORMAT_RGB555:      return V4L2_PIX_FMT_RGB555X;    // MSB first
+        case MT9D111_OUTPUT_FORMAT_JPEG:        return V4L2_PIX_FMT_JPEG;
+        case MT9D111_OUTPUT_FORMAT_RAW_8:       return V4L2_PIX_FMT_SGRBG8;
+        default:                                return 0;
+    }
+}
+
+bool MT9D111Capture::SetFormat(uint8_t format, uint16_t width, uint16_t height)
+{
+    uint32_t fourcc = MT9D111Capture::GetPixelFormat(format);
+
+    if (fourcc == 0)
+    {
+        LOG_ERROR("MT9D111Capture", "There is no V4L2 pixel format for the output format %u!", format);
+
+        this->last_error = EINVAL;
+
+        return false;
+    }
+
+    return this->SetPixelFormat(fourcc, width, height);
+}
+
+bool MT9D111Capture::SetPixelFormat(uint32_t fourcc, uint16_t width, uint16_t height)
+{
+    if (this->fd < 0)
+    {
+        this->last_error = EBADF;
+
+        return false;
+    }
+
+    if (this->streaming)
+    {
+        this->last_error = EBUSY;
+
+        return false;
+    }
+
+    struct v4l2_format fmt;
+    memset(&fmt, 0, sizeof(fmt));
+
+    fmt.type                    = V4L2_BUF_TYPE_VIDEO_CAPTURE;
+    fmt.fmt.pix.width           = width;
+    fmt.fmt.pix.height          = height;
+    fmt.fmt.pix.pixelformat     = fourcc;
+    fmt.fmt.pix.field           = V4L2_FIELD_NONE;
+
+    if (!this->IOCtl(VIDIOC_S_FMT, &fmt))
+    {
+        LOG_ERROR("MT9D111Capture", "Error setting the V4L2 format! (errno=%u)", this->last_error);
+
+        return false;
+    }
+
+    if (fmt.fmt.pix.pixelformat != fourcc)
+    {
+        LOG_ERROR("MT9D111Capture", "The pixel format 0x%X is not supported by the V4L2 device! (got 0x%X)", fourcc,
+                  fmt.fmt.pix.pixelformat);
+
+        this->last_error = EINVAL;
+
+        return false;
+    }
+
+    if ((fmt.fmt.pix.width != width) or (fmt.fmt.pix.height != height))
+    {
+        LOG_WARNING("MT9D111Capture", "Frame size adjusted by the V4L2 device to %ux%u!", fmt.fmt.pix.width,
+                    fmt.fmt.pix.height);
+    }
+
+    this->pixel_format      = fmt.fmt.pix.pixelformat;
+    this->width             = fmt.fmt.pix.width;
+    this->height            = fmt.fmt.pix.height;
+    this->bytes_per_line    = fmt.fmt.pix.bytesperline;
+    this->frame_size        = fmt.fmt.pix.sizeimage;
+
+    return true;
+}
+
+bool MT9D111Capture::Configure(MT9D111 &cam, uint8_t mode, uint8_t format, uint16_t width, uint16_t height)
+{
+    if (!this->SetFormat(format, width, height))
+    {
+        return false;
+    }
+
+    if (!cam.SetOutputFormat(format) or !cam.SetResolution(mode, this->width, this->height))
+    {
+        LOG_ERROR("MT9D111Capture", "Error configuring the sensor with the negotiated format!");
+
+        this->last_error = EIO;
+
+        return false;
+    }
+
+    return true;
+}
+
+uint16_t MT9D111Capture::GetWidth()
+{
+    return this->width;
+}
+
+uint16_t MT9D111Capture::GetHeight()
+{
+    return this->height;
+}
+
+uint32_t MT9D111Capture::GetBytesPerLine()
+{
+    return this->bytes_per_line;
+}
+
+uint32_t MT9D111Capture::GetFrameSize()
+{
+    return this->frame_size;
+}
+
+bool MT9D111Capture::QueueBuffer(unsigned int index)
+{
+    struct v4l2_buffer buf;
+    memset(&buf, 0, sizeof(buf));
+
+    buf.type    = V4L2_BUF_TYPE_VIDEO_CAPTURE;
+    buf.memory  = V4L2_MEMORY_MMAP;
+    buf.index   = index;
+
+    if (!this->IOCtl(VIDIOC_QBUF, &buf))
+    {
+        LOG_ERROR("MT9D111Capture", "Error queueing the buffer %u! (errno=%u)", index, this->last_error);
+
+        return false;
+    }
+
+    this->buffers[index].queued = true;
+
+    return true;
+}
+
+bool MT9D111Capture::ReleaseLease(unsigned int index, uint32_t gen)
+{
+    lock_guard<mutex> lock(this->ring_mutex);
+
+    // The buffers of a stopped stream were already returned
+    if (!this->streaming or (gen != this->generation) or (index >= this->buffers_len) or this->buffers[index].queued)
+    {
+        return false;
+    }
+
+    return this->QueueBuffer(index);
+}
+
+bool MT9D111Capture::Start(unsigned int n, bool dmabuf)
+{
+    if (this->fd < 0)
+    {
+        this->last_error = EBADF;
+
+        return false;
+    }
+
+    if (this->streaming)
+    {
+        this->last_error = EBUSY;
+
+        return false;
+    }
+
+    struct v4l2_requestbuffers req;
+    memset(&req, 0, sizeof(req));
+
+    req.count   = (n > MT9D111_CAPTURE_MAX_BUFFERS)? MT9D111_CAPTURE_MAX_BUFFERS : n;
+    req.type    = V4L2_BUF_TYPE_VIDEO_CAPTURE;
+    req.memory  = V4L2_MEMORY_MMAP;
+
+    if (!this->IOCtl(VIDIOC_REQBUFS, &req))
+    {
+        LOG_ERROR("MT9D111Capture", "Error requesting %u buffers! (errno=%u)", req.count, this->last_error);
+
+        return false;
+    }
+
+    if ((req.count == 0) or (req.count > MT9D111_CAPTURE_MAX_BUFFERS))
+    {
+        LOG_ERROR("MT9D111Capture", "Invalid number of allocated buffers! (%u)", req.count);
+
+        this->buffers_len = req.count;
+        this->ReleaseBuffers();
+
+        this->last_error = ENOMEM;
+
+        return false;
+    }
+
+    this->buffers_len = req.count;
+
+    for(unsigned int i=0; i<this->buffers_len; i++)
+    {
+        this->buffers[i].start  = MAP_FAILED;
+        this->buffers[i].length = 0;
+        this->buffers[i].queued = false;
+        this->buffers[i].dmabuf_fd = -1;
+    }
+
+    for(unsigned int i=0; i<this->buffers_len; i++)
+    {
+        struct v4l2_buffer buf;
+        memset(&buf, 0, sizeof(buf));
+
+        buf.type    = V4L2_BUF_TYPE_VIDEO_CAPTURE;
+        buf.memory  = V4L2_MEMORY_MMAP;
+        buf.index   = i;
+
+        if (!this->IOCtl(VIDIOC_QUERYBUF, &buf))
+        {
+            LOG_ERROR("MT9D111Capture", "Error querying the buffer %u! (errno=%u)", i, this->last_error);
+
+            this->ReleaseBuffers();
+
+            return false;
+        }
+
+        void *start = mmap(NULL, buf.length, PROT_READ | PROT_WRITE, MAP_SHARED, this->fd, buf.m.offset);
+        if (start == MAP_FAILED)
+        {
+            this->last_error = errno;
+
+            LOG_ERROR("MT9D111Capture", "Error mapping the buffer %u! (errno=%u)", i, this->last_error);
+
+            this->ReleaseBuffers();
+
+            return false;
+        }
+
+        this->buffers[i].start  = start;
+        this->buffers[i].length = buf.length;
+
+        if (dmabuf)
+        {
+            struct v4l2_exportbuffer expbuf;
+            memset(&expbuf, 0, sizeof(expbuf));
+
+            expbuf.type     = V4L2_BUF_TYPE_VIDEO_CAPTURE;
+            expbuf.index    = i;
+            expbuf.flags    = O_CLOEXEC | O_RDONLY;
+
+            if (!this->IOCtl(VIDIOC_EXPBUF, &expbuf))
+            {
+                LOG_ERROR("MT9D111Capture", "Error exporting the buffer %u as a DMA-BUF! (errno=%u)", i, this->last_error);
+
+                this->ReleaseBuffers();
+
+                return false;
+            }
+
+            this->buffers[i].dmabuf_fd = expbuf.fd;
+        }
+
+        if (!this->QueueBuffer(i))
+        {
+            this->ReleaseBuffers();
+
+            return false;
+        }
+    }
+
+    int type = V4L2_BUF_TYPE_VIDEO_CAPTURE;
+
+    if (!this->IOCtl(VIDIOC_STREAMON, &type))
+    {
+        LOG_ERROR("MT9D111Capture", "Error starting the stream! (errno=%u)", this->last_error);
+
+        this->ReleaseBuffers();
+
+        return false;
+    }
+
+    this->streaming         = true;
+    this->sequence_valid    = false;
+    this->dropped_frames    = 0;
+
+    return true;
+}
+
+bool MT9D111Capture::Stop()
+{
+    lock_guard<mutex> lock(this->ring_mutex);
+
+    if (!this->streaming)
+    {
+        return false;
+    }
+
+    int type = V4L2_BUF_TYPE_VIDEO_CAPTURE;
+
+    // Returns all the buffers to the application
+    bool res = this->IOCtl(VIDIOC_STREAMOFF, &type);
+
+    this->streaming = false;
+
+    // The leases of this stream must not queue their buffers anymore
+    this->generation++;
+
+    this->ReleaseBuffers();
+
+    return res;
+}
+
+bool MT9D111Capture::Dequeue(CaptureFrame &frame, int timeout_ms)
+{
+    if (!this->streaming)
+    {
+        this->last_error = EINVAL;
+
+        return false;
+    }
+
+    struct v4l2_buffer buf;
+
+    while(1)
+    {
+        memset(&buf, 0, sizeof(buf));
+
+        buf.type    = V4L2_BUF_TYPE_VIDEO_CAPTURE;
+        buf.memory  = V4L2_MEMORY_MMAP;
+
+        if (this->IOCtl(VIDIOC_DQBUF, &buf))
+        {
+            break;
+        }
+
+        if (this->last_error != EAGAIN)
+        {
+            LOG_ERROR("MT9D111Capture", "Error dequeueing a buffer! (errno=%u)", this->last_error);
+
+            return false;
+        }
+
+        struct pollfd pfd;
+        pfd.fd      = this->fd;
+        pfd.events  = POLLIN;
+        pfd.revents = 0;
+
+        int res = poll(&pfd, 1, timeout_ms);
+        if (res < 0)
+        {
+            if (errno == EINTR)
+            {
+                continue;
+            }
+
+            this->last_error = errno;
+
+            return false;
+        }
+        else if (res == 0)
+        {
+            this->last_error = ETIMEDOUT;
+
+            return false;
+        }
+    }
+
+    lock_guard<mutex> lock(this->ring_mutex);
+
+    if (buf.index >= this->buffers_len)
+    {
+        this->last_error = EIO;
+
+        return false;
+    }
+
+    this->buffers[buf.index].queued = false;
+
+    if (this->sequence_valid and (buf.sequence != this->last_sequence + 1))
+    {
+        this->dropped_frames += buf.sequence - this->last_sequence - 1;
+    }
+
+    this->sequence_valid    = true;
+    this->last_sequence     = buf.sequence;
+
+    frame.data      = (const uint8_t*)this->buffers[buf.index].start;
+    frame.len       = buf.bytesused;
+    frame.index     = buf.index;
+    frame.sequence  = buf.sequence;
+    frame.timestamp = (uint64_t)buf.timestamp.tv_sec*1000000000ULL + (uint64_t)buf.timestamp.tv_usec*1000ULL;
+    frame.error     = (buf.flags & V4L2_BUF_FLAG_ERROR) != 0;
+    frame.dmabuf_fd = this->buffers[buf.index].dmabuf_fd;
+
+    return true;
+}
+
+bool MT9D111Capture::Queue(const CaptureFrame &frame)
+{
+    lock_guard<mutex> lock(this->ring_mutex);
+
+    if (!this->streaming or (frame.index >= this->buffers_len) or this->buffers[frame.index].queued)
+    {
+        this->last_error = EINVAL;
+
+        return false;
+    }
+
+    return this->QueueBuffer(frame.index);
+}
+
+bool MT9D111Capture::Acquire(FrameLease &lease, int timeout_ms)
+{
+    CaptureFrame frame;
+
+    if (!this->Dequeue(frame, timeout_ms))
+    {
+        return false;
+    }
+
+    if (!lease.Reset(this->link, frame, this->generation))
+    {
+        this->last_error = errno;
+
+        // The buffer returns to the ring
+        this->Queue(frame);
+
+        return false;
+    }
+
+    return true;
+}
+
+unsigned int MT9D111Capture::GetBuffers()
+{
+    return this->buffers_len;
+}
+
+unsigned long MT9D111Capture::GetDroppedFrames()
+{
+    return this->dropped_frames;
+}
+
+int MT9D111Capture::GetLastError()
+{
+    return this->last_error;
+}
+
+FrameLease::FrameLease()
+{
+    this->state = NULL;
+}
+
+FrameLease::FrameLease(const FrameLease &other)
+{
+    this->state = other.state;
+
+    if (this->state != NULL)
+    {
+        this->state->refs.fetch_add(1, memory_order_relaxed);
+    }
+}
+
+FrameLease& FrameLease::operator=(const FrameLease &other)
+{
+    // The new reference is taken first, in case both leases share the same frame (or are the same lease)
+    LeaseState *s = other.state;
+
+    if (s != NULL)
+    {
+        s->refs.fetch_add(1, memory_order_relaxed);
+    }
+
+    this->Release();
+
+    this->state = s;
+
+    return *this;
+}
+
+FrameLease::~FrameLease()
+{
+    this->Release();
+}
+
+bool FrameLease::Reset(CaptureLink *link, const CaptureFrame &frame, uint32_t generation)
+{
+    this->Release();
+
+    int dmabuf_fd = -1;
+
+    // Own reference to the DMA-BUF, the ring closes its descriptors when the stream is stopped
+    if (frame.dmabuf_fd >= 0)
+    {
+        dmabuf_fd = fcntl(frame.dmabuf_fd, F_DUPFD_CLOEXEC, 0);
+        if (dmabuf_fd < 0)
+        {
+            LOG_ERROR("MT9D111Capture", "Error duplicating the DMA-BUF %u! (errno=%u)", frame.dmabuf_fd, errno);
+
+            return false;
+        }
+    }
+
+    link->refs.fetch_add(1, memory_order_relaxed);
+
+    this->state = new LeaseState;
+
+    this->state->refs.store(1);
+    this->state->link       = link;
+    this->state->frame      = frame;
+    this->state->generation = generation;
+
+    this->state->frame.dmabuf_fd = dmabuf_fd;
+
+    return true;
+}
+
+void FrameLease::Release()
+{
+    if (this->state == NULL)
+    {
+        return;
+    }
+
+    if (this->state->refs.fetch_sub(1, memory_order_acq_rel) == 1)
+    {
+        CaptureLink *link = this->state->link;
+
+        {
+            lock_guard<mutex> lock(link->lock);
+
+            if (link->capture != NULL)
+            {
+                link->capture->ReleaseLease(this->state->frame.index, this->state->generation);
+            }
+        }
+
+        if (this->state->frame.dmabuf_fd >= 0)
+        {
+            close(this->state->frame.dmabuf_fd);
+        }
+
+        if (link->refs.fetch_sub(1, memory_order_acq_rel) == 1)
+        {
+            delete link;
+        }
+
+        delete this->state;
+    }
+
+    this->state = NULL;
+}
+
+bool FrameLease::IsValid() const
+{
+    return this->state != NULL;
+}
+
+const CaptureFrame& FrameLease::GetFrame() const
+{
+    return this->state->frame;
+}
+
+int FrameLease::GetDmaBufFD() const
+{
+    return (this->state != NULL)? this->state->frame.dmabuf_fd : -1;
+}
+
+unsigned int FrameLease::GetRefs() const
+{
+    return (this->state != NULL)? this->state->refs.load() : 0;
+}
+
+DmaBufImport::DmaBufImport()
+{
+    this->fd    = -1;
+    this->data  = NULL;
+    this->len   = 0;
+}
+
+DmaBufImport::~DmaBufImport()
+{
+    this->Release();
+}
+
+bool DmaBufImport::Import(int dmabuf_fd, size_t length)
+{
+    this->Release();
+
+    if ((dmabuf_fd < 0) or (length == 0))
+    {
+        return false;
+    }
+
+    // Own reference to the DMA-BUF, independent of the ring
+    this->fd = fcntl(dmabuf_fd, F_DUPFD_CLOEXEC, 0);
+    if (this->fd < 0)
+    {
+        LOG_ERROR("MT9D111Capture", "Error duplicating the DMA-BUF %u! (errno=%u)", dmabuf_fd, errno);
+
+        return false;
+    }
+
+    void *map = mmap(NULL, length, PROT_READ, MAP_SHARED, this->fd, 0);
+    if (map == MAP_FAILED)
+    {
+        LOG_ERROR("MT9D111Capture", "Error mapping the DMA-BUF %u! (errno=%u)", dmabuf_fd, errno);
+
+        close(this->fd);
+
+        this->fd = -1;
+
+        return false;
+    }
+
+    this->data  = map;
+    this->len   = length;
+
+    return true;
+}
+
+bool DmaBufImport::Import(const FrameLease &lease)
+{
+    if (!lease.IsValid())
+    {
+        return false;
+    }
+
+    return this->Import(lease.GetDmaBufFD(), lease.GetFrame().len);
+}
+
+void DmaBufImport::Release()
+{
+    if (this->data != NULL)
+    {
+        munmap(this->data, this->len);
+    }
+
+    if (this->fd >= 0)
+    {
+        close(this->fd);
+    }
+
+    this->fd    = -1;
+    this->data  = NULL;
+    this->len   = 0;
+}
+
+/**
+ * \brief Executes DMA_BUF_IOCTL_SYNC on a DMA-BUF (retried if interrupted).
+ *
+ * \param[in] fd is the DMA-BUF file descriptor.
+ * \param[in] flags are the synchronization flags (DMA_BUF_SYNC_*).
+ *
+ * \return TRUE/FALSE if successful or not.
+ */
+static bool SyncDmaBuf(int fd, uint64_t flags)
+{
+    if (fd < 0)
+    {
+        return false;
+    }
+
+    struct dma_buf_sync sync;
+    sync.flags = flags;
+
+    int res;
+
+    do
+    {
+        res = ioctl(fd, DMA_BUF_IOCTL_SYNC, &sync);
+    } while((res < 0) and ((errno == EINTR) or (errno == EAGAIN)));
+
+    return res == 0;
+}
+
+bool DmaBufImport::BeginAccess()
+{
+    return SyncDmaBuf(this->fd, DMA_BUF_SYNC_START | DMA_BUF_SYNC_READ);
+}
+
+bool DmaBufImport::EndAccess()
+{
+    return SyncDmaBuf(this->fd, DMA_BUF_SYNC_END | DMA_BUF_SYNC_READ);
+}
+
+const uint8_t* DmaBufImport::GetData() const
+{
+    return (const uint8_t*)this->data;
+}
+
+size_t DmaBufImport::GetLength() const
+{
+    return this->len;
+}
+
+int DmaBufImport::GetFD() const
+{
+    return this->fd;
+}
+
+//! \} End of capture group
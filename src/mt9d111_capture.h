@@ -0,0 +1,598 @@
+/*
+ * mt9d111_capture.h
+ * 
+ * Copyright (C) 2018, Gabriel Mariano Marcelino <gabriel.mm8@gmail.com>
+ * 
+ * This file is part of MT9D111-Driver.
+ * 
+ * MT9D111-Driver is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ * 
+ * MT9D111-Driver is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ * 
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with MT9D111-Driver. If not, see <http://www.gnu.org/licenses/>.
+ * 
+ */
+
+/**
+ * \brief V4L2 frame capture definition.
+ * 
+ * The sensor is configured by the I2C bus, but its pixels are received by a V4L2 capture device (the parallel
+ * interface of the SoC). This class negotiates the V4L2 format matching the sensor configuration and streams the
+ * frames with a ring of memory mapped buffers, without copies:
+ * 
+ * \code
+ *      MT9D111Capture capture;
+ * 
+ *      capture.Open("/dev/video0");
+ *      capture.Configure(cam, MT9D111_MODE_PREVIEW, MT9D111_OUTPUT_FORMAT_YCbCr, 640, 480);
+ *      capture.Start(4);
+ * 
+ *      CaptureFrame frame;
+ *      if (capture.Dequeue(frame, 1000))
+ *      {
+ *          // frame.data is valid until the buffer is queued again
+ *          capture.Queue(frame);
+ *      }
+ * 
+ *      capture.Stop();
+ * \endcode
+ * 
+ * The buffers can also be exported as DMA-BUF file descriptors ("Start" with "dmabuf" = TRUE) and handed to other
+ * stages (an encoder, a network sender, etc.) without copying the frames. Each stage holds a FrameLease, and the buffer
+ * returns to the ring when the last lease is released:
+ * 
+ * \code
+ *      FrameLease lease;
+ *      if (capture.Acquire(lease, 1000))
+ *      {
+ *          FrameLease encoder_lease = lease;       // Shared with the encoder thread
+ *          FrameLease sender_lease = lease;        // Shared with the network thread
+ *          lease.Release();
+ *      }
+ * 
+ *      // In another stage (the file descriptor can also be sent to another process)
+ *      DmaBufImport import;
+ *      import.Import(sender_lease);
+ *      import.BeginAccess();
+ *      send(sock, import.GetData(), import.GetLength(), 0);
+ *      import.EndAccess();
+ *      sender_lease.Release();
+ * \endcode
+ * 
+ * It can be tested without the sensor with the vivid virtual driver ("modprobe vivid") and "SetFormat".
+ * 
+ * \author Gabriel Mariano Marcelino <gabriel.mm8@gmail.com>
+ * 
+ * \version 1.0-dev
+ * 
+ * \date 17/10/2026
+ * 
+ * \defgroup capture Capture
+ * \ingroup mt9d111
+ * \{
+ */
+
+#ifndef MT9D111_CAPTURE_H_
+#define MT9D111_CAPTURE_H_
+
+#include <stdint.h>
+#include <stddef.h>
+#include <atomic>
+#include <mutex>
+
+#include "mt9d111.h"
+
+#define MT9D111_CAPTURE_DEFAULT_DEVICE              "/dev/video0"
+#define MT9D111_CAPTURE_DEFAULT_BUFFERS             4
+#define MT9D111_CAPTURE_MAX_BUFFERS                 32
+
+/**
+ * \brief A captured frame (view of a buffer of the ring).
+ */
+struct CaptureFrame
+{
+    const uint8_t *data;    /**< Frame data (memory mapped, valid until the buffer is queued again). */
+    size_t len;             /**< Number of bytes of the frame. */
+    unsigned int index;     /**< Buffer index. */
+    uint32_t sequence;      /**< Frame sequence number (set by the V4L2 driver). */
+    uint64_t timestamp;     /**< Capture time in nanoseconds (CLOCK_MONOTONIC with most V4L2 drivers). */
+    bool error;             /**< The V4L2 driver reported the frame as corrupted. */
+    int dmabuf_fd;          /**< DMA-BUF file descriptor of the buffer (-1 if not exported). */
+};
+
+/**
+ * \brief Memory mapped buffer of the ring.
+ */
+struct CaptureBuffer
+{
+    void *start;            /**< Mapping address. */
+    size_t length;          /**< Mapping length. */
+    bool queued;            /**< The buffer is owned by the V4L2 driver. */
+    int dmabuf_fd;          /**< Exported DMA-BUF file descriptor (-1 if not exported). */
+};
+
+class MT9D111Capture;
+
+/**
+ * \brief Reference-counted link between a capture object and the leases of its frames.
+ *
+ * The capture object clears "capture" when it is destroyed, so the leases that outlive it do not touch the ring.
+ */
+struct CaptureLink
+{
+    std::atomic<unsigned int> refs;     /**< Number of references (the capture object and the leased frames). */
+    std::mutex lock;                    /**< Lock of "capture" (held while a released buffer is queued). */
+    MT9D111Capture *capture;            /**< Capture object (NULL after it is destroyed). */
+};
+
+/**
+ * \brief Shared state of the leases of a frame.
+ */
+struct LeaseState
+{
+    std::atomic<unsigned int> refs;     /**< Number of leases of the frame. */
+    CaptureLink *link;                  /**< Link to the capture object of the frame. */
+    CaptureFrame frame;                 /**< Leased frame (with its own duplicate of the DMA-BUF file descriptor). */
+    uint32_t generation;                /**< Stream generation of the frame (see MT9D111Capture::Stop). */
+};
+
+/**
+ * \brief Reference-counted lease of a captured frame.
+ *
+ * Copies of a lease share the same frame, and the buffer of the frame is queued again when the last copy is released
+ * (or destroyed). A lease can be copied and released by any thread, but a single lease object must not be used by
+ * several threads at the same time.
+ *
+ * Each leased frame holds its own duplicate of the DMA-BUF file descriptor, so the descriptor remains valid after the
+ * stream is stopped or the capture object is destroyed (releasing the lease then does not queue the buffer).
+ */
+class FrameLease
+{
+    private:
+        LeaseState *state;  /**< Shared state (NULL if the lease is empty). */
+
+        /**
+         * \brief Leases a dequeued frame (used by MT9D111Capture::Acquire).
+         *
+         * \param[in] link is the link to the capture object of the frame.
+         * \param[in] frame is the dequeued frame.
+         * \param[in] generation is the stream generation of the frame.
+         *
+         * \return TRUE/FALSE if successful or not.
+         */
+        bool Reset(CaptureLink *link, const CaptureFrame &frame, uint32_t generation);
+
+        friend class MT9D111Capture;
+
+    public:
+        /**
+         * \brief Constructor (empty lease).
+         *
+         * \return None.
+         */
+        FrameLease();
+
+        /**
+         * \brief Copy constructor (takes a new reference to the frame).
+         *
+         * \param[in] other is the lease to share.
+         *
+         * \return None.
+         */
+        FrameLease(const FrameLease &other);
+
+        /**
+         * \brief Assignment (releases the current frame and takes a reference to the new one).
+         *
+         * \param[in] other is the lease to share.
+         *
+         * \return This lease.
+         */
+        FrameLease& operator=(const FrameLease &other);
+
+        /**
+         * \brief Destructor (releases the lease).
+         *
+         * \return None.
+         */
+        ~FrameLease();
+
+        /**
+         * \brief Releases the lease (the buffer returns to the ring if this is the last lease of the frame).
+         *
+         * \return None.
+         */
+        void Release();
+
+        /**
+         * \brief Checks if the lease holds a frame.
+         *
+         * \return TRUE/FALSE if the lease holds a frame or not.
+         */
+        bool IsValid() const;
+
+        /**
+         * \brief Gets the leased frame.
+         *
+         * \note The frame data is invalid if the stream was stopped, but the DMA-BUF file descriptor remains valid.
+         *
+         * \return The leased frame (must not be called on an empty lease).
+         */
+        const CaptureFrame& GetFrame() const;
+
+        /**
+         * \brief Gets the DMA-BUF file descriptor of the leased frame.
+         *
+         * \return The file descriptor (owned by the lease, valid until its last copy is released), or -1.
+         */
+        int GetDmaBufFD() const;
+
+        /**
+         * \brief Gets the number of leases of the frame.
+         *
+         * \return The number of leases (0 if the lease is empty).
+         */
+        unsigned int GetRefs() const;
+};
+
+/**
+ * \brief CPU mapping of an imported DMA-BUF.
+ *
+ * The import duplicates the file descriptor, so the memory remains valid after the lease is released or the stream is
+ * stopped (but the buffer can be filled again by the V4L2 driver once its last lease is released).
+ */
+class DmaBufImport
+{
+    private:
+        int fd;             /**< Duplicated DMA-BUF file descriptor. */
+        void *data;         /**< Read-only mapping. */
+        size_t len;         /**< Mapping length. */
+
+    public:
+        /**
+         * \brief Constructor.
+         *
+         * \return None.
+         */
+        DmaBufImport();
+
+        DmaBufImport(const DmaBufImport&) = delete;
+
+        DmaBufImport& operator=(const DmaBufImport&) = delete;
+
+        /**
+         * \brief Destructor (releases the import).
+         *
+         * \return None.
+         */
+        ~DmaBufImport();
+
+        /**
+         * \brief Imports a DMA-BUF file descriptor.
+         *
+         * \param[in] dmabuf_fd is the DMA-BUF file descriptor (it is duplicated, the caller keeps its ownership).
+         * \param[in] length is the number of bytes to map.
+         *
+         * \return TRUE/FALSE if successful or not.
+         */
+        bool Import(int dmabuf_fd, size_t length);
+
+        /**
+         * \brief Imports the DMA-BUF of a leased frame.
+         *
+         * \param[in] lease is the frame lease.
+         *
+         * \return TRUE/FALSE if successful or not.
+         */
+        bool Import(const FrameLease &lease);
+
+        /**
+         * \brief Unmaps and closes the import.
+         *
+         * \return None.
+         */
+        void Release();
+
+        /**
+         * \brief Starts a CPU read access (DMA_BUF_IOCTL_SYNC, makes the device writes visible to the CPU).
+         *
+         * \return TRUE/FALSE if successful or not.
+         */
+        bool BeginAccess();
+
+        /**
+         * \brief Ends a CPU read access started by "BeginAccess".
+         *
+         * \return TRUE/FALSE if successful or not.
+         */
+        bool EndAccess();
+
+        /**
+         * \brief Gets the mapped data.
+         *
+         * \return A pointer to the data, or NULL if nothing is imported.
+         */
+        const uint8_t* GetData() const;
+
+        /**
+         * \brief Gets the mapped length.
+         *
+         * \return The number of mapped bytes.
+         */
+        size_t GetLength() const;
+
+        /**
+         * \brief Gets the duplicated file descriptor (ex.: to queue it in an encoder with V4L2_MEMORY_DMABUF).
+         *
+         * \return The file descriptor, or -1 if nothing is imported.
+         */
+        int GetFD() const;
+};
+
+/**
+ * \brief V4L2 capture of the MT9D111 frames.
+ */
+class MT9D111Capture
+{
+    private:
+        int fd;                                                 /**< V4L2 device file descriptor. */
+        int last_error;                                         /**< errno of the last failed operation. */
+
+        uint32_t pixel_format;                                  /**< Negotiated V4L2 pixel format. */
+        uint16_t width;                                         /**< Negotiated width in pixels. */
+        uint16_t height;                                        /**< Negotiated height in pixels. */
+        uint32_t bytes_per_line;                                /**< Negotiated line stride in bytes. */
+        uint32_t frame_size;                                    /**< Negotiated max. frame size in bytes. */
+
+        CaptureBuffer buffers[MT9D111_CAPTURE_MAX_BUFFERS];     /**< Buffers ring. */
+        unsigned int buffers_len;                               /**< Number of buffers of the ring. */
+        bool streaming;                                         /**< The stream is on. */
+
+        std::mutex ring_mutex;                                  /**< Lock of the ring (leases are released by any thread). */
+        uint32_t generation;                                    /**< Stream generation (incremented by "Stop"). */
+        CaptureLink *link;                                      /**< Link shared with the leases of the frames. */
+
+        bool sequence_valid;                                    /**< "last_sequence" is valid. */
+        uint32_t last_sequence;                                 /**< Sequence number of the last frame. */
+        unsigned long dropped_frames;                           /**< Number of gaps in the sequence numbers. */
+
+        /**
+         * \brief Executes an ioctl on the V4L2 device (retried if interrupted).
+         *
+         * \param[in] req is the ioctl request.
+         * \param[in,out] arg is the ioctl argument.
+         *
+         * \return TRUE/FALSE if successful or not (see "GetLastError").
+         */
+        bool IOCtl(unsigned long req, void *arg);
+
+        /**
+         * \brief Unmaps and frees the buffers of the ring.
+         *
+         * \return None.
+         */
+        void ReleaseBuffers();
+
+        /**
+         * \brief Queues a buffer (the ring lock must be held).
+         *
+         * \param[in] index is the buffer index.
+         *
+         * \return TRUE/FALSE if successful or not.
+         */
+        bool QueueBuffer(unsigned int index);
+
+        /**
+         * \brief Queues the buffer of a frame whose last lease was released.
+         *
+         * \param[in] index is the buffer index.
+         * \param[in] gen is the stream generation of the frame (nothing is done if the stream was stopped since).
+         *
+         * \return TRUE/FALSE if the buffer was queued or not.
+         */
+        bool ReleaseLease(unsigned int index, uint32_t gen);
+
+        friend class FrameLease;
+
+    public:
+        /**
+         * \brief Constructor.
+         *
+         * \return None.
+         */
+        MT9D111Capture();
+
+        /**
+         * \brief Destructor (stops the stream and closes the device).
+         *
+         * The leases still held are detached from the capture object, and releasing them does nothing.
+         *
+         * \return None.
+         */
+        ~MT9D111Capture();
+
+        /**
+         * \brief Opens a V4L2 capture device.
+         *
+         * The device must support single-planar video capture and streaming I/O.
+         *
+         * \param[in] dev is the device path (ex.: "/dev/video0").
+         *
+         * \return TRUE/FALSE if successful or not.
+         */
+        bool Open(const char *dev=MT9D111_CAPTURE_DEFAULT_DEVICE);
+
+        /**
+         * \brief Stops the stream and closes the device.
+         *
+         * \return TRUE/FALSE if successful or not.
+         */
+        bool Close();
+
+        /**
+         * \brief Gets the V4L2 pixel format of an output format of the sensor.
+         *
+         * \param[in] format is the output format (MT9D111_OUTPUT_FORMAT_YCbCr, MT9D111_OUTPUT_FORMAT_RGB565, etc.).
+         *
+         * \return The V4L2 pixel format, or 0 if there is no V4L2 format with the byte order of the sensor (the RGB444
+         *         and the raw 8+2 formats). In this case, "SetPixelFormat" must be used.
+         */
+        static uint32_t GetPixelFormat(uint8_t format);
+
+        /**
+         * \brief Sets the V4L2 format matching an output format of the sensor.
+         *
+         * \see GetPixelFormat
+         *
+         * \param[in] format is the output format (MT9D111_OUTPUT_FORMAT_YCbCr, MT9D111_OUTPUT_FORMAT_RGB565, etc.).
+         * \param[in] width is the frame width in pixels.
+         * \param[in] height is the frame height in pixels.
+         *
+         * \return TRUE/FALSE if successful or not.
+         */
+        bool SetFormat(uint8_t format, uint16_t width, uint16_t height);
+
+        /**
+         * \brief Sets the V4L2 format.
+         *
+         * The V4L2 driver can adjust the frame size (see "GetWidth" and "GetHeight"), but not the pixel format. It
+         * cannot be called while the stream is on.
+         *
+         * \param[in] fourcc is the V4L2 pixel format (V4L2_PIX_FMT_*).
+         * \param[in] width is the frame width in pixels.
+         * \param[in] height is the frame height in pixels.
+         *
+         * \return TRUE/FALSE if successful or not.
+         */
+        bool SetPixelFormat(uint32_t fourcc, uint16_t width, uint16_t height);
+
+        /**
+         * \brief Configures the sensor and the V4L2 device with the same format.
+         *
+         * The V4L2 format is negotiated first, and the sensor is configured with the negotiated frame size
+         * ("SetOutputFormat" and "SetResolution"). The sensor mode is not changed.
+         *
+         * \param[in,out] cam is the sensor.
+         * \param[in] mode is the sensor mode of the frame size (MT9D111_MODE_PREVIEW or MT9D111_MODE_CAPTURE).
+         * \param[in] format is the output format (MT9D111_OUTPUT_FORMAT_YCbCr, MT9D111_OUTPUT_FORMAT_RGB565, etc.).
+         * \param[in] width is the frame width in pixels.
+         * \param[in] height is the frame height in pixels.
+         *
+         * \return TRUE/FALSE if successful or not.
+         */
+        bool Configure(MT9D111 &cam, uint8_t mode, uint8_t format, uint16_t width, uint16_t height);
+
+        /**
+         * \brief Gets the negotiated frame width.
+         *
+         * \return The frame width in pixels.
+         */
+        uint16_t GetWidth();
+
+        /**
+         * \brief Gets the negotiated frame height.
+         *
+         * \return The frame height in pixels.
+         */
+        uint16_t GetHeight();
+
+        /**
+         * \brief Gets the negotiated line stride.
+         *
+         * \return The number of bytes of a line (0 for compressed formats).
+         */
+        uint32_t GetBytesPerLine();
+
+        /**
+         * \brief Gets the negotiated max. frame size.
+         *
+         * \return The max. number of bytes of a frame.
+         */
+        uint32_t GetFrameSize();
+
+        /**
+         * \brief Allocates and maps the buffers ring, queues all the buffers and starts the stream.
+         *
+         * \param[in] n is the number of buffers (the V4L2 driver can allocate a different number, see "GetBuffers").
+         * \param[in] dmabuf is TRUE to export the buffers as DMA-BUF file descriptors (VIDIOC_EXPBUF).
+         *
+         * \return TRUE/FALSE if successful or not.
+         */
+        bool Start(unsigned int n=MT9D111_CAPTURE_DEFAULT_BUFFERS, bool dmabuf=false);
+
+        /**
+         * \brief Stops the stream and frees the buffers ring.
+         *
+         * The frames not queued again are invalid after this call, and releasing their leases does nothing (the
+         * DMA-BUF file descriptors of the leases remain valid).
+         *
+         * \return TRUE/FALSE if successful or not.
+         */
+        bool Stop();
+
+        /**
+         * \brief Waits the next captured frame.
+         *
+         * The buffer of the frame is owned by the caller until "Queue" is called, so the number of frames that can be
+         * held at the same time must be lower than the number of buffers, otherwise the V4L2 driver drops frames.
+         *
+         * \param[out] frame is the captured frame.
+         * \param[in] timeout_ms is the timeout in milliseconds (-1 to wait forever).
+         *
+         * \return TRUE/FALSE if a frame was received or not (ETIMEDOUT on timeout).
+         */
+        bool Dequeue(CaptureFrame &frame, int timeout_ms=-1);
+
+        /**
+         * \brief Gives the buffer of a frame back to the V4L2 driver.
+         *
+         * \param[in] frame is a frame returned by "Dequeue".
+         *
+         * \return TRUE/FALSE if successful or not.
+         */
+        bool Queue(const CaptureFrame &frame);
+
+        /**
+         * \brief Waits the next captured frame and leases it.
+         *
+         * The buffer of the frame is queued again when the last copy of the lease is released.
+         *
+         * \param[out] lease is the lease of the captured frame (its previous frame is released).
+         * \param[in] timeout_ms is the timeout in milliseconds (-1 to wait forever).
+         *
+         * \return TRUE/FALSE if a frame was received or not (ETIMEDOUT on timeout).
+         */
+        bool Acquire(FrameLease &lease, int timeout_ms=-1);
+
+        /**
+         * \brief Gets the number of buffers of the ring.
+         *
+         * \return The number of allocated buffers.
+         */
+        unsigned int GetBuffers();
+
+        /**
+         * \brief Gets the number of dropped frames since "Start" (gaps in the sequence numbers).
+         *
+         * \return The number of dropped frames.
+         */
+        unsigned long GetDroppedFrames();
+
+        /**
+         * \brief Gets the error of the last failed operation.
+         *
+         * \return The errno value.
+         */
+        int GetLastError();
+};
+
+#endif // MT9D111_CAPTURE_H_
+
+//! \} End of capture group
@@ -38,11 +38,12 @@
 #define MT9D111_CONFIG_H_
 
 #include "mt9d111_reg.h"
+#include "mt9d111_op.h"
 
 /**
  * \brief Default registers values (Values after boot).
  */
-const Register reg_default_vals[] = 
+constexpr Register reg_default_vals[] = 
 {
     {MT9D111_REG_ROW_START,                     MT9D111_REG_PAGE_0,             0x001C},
     {MT9D111_REG_COLUMN_START,                  MT9D111_REG_PAGE_0,             0x003C},
@@ -106,7 +107,7 @@ const Register reg_default_vals[] =
  *
  * \see https://github.com/ArduCAM/Arduino/blob/master/ArduCAM/mt9d111_regs.h
  */
-const Register reg_vals_qvga_30fps[] =
+constexpr Register reg_vals_qvga_30fps[] =
 {
     {MT9D111_REG_PAGE_REGISTER                                          , MT9D111_REG_PAGE_0,   MT9D111_REG_PAGE_0},
     {0x33                                                               , MT9D111_REG_PAGE_0,   0x0343},    // RESERVED_CORE_33
@@ -117,7 +118,7 @@ const Register reg_vals_qvga_30fps[] =
 
     {MT9D111_REG_PAGE_REGISTER                                          , MT9D111_REG_PAGE_0,   MT9D111_REG_PAGE_0},
     {0x38                                                               , MT9D111_REG_PAGE_0,   0x0866},    // RESERVED_CORE_38
-    // Delay = 100ms
+    MT9D111_REG_DELAY(100),
 
     {MT9D111_REG_PAGE_REGISTER                                          , MT9D111_REG_PAGE_2,   MT9D111_REG_PAGE_2},
     {MT9D111_REG_LENS_CORRECTION_CONTROL                                , MT9D111_REG_PAGE_2,   0x0168},    // LENS_CORRECTION_CONTROL
@@ -170,14 +171,14 @@ const Register reg_vals_qvga_30fps[] =
 
     {MT9D111_REG_PAGE_REGISTER                                          , MT9D111_REG_PAGE_1,   MT9D111_REG_PAGE_1},
     {MT9D111_REG_COLOR_PIPELINE_CONTROL                                 , MT9D111_REG_PAGE_1,   0x01FC},    // COLOR_PIPELINE_CONTROL
-    // Delay = 100ms
+    MT9D111_REG_DELAY(100),
 
     {MT9D111_REG_PAGE_REGISTER                                          , MT9D111_REG_PAGE_1,   MT9D111_REG_PAGE_1},
     {MT9D111_REG_YUV_YCbCr_CONTROL                                      , MT9D111_REG_PAGE_1,   0x0004},    // YUV_YCBCR_CONTROL
 
     {MT9D111_REG_PAGE_REGISTER                                          , MT9D111_REG_PAGE_0,   MT9D111_REG_PAGE_0},
     {MT9D111_REG_CLOCK_CONTROL                                          , MT9D111_REG_PAGE_0,   0xA000},    // CLOCK_ENABLING
-    // Delay = 100ms
+    MT9D111_REG_DELAY(100),
 
     {MT9D111_REG_PAGE_REGISTER                                          , MT9D111_REG_PAGE_1,   MT9D111_REG_PAGE_1},
     {MT9D111_REG_MICROCONTROLLER_VARIABLE_ADDRESS                       , MT9D111_REG_PAGE_1,   0xA102},    // SEQ_MODE
@@ -281,7 +282,7 @@ const Register reg_vals_qvga_30fps[] =
     {MT9D111_REG_MICROCONTROLLER_VARIABLE_DATA                          , MT9D111_REG_PAGE_1,   0x0003},    // MODE_GAM_CONT_A
     {MT9D111_REG_MICROCONTROLLER_VARIABLE_ADDRESS                       , MT9D111_REG_PAGE_1,   0xA744},    // MODE_GAM_CONT_B
     {MT9D111_REG_MICROCONTROLLER_VARIABLE_DATA                          , MT9D111_REG_PAGE_1,   0x0003},    // MODE_GAM_CONT_B
-    // Delay = 500 ms
+    MT9D111_REG_DELAY(500),
 
     {MT9D111_REG_PAGE_REGISTER                                          , MT9D111_REG_PAGE_1,   MT9D111_REG_PAGE_1},
     {MT9D111_REG_MICROCONTROLLER_VARIABLE_ADDRESS                       , MT9D111_REG_PAGE_1,   0x2703},    // MODE_OUTPUT_WIDTH_A
@@ -302,6 +303,11 @@ const Register reg_vals_qvga_30fps[] =
     {MT9D111_REG_RESERVED_2                                             , MT9D111_REG_PAGE_0,   0xFFFF}
 };
 
+/**
+ * \brief QVGA (320x240) at 30 FPS (compiled list of operations).
+ */
+constexpr auto ops_qvga_30fps = CompileRegs(reg_vals_qvga_30fps);
+
 #endif // MT9D111_CONFIG_H_
 
 //! \} End of config group
@@ -37,6 +37,9 @@
 #ifndef MT9D111_DRIVER_H_
 #define MT9D111_DRIVER_H_
 
+#include <stdint.h>
+#include <stddef.h>
+
 // Address for physical access
 #define MT9D111_DRIVER_PHYSICAL_ACCESS_ADDRESS_LOGICAL                  (1 << 13)   /**< Logical access. */
 
@@ -480,7 +483,7 @@ struct Monitor
     char msgCount;                      /**< Number of posted messages. */
     uint32_t msg;                       /**< First message (unused). */
     uint8_t ver;                        /**< Firmware version. */
-};
+} __attribute__((packed));
 
 /**
  * \brief Shared (between capture and preview modes) parameters.
@@ -496,6 +499,7 @@ struct SharedParams
     uint8_t awbContStep;                /**< . */
     uint8_t awbFastBuff;                /**< . */
     uint8_t awbFastStep;                /**< . */
+    uint8_t reserved0[3];               /**< Reserved. */
     uint8_t totalMaxFrames;             /**< . */
     uint8_t flashTH;                    /**< . */
     uint8_t outdoorTH;                  /**< . */
@@ -510,7 +514,7 @@ struct SharedParams
     uint8_t LLApCorr2;                  /**< . */
     uint8_t LLApThresh1;                /**< . */
     uint8_t LLApThresh2;                /**< . */
-};
+} __attribute__((packed));
 
 /**
  * \brief Capture mode parameters.
@@ -519,7 +523,7 @@ struct CaptureParams
 {
     uint8_t mode;                       /**< Capture mode. */
     uint8_t numFrames;                  /**< Number of frames captured in still capture mode. */
-};
+} __attribute__((packed));
 
 /**
  * \brief Preview mode parameters.
@@ -533,7 +537,7 @@ struct PreviewParams
     uint8_t hg;                         /**< . */
     uint8_t flash;                      /**< . */
     uint8_t skipFrame;                  /**< . */
-};
+} __attribute__((packed));
 
 /**
  * \brief .
@@ -548,7 +552,7 @@ struct Sequencer
     SharedParams sharedParams;          /**< . */
     CaptureParams captureParams;        /**< . */
     PreviewParams previewParams[4];     /**< . */
-};
+} __attribute__((packed));
 
 /**
  * \brief Auto Exposure driver variables.
@@ -570,8 +574,9 @@ struct AutoExposure
     uint8_t minVirtGain;                /**< . */
     uint8_t maxVirtGain;                /**< . */
     uint8_t maxADChi;                   /**< . */
+    uint8_t minADChi;                   /**< . */
     uint8_t minADClo;                   /**< . */
-    uint8_t maxDGainAE1;                /**< . */
+    uint16_t maxDGainAE1;               /**< . */
     uint8_t maxDGainAE2;                /**< . */
     uint8_t IndexTH23;                  /**< . */
     uint8_t maxGain23;                  /**< . */
@@ -583,27 +588,29 @@ struct AutoExposure
     uint8_t VirtGain;                   /**< . */
     uint8_t ADC_hi;                     /**< . */
     uint8_t ADC_lo;                     /**< . */
-    uint8_t DGainAE1;                   /**< . */
+    uint16_t DGainAE1;                  /**< . */
     uint8_t DGainAE2;                   /**< . */
-    uint8_t R9;                         /**< . */
+    uint16_t R9;                        /**< . */
     uint8_t R65;                        /**< . */
-    uint8_t rowTime;                    /**< . */
+    uint16_t rowTime;                   /**< . */
     uint8_t gainR12;                    /**< . */
     uint8_t SkipFrames_cnt;             /**< . */
-    uint8_t BufferedLuma;               /**< . */
+    uint16_t BufferedLuma;              /**< . */
     uint8_t dirAE_prev;                 /**< . */
     uint16_t R9_step;                   /**< . */
+    uint8_t reserved0;                  /**< Reserved. */
     uint8_t maxADClo;                   /**< . */
     uint16_t physGainR;                 /**< . */
     uint16_t physGainG;                 /**< . */
     uint16_t physGainB;                 /**< . */
+    uint8_t reserved1[25];              /**< Reserved. */
     uint8_t mmEVZone1;                  /**< . */
     uint8_t mmEVZone2;                  /**< . */
     uint8_t mmEVZone3;                  /**< . */
     uint8_t mmEVZone4;                  /**< . */
     uint8_t mmShiftEV;                  /**< . */
     uint8_t numOE;                      /**< . */
-};
+} __attribute__((packed));
 
 /**
  * \brief Auto White Balance driver variables.
@@ -638,7 +645,7 @@ struct AutoWhiteBalance
     uint8_t steadyBGainOutMax;          /**< . */
     uint8_t steadyBGainInMin;           /**< . */
     uint8_t steadyBGainInMax;           /**< . */
-    uint8_t cntPxITH;                   /**< . */
+    uint16_t cntPxITH;                  /**< . */
     uint8_t TG_min0;                    /**< . */
     uint8_t TG_max0;                    /**< . */
     uint8_t X0;                         /**< . */
@@ -648,7 +655,7 @@ struct AutoWhiteBalance
     uint8_t kR_R;                       /**< . */
     uint8_t kG_R;                       /**< . */
     uint8_t kB_R;                       /**< . */
-};
+} __attribute__((packed));
 
 /**
  * \brief Flicker Detection driver variables.
@@ -673,7 +680,7 @@ struct FlickerDetection
     uint16_t R9_step60;                 /**< Minimal shutter width step for 60Hz AC. */
     uint16_t R9_step50;                 /**< Minimal shutter width step for 50Hz AC. */
     uint8_t Buffer[48];                 /**< Reserved. */
-};
+} __attribute__((packed));
 
 /**
  * \brief Auto Focus driver variables.
@@ -691,11 +698,11 @@ struct AutoFocus
     uint8_t stepSize;                   /**< Logical step size for the second scan. */
     uint16_t wakeUpLine;                /**< Number of image row at which the MCU wakes up to execute AF driver code. */
     uint32_t zoneWeights;               /**< Weights of the AF windows or zones. */
-    uint16_t distanceWeight;            /**< Reserved. */
+    uint8_t distanceWeight;             /**< Reserved. */
     uint8_t bestPosition;               /**< This variable is used in 3 different ways depending on values of bits 6 and 7 of af->mode. */
     uint8_t shaTH;                      /**< Sharpness score variability threshold. */
     uint8_t positions[20];              /**< Programmable logical lens positions. */
-};
+} __attribute__((packed));
 
 /**
  * \brief .
@@ -709,8 +716,8 @@ struct Timer
     uint16_t maxShortDelay;             /**< . */
     uint16_t maxLongDelay;              /**< . */
     uint8_t maxQuickMove;               /**< . */
-    uint8_t config;                     
-};
+    uint8_t config;                     /**< . */
+} __attribute__((packed));
 
 /**
  * \brief .
@@ -723,7 +730,7 @@ struct SI
     uint16_t clkQtrPrd;                 /**< . */
     uint8_t needsAck;                   /**< . */
     uint8_t slaveAddr;                  /**< . */
-};
+} __attribute__((packed));
 
 /**
  * \brief .
@@ -735,13 +742,13 @@ struct SM
     uint8_t drv1Mask;                   /**< . */
     uint8_t drv2Mask;                   /**< . */
     uint8_t drv3Mask;                   /**< . */
-    uint8_t drvsQtrPrd;                 /**< . */
+    uint16_t drvsQtrPrd;                /**< . */
     uint8_t drvsGenMode;                /**< . */
     uint16_t piEnabMask;                /**< . */
     uint16_t piOutMask;                 /**< . */
     uint8_t piEdgeOffset;               /**< . */
     uint8_t piConfig;                   /**< . */
-};
+} __attribute__((packed));
 
 /**
  * \brief .
@@ -761,7 +768,7 @@ struct AutoFocusMechanics
     Timer timer;                        /**< . */
     SI si;                              /**< . */
     SM sm;                              /**< . */
-};
+} __attribute__((packed));
 
 /**
  * \brief Mode/Context driver variables.
@@ -793,11 +800,13 @@ struct Mode
     uint16_t crop_Y0_A;                 /**< . */
     uint16_t crop_Y1_A;                 /**< . */
     uint16_t dec_ctrl_A;                /**< . */
+    uint8_t reserved0[4];               /**< Reserved. */
     uint16_t crop_X0_B;                 /**< . */
     uint16_t crop_X1_B;                 /**< . */
     uint16_t crop_Y0_B;                 /**< . */
     uint16_t crop_Y1_B;                 /**< . */
     uint16_t dec_ctrl_B;                /**< . */
+    uint8_t reserved1[4];               /**< Reserved. */
     uint8_t gam_cont_A;                 /**< . */
     uint8_t gam_cont_B;                 /**< . */
     uint8_t gamma_table_A_0;            /**< . */
@@ -854,7 +863,7 @@ struct Mode
     uint16_t spec_effects_B;            /**< . */
     uint8_t y_rgb_offset_A;             /**< . */
     uint8_t y_rgb_offset_B;             /**< . */
-};
+} __attribute__((packed));
 
 /**
  * \brief JPEG driver variables.
@@ -874,7 +883,7 @@ struct JPEG
     uint8_t state;                      /**< JPEG driver state. */
     uint8_t dataLengthMSB;              /**< Bit [23:16] of previous frame JPEG data length. */
     uint16_t dataLengthLSBs;            /**< Bit [15:0] of previous frame JPEG data length. */
-};
+} __attribute__((packed));
 
 /**
  * \brief Histogram driver variables.
@@ -894,7 +903,7 @@ struct Histogram
     uint16_t DLevel_buf;                /**< Buffered current offset. */
     uint8_t factorHi;                   /**< Factor of overexposure compensation for mettering mode. */
     uint8_t percentHi;                  /**< Highlight clipping 255 - 100%. */
-};
+} __attribute__((packed));
 
 /**
  * \brief Driver virables.
@@ -911,6 +920,254 @@ struct Driver
     Mode mode;                          /**< . */
     JPEG jpeg;                          /**< . */
     Histogram hg;                       /**< . */
+} __attribute__((packed));
+
+// Layout checks (the structs must match the variables offsets of the firmware drivers)
+static_assert(offsetof(Monitor, cmd) == MT9D111_DRIVER_VAR_MONITOR_CMD, "Wrong offset of Monitor.cmd!");
+static_assert(offsetof(Monitor, arg1) == MT9D111_DRIVER_VAR_MONITOR_ARG1, "Wrong offset of Monitor.arg1!");
+static_assert(offsetof(Monitor, arg2) == MT9D111_DRIVER_VAR_MONITOR_ARG2, "Wrong offset of Monitor.arg2!");
+static_assert(offsetof(Monitor, msgCount) == MT9D111_DRIVER_VAR_MONITOR_MSG_COUNT, "Wrong offset of Monitor.msgCount!");
+static_assert(offsetof(Monitor, msg) == MT9D111_DRIVER_VAR_MONITOR_MSG, "Wrong offset of Monitor.msg!");
+static_assert(offsetof(Monitor, ver) == MT9D111_DRIVER_VAR_MONITOR_VER, "Wrong offset of Monitor.ver!");
+
+static_assert(offsetof(Sequencer, mode) == MT9D111_DRIVER_VAR_SEQUENCER_MODE, "Wrong offset of Sequencer.mode!");
+static_assert(offsetof(Sequencer, cmd) == MT9D111_DRIVER_VAR_SEQUENCER_CMD, "Wrong offset of Sequencer.cmd!");
+static_assert(offsetof(Sequencer, state) == MT9D111_DRIVER_VAR_SEQUENCER_STATE, "Wrong offset of Sequencer.state!");
+static_assert(offsetof(Sequencer, stepMode) == MT9D111_DRIVER_VAR_SEQUENCER_STEP_MODE, "Wrong offset of Sequencer.stepMode!");
+static_assert(offsetof(Sequencer, sharedParams.flashType) == MT9D111_DRIVER_VAR_SEQUENCER_SHARED_PARAMS_FLASH_TYPE, "Wrong offset of Sequencer.sharedParams.flashType!");
+static_assert(offsetof(Sequencer, sharedParams.awbFastStep) == MT9D111_DRIVER_VAR_SEQUENCER_SHARED_PARAMS_AWB_FAST_STEP, "Wrong offset of Sequencer.sharedParams.awbFastStep!");
+static_assert(offsetof(Sequencer, sharedParams.totalMaxFrames) == MT9D111_DRIVER_VAR_SEQUENCER_SHARED_PARAMS_TOTAL_MAX_FRAMES, "Wrong offset of Sequencer.sharedParams.totalMaxFrames!");
+static_assert(offsetof(Sequencer, sharedParams.LLApThresh2) == MT9D111_DRIVER_VAR_SEQUENCER_SHARED_PARAMS_LL_AP_THRESH_2, "Wrong offset of Sequencer.sharedParams.LLApThresh2!");
+static_assert(offsetof(Sequencer, captureParams.mode) == MT9D111_DRIVER_VAR_SEQUENCER_CAPTURE_PARAMS_MODE, "Wrong offset of Sequencer.captureParams.mode!");
+static_assert(offsetof(Sequencer, captureParams.numFrames) == MT9D111_DRIVER_VAR_SEQUENCER_CAPTURE_PARAMS_NUM_FRAMES, "Wrong offset of Sequencer.captureParams.numFrames!");
+static_assert(offsetof(Sequencer, previewParams[0].ae) == MT9D111_DRIVER_VAR_SEQUENCER_PREVIEW_PARAMS_0_AE, "Wrong offset of Sequencer.previewParams[0].ae!");
+static_assert(offsetof(Sequencer, previewParams[1].ae) == MT9D111_DRIVER_VAR_SEQUENCER_PREVIEW_PARAMS_1_AE, "Wrong offset of Sequencer.previewParams[1].ae!");
+static_assert(offsetof(Sequencer, previewParams[2].ae) == MT9D111_DRIVER_VAR_SEQUENCER_PREVIEW_PARAMS_2_AE, "Wrong offset of Sequencer.previewParams[2].ae!");
+static_assert(offsetof(Sequencer, previewParams[3].skipFrame) == MT9D111_DRIVER_VAR_SEQUENCER_PREVIEW_PARAMS_3_SKIP_FRAME, "Wrong offset of Sequencer.previewParams[3].skipFrame!");
+
+static_assert(offsetof(AutoExposure, windowPos) == MT9D111_DRIVER_VAR_AUTO_EXPOSURE_WINDOW_POS, "Wrong offset of AutoExposure.windowPos!");
+static_assert(offsetof(AutoExposure, wakeUpLine) == MT9D111_DRIVER_VAR_AUTO_EXPOSURE_WAKE_UP_LINE, "Wrong offset of AutoExposure.wakeUpLine!");
+static_assert(offsetof(AutoExposure, masR12) == MT9D111_DRIVER_VAR_AUTO_EXPOSURE_MAX_R12, "Wrong offset of AutoExposure.masR12!");
+static_assert(offsetof(AutoExposure, maxADChi) == MT9D111_DRIVER_VAR_AUTO_EXPOSURE_MAX_ADC_HI, "Wrong offset of AutoExposure.maxADChi!");
+static_assert(offsetof(AutoExposure, minADChi) == MT9D111_DRIVER_VAR_AUTO_EXPOSURE_MIN_ADC_HI, "Wrong offset of AutoExposure.minADChi!");
+static_assert(offsetof(AutoExposure, minADClo) == MT9D111_DRIVER_VAR_AUTO_EXPOSURE_MIN_ADC_LO, "Wrong offset of AutoExposure.minADClo!");
+static_assert(offsetof(AutoExposure, maxDGainAE1) == MT9D111_DRIVER_VAR_AUTO_EXPOSURE_MAX_D_GAIN_AE1, "Wrong offset of AutoExposure.maxDGainAE1!");
+static_assert(offsetof(AutoExposure, maxDGainAE2) == MT9D111_DRIVER_VAR_AUTO_EXPOSURE_MAX_D_GAIN_AE2, "Wrong offset of AutoExposure.maxDGainAE2!");
+static_assert(offsetof(AutoExposure, R12) == MT9D111_DRIVER_VAR_AUTO_EXPOSURE_R12, "Wrong offset of AutoExposure.R12!");
+static_assert(offsetof(AutoExposure, DGainAE1) == MT9D111_DRIVER_VAR_AUTO_EXPOSURE_D_GAIN_AE1, "Wrong offset of AutoExposure.DGainAE1!");
+static_assert(offsetof(AutoExposure, DGainAE2) == MT9D111_DRIVER_VAR_AUTO_EXPOSURE_D_GAIN_AE2, "Wrong offset of AutoExposure.DGainAE2!");
+static_assert(offsetof(AutoExposure, R9) == MT9D111_DRIVER_VAR_AUTO_EXPOSURE_R9, "Wrong offset of AutoExposure.R9!");
+static_assert(offsetof(AutoExposure, R65) == MT9D111_DRIVER_VAR_AUTO_EXPOSURE_R65, "Wrong offset of AutoExposure.R65!");
+static_assert(offsetof(AutoExposure, rowTime) == MT9D111_DRIVER_VAR_AUTO_EXPOSURE_ROW_TIME, "Wrong offset of AutoExposure.rowTime!");
+static_assert(offsetof(AutoExposure, gainR12) == MT9D111_DRIVER_VAR_AUTO_EXPOSURE_GAIN_R12, "Wrong offset of AutoExposure.gainR12!");
+static_assert(offsetof(AutoExposure, BufferedLuma) == MT9D111_DRIVER_VAR_AUTO_EXPOSURE_BUFFERED_LUMA, "Wrong offset of AutoExposure.BufferedLuma!");
+static_assert(offsetof(AutoExposure, dirAE_prev) == MT9D111_DRIVER_VAR_AUTO_EXPOSURE_DIR_AE_PREV, "Wrong offset of AutoExposure.dirAE_prev!");
+static_assert(offsetof(AutoExposure, R9_step) == MT9D111_DRIVER_VAR_AUTO_EXPOSURE_R9_STEP, "Wrong offset of AutoExposure.R9_step!");
+static_assert(offsetof(AutoExposure, maxADClo) == MT9D111_DRIVER_VAR_AUTO_EXPOSURE_MAX_ADC_LO, "Wrong offset of AutoExposure.maxADClo!");
+static_assert(offsetof(AutoExposure, physGainR) == MT9D111_DRIVER_VAR_AUTO_EXPOSURE_PHYS_GAIN_R, "Wrong offset of AutoExposure.physGainR!");
+static_assert(offsetof(AutoExposure, physGainB) == MT9D111_DRIVER_VAR_AUTO_EXPOSURE_PHYS_GAIN_B, "Wrong offset of AutoExposure.physGainB!");
+static_assert(offsetof(AutoExposure, mmEVZone1) == MT9D111_DRIVER_VAR_AUTO_EXPOSURE_MM_EV_ZONE_1, "Wrong offset of AutoExposure.mmEVZone1!");
+static_assert(offsetof(AutoExposure, numOE) == MT9D111_DRIVER_VAR_AUTO_EXPOSURE_NUM_OE, "Wrong offset of AutoExposure.numOE!");
+
+static_assert(offsetof(AutoWhiteBalance, wakeUpLine) == MT9D111_DRIVER_VAR_AUTO_WHITE_BALANCE_WAKEUP_LINE, "Wrong offset of AutoWhiteBalance.wakeUpLine!");
+static_assert(offsetof(AutoWhiteBalance, ccmL) == MT9D111_DRIVER_VAR_AUTO_WHITE_BALANCE_CCM_L_0, "Wrong offset of AutoWhiteBalance.ccmL!");
+static_assert(offsetof(AutoWhiteBalance, ccmRL) == MT9D111_DRIVER_VAR_AUTO_WHITE_BALANCE_CCM_RL_0, "Wrong offset of AutoWhiteBalance.ccmRL!");
+static_assert(offsetof(AutoWhiteBalance, ccm) == MT9D111_DRIVER_VAR_AUTO_WHITE_BALANCE_CCM_0, "Wrong offset of AutoWhiteBalance.ccm!");
+static_assert(offsetof(AutoWhiteBalance, GainBufferSpeed) == MT9D111_DRIVER_VAR_AUTO_WHITE_BALANCE_GAIN_BUFFER_SPEED, "Wrong offset of AutoWhiteBalance.GainBufferSpeed!");
+static_assert(offsetof(AutoWhiteBalance, mode) == MT9D111_DRIVER_VAR_AUTO_WHITE_BALANCE_MODE, "Wrong offset of AutoWhiteBalance.mode!");
+static_assert(offsetof(AutoWhiteBalance, GainR_buf) == MT9D111_DRIVER_VAR_AUTO_WHITE_BALANCE_GAIN_R_BUF, "Wrong offset of AutoWhiteBalance.GainR_buf!");
+static_assert(offsetof(AutoWhiteBalance, GainB_buf) == MT9D111_DRIVER_VAR_AUTO_WHITE_BALANCE_GAIN_B_BUF, "Wrong offset of AutoWhiteBalance.GainB_buf!");
+static_assert(offsetof(AutoWhiteBalance, sumR) == MT9D111_DRIVER_VAR_AUTO_WHITE_BALANCE_SUM_R, "Wrong offset of AutoWhiteBalance.sumR!");
+static_assert(offsetof(AutoWhiteBalance, cntPxITH) == MT9D111_DRIVER_VAR_AUTO_WHITE_BALANCE_CNT_PX_ITH, "Wrong offset of AutoWhiteBalance.cntPxITH!");
+static_assert(offsetof(AutoWhiteBalance, TG_min0) == MT9D111_DRIVER_VAR_AUTO_WHITE_BALANCE_TG_MIN_0, "Wrong offset of AutoWhiteBalance.TG_min0!");
+static_assert(offsetof(AutoWhiteBalance, kB_R) == MT9D111_DRIVER_VAR_AUTO_WHITE_BALANCE_K_B_R, "Wrong offset of AutoWhiteBalance.kB_R!");
+
+static_assert(offsetof(FlickerDetection, mode) == MT9D111_DRIVER_VAR_FLICKER_DETECTION_MODE, "Wrong offset of FlickerDetection.mode!");
+static_assert(offsetof(FlickerDetection, wakeUpLine) == MT9D111_DRIVER_VAR_FLICKER_DETECTION_WAKEUP_LINE, "Wrong offset of FlickerDetection.wakeUpLine!");
+static_assert(offsetof(FlickerDetection, smooth_cnt) == MT9D111_DRIVER_VAR_FLICKER_DETECTION_SMOOTH_CNT, "Wrong offset of FlickerDetection.smooth_cnt!");
+static_assert(offsetof(FlickerDetection, minAmplitude) == MT9D111_DRIVER_VAR_FLICKER_DETECTION_MIN_AMPLITUDE, "Wrong offset of FlickerDetection.minAmplitude!");
+static_assert(offsetof(FlickerDetection, R9_step60) == MT9D111_DRIVER_VAR_FLICKER_DETECTION_R9_STEP_60, "Wrong offset of FlickerDetection.R9_step60!");
+static_assert(offsetof(FlickerDetection, R9_step50) == MT9D111_DRIVER_VAR_FLICKER_DETECTION_R9_STEP_50, "Wrong offset of FlickerDetection.R9_step50!");
+static_assert(offsetof(FlickerDetection, Buffer) == MT9D111_DRIVER_VAR_FLICKER_DETECTION_BUFFER, "Wrong offset of FlickerDetection.Buffer!");
+
+static_assert(offsetof(AutoFocus, wakeUpLine) == MT9D111_DRIVER_VAR_AUTO_FOCUS_WAKEUP_LINE, "Wrong offset of AutoFocus.wakeUpLine!");
+static_assert(offsetof(AutoFocus, zoneWeights) == MT9D111_DRIVER_VAR_AUTO_FOCUS_ZONE_WEIGHTS, "Wrong offset of AutoFocus.zoneWeights!");
+static_assert(offsetof(AutoFocus, distanceWeight) == MT9D111_DRIVER_VAR_AUTO_FOCUS_DISTANCE_WEIGHT, "Wrong offset of AutoFocus.distanceWeight!");
+static_assert(offsetof(AutoFocus, bestPosition) == MT9D111_DRIVER_VAR_AUTO_FOCUS_BEST_POSITION, "Wrong offset of AutoFocus.bestPosition!");
+static_assert(offsetof(AutoFocus, shaTH) == MT9D111_DRIVER_VAR_AUTO_FOCUS_SHA_TH, "Wrong offset of AutoFocus.shaTH!");
+static_assert(offsetof(AutoFocus, positions) == MT9D111_DRIVER_VAR_AUTO_FOCUS_POSITIONS_0, "Wrong offset of AutoFocus.positions!");
+
+static_assert(offsetof(AutoFocusMechanics, type) == MT9D111_DRIVER_VAR_AUTO_FOCUS_MECHANICS_TYPE, "Wrong offset of AutoFocusMechanics.type!");
+static_assert(offsetof(AutoFocusMechanics, custCtrl) == MT9D111_DRIVER_VAR_AUTO_FOCUS_MECHANICS_CUST_CTRLS, "Wrong offset of AutoFocusMechanics.custCtrl!");
+static_assert(offsetof(AutoFocusMechanics, timer.vmt) == MT9D111_DRIVER_VAR_AUTO_FOCUS_MECHANICS_TIMER_VMT, "Wrong offset of AutoFocusMechanics.timer.vmt!");
+static_assert(offsetof(AutoFocusMechanics, timer.config) == MT9D111_DRIVER_VAR_AUTO_FOCUS_MECHANICS_TIMER_CONFIG, "Wrong offset of AutoFocusMechanics.timer.config!");
+static_assert(offsetof(AutoFocusMechanics, si.vmt) == MT9D111_DRIVER_VAR_AUTO_FOCUS_MECHANICS_SI_VMT, "Wrong offset of AutoFocusMechanics.si.vmt!");
+static_assert(offsetof(AutoFocusMechanics, si.slaveAddr) == MT9D111_DRIVER_VAR_AUTO_FOCUS_MECHANICS_SI_SLAVE_ADDR, "Wrong offset of AutoFocusMechanics.si.slaveAddr!");
+static_assert(offsetof(AutoFocusMechanics, sm.enabMask) == MT9D111_DRIVER_VAR_AUTO_FOCUS_MECHANICS_SM_ENAB_MASK, "Wrong offset of AutoFocusMechanics.sm.enabMask!");
+static_assert(offsetof(AutoFocusMechanics, sm.drvsQtrPrd) == MT9D111_DRIVER_VAR_AUTO_FOCUS_MECHANICS_SM_DRVS_QTR_PRD, "Wrong offset of AutoFocusMechanics.sm.drvsQtrPrd!");
+static_assert(offsetof(AutoFocusMechanics, sm.drvsGenMode) == MT9D111_DRIVER_VAR_AUTO_FOCUS_MECHANICS_SM_DRVS_GEN_MODE, "Wrong offset of AutoFocusMechanics.sm.drvsGenMode!");
+static_assert(offsetof(AutoFocusMechanics, sm.piConfig) == MT9D111_DRIVER_VAR_AUTO_FOCUS_MECHANICS_SM_PI_CONFIG, "Wrong offset of AutoFocusMechanics.sm.piConfig!");
+
+static_assert(offsetof(Mode, context) == MT9D111_DRIVER_VAR_MODE_CONTEXT, "Wrong offset of Mode.context!");
+static_assert(offsetof(Mode, output_width_A) == MT9D111_DRIVER_VAR_MODE_OUTPUT_WIDTH_A, "Wrong offset of Mode.output_width_A!");
+static_assert(offsetof(Mode, output_height_B) == MT9D111_DRIVER_VAR_MODE_OUTPUT_HEIGHT_B, "Wrong offset of Mode.output_height_B!");
+static_assert(offsetof(Mode, PLL_lock_delay) == MT9D111_DRIVER_VAR_MODE_PLL_LOCL_DELAY, "Wrong offset of Mode.PLL_lock_delay!");
+static_assert(offsetof(Mode, s_row_speed_B) == MT9D111_DRIVER_VAR_MODE_S_ROW_SPEED_B, "Wrong offset of Mode.s_row_speed_B!");
+static_assert(offsetof(Mode, dec_ctrl_A) == MT9D111_DRIVER_VAR_MODE_DEC_CTRL_A, "Wrong offset of Mode.dec_ctrl_A!");
+static_assert(offsetof(Mode, crop_X0_B) == MT9D111_DRIVER_VAR_MODE_CROP_X0_B, "Wrong offset of Mode.crop_X0_B!");
+static_assert(offsetof(Mode, dec_ctrl_B) == MT9D111_DRIVER_VAR_MODE_DEC_CTRL_B, "Wrong offset of Mode.dec_ctrl_B!");
+static_assert(offsetof(Mode, gam_cont_A) == MT9D111_DRIVER_VAR_MODE_GAM_CONT_A, "Wrong offset of Mode.gam_cont_A!");
+static_assert(offsetof(Mode, gamma_table_A_0) == MT9D111_DRIVER_VAR_MODE_GAMMA_TABLE_A_0, "Wrong offset of Mode.gamma_table_A_0!");
+static_assert(offsetof(Mode, gamma_table_B_0) == MT9D111_DRIVER_VAR_MODE_GAMMA_TABLE_B_0, "Wrong offset of Mode.gamma_table_B_0!");
+static_assert(offsetof(Mode, FIFO_config0_A) == MT9D111_DRIVER_VAR_MODE_FIFO_CONFIG0_A, "Wrong offset of Mode.FIFO_config0_A!");
+static_assert(offsetof(Mode, FIFO_config2_A) == MT9D111_DRIVER_VAR_MODE_FIFO_CONFIG2_A, "Wrong offset of Mode.FIFO_config2_A!");
+static_assert(offsetof(Mode, FIFO_len_timing_A) == MT9D111_DRIVER_VAR_MODE_FIFO_LEN_TIMING_A, "Wrong offset of Mode.FIFO_len_timing_A!");
+static_assert(offsetof(Mode, FIFO_len_timing_B) == MT9D111_DRIVER_VAR_MODE_FIFO_LEN_TIMING_B, "Wrong offset of Mode.FIFO_len_timing_B!");
+static_assert(offsetof(Mode, spoof_width_B) == MT9D111_DRIVER_VAR_MODE_SPOOF_WIDTH_B, "Wrong offset of Mode.spoof_width_B!");
+static_assert(offsetof(Mode, out_format_A) == MT9D111_DRIVER_VAR_MODE_OUT_FORMAT_A, "Wrong offset of Mode.out_format_A!");
+static_assert(offsetof(Mode, spec_effects_A) == MT9D111_DRIVER_VAR_MODE_SPEC_EFFECTS_A, "Wrong offset of Mode.spec_effects_A!");
+static_assert(offsetof(Mode, y_rgb_offset_B) == MT9D111_DRIVER_VAR_MODE_Y_RGB_OFFSET_B, "Wrong offset of Mode.y_rgb_offset_B!");
+
+static_assert(offsetof(JPEG, width) == MT9D111_DRIVER_VAR_JPEG_WIDTH, "Wrong offset of JPEG.width!");
+static_assert(offsetof(JPEG, format) == MT9D111_DRIVER_VAR_JPEG_FORMAT, "Wrong offset of JPEG.format!");
+static_assert(offsetof(JPEG, restartInt) == MT9D111_DRIVER_VAR_JPEG_RESTART_INT, "Wrong offset of JPEG.restartInt!");
+static_assert(offsetof(JPEG, qscale1) == MT9D111_DRIVER_VAR_JPEG_QSCALE1, "Wrong offset of JPEG.qscale1!");
+static_assert(offsetof(JPEG, dataLengthMSB) == MT9D111_DRIVER_VAR_JPEG_DATA_LENGTH_MSB, "Wrong offset of JPEG.dataLengthMSB!");
+static_assert(offsetof(JPEG, dataLengthLSBs) == MT9D111_DRIVER_VAR_JPEG_DATA_LENGTH_LSB, "Wrong offset of JPEG.dataLengthLSBs!");
+
+static_assert(offsetof(Histogram, DlevelBufferSpeed) == MT9D111_DRIVER_VAR_HISTOGRAM_D_LEVEL_BUFFER_SPEED, "Wrong offset of Histogram.DlevelBufferSpeed!");
+static_assert(offsetof(Histogram, Dlevel) == MT9D111_DRIVER_VAR_HISTOGRAM_D_LEVEL, "Wrong offset of Histogram.Dlevel!");
+static_assert(offsetof(Histogram, DLevel_buf) == MT9D111_DRIVER_VAR_HISTOGRAM_D_LEVEL_BUF, "Wrong offset of Histogram.DLevel_buf!");
+static_assert(offsetof(Histogram, percentHi) == MT9D111_DRIVER_VAR_HISTOGRAM_PERCENT_HI, "Wrong offset of Histogram.percentHi!");
+
+static_assert(sizeof(Monitor) == 13, "Wrong size of Monitor!");
+static_assert(sizeof(Sequencer) == 62, "Wrong size of Sequencer!");
+static_assert(sizeof(AutoExposure) == 88, "Wrong size of AutoExposure!");
+static_assert(sizeof(AutoWhiteBalance) == 106, "Wrong size of AutoWhiteBalance!");
+static_assert(sizeof(FlickerDetection) == 69, "Wrong size of FlickerDetection!");
+static_assert(sizeof(AutoFocus) == 39, "Wrong size of AutoFocus!");
+static_assert(sizeof(AutoFocusMechanics) == 50, "Wrong size of AutoFocusMechanics!");
+static_assert(sizeof(Mode) == 133, "Wrong size of Mode!");
+static_assert(sizeof(JPEG) == 18, "Wrong size of JPEG!");
+static_assert(sizeof(Histogram) == 15, "Wrong size of Histogram!");
+
+/**
+ * \brief Multi-byte field (or array of fields) of a driver structure.
+ *
+ * The MCU stores the variables in big-endian order, so these fields must be byte swapped on little-endian hosts.
+ */
+struct DriverVarField
+{
+    uint8_t offset;                     /**< Offset of the first field in the structure. */
+    uint8_t size;                       /**< Size of each field in bytes (2 or 4). */
+    uint8_t count;                      /**< Number of consecutive fields. */
+};
+
+const DriverVarField driver_fields_monitor[] = {
+    {offsetof(Monitor, vmt), 2, 1},
+    {offsetof(Monitor, arg1), 2, 2},
+    {offsetof(Monitor, msg), 4, 1}
+};
+
+const DriverVarField driver_fields_sequencer[] = {
+    {offsetof(Sequencer, vmt), 2, 1}
+};
+
+const DriverVarField driver_fields_auto_exposure[] = {
+    {offsetof(AutoExposure, vmt), 2, 1},
+    {offsetof(AutoExposure, wakeUpLine), 2, 1},
+    {offsetof(AutoExposure, masR12), 2, 1},
+    {offsetof(AutoExposure, maxDGainAE1), 2, 1},
+    {offsetof(AutoExposure, R12), 2, 1},
+    {offsetof(AutoExposure, DGainAE1), 2, 1},
+    {offsetof(AutoExposure, R9), 2, 1},
+    {offsetof(AutoExposure, rowTime), 2, 1},
+    {offsetof(AutoExposure, BufferedLuma), 2, 1},
+    {offsetof(AutoExposure, R9_step), 2, 1},
+    {offsetof(AutoExposure, physGainR), 2, 3}
+};
+
+const DriverVarField driver_fields_auto_white_balance[] = {
+    {offsetof(AutoWhiteBalance, vmt), 2, 1},
+    {offsetof(AutoWhiteBalance, wakeUpLine), 2, 1},
+    {offsetof(AutoWhiteBalance, ccmL), 2, 33},
+    {offsetof(AutoWhiteBalance, GainR_buf), 2, 2},
+    {offsetof(AutoWhiteBalance, cntPxITH), 2, 1}
+};
+
+const DriverVarField driver_fields_flicker_detection[] = {
+    {offsetof(FlickerDetection, vmt), 2, 1},
+    {offsetof(FlickerDetection, wakeUpLine), 2, 1},
+    {offsetof(FlickerDetection, R9_step60), 2, 2}
+};
+
+const DriverVarField driver_fields_auto_focus[] = {
+    {offsetof(AutoFocus, Vmt), 2, 1},
+    {offsetof(AutoFocus, wakeUpLine), 2, 1},
+    {offsetof(AutoFocus, zoneWeights), 4, 1}
+};
+
+const DriverVarField driver_fields_auto_focus_mechanics[] = {
+    {offsetof(AutoFocusMechanics, vmt), 2, 1},
+    {offsetof(AutoFocusMechanics, timer.vmt), 2, 6},
+    {offsetof(AutoFocusMechanics, si.vmt), 2, 4},
+    {offsetof(AutoFocusMechanics, sm.enabMask), 2, 1},
+    {offsetof(AutoFocusMechanics, sm.drvsQtrPrd), 2, 1},
+    {offsetof(AutoFocusMechanics, sm.piEnabMask), 2, 2}
+};
+
+const DriverVarField driver_fields_mode[] = {
+    {offsetof(Mode, VMT_pointer), 2, 1},
+    {offsetof(Mode, output_width_A), 2, 18},
+    {offsetof(Mode, crop_X0_A), 2, 5},
+    {offsetof(Mode, crop_X0_B), 2, 5},
+    {offsetof(Mode, FIFO_config0_A), 2, 2},
+    {offsetof(Mode, FIFO_len_timing_A), 2, 3},
+    {offsetof(Mode, FIFO_len_timing_B), 2, 3},
+    {offsetof(Mode, spec_effects_A), 2, 2}
+};
+
+const DriverVarField driver_fields_jpeg[] = {
+    {offsetof(JPEG, vmt), 2, 3},
+    {offsetof(JPEG, restartInt), 2, 1},
+    {offsetof(JPEG, dataLengthLSBs), 2, 1}
+};
+
+const DriverVarField driver_fields_histogram[] = {
+    {offsetof(Histogram, vmt), 2, 1},
+    {offsetof(Histogram, DLevel_buf), 2, 1}
+};
+
+/**
+ * \brief Range of variables of a driver structure.
+ */
+struct DriverVarRange
+{
+    uint8_t offset;                     /**< Offset of the first variable in the structure. */
+    uint8_t len;                        /**< Number of bytes. */
+};
+
+/**
+ * \brief Variables that are not written back by "WriteDriver" (commands, states and status).
+ *
+ * Writing a command variable executes the command, and the states and status variables are updated by the firmware.
+ */
+const DriverVarRange driver_skip_monitor[] = {
+    {offsetof(Monitor, cmd), 1},
+    {offsetof(Monitor, msgCount), sizeof(Monitor) - offsetof(Monitor, msgCount)}    // msgCount, msg and ver
+};
+
+const DriverVarRange driver_skip_sequencer[] = {
+    {offsetof(Sequencer, cmd), 1},
+    {offsetof(Sequencer, state), 1}
+};
+
+const DriverVarRange driver_skip_mode[] = {
+    {offsetof(Mode, context), 1}
+};
+
+const DriverVarRange driver_skip_jpeg[] = {
+    {offsetof(JPEG, state), sizeof(JPEG) - offsetof(JPEG, state)}                   // state and data length
 };
 
 #endif // MT9D111_DRIVER_H_
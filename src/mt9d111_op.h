@@ -0,0 +1,370 @@
+/*
+ * mt9d111_op.h
+ * 
+ * Copyright (C) 2018, Gabriel Mariano Marcelino <gabriel.mm8@gmail.com>
+ * 
+ * This file is part of MT9D111-Driver.
+ * 
+ * MT9D111-Driver is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ * 
+ * MT9D111-Driver is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ * 
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with MT9D111-Driver. If not, see <http://www.gnu.org/licenses/>.
+ * 
+ */
+
+/**
+ * \brief MT9D111 registers sequences (operations lists) and compile-time table compiler.
+ * 
+ * \author Gabriel Mariano Marcelino <gabriel.mm8@gmail.com>
+ * 
+ * \version 1.0-dev
+ * 
+ * \date 17/10/2026
+ * 
+ * \defgroup op Operations
+ * \ingroup mt9d111
+ * \{
+ */
+
+#ifndef MT9D111_OP_H_
+#define MT9D111_OP_H_
+
+#include <stdint.h>
+#include <stddef.h>
+
+#include "mt9d111_reg.h"
+#include "mt9d111_reg_desc.h"
+#include "mt9d111_driver.h"
+
+// Operation codes
+#define MT9D111_OP_WRITE                            0   /**< Write a register (page, address, value). */
+#define MT9D111_OP_DELAY                            1   /**< Wait "value" milliseconds. */
+#define MT9D111_OP_WRITE_VAR                        2   /**< Write a driver variable (driver ID, offset, value). */
+#define MT9D111_OP_POLL_EQ                          3   /**< Wait until a register/variable is equal to "value". */
+#define MT9D111_OP_POLL_MASK                        4   /**< Wait until (register/variable & "mask") is equal to "value". */
+#define MT9D111_OP_BARRIER                          5   /**< Send all the pending writes before the next operation. */
+
+// Operation flags
+#define MT9D111_OP_FLAG_VAR                         (1 << 0)    /**< The target is a driver variable (page = driver ID, address = offset). */
+#define MT9D111_OP_FLAG_16_BIT                      (1 << 1)    /**< 16-bit driver variable. */
+
+// Polling
+#define MT9D111_OP_POLL_DEFAULT_TIMEOUT_MS          1000    /**< Default polling timeout in milliseconds. */
+#define MT9D111_OP_POLL_MIN_INTERVAL_US             100     /**< First polling interval in microseconds. */
+#define MT9D111_OP_POLL_MAX_INTERVAL_US             10000   /**< Max. polling interval in microseconds. */
+
+// Execution
+#define MT9D111_OP_RUN_BATCH_LEN                    64      /**< Max. number of register writes sent together by "MT9D111::Run". */
+
+/**
+ * \brief A single operation of a registers sequence.
+ */
+struct Op
+{
+    uint8_t     code;       /**< Operation code. */
+    uint8_t     flags;      /**< Operation flags (MT9D111_OP_FLAG_VAR, MT9D111_OP_FLAG_16_BIT). */
+    uint8_t     page;       /**< Register page number (or driver ID for driver variables). */
+    uint8_t     address;    /**< Register address (or variable offset for driver variables). */
+    uint16_t    value;      /**< Register value, expected value (polls) or delay in milliseconds. */
+    uint16_t    mask;       /**< Mask of the polled value (MT9D111_OP_POLL_MASK). */
+    uint16_t    timeout;    /**< Polling timeout in milliseconds. */
+};
+
+/**
+ * \brief Operation builders.
+ *
+ * The driver IDs are the MT9D111_DRIVER_ID_* values.
+ */
+#define MT9D111_OP_WR(page, adr, val)               {MT9D111_OP_WRITE, 0, (page), (adr), (val), 0xFFFF, 0}
+#define MT9D111_OP_WR_VAR8(id, ofs, val)            {MT9D111_OP_WRITE_VAR, MT9D111_OP_FLAG_VAR, ((id) >> 8), (ofs), (val), 0xFFFF, 0}
+#define MT9D111_OP_WR_VAR16(id, ofs, val)           {MT9D111_OP_WRITE_VAR, MT9D111_OP_FLAG_VAR | MT9D111_OP_FLAG_16_BIT, ((id) >> 8), (ofs), (val), 0xFFFF, 0}
+#define MT9D111_OP_WAIT(ms)                         {MT9D111_OP_DELAY, 0, MT9D111_REG_PAGE_DELAY, 0, (ms), 0xFFFF, 0}
+#define MT9D111_OP_POLL_REG(page, adr, val, ms)     {MT9D111_OP_POLL_EQ, 0, (page), (adr), (val), 0xFFFF, (ms)}
+#define MT9D111_OP_POLL_REG_MASK(page, adr, msk, val, ms)   {MT9D111_OP_POLL_MASK, 0, (page), (adr), (val), (msk), (ms)}
+#define MT9D111_OP_POLL_VAR8(id, ofs, val, ms)      {MT9D111_OP_POLL_EQ, MT9D111_OP_FLAG_VAR, ((id) >> 8), (ofs), (val), 0xFFFF, (ms)}
+#define MT9D111_OP_POLL_VAR8_MASK(id, ofs, msk, val, ms)    {MT9D111_OP_POLL_MASK, MT9D111_OP_FLAG_VAR, ((id) >> 8), (ofs), (val), (msk), (ms)}
+#define MT9D111_OP_FENCE                            {MT9D111_OP_BARRIER, 0, 0, 0, 0, 0xFFFF, 0}
+
+/**
+ * \brief List of operations with a fixed capacity (output of the registers table compiler).
+ */
+template<size_t N>
+struct OpList
+{
+    Op      ops[N];         /**< Operations. */
+    size_t  len;            /**< Number of valid operations. */
+};
+
+/**
+ * \brief Checks if a register write must keep its position in a registers table.
+ *
+ * Resets, clock/PLL changes, microcontroller boot mode changes and sequencer commands (seq.cmd) are barriers: no
+ * write can be moved across them.
+ *
+ * \param[in] reg is the register to check.
+ * \param[in] var_adr is the last driver variable address written to R198:1.
+ *
+ * \return TRUE/FALSE if the write is a barrier or not.
+ */
+constexpr bool OpIsBarrier(const Register &reg, uint16_t var_adr)
+{
+    if (reg.page == MT9D111_REG_PAGE_0)
+    {
+        return (reg.address == MT9D111_REG_RESET) or (reg.address == MT9D111_REG_CLOCK_CONTROL) or
+               (reg.address == MT9D111_REG_PLL_CONTROL_1) or (reg.address == MT9D111_REG_PLL_CONTROL_2);
+    }
+
+    if (reg.page == MT9D111_REG_PAGE_1)
+    {
+        if (reg.address == MT9D111_REG_MICROCONTROLLER_BOOT_MODE)
+        {
+            return true;
+        }
+
+        // Driver ID and offset of the variable (ignoring the access width)
+        return (reg.address == MT9D111_REG_MICROCONTROLLER_VARIABLE_DATA) and
+               ((var_adr & 0x1FFF) == (MT9D111_DRIVER_ID_SEQUENCER | MT9D111_DRIVER_VAR_SEQUENCER_CMD));
+    }
+
+    return false;
+}
+
+/**
+ * \brief Checks if a register write can be removed when it repeats the last value written to the register.
+ *
+ * \param[in] reg is the register to check.
+ *
+ * \return TRUE/FALSE if a repeated write is redundant or not.
+ */
+constexpr bool OpIsDedupable(const Register &reg)
+{
+    if ((reg.page == MT9D111_REG_PAGE_0) and (reg.address == MT9D111_REG_RESET))
+    {
+        return false;
+    }
+
+    if ((reg.page == MT9D111_REG_PAGE_1) and
+        ((reg.address == MT9D111_REG_MICROCONTROLLER_VARIABLE_ADDRESS) or
+         (reg.address == MT9D111_REG_MICROCONTROLLER_VARIABLE_DATA) or
+         (reg.address == MT9D111_REG_MICROCONTROLLER_VARIABLE_DATA_USING_BURST_TWO_WIRE_SERIAL_INTERFACE_ACCESS)))
+    {
+        return false;
+    }
+
+    return true;
+}
+
+/**
+ * \brief Checks if a table entry carries no register write (page selection or end of table mark).
+ *
+ * \param[in] reg is the entry to check.
+ *
+ * \return TRUE/FALSE if the entry must be dropped or not.
+ */
+constexpr bool OpIsDropped(const Register &reg)
+{
+    return (reg.address == MT9D111_REG_PAGE_REGISTER) or
+           ((reg.page == MT9D111_REG_PAGE_0) and (reg.address == MT9D111_REG_RESERVED_2) and (reg.value == 0xFFFF));
+}
+
+/**
+ * \brief Forgets the last value written to every register.
+ *
+ * After a barrier the registers may be back to their defaults (resets) or rewritten by the firmware (clock changes,
+ * sequencer commands), so no later write can be removed as redundant.
+ *
+ * \param[in,out] last_valid indicates if the last written value is known for each register.
+ *
+ * \return None.
+ */
+constexpr void OpForgetValues(bool (*last_valid)[MT9D111_REG_PAGE_SIZE])
+{
+    for(unsigned int p=0; p<MT9D111_REG_PAGES; p++)
+    {
+        for(unsigned int a=0; a<MT9D111_REG_PAGE_SIZE; a++)
+        {
+            last_valid[p][a] = false;
+        }
+    }
+}
+
+/**
+ * \brief Emits the writes of a segment of a registers table (no delays or barriers inside) grouped by page.
+ *
+ * The active page is emitted first (if present), then the other pages in order of first occurrence. The order of the
+ * writes of the same page is kept. A write is skipped when it repeats the known last value of the register.
+ *
+ * Used both at compile time (see "CompileRegs") and at run time (see "MT9D111::ApplyProfile").
+ *
+ * \param[in,out] ops is the output array of operations.
+ * \param[in,out] n_ops is the number of operations in the array.
+ * \param[in] regs is the registers table.
+ * \param[in] start is the first entry of the segment.
+ * \param[in] end is the entry after the last entry of the segment.
+ * \param[in,out] page is the active page (updated only when a write is emitted).
+ * \param[in,out] last_val is the last value written to each register.
+ * \param[in,out] last_valid indicates if "last_val" is known for each register (only for cacheable registers).
+ *
+ * \return The number of emitted writes.
+ */
+constexpr size_t OpEmitSegment(Op *ops, size_t &n_ops, const Register *regs, size_t start, size_t end, uint8_t &page,
+                               uint16_t (*last_val)[MT9D111_REG_PAGE_SIZE], bool (*last_valid)[MT9D111_REG_PAGE_SIZE])
+{
+    size_t n = 0;
+    size_t first[MT9D111_REG_PAGES] = {};
+    bool present[MT9D111_REG_PAGES] = {};
+
+    for(size_t i=start; i<end; i++)
+    {
+        if ((regs[i].page < MT9D111_REG_PAGES) and !OpIsDropped(regs[i]) and !present[regs[i].page])
+        {
+            present[regs[i].page] = true;
+            first[regs[i].page] = i;
+        }
+    }
+
+    for(unsigned int k=0; k<MT9D111_REG_PAGES; k++)
+    {
+        // Select the next page
+        uint8_t p = MT9D111_REG_PAGE_UNKNOWN;
+
+        if ((page < MT9D111_REG_PAGES) and present[page])
+        {
+            p = page;
+        }
+        else
+        {
+            for(uint8_t q=0; q<MT9D111_REG_PAGES; q++)
+            {
+                if (present[q] and ((p == MT9D111_REG_PAGE_UNKNOWN) or (first[q] < first[p])))
+                {
+                    p = q;
+                }
+            }
+        }
+
+        if (p == MT9D111_REG_PAGE_UNKNOWN)
+        {
+            break;
+        }
+
+        present[p] = false;
+
+        for(size_t i=start; i<end; i++)
+        {
+            uint8_t adr = regs[i].address;
+
+            if ((regs[i].page != p) or OpIsDropped(regs[i]))
+            {
+                continue;
+            }
+
+            if (OpIsDedupable(regs[i]) and last_valid[p][adr] and (last_val[p][adr] == regs[i].value))
+            {
+                continue;
+            }
+
+            last_val[p][adr]    = regs[i].value;
+            last_valid[p][adr]  = RegIsCacheable(p, adr);
+
+            ops[n_ops] = Op{MT9D111_OP_WRITE, 0, p, adr, regs[i].value, 0xFFFF, 0};
+            n_ops++;
+
+            page = p;
+            n++;
+        }
+    }
+
+    return n;
+}
+
+/**
+ * \brief Compiles a registers table into an optimized list of operations (at compile time).
+ *
+ * The compiler:
+ *      - Drops the page register entries (the page of each write is selected by the interpreter, only when it changes).
+ *      - Splits the table in segments at delays (MT9D111_REG_DELAY) and barriers (see "OpIsBarrier").
+ *      - Groups the writes of each segment by page, keeping the relative order of the writes of the same page.
+ *      - Removes writes that repeat the last value written to the same register (since the last barrier).
+ *      - Emits explicit delay operations.
+ *      - Emits a barrier after each barrier write, or a poll of seq.cmd until zero after each sequencer command
+ *        (instead of a fixed delay).
+ *      .
+ *
+ * \param[in] regs is the registers table.
+ *
+ * \return The list of operations.
+ */
+template<size_t N>
+constexpr OpList<2*N> CompileRegs(const Register (&regs)[N])
+{
+    OpList<2*N> list{};
+
+    uint16_t last_val[MT9D111_REG_PAGES][MT9D111_REG_PAGE_SIZE] = {};
+    bool last_valid[MT9D111_REG_PAGES][MT9D111_REG_PAGE_SIZE] = {};
+
+    uint8_t page = MT9D111_REG_PAGE_UNKNOWN;
+    uint16_t var_adr = 0;
+    size_t start = 0;
+
+    for(size_t i=0; i<N; i++)
+    {
+        bool delay = (regs[i].page == MT9D111_REG_PAGE_DELAY);
+        bool barrier = !delay and OpIsBarrier(regs[i], var_adr);
+
+        if ((regs[i].page == MT9D111_REG_PAGE_1) and (regs[i].address == MT9D111_REG_MICROCONTROLLER_VARIABLE_ADDRESS))
+        {
+            var_adr = regs[i].value;
+        }
+
+        if (!delay and !barrier)
+        {
+            continue;
+        }
+
+        OpEmitSegment(list.ops, list.len, regs, start, i, page, last_val, last_valid);
+
+        if (delay)
+        {
+            list.ops[list.len] = Op{MT9D111_OP_DELAY, 0, MT9D111_REG_PAGE_DELAY, 0, regs[i].value, 0xFFFF, 0};
+            list.len++;
+        }
+        else
+        {
+            OpEmitSegment(list.ops, list.len, regs, i, i + 1, page, last_val, last_valid);
+
+            OpForgetValues(last_valid);
+
+            if ((regs[i].page == MT9D111_REG_PAGE_1) and (regs[i].address == MT9D111_REG_MICROCONTROLLER_VARIABLE_DATA))
+            {
+                // The firmware clears seq.cmd when the command is done
+                list.ops[list.len] = Op{MT9D111_OP_POLL_EQ, MT9D111_OP_FLAG_VAR, MT9D111_DRIVER_ID_SEQUENCER >> 8,
+                                        MT9D111_DRIVER_VAR_SEQUENCER_CMD, 0, 0xFFFF, MT9D111_OP_POLL_DEFAULT_TIMEOUT_MS};
+            }
+            else
+            {
+                list.ops[list.len] = Op{MT9D111_OP_BARRIER, 0, 0, 0, 0, 0xFFFF, 0};
+            }
+
+            list.len++;
+        }
+
+        start = i + 1;
+    }
+
+    OpEmitSegment(list.ops, list.len, regs, start, N, page, last_val, last_valid);
+
+    return list;
+}
+
+#endif // MT9D111_OP_H_
+
+//! \} End of op group
@@ -37,9 +37,14 @@
 #ifndef MT9D111_PINS_H_
 #define MT9D111_PINS_H_
 
+#include "gpio.h"
+
 #define MT9D111_GPIO_RESET          5
 #define MT9D111_GPIO_STANDBY        6
 
+#define MT9D111_GPIO_BACKEND        GPIO_BACKEND_SYSFS  // Default backend (see MT9D111::SetGPIOBackend)
+#define MT9D111_GPIO_CHIP           GPIO_DEFAULT_CHIP
+
 #endif // MT9D111_PINS_H_
 
 //! \} End of pins group
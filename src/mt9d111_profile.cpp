@@ -0,0 +1,464 @@
+/*
+ * mt9d111_profile.cpp
+ * 
+ * Copyright (C) 2018, Gabriel Mariano Marcelino <gabriel.mm8@gmail.com>
+ * 
+ * This file is part of MT9D111-Driver.
+ * 
+ * MT9D111-Driver is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ * 
+ * MT9D111-Driver is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ * 
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with MT9D111-Driver. If not, see <http://www.gnu.org/licenses/>.
+ * 
+ */
+
+/**
+ * \brief MT9D111 binary configuration profiles implementation.
+ * 
+ * \author Gabriel Mariano Marcelino <gabriel.mm8@gmail.com>
+ * 
+ * \version 1.0-dev
+ * 
+ * \date 17/10/2026
+ * 
+ * \addtogroup profile
+ * \{
+ */
+
+#include <stdio.h>
+#include <string.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+#include "mt9d111_profile.h"
+#include "mt9d111.h"
+#include "mt9d111_op.h"
+#include "mt9d111_driver.h"
+#include "logger.h"
+
+using namespace std;
+
+/**
+ * \brief CRC-32 lookup table (reflected polynomial 0xEDB88320, built at compile time).
+ */
+struct CRC32Table
+{
+    uint32_t t[256];    /**< Table entries. */
+
+    /**
+     * \brief Constructor.
+     *
+     * \return None.
+     */
+    constexpr CRC32Table() : t()
+    {
+        for(uint32_t i=0; i<256; i++)
+        {
+            uint32_t c = i;
+            for(unsigned int k=0; k<8; k++)
+            {
+                c = (c & 1)? (0xEDB88320 ^ (c >> 1)) : (c >> 1);
+            }
+
+            t[i] = c;
+        }
+    }
+};
+
+static constexpr CRC32Table crc32_table;
+
+/**
+ * \brief Rounds a size up to the alignment of the records.
+ *
+ * \param[in] n is the size in bytes.
+ *
+ * \return The aligned size.
+ */
+static inline size_t ProfileAlign(size_t n)
+{
+    return (n + MT9D111_PROFILE_ALIGN - 1) & ~((size_t)MT9D111_PROFILE_ALIGN - 1);
+}
+
+MT9D111Profile::MT9D111Profile()
+{
+    this->data = NULL;
+    this->size = 0;
+}
+
+MT9D111Profile::~MT9D111Profile()
+{
+    this->Close();
+}
+
+bool MT9D111Profile::Open(const char *file)
+{
+    this->Close();
+
+    int fd = open(file, O_RDONLY | O_CLOEXEC);
+    if (fd < 0)
+    {
+        LOG_ERROR("MT9D111Profile", "Error opening a profile! (errno=%u)", errno);
+
+        return false;
+    }
+
+    struct stat st;
+    if ((fstat(fd, &st) < 0) or (st.st_size < (off_t)sizeof(ProfileHeader)))
+    {
+        close(fd);
+
+        LOG_ERROR("MT9D111Profile", "Invalid profile file!");
+
+        return false;
+    }
+
+    // The whole file is paged in now, so the records can be used later without I/O
+    void *p = mmap(NULL, st.st_size, PROT_READ, MAP_PRIVATE | MAP_POPULATE, fd, 0);
+
+    close(fd);
+
+    if (p == MAP_FAILED)
+    {
+        LOG_ERROR("MT9D111Profile", "Error mapping a profile! (errno=%u)", errno);
+
+        return false;
+    }
+
+    this->data = (const uint8_t*)p;
+    this->size = st.st_size;
+
+    if (!this->Validate())
+    {
+        this->Close();
+
+        return false;
+    }
+
+    return true;
+}
+
+void MT9D111Profile::Close()
+{
+    if (this->data != NULL)
+    {
+        munmap((void*)this->data, this->size);
+    }
+
+    this->data = NULL;
+    this->size = 0;
+}
+
+bool MT9D111Profile::IsOpen() const
+{
+    return this->data != NULL;
+}
+
+const ProfileHeader* MT9D111Profile::GetHeader() const
+{
+    return (const ProfileHeader*)this->data;
+}
+
+const ProfileRecord* MT9D111Profile::GetRecord(const ProfileRecord *prev) const
+{
+    if ((this->data == NULL) or (this->GetHeader()->records == 0))
+    {
+        return NULL;
+    }
+
+    if (prev == NULL)
+    {
+        return (const ProfileRecord*)(this->data + sizeof(ProfileHeader));
+    }
+
+    const uint8_t *next = (const uint8_t*)prev + sizeof(ProfileRecord) + ProfileAlign(MT9D111Profile::GetPayloadSize(prev));
+
+    // The bounds were checked when the profile was opened
+    if (next >= this->data + this->size)
+    {
+        return NULL;
+    }
+
+    return (const ProfileRecord*)next;
+}
+
+const Register* MT9D111Profile::GetRegisters(const ProfileRecord *rec)
+{
+    return (const Register*)MT9D111Profile::GetPayload(rec);
+}
+
+const uint8_t* MT9D111Profile::GetPayload(const ProfileRecord *rec)
+{
+    return (const uint8_t*)rec + sizeof(ProfileRecord);
+}
+
+size_t MT9D111Profile::GetPayloadSize(const ProfileRecord *rec)
+{
+    switch(rec->type)
+    {
+        case MT9D111_PROFILE_REC_RUN:
+            return rec->len*sizeof(Register);
+        case MT9D111_PROFILE_REC_VARS:
+            return rec->len;
+        default:
+            return 0;
+    }
+}
+
+uint32_t MT9D111Profile::CRC32(const uint8_t *buf, size_t len)
+{
+    uint32_t crc = 0xFFFFFFFF;
+
+    for(size_t i=0; i<len; i++)
+    {
+        crc = crc32_table.t[(crc ^ buf[i]) & 0xFF] ^ (crc >> 8);
+    }
+
+    return crc ^ 0xFFFFFFFF;
+}
+
+bool MT9D111Profile::Validate()
+{
+    const ProfileHeader *hdr = this->GetHeader();
+
+    if ((hdr->magic != MT9D111_PROFILE_MAGIC) or (hdr->version != MT9D111_PROFILE_VERSION) or (hdr->size != this->size))
+    {
+        LOG_ERROR("MT9D111Profile", "Invalid profile header! (magic=0x%X, version=%u)", hdr->magic, hdr->version);
+
+        return false;
+    }
+
+    uint32_t crc = MT9D111Profile::CRC32(this->data + sizeof(ProfileHeader), this->size - sizeof(ProfileHeader));
+    if (crc != hdr->crc)
+    {
+        LOG_ERROR("MT9D111Profile", "Invalid profile CRC! (read=0x%X, expected=0x%X)", crc, hdr->crc);
+
+        return false;
+    }
+
+    size_t pos = sizeof(ProfileHeader);
+
+    for(unsigned int i=0; i<hdr->records; i++)
+    {
+        if (pos + sizeof(ProfileRecord) > this->size)
+        {
+            LOG_ERROR("MT9D111Profile", "Truncated profile! (record %u)", i);
+
+            return false;
+        }
+
+        const ProfileRecord *rec = (const ProfileRecord*)(this->data + pos);
+
+        if ((rec->type > MT9D111_PROFILE_REC_POLL_VAR) or
+            ((rec->type == MT9D111_PROFILE_REC_RUN) and (rec->page >= MT9D111_REG_PAGES)))
+        {
+            LOG_ERROR("MT9D111Profile", "Invalid profile record! (record %u, type %u)", i, rec->type);
+
+            return false;
+        }
+
+        // The driver variables must fit in the variables window of a valid driver
+        if (((rec->type == MT9D111_PROFILE_REC_VARS) or (rec->type == MT9D111_PROFILE_REC_POLL_VAR)) and
+            ((rec->page >= MT9D111_DRIVER_IDS) or
+             ((rec->type == MT9D111_PROFILE_REC_VARS) and (rec->offset + rec->len > MT9D111_DRIVER_VARS_SIZE))))
+        {
+            LOG_ERROR("MT9D111Profile", "Invalid driver variables record! (record %u, driver %u, offset %u, len %u)", i,
+                      rec->page, rec->offset, rec->len);
+
+            return false;
+        }
+
+        pos += sizeof(ProfileRecord) + ProfileAlign(MT9D111Profile::GetPayloadSize(rec));
+
+        if (pos > this->size)
+        {
+            LOG_ERROR("MT9D111Profile", "Truncated profile! (record %u)", i);
+
+            return false;
+        }
+    }
+
+    if (pos != this->size)
+    {
+        LOG_ERROR("MT9D111Profile", "Invalid profile size!");
+
+        return false;
+    }
+
+    return true;
+}
+
+bool MT9D111Profile::Write(const char *file, const Register *regs, size_t len, const char *name)
+{
+    // Worst case: a record (and a poll) per entry
+    size_t cap = sizeof(ProfileHeader) + len*(2*sizeof(ProfileRecord) + MT9D111_PROFILE_ALIGN);
+    uint8_t *buf = new uint8_t[cap];
+
+    memset(buf, 0, cap);
+
+    size_t pos = sizeof(ProfileHeader);
+    unsigned int records = 0;
+    ProfileRecord *run = NULL;      // Open run of registers
+    ProfileRecord *vars = NULL;     // Open block of driver variables
+
+    size_t i = 0;
+    while(i < len)
+    {
+        const Register &reg = regs[i];
+
+        if ((reg.page != MT9D111_REG_PAGE_DELAY) and OpIsDropped(reg))
+        {
+            i++;
+
+            continue;
+        }
+
+        // Driver variable: address (R198:1) followed by the value (R200:1)
+        bool var = (reg.page == MT9D111_REG_PAGE_1) and (reg.address == MT9D111_REG_MICROCONTROLLER_VARIABLE_ADDRESS) and
+                   ((reg.value & (3 << 13)) == MT9D111_DRIVER_PHYSICAL_ACCESS_ADDRESS_LOGICAL) and (i + 1 < len) and
+                   (regs[i+1].page == MT9D111_REG_PAGE_1) and
+                   (regs[i+1].address == MT9D111_REG_MICROCONTROLLER_VARIABLE_DATA);
+
+        // Close the open records
+        if (!var and (vars != NULL))
+        {
+            pos = ProfileAlign(pos);
+            vars = NULL;
+        }
+
+        if (var or (reg.page == MT9D111_REG_PAGE_DELAY))
+        {
+            run = NULL;
+        }
+
+        if (reg.page == MT9D111_REG_PAGE_DELAY)
+        {
+            ProfileRecord *rec = (ProfileRecord*)(buf + pos);
+
+            rec->type   = MT9D111_PROFILE_REC_DELAY;
+            rec->len    = reg.value;
+
+            pos += sizeof(ProfileRecord);
+            records++;
+
+            i++;
+        }
+        else if (var)
+        {
+            uint8_t driver  = (reg.value >> 8) & 0x1F;
+            uint8_t offset  = reg.value & 0xFF;
+            uint8_t bytes   = (reg.value & MT9D111_DRIVER_VARIABLE_8_BIT_ACCESS)? 1 : 2;
+            uint16_t val    = regs[i+1].value;
+
+            // Consecutive variables of the same driver are merged
+            if ((vars == NULL) or (vars->page != driver) or (vars->offset + vars->len != offset) or
+                (offset + bytes > 0xFF))
+            {
+                if (vars != NULL)
+                {
+                    pos = ProfileAlign(pos);
+                }
+
+                vars = (ProfileRecord*)(buf + pos);
+
+                vars->type      = MT9D111_PROFILE_REC_VARS;
+                vars->page      = driver;
+                vars->offset    = offset;
+                vars->len       = 0;
+
+                pos += sizeof(ProfileRecord);
+                records++;
+            }
+
+            // The variables are big-endian in the sensor memory
+            if (bytes == 2)
+            {
+                buf[pos++] = val >> 8;
+            }
+
+            buf[pos++] = val & 0xFF;
+
+            vars->len += bytes;
+
+            if ((driver == (MT9D111_DRIVER_ID_SEQUENCER >> 8)) and (offset == MT9D111_DRIVER_VAR_SEQUENCER_CMD))
+            {
+                // The firmware clears seq.cmd when the command is done
+                pos = ProfileAlign(pos);
+                vars = NULL;
+
+                ProfileRecord *rec = (ProfileRecord*)(buf + pos);
+
+                rec->type   = MT9D111_PROFILE_REC_POLL_VAR;
+                rec->page   = driver;
+                rec->offset = offset;
+                rec->len    = MT9D111_OP_POLL_DEFAULT_TIMEOUT_MS;
+                rec->value  = 0;
+
+                pos += sizeof(ProfileRecord);
+                records++;
+            }
+
+            i += 2;
+        }
+        else
+        {
+            if ((run == NULL) or (run->page != reg.page))
+            {
+                run = (ProfileRecord*)(buf + pos);
+
+                run->type   = MT9D111_PROFILE_REC_RUN;
+                run->page   = reg.page;
+                run->len    = 0;
+
+                pos += sizeof(ProfileRecord);
+                records++;
+            }
+
+            memcpy(buf + pos, &reg, sizeof(Register));
+
+            pos += sizeof(Register);
+            run->len++;
+
+            i++;
+        }
+    }
+
+    pos = ProfileAlign(pos);
+
+    ProfileHeader *hdr = (ProfileHeader*)buf;
+
+    hdr->magic      = MT9D111_PROFILE_MAGIC;
+    hdr->version    = MT9D111_PROFILE_VERSION;
+    hdr->records    = records;
+    hdr->size       = pos;
+    hdr->crc        = MT9D111Profile::CRC32(buf + sizeof(ProfileHeader), pos - sizeof(ProfileHeader));
+
+    // The name is NUL terminated only if shorter than the field (the buffer is zeroed)
+    memcpy(hdr->name, name, strnlen(name, MT9D111_PROFILE_NAME_MAX_LEN));
+
+    bool res = false;
+
+    FILE *f = fopen(file, "wb");
+    if (f != NULL)
+    {
+        res = fwrite(buf, 1, pos, f) == pos;
+
+        res = (fclose(f) == 0) and res;
+    }
+
+    delete[] buf;
+
+    return res;
+}
+
+//! \} End of profile group
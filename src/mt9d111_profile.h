@@ -0,0 +1,231 @@
+/*
+ * mt9d111_profile.h
+ * 
+ * Copyright (C) 2018, Gabriel Mariano Marcelino <gabriel.mm8@gmail.com>
+ * 
+ * This file is part of MT9D111-Driver.
+ * 
+ * MT9D111-Driver is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ * 
+ * MT9D111-Driver is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ * 
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with MT9D111-Driver. If not, see <http://www.gnu.org/licenses/>.
+ * 
+ */
+
+/**
+ * \brief MT9D111 binary configuration profiles.
+ * 
+ * A profile file is a header followed by a list of records. All fields are little-endian and every record starts at a
+ * 4 bytes boundary, so the file is used directly from a read-only memory mapping (no parsing or copies):
+ * 
+ *      - Header (ProfileHeader).
+ *      - Record (ProfileRecord) + payload (padded to 4 bytes).
+ *      - ...
+ *      .
+ * 
+ * The payload of a run of registers is an array of Register (the same format of the compiled tables), and the payload
+ * of a driver variables block is the raw content of the variables (big-endian, as in the sensor memory).
+ * 
+ * \author Gabriel Mariano Marcelino <gabriel.mm8@gmail.com>
+ * 
+ * \version 1.0-dev
+ * 
+ * \date 17/10/2026
+ * 
+ * \defgroup profile Profiles
+ * \ingroup mt9d111
+ * \{
+ */
+
+#ifndef MT9D111_PROFILE_H_
+#define MT9D111_PROFILE_H_
+
+#include <stdint.h>
+#include <stddef.h>
+
+#include "mt9d111_reg.h"
+
+#define MT9D111_PROFILE_MAGIC                       0x5044394D  /**< "M9DP". */
+#define MT9D111_PROFILE_VERSION                     1
+#define MT9D111_PROFILE_NAME_MAX_LEN                16
+#define MT9D111_PROFILE_ALIGN                       4           /**< Alignment of the records. */
+
+// Record types
+#define MT9D111_PROFILE_REC_RUN                     0   /**< Registers of the same page (payload = Register[len]). */
+#define MT9D111_PROFILE_REC_VARS                    1   /**< Consecutive driver variables (payload = len bytes). */
+#define MT9D111_PROFILE_REC_DELAY                   2   /**< Wait "len" milliseconds. */
+#define MT9D111_PROFILE_REC_POLL_VAR                3   /**< Wait until the 8-bit driver variable is equal to "value" ("len" = timeout in ms). */
+
+/**
+ * \brief Header of a profile file.
+ */
+struct ProfileHeader
+{
+    uint32_t    magic;                                  /**< MT9D111_PROFILE_MAGIC. */
+    uint16_t    version;                                /**< MT9D111_PROFILE_VERSION. */
+    uint16_t    records;                                /**< Number of records. */
+    uint32_t    size;                                   /**< Size of the file in bytes (header included). */
+    uint32_t    crc;                                    /**< CRC-32 of the records (everything after the header). */
+    char        name[MT9D111_PROFILE_NAME_MAX_LEN];     /**< Name of the profile (NUL terminated if shorter). */
+};
+
+/**
+ * \brief Header of a record of a profile file.
+ */
+struct ProfileRecord
+{
+    uint8_t     type;       /**< Record type (MT9D111_PROFILE_REC_*). */
+    uint8_t     page;       /**< Register page (runs) or driver ID >> 8 (driver variables). */
+    uint8_t     offset;     /**< Offset of the first driver variable. */
+    uint8_t     reserved;   /**< Reserved (0). */
+    uint16_t    len;        /**< Number of registers, number of bytes, delay or timeout in milliseconds. */
+    uint16_t    value;      /**< Expected value (polls). */
+};
+
+// The profile files are little-endian and mapped without conversion
+#if !defined(__BYTE_ORDER__) or (__BYTE_ORDER__ != __ORDER_LITTLE_ENDIAN__)
+#error "The profile files are only supported on little-endian hosts!"
+#endif
+
+static_assert(sizeof(ProfileHeader) == 32, "Invalid size of the profile header!");
+static_assert(sizeof(ProfileRecord) == 8, "Invalid size of the profile records!");
+static_assert(sizeof(Register) == 4, "Invalid size of the registers entries!");
+
+/**
+ * \brief Read-only view of a profile file (memory-mapped).
+ */
+class MT9D111Profile
+{
+    private:
+        const uint8_t *data;    /**< Mapped file (NULL if closed). */
+        size_t size;            /**< Size of the mapping. */
+
+        /**
+         * \brief Checks the header, the CRC and the bounds of all records.
+         *
+         * \return TRUE/FALSE if the profile is valid or not.
+         */
+        bool Validate();
+
+    public:
+        /**
+         * \brief Constructor.
+         *
+         * \return None.
+         */
+        MT9D111Profile();
+
+        /**
+         * \brief Destructor (unmaps the file).
+         *
+         * \return None.
+         */
+        ~MT9D111Profile();
+
+        /**
+         * \brief Maps and validates a profile file.
+         *
+         * The whole file is paged in and checked once. After that, reading the records does no I/O.
+         *
+         * \param[in] file is the path of the profile file.
+         *
+         * \return TRUE/FALSE if the profile was loaded or not.
+         */
+        bool Open(const char *file);
+
+        /**
+         * \brief Unmaps the profile file.
+         *
+         * \return None.
+         */
+        void Close();
+
+        /**
+         * \brief Checks if a valid profile is mapped.
+         *
+         * \return TRUE/FALSE if a profile is mapped or not.
+         */
+        bool IsOpen() const;
+
+        /**
+         * \brief Gets the header of the profile.
+         *
+         * \return A pointer to the header (NULL if closed).
+         */
+        const ProfileHeader* GetHeader() const;
+
+        /**
+         * \brief Gets a record of the profile.
+         *
+         * \param[in] prev is the previous record (NULL to get the first one).
+         *
+         * \return A pointer to the next record (NULL after the last one).
+         */
+        const ProfileRecord* GetRecord(const ProfileRecord *prev) const;
+
+        /**
+         * \brief Gets the registers of a run record.
+         *
+         * \param[in] rec is a MT9D111_PROFILE_REC_RUN record.
+         *
+         * \return A pointer to the "len" registers (inside the mapping).
+         */
+        static const Register* GetRegisters(const ProfileRecord *rec);
+
+        /**
+         * \brief Gets the payload of a record.
+         *
+         * \param[in] rec is a record.
+         *
+         * \return A pointer to the payload (inside the mapping).
+         */
+        static const uint8_t* GetPayload(const ProfileRecord *rec);
+
+        /**
+         * \brief Gets the size of the payload of a record (without padding).
+         *
+         * \param[in] rec is a record.
+         *
+         * \return The size in bytes.
+         */
+        static size_t GetPayloadSize(const ProfileRecord *rec);
+
+        /**
+         * \brief Computes the CRC-32 (IEEE 802.3) of a buffer.
+         *
+         * \param[in] buf is the buffer.
+         * \param[in] len is the number of bytes of the buffer.
+         *
+         * \return The CRC-32 value.
+         */
+        static uint32_t CRC32(const uint8_t *buf, size_t len);
+
+        /**
+         * \brief Converts a registers table (as the ones of mt9d111_config.h) into a profile file.
+         *
+         * Consecutive registers of the same page are stored as runs, the pairs of writes to R198:1 and R200:1 with
+         * logical addresses as driver variables blocks (consecutive variables of the same driver are merged), and the
+         * delay entries as delays. A poll of seq.cmd until zero is added after each sequencer command. Page register
+         * entries and end of table marks are dropped.
+         *
+         * \param[in] file is the path of the output file.
+         * \param[in] regs is the registers table.
+         * \param[in] len is the number of entries of the table.
+         * \param[in] name is the name of the profile.
+         *
+         * \return TRUE/FALSE if the file was written or not.
+         */
+        static bool Write(const char *file, const Register *regs, size_t len, const char *name);
+};
+
+#endif // MT9D111_PROFILE_H_
+
+//! \} End of profile group
@@ -53,6 +53,16 @@ struct Register
 #define MT9D111_REG_PAGE_0                          0   /**< Sensor core. */
 #define MT9D111_REG_PAGE_1                          1   /**< IFP page 1. */
 #define MT9D111_REG_PAGE_2                          2   /**< IFP page 2. */
+#define MT9D111_REG_PAGE_UNKNOWN                    0xFF /**< The active page is unknown. */
+#define MT9D111_REG_PAGE_DELAY                      0xFE /**< Pseudo-page of delay entries (value = delay in ms). */
+
+/**
+ * \brief Delay entry of a registers table.
+ */
+#define MT9D111_REG_DELAY(ms)                       {0x00, MT9D111_REG_PAGE_DELAY, (ms)}
+
+#define MT9D111_REG_PAGES                           3   /**< Number of registers pages. */
+#define MT9D111_REG_PAGE_SIZE                       256 /**< Number of registers addresses per page. */
 
 /**
  * \brief Sensor Core Registers Addresses.
@@ -0,0 +1,400 @@
+/*
+ * mt9d111_reg_desc.h
+ * 
+ * Copyright (C) 2018, Gabriel Mariano Marcelino <gabriel.mm8@gmail.com>
+ * 
+ * This file is part of MT9D111-Driver.
+ * 
+ * MT9D111-Driver is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ * 
+ * MT9D111-Driver is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ * 
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with MT9D111-Driver. If not, see <http://www.gnu.org/licenses/>.
+ * 
+ */
+
+/**
+ * \brief MT9D111 registers descriptors (page, used bits, access type, volatility and default value).
+ * 
+ * Generated by tools/mt9d111_reg_desc.py from mt9d111_reg.h. Do not edit!
+ * 
+ * \author Gabriel Mariano Marcelino <gabriel.mm8@gmail.com>
+ * 
+ * \version 1.0-dev
+ * 
+ * \date 17/10/2026
+ * 
+ * \addtogroup registers
+ * \{
+ */
+
+#ifndef MT9D111_REG_DESC_H_
+#define MT9D111_REG_DESC_H_
+
+#include <stdint.h>
+#include <stddef.h>
+
+#include "mt9d111_reg.h"
+
+// Descriptor flags
+#define MT9D111_REG_DESC_PRESENT                    (1 << 0)    /**< The register is documented. */
+#define MT9D111_REG_DESC_READ_ONLY                  (1 << 1)    /**< Writes are ignored. */
+#define MT9D111_REG_DESC_SELF_CLEARING              (1 << 2)    /**< Some bits are cleared by the sensor after a write. */
+#define MT9D111_REG_DESC_VOLATILE                   (1 << 3)    /**< The value is updated by the sensor or by the firmware drivers. */
+#define MT9D111_REG_DESC_DEFAULT_KNOWN              (1 << 4)    /**< The default (power-up) value is documented. */
+
+#define MT9D111_REG_DESC_LEN                        244
+
+/**
+ * \brief Descriptor of a register.
+ */
+struct RegDesc
+{
+    uint8_t     page;       /**< Register page number. */
+    uint8_t     address;    /**< Register address. */
+    uint8_t     flags;      /**< Descriptor flags (MT9D111_REG_DESC_*). */
+    uint16_t    mask;       /**< Used bits. */
+    uint16_t    value;      /**< Default value (if MT9D111_REG_DESC_DEFAULT_KNOWN). */
+    const char  *name;      /**< Register name (without the MT9D111_REG_ prefix). */
+};
+
+/**
+ * \brief Descriptors of all the documented registers, sorted by page and address.
+ */
+constexpr RegDesc mt9d111_reg_desc_list[MT9D111_REG_DESC_LEN] =
+{
+    {MT9D111_REG_PAGE_0, MT9D111_REG_RESERVED, MT9D111_REG_DESC_PRESENT | MT9D111_REG_DESC_DEFAULT_KNOWN, 0xFFFF, 0x1519, "RESERVED"},
+    {MT9D111_REG_PAGE_0, MT9D111_REG_ROW_START, MT9D111_REG_DESC_PRESENT, 0x07FF, 0x0000, "ROW_START"},
+    {MT9D111_REG_PAGE_0, MT9D111_REG_COLUMN_START, MT9D111_REG_DESC_PRESENT, 0x07FF, 0x0000, "COLUMN_START"},
+    {MT9D111_REG_PAGE_0, MT9D111_REG_ROW_WIDTH, MT9D111_REG_DESC_PRESENT, 0x07FF, 0x0000, "ROW_WIDTH"},
+    {MT9D111_REG_PAGE_0, MT9D111_REG_COL_WIDTH, MT9D111_REG_DESC_PRESENT, 0x07FF, 0x0000, "COL_WIDTH"},
+    {MT9D111_REG_PAGE_0, MT9D111_REG_HORIZONTAL_BLANKING_B, MT9D111_REG_DESC_PRESENT, 0x3FFF, 0x0000, "HORIZONTAL_BLANKING_B"},
+    {MT9D111_REG_PAGE_0, MT9D111_REG_VERTICAL_BLANKING_B, MT9D111_REG_DESC_PRESENT, 0x7FFF, 0x0000, "VERTICAL_BLANKING_B"},
+    {MT9D111_REG_PAGE_0, MT9D111_REG_HORIZONTAL_BLANKING_A, MT9D111_REG_DESC_PRESENT, 0x3FFF, 0x0000, "HORIZONTAL_BLANKING_A"},
+    {MT9D111_REG_PAGE_0, MT9D111_REG_VERTICAL_BLANKING_A, MT9D111_REG_DESC_PRESENT, 0x7FFF, 0x0000, "VERTICAL_BLANKING_A"},
+    {MT9D111_REG_PAGE_0, MT9D111_REG_SHUTTER_WIDTH, MT9D111_REG_DESC_PRESENT | MT9D111_REG_DESC_VOLATILE, 0xFFFF, 0x0000, "SHUTTER_WIDTH"},
+    {MT9D111_REG_PAGE_0, MT9D111_REG_ROW_SPEED, MT9D111_REG_DESC_PRESENT, 0xFFFF, 0x0000, "ROW_SPEED"},
+    {MT9D111_REG_PAGE_0, MT9D111_REG_EXTRA_DELAY, MT9D111_REG_DESC_PRESENT, 0x3FFF, 0x0000, "EXTRA_DELAY"},
+    {MT9D111_REG_PAGE_0, MT9D111_REG_SHUTTER_DELAY, MT9D111_REG_DESC_PRESENT, 0x3FFF, 0x0000, "SHUTTER_DELAY"},
+    {MT9D111_REG_PAGE_0, MT9D111_REG_RESET, MT9D111_REG_DESC_PRESENT | MT9D111_REG_DESC_SELF_CLEARING, 0xFFFF, 0x0000, "RESET"},
+    {MT9D111_REG_PAGE_0, MT9D111_REG_FRAME_VALID_CONTROL, MT9D111_REG_DESC_PRESENT, 0xFFFF, 0x0000, "FRAME_VALID_CONTROL"},
+    {MT9D111_REG_PAGE_0, MT9D111_REG_READ_MODE_B, MT9D111_REG_DESC_PRESENT, 0xFFFF, 0x0000, "READ_MODE_B"},
+    {MT9D111_REG_PAGE_0, MT9D111_REG_READ_MODE_A, MT9D111_REG_DESC_PRESENT, 0xFFFF, 0x0000, "READ_MODE_A"},
+    {MT9D111_REG_PAGE_0, MT9D111_REG_DARK_COL_ROWS, MT9D111_REG_DESC_PRESENT, 0x07FF, 0x0000, "DARK_COL_ROWS"},
+    {MT9D111_REG_PAGE_0, MT9D111_REG_FLASH, MT9D111_REG_DESC_PRESENT, 0xFFFF, 0x0000, "FLASH"},
+    {MT9D111_REG_PAGE_0, MT9D111_REG_EXTRA_RESET, MT9D111_REG_DESC_PRESENT, 0xFFFF, 0x0000, "EXTRA_RESET"},
+    {MT9D111_REG_PAGE_0, MT9D111_REG_LINE_VALID_CONTROL, MT9D111_REG_DESC_PRESENT, 0xFFFF, 0x0000, "LINE_VALID_CONTROL"},
+    {MT9D111_REG_PAGE_0, MT9D111_REG_BOTTOM_DARK_ROWS, MT9D111_REG_DESC_PRESENT, 0x00FF, 0x0000, "BOTTOM_DARK_ROWS"},
+    {MT9D111_REG_PAGE_0, MT9D111_REG_GREEN_1_GAIN, MT9D111_REG_DESC_PRESENT | MT9D111_REG_DESC_VOLATILE, 0x0FFF, 0x0000, "GREEN_1_GAIN"},
+    {MT9D111_REG_PAGE_0, MT9D111_REG_BLUE_GAIN, MT9D111_REG_DESC_PRESENT | MT9D111_REG_DESC_VOLATILE, 0x0FFF, 0x0000, "BLUE_GAIN"},
+    {MT9D111_REG_PAGE_0, MT9D111_REG_RED_GAIN, MT9D111_REG_DESC_PRESENT | MT9D111_REG_DESC_VOLATILE, 0x0FFF, 0x0000, "RED_GAIN"},
+    {MT9D111_REG_PAGE_0, MT9D111_REG_GREEN_2_GAIN, MT9D111_REG_DESC_PRESENT | MT9D111_REG_DESC_VOLATILE, 0x0FFF, 0x0000, "GREEN_2_GAIN"},
+    {MT9D111_REG_PAGE_0, MT9D111_REG_GLOBAL_GAIN, MT9D111_REG_DESC_PRESENT | MT9D111_REG_DESC_VOLATILE, 0xFFFF, 0x0000, "GLOBAL_GAIN"},
+    {MT9D111_REG_PAGE_0, MT9D111_REG_ROW_NOISE, MT9D111_REG_DESC_PRESENT, 0xFFFF, 0x0000, "ROW_NOISE"},
+    {MT9D111_REG_PAGE_0, MT9D111_REG_BLACK_ROWS, MT9D111_REG_DESC_PRESENT, 0xFFFF, 0x0000, "BLACK_ROWS"},
+    {MT9D111_REG_PAGE_0, MT9D111_REG_DARK_G1_AVERAGE, MT9D111_REG_DESC_PRESENT | MT9D111_REG_DESC_VOLATILE, 0x007F, 0x0000, "DARK_G1_AVERAGE"},
+    {MT9D111_REG_PAGE_0, MT9D111_REG_DARK_B_AVERAGE, MT9D111_REG_DESC_PRESENT | MT9D111_REG_DESC_VOLATILE, 0x007F, 0x0000, "DARK_B_AVERAGE"},
+    {MT9D111_REG_PAGE_0, MT9D111_REG_DARK_R_AVERAGE, MT9D111_REG_DESC_PRESENT | MT9D111_REG_DESC_VOLATILE, 0x007F, 0x0000, "DARK_R_AVERAGE"},
+    {MT9D111_REG_PAGE_0, MT9D111_REG_DARK_G2_AVERAGE, MT9D111_REG_DESC_PRESENT | MT9D111_REG_DESC_VOLATILE, 0x007F, 0x0000, "DARK_G2_AVERAGE"},
+    {MT9D111_REG_PAGE_0, MT9D111_REG_CALIB_THRESHOLD, MT9D111_REG_DESC_PRESENT, 0x7FFF, 0x0000, "CALIB_THRESHOLD"},
+    {MT9D111_REG_PAGE_0, MT9D111_REG_CALIB_CONTROL, MT9D111_REG_DESC_PRESENT, 0xFFFF, 0x0000, "CALIB_CONTROL"},
+    {MT9D111_REG_PAGE_0, MT9D111_REG_CALIB_GREEN_1, MT9D111_REG_DESC_PRESENT, 0xFFFF, 0x0000, "CALIB_GREEN_1"},
+    {MT9D111_REG_PAGE_0, MT9D111_REG_CALIB_BLUE, MT9D111_REG_DESC_PRESENT, 0xFFFF, 0x0000, "CALIB_BLUE"},
+    {MT9D111_REG_PAGE_0, MT9D111_REG_CALIB_RED, MT9D111_REG_DESC_PRESENT, 0xFFFF, 0x0000, "CALIB_RED"},
+    {MT9D111_REG_PAGE_0, MT9D111_REG_CALIB_GREEN_2, MT9D111_REG_DESC_PRESENT, 0xFFFF, 0x0000, "CALIB_GREEN_2"},
+    {MT9D111_REG_PAGE_0, MT9D111_REG_CLOCK_CONTROL, MT9D111_REG_DESC_PRESENT, 0xFFFF, 0x0000, "CLOCK_CONTROL"},
+    {MT9D111_REG_PAGE_0, MT9D111_REG_PLL_CONTROL_1, MT9D111_REG_DESC_PRESENT, 0xFFFF, 0x0000, "PLL_CONTROL_1"},
+    {MT9D111_REG_PAGE_0, MT9D111_REG_PLL_CONTROL_2, MT9D111_REG_DESC_PRESENT, 0x0FFF, 0x0000, "PLL_CONTROL_2"},
+    {MT9D111_REG_PAGE_0, MT9D111_REG_GLOBAL_SHUTTER_CONTROL, MT9D111_REG_DESC_PRESENT, 0xFFFF, 0x0000, "GLOBAL_SHUTTER_CONTROL"},
+    {MT9D111_REG_PAGE_0, MT9D111_REG_START_INTEGRATION_T1, MT9D111_REG_DESC_PRESENT, 0xFFFF, 0x0000, "START_INTEGRATION_T1"},
+    {MT9D111_REG_PAGE_0, MT9D111_REG_START_READOUT_T2, MT9D111_REG_DESC_PRESENT, 0xFFFF, 0x0000, "START_READOUT_T2"},
+    {MT9D111_REG_PAGE_0, MT9D111_REG_ASSERT_STROBE_T3, MT9D111_REG_DESC_PRESENT, 0xFFFF, 0x0000, "ASSERT_STROBE_T3"},
+    {MT9D111_REG_PAGE_0, MT9D111_REG_DEASSERT_STROBE_T4, MT9D111_REG_DESC_PRESENT, 0xFFFF, 0x0000, "DEASSERT_STROBE_T4"},
+    {MT9D111_REG_PAGE_0, MT9D111_REG_ASSERT_FLASH, MT9D111_REG_DESC_PRESENT, 0xFFFF, 0x0000, "ASSERT_FLASH"},
+    {MT9D111_REG_PAGE_0, MT9D111_REG_DEASSERT_FLASH, MT9D111_REG_DESC_PRESENT, 0xFFFF, 0x0000, "DEASSERT_FLASH"},
+    {MT9D111_REG_PAGE_0, MT9D111_REG_EXTERNAL_SAMPLE_1, MT9D111_REG_DESC_PRESENT, 0x03FF, 0x0000, "EXTERNAL_SAMPLE_1"},
+    {MT9D111_REG_PAGE_0, MT9D111_REG_EXTERNAL_SAMPLE_2, MT9D111_REG_DESC_PRESENT, 0x03FF, 0x0000, "EXTERNAL_SAMPLE_2"},
+    {MT9D111_REG_PAGE_0, MT9D111_REG_EXTERNAL_SAMPLE_3, MT9D111_REG_DESC_PRESENT, 0x03FF, 0x0000, "EXTERNAL_SAMPLE_3"},
+    {MT9D111_REG_PAGE_0, MT9D111_REG_EXTERNAL_SAMPLING_CONTROL, MT9D111_REG_DESC_PRESENT, 0xFFFF, 0x0000, "EXTERNAL_SAMPLING_CONTROL"},
+    {MT9D111_REG_PAGE_0, MT9D111_REG_PAGE_REGISTER, MT9D111_REG_DESC_PRESENT, 0x0007, 0x0000, "PAGE_REGISTER"},
+    {MT9D111_REG_PAGE_0, MT9D111_REG_BYTEWISE_ADDRESS, MT9D111_REG_DESC_PRESENT | MT9D111_REG_DESC_VOLATILE, 0xFFFF, 0x0000, "BYTEWISE_ADDRESS"},
+    {MT9D111_REG_PAGE_0, MT9D111_REG_CONTEXT_CONTROL, MT9D111_REG_DESC_PRESENT | MT9D111_REG_DESC_SELF_CLEARING, 0xFFFF, 0x0000, "CONTEXT_CONTROL"},
+    {MT9D111_REG_PAGE_0, MT9D111_REG_RESERVED_2, MT9D111_REG_DESC_PRESENT | MT9D111_REG_DESC_DEFAULT_KNOWN, 0xFFFF, 0x1519, "RESERVED_2"},
+    {MT9D111_REG_PAGE_1, MT9D111_REG_COLOR_PIPELINE_CONTROL, MT9D111_REG_DESC_PRESENT, 0x07FF, 0x0000, "COLOR_PIPELINE_CONTROL"},
+    {MT9D111_REG_PAGE_1, MT9D111_REG_FACTORY_BYPASS, MT9D111_REG_DESC_PRESENT, 0x001F, 0x0000, "FACTORY_BYPASS"},
+    {MT9D111_REG_PAGE_1, MT9D111_REG_PAD_SLEW, MT9D111_REG_DESC_PRESENT, 0x07FF, 0x0000, "PAD_SLEW"},
+    {MT9D111_REG_PAGE_1, MT9D111_REG_INTERNAL_CLOCK_CONTROL, MT9D111_REG_DESC_PRESENT, 0x01FF, 0x0000, "INTERNAL_CLOCK_CONTROL"},
+    {MT9D111_REG_PAGE_1, MT9D111_REG_X0_COORDINATE_FOR_CROP_WINDOW, MT9D111_REG_DESC_PRESENT, 0x07FF, 0x0000, "X0_COORDINATE_FOR_CROP_WINDOW"},
+    {MT9D111_REG_PAGE_1, MT9D111_REG_X1_COORDINATE_FOR_CROP_WINDOW_1, MT9D111_REG_DESC_PRESENT, 0x07FF, 0x0000, "X1_COORDINATE_FOR_CROP_WINDOW_1"},
+    {MT9D111_REG_PAGE_1, MT9D111_REG_Y0_COORDINATE_FOR_CROP_WINDOW, MT9D111_REG_DESC_PRESENT, 0x07FF, 0x0000, "Y0_COORDINATE_FOR_CROP_WINDOW"},
+    {MT9D111_REG_PAGE_1, MT9D111_REG_Y1_COORDINATE_FOR_CROP_WINDOW_1, MT9D111_REG_DESC_PRESENT, 0x07FF, 0x0000, "Y1_COORDINATE_FOR_CROP_WINDOW_1"},
+    {MT9D111_REG_PAGE_1, MT9D111_REG_DECIMATOR_CONTROL, MT9D111_REG_DESC_PRESENT, 0x007F, 0x0000, "DECIMATOR_CONTROL"},
+    {MT9D111_REG_PAGE_1, MT9D111_REG_WEIGHT_FOR_HORIZONTAL_DECIMATION, MT9D111_REG_DESC_PRESENT, 0x1FFF, 0x0000, "WEIGHT_FOR_HORIZONTAL_DECIMATION"},
+    {MT9D111_REG_PAGE_1, MT9D111_REG_WEIGHT_FOR_VERTICAL_DECIMATION, MT9D111_REG_DESC_PRESENT, 0x1FFF, 0x0000, "WEIGHT_FOR_VERTICAL_DECIMATION"},
+    {MT9D111_REG_PAGE_1, MT9D111_REG_LUMINANCE_RANGE_OF_PIX_CONSIDERED_IN_WB_STATS, MT9D111_REG_DESC_PRESENT, 0xFFFF, 0x0000, "LUMINANCE_RANGE_OF_PIX_CONSIDERED_IN_WB_STATS"},
+    {MT9D111_REG_PAGE_1, MT9D111_REG_RIGHT_LEFT_COORDINATES_OF_AWB_MEASUREMENT_WINDOW, MT9D111_REG_DESC_PRESENT, 0xFFFF, 0x0000, "RIGHT_LEFT_COORDINATES_OF_AWB_MEASUREMENT_WINDOW"},
+    {MT9D111_REG_PAGE_1, MT9D111_REG_BOTTOM_TOP_COORDINATES_OF_AWB_MEASUREMENT_WINDOW, MT9D111_REG_DESC_PRESENT, 0xFFFF, 0x0000, "BOTTOM_TOP_COORDINATES_OF_AWB_MEASUREMENT_WINDOW"},
+    {MT9D111_REG_PAGE_1, MT9D111_REG_RED_CHROMIANCE_MEASURE_CALCULATED_BY_AWB, MT9D111_REG_DESC_PRESENT | MT9D111_REG_DESC_VOLATILE, 0xFFFF, 0x0000, "RED_CHROMIANCE_MEASURE_CALCULATED_BY_AWB"},
+    {MT9D111_REG_PAGE_1, MT9D111_REG_LUMINANCE_MEASURE_CALCULATED_BY_AWB, MT9D111_REG_DESC_PRESENT | MT9D111_REG_DESC_VOLATILE, 0xFFFF, 0x0000, "LUMINANCE_MEASURE_CALCULATED_BY_AWB"},
+    {MT9D111_REG_PAGE_1, MT9D111_REG_BLUE_CHROMIANCE_MEASURE_CALCULATED_BY_AWB, MT9D111_REG_DESC_PRESENT | MT9D111_REG_DESC_VOLATILE, 0xFFFF, 0x0000, "BLUE_CHROMIANCE_MEASURE_CALCULATED_BY_AWB"},
+    {MT9D111_REG_PAGE_1, MT9D111_REG_1D_APERTURE_CORRECTION_PARAMETERS, MT9D111_REG_DESC_PRESENT, 0x3FFF, 0x0000, "1D_APERTURE_CORRECTION_PARAMETERS"},
+    {MT9D111_REG_PAGE_1, MT9D111_REG_2D_APERTURE_CORRECTION_PARAMETERS, MT9D111_REG_DESC_PRESENT, 0x7FFF, 0x0000, "2D_APERTURE_CORRECTION_PARAMETERS"},
+    {MT9D111_REG_PAGE_1, MT9D111_REG_FILTERS, MT9D111_REG_DESC_PRESENT, 0x003F, 0x0000, "FILTERS"},
+    {MT9D111_REG_PAGE_1, MT9D111_REG_SECOND_BLACK_LEVEL, MT9D111_REG_DESC_PRESENT, 0xFFFF, 0x0000, "SECOND_BLACK_LEVEL"},
+    {MT9D111_REG_PAGE_1, MT9D111_REG_FIRST_BLACK_LEVEL, MT9D111_REG_DESC_PRESENT, 0xFFFF, 0x0000, "FIRST_BLACK_LEVEL"},
+    {MT9D111_REG_PAGE_1, MT9D111_REG_ENABLE_SUPPORT_FOR_PREVIEW_MODES, MT9D111_REG_DESC_PRESENT, 0xFFFF, 0x0000, "ENABLE_SUPPORT_FOR_PREVIEW_MODES"},
+    {MT9D111_REG_PAGE_1, MT9D111_REG_MIRRORS_SENSOR_REGISTER_0x20, MT9D111_REG_DESC_PRESENT | MT9D111_REG_DESC_READ_ONLY, 0xFFFF, 0x0000, "MIRRORS_SENSOR_REGISTER_0x20"},
+    {MT9D111_REG_PAGE_1, MT9D111_REG_MIRRORS_SENSOR_REGISTER_0xF2, MT9D111_REG_DESC_PRESENT | MT9D111_REG_DESC_READ_ONLY, 0xFFFF, 0x0000, "MIRRORS_SENSOR_REGISTER_0xF2"},
+    {MT9D111_REG_PAGE_1, MT9D111_REG_MIRRORS_SENSOR_REGISTER_0x21, MT9D111_REG_DESC_PRESENT | MT9D111_REG_DESC_READ_ONLY, 0xFFFF, 0x0000, "MIRRORS_SENSOR_REGISTER_0x21"},
+    {MT9D111_REG_PAGE_1, MT9D111_REG_EDGE_THRESHOLD_FOR_INTERPOLATION, MT9D111_REG_DESC_PRESENT, 0xFFFF, 0x0000, "EDGE_THRESHOLD_FOR_INTERPOLATION"},
+    {MT9D111_REG_PAGE_1, MT9D111_REG_TEST_PATTERN, MT9D111_REG_DESC_PRESENT, 0x0007, 0x0000, "TEST_PATTERN"},
+    {MT9D111_REG_PAGE_1, MT9D111_REG_TEST_PATTERN_R_MONOCHROME_VALUE, MT9D111_REG_DESC_PRESENT, 0x03FF, 0x0000, "TEST_PATTERN_R_MONOCHROME_VALUE"},
+    {MT9D111_REG_PAGE_1, MT9D111_REG_TEST_PATTERN_G_MONOCHROME_VALUE, MT9D111_REG_DESC_PRESENT, 0x03FF, 0x0000, "TEST_PATTERN_G_MONOCHROME_VALUE"},
+    {MT9D111_REG_PAGE_1, MT9D111_REG_TEST_PATTERN_B_VALUE, MT9D111_REG_DESC_PRESENT, 0x03FF, 0x0000, "TEST_PATTERN_B_VALUE"},
+    {MT9D111_REG_PAGE_1, MT9D111_REG_DIGITAL_GAIN_2, MT9D111_REG_DESC_PRESENT | MT9D111_REG_DESC_VOLATILE, 0xFFFF, 0x0000, "DIGITAL_GAIN_2"},
+    {MT9D111_REG_PAGE_1, MT9D111_REG_COLOR_CORRECTION_MATRIX_EXPONENTS_FOR_C11_C22, MT9D111_REG_DESC_PRESENT | MT9D111_REG_DESC_VOLATILE, 0x7FFF, 0x0000, "COLOR_CORRECTION_MATRIX_EXPONENTS_FOR_C11_C22"},
+    {MT9D111_REG_PAGE_1, MT9D111_REG_COLOR_CORRECTION_MATRIX_EXPONENTS_FOR_C22_C33, MT9D111_REG_DESC_PRESENT | MT9D111_REG_DESC_VOLATILE, 0x0FFF, 0x0000, "COLOR_CORRECTION_MATRIX_EXPONENTS_FOR_C22_C33"},
+    {MT9D111_REG_PAGE_1, MT9D111_REG_COLOR_CORRECTION_MATRIX_ELEMENTS_1_AND_2_MANTISSAS, MT9D111_REG_DESC_PRESENT | MT9D111_REG_DESC_VOLATILE, 0xFFFF, 0x0000, "COLOR_CORRECTION_MATRIX_ELEMENTS_1_AND_2_MANTISSAS"},
+    {MT9D111_REG_PAGE_1, MT9D111_REG_COLOR_CORRECTION_MATRIX_ELEMENTS_3_AND_4_MANTISSAS, MT9D111_REG_DESC_PRESENT | MT9D111_REG_DESC_VOLATILE, 0xFFFF, 0x0000, "COLOR_CORRECTION_MATRIX_ELEMENTS_3_AND_4_MANTISSAS"},
+    {MT9D111_REG_PAGE_1, MT9D111_REG_COLOR_CORRECTION_MATRIX_ELEMENTS_5_AND_6_MANTISSAS, MT9D111_REG_DESC_PRESENT | MT9D111_REG_DESC_VOLATILE, 0xFFFF, 0x0000, "COLOR_CORRECTION_MATRIX_ELEMENTS_5_AND_6_MANTISSAS"},
+    {MT9D111_REG_PAGE_1, MT9D111_REG_COLOR_CORRECTION_MATRIX_ELEMENTS_7_AND_8_MANTISSAS, MT9D111_REG_DESC_PRESENT | MT9D111_REG_DESC_VOLATILE, 0xFFFF, 0x0000, "COLOR_CORRECTION_MATRIX_ELEMENTS_7_AND_8_MANTISSAS"},
+    {MT9D111_REG_PAGE_1, MT9D111_REG_COLOR_CORRECTION_MATRIX_ELEMENT_9_MANTISSA_AND_SIGNS, MT9D111_REG_DESC_PRESENT | MT9D111_REG_DESC_VOLATILE, 0x3FFF, 0x0000, "COLOR_CORRECTION_MATRIX_ELEMENT_9_MANTISSA_AND_SIGNS"},
+    {MT9D111_REG_PAGE_1, MT9D111_REG_DIGITAL_GAIN_1_FOR_RED_PIXELS, MT9D111_REG_DESC_PRESENT | MT9D111_REG_DESC_VOLATILE, 0xFFFF, 0x0000, "DIGITAL_GAIN_1_FOR_RED_PIXELS"},
+    {MT9D111_REG_PAGE_1, MT9D111_REG_DIGITAL_GAIN_1_FOR_GREEN_1_PIXELS, MT9D111_REG_DESC_PRESENT | MT9D111_REG_DESC_VOLATILE, 0xFFFF, 0x0000, "DIGITAL_GAIN_1_FOR_GREEN_1_PIXELS"},
+    {MT9D111_REG_PAGE_1, MT9D111_REG_DIGITAL_GAIN_1_FOR_GREEN_2_PIXELS, MT9D111_REG_DESC_PRESENT | MT9D111_REG_DESC_VOLATILE, 0xFFFF, 0x0000, "DIGITAL_GAIN_1_FOR_GREEN_2_PIXELS"},
+    {MT9D111_REG_PAGE_1, MT9D111_REG_DIGITAL_GAIN_1_FOR_BLUE_PIXELS, MT9D111_REG_DESC_PRESENT | MT9D111_REG_DESC_VOLATILE, 0xFFFF, 0x0000, "DIGITAL_GAIN_1_FOR_BLUE_PIXELS"},
+    {MT9D111_REG_PAGE_1, MT9D111_REG_DIGITAL_GAIN_1_FOR_ALL_COLORS, MT9D111_REG_DESC_PRESENT | MT9D111_REG_DESC_VOLATILE, 0xFFFF, 0x0000, "DIGITAL_GAIN_1_FOR_ALL_COLORS"},
+    {MT9D111_REG_PAGE_1, MT9D111_REG_BOUNDARIES_OF_FLICKER_MEASUREMENT_WINDOW_LEFT_WIDTH, MT9D111_REG_DESC_PRESENT, 0xFFFF, 0x0000, "BOUNDARIES_OF_FLICKER_MEASUREMENT_WINDOW_LEFT_WIDTH"},
+    {MT9D111_REG_PAGE_1, MT9D111_REG_BOUNDARIES_OF_FLICKER_MEASUREMENT_WINDOW_TOP_HEIGHT, MT9D111_REG_DESC_PRESENT, 0xFFFF, 0x0000, "BOUNDARIES_OF_FLICKER_MEASUREMENT_WINDOW_TOP_HEIGHT"},
+    {MT9D111_REG_PAGE_1, MT9D111_REG_FLICKER_MEASUREMENT_WINDOW_SIZE, MT9D111_REG_DESC_PRESENT, 0xFFFF, 0x0000, "FLICKER_MEASUREMENT_WINDOW_SIZE"},
+    {MT9D111_REG_PAGE_1, MT9D111_REG_MEASURE_OF_AVERAGE_LUMINANCE_IN_FLICKER_MEASUREMENT_WINDOW, MT9D111_REG_DESC_PRESENT | MT9D111_REG_DESC_VOLATILE, 0xFFFF, 0x0000, "MEASURE_OF_AVERAGE_LUMINANCE_IN_FLICKER_MEASUREMENT_WINDOW"},
+    {MT9D111_REG_PAGE_1, MT9D111_REG_BLANK_FRAMES, MT9D111_REG_DESC_PRESENT, 0xFFFF, 0x0000, "BLANK_FRAMES"},
+    {MT9D111_REG_PAGE_1, MT9D111_REG_OUTPUT_FORMAT_CONFIGURATION, MT9D111_REG_DESC_PRESENT, 0x00FF, 0x0000, "OUTPUT_FORMAT_CONFIGURATION"},
+    {MT9D111_REG_PAGE_1, MT9D111_REG_OUTPUT_FORMAT_TEST, MT9D111_REG_DESC_PRESENT, 0x00FF, 0x0000, "OUTPUT_FORMAT_TEST"},
+    {MT9D111_REG_PAGE_1, MT9D111_REG_LINE_COUNT, MT9D111_REG_DESC_PRESENT | MT9D111_REG_DESC_VOLATILE, 0x0FFF, 0x0000, "LINE_COUNT"},
+    {MT9D111_REG_PAGE_1, MT9D111_REG_FRAME_COUNT, MT9D111_REG_DESC_PRESENT | MT9D111_REG_DESC_VOLATILE, 0xFFFF, 0x0000, "FRAME_COUNT"},
+    {MT9D111_REG_PAGE_1, MT9D111_REG_SPECIAL_EFFECTS, MT9D111_REG_DESC_PRESENT, 0xFFFF, 0x0000, "SPECIAL_EFFECTS"},
+    {MT9D111_REG_PAGE_1, MT9D111_REG_SEPIA_CONSTANTS, MT9D111_REG_DESC_PRESENT, 0xFFFF, 0x0000, "SEPIA_CONSTANTS"},
+    {MT9D111_REG_PAGE_1, MT9D111_REG_GAMMA_CURVE_KNEES_0_AND_1, MT9D111_REG_DESC_PRESENT, 0xFFFF, 0x0000, "GAMMA_CURVE_KNEES_0_AND_1"},
+    {MT9D111_REG_PAGE_1, MT9D111_REG_GAMMA_CURVE_KNEES_2_AND_3, MT9D111_REG_DESC_PRESENT, 0xFFFF, 0x0000, "GAMMA_CURVE_KNEES_2_AND_3"},
+    {MT9D111_REG_PAGE_1, MT9D111_REG_GAMMA_CURVE_KNEES_4_AND_5, MT9D111_REG_DESC_PRESENT, 0xFFFF, 0x0000, "GAMMA_CURVE_KNEES_4_AND_5"},
+    {MT9D111_REG_PAGE_1, MT9D111_REG_GAMMA_CURVE_KNEES_6_AND_7, MT9D111_REG_DESC_PRESENT, 0xFFFF, 0x0000, "GAMMA_CURVE_KNEES_6_AND_7"},
+    {MT9D111_REG_PAGE_1, MT9D111_REG_GAMMA_CURVE_KNEES_8_AND_9, MT9D111_REG_DESC_PRESENT, 0xFFFF, 0x0000, "GAMMA_CURVE_KNEES_8_AND_9"},
+    {MT9D111_REG_PAGE_1, MT9D111_REG_GAMMA_CURVE_KNEES_10_AND_11, MT9D111_REG_DESC_PRESENT, 0xFFFF, 0x0000, "GAMMA_CURVE_KNEES_10_AND_11"},
+    {MT9D111_REG_PAGE_1, MT9D111_REG_GAMMA_CURVE_KNEES_12_AND_13, MT9D111_REG_DESC_PRESENT, 0xFFFF, 0x0000, "GAMMA_CURVE_KNEES_12_AND_13"},
+    {MT9D111_REG_PAGE_1, MT9D111_REG_GAMMA_CURVE_KNEES_14_AND_15, MT9D111_REG_DESC_PRESENT, 0xFFFF, 0x0000, "GAMMA_CURVE_KNEES_14_AND_15"},
+    {MT9D111_REG_PAGE_1, MT9D111_REG_GAMMA_CURVE_KNEES_16_AND_17, MT9D111_REG_DESC_PRESENT, 0xFFFF, 0x0000, "GAMMA_CURVE_KNEES_16_AND_17"},
+    {MT9D111_REG_PAGE_1, MT9D111_REG_GAMMA_CURVE_KNEE_18, MT9D111_REG_DESC_PRESENT, 0x00FF, 0x0000, "GAMMA_CURVE_KNEE_18"},
+    {MT9D111_REG_PAGE_1, MT9D111_REG_YUV_YCbCr_CONTROL, MT9D111_REG_DESC_PRESENT, 0x000F, 0x0000, "YUV_YCbCr_CONTROL"},
+    {MT9D111_REG_PAGE_1, MT9D111_REG_Y_RGB_OFFSET, MT9D111_REG_DESC_PRESENT, 0xFFFF, 0x0000, "Y_RGB_OFFSET"},
+    {MT9D111_REG_PAGE_1, MT9D111_REG_MICROCONTROLLER_BOOT_MODE, MT9D111_REG_DESC_PRESENT, 0xFFFF, 0x0000, "MICROCONTROLLER_BOOT_MODE"},
+    {MT9D111_REG_PAGE_1, MT9D111_REG_MICROCONTROLLER_VARIABLE_ADDRESS, MT9D111_REG_DESC_PRESENT, 0xFFFF, 0x0000, "MICROCONTROLLER_VARIABLE_ADDRESS"},
+    {MT9D111_REG_PAGE_1, MT9D111_REG_MICROCONTROLLER_VARIABLE_DATA, MT9D111_REG_DESC_PRESENT | MT9D111_REG_DESC_VOLATILE, 0xFFFF, 0x0000, "MICROCONTROLLER_VARIABLE_DATA"},
+    {MT9D111_REG_PAGE_1, MT9D111_REG_MICROCONTROLLER_VARIABLE_DATA_USING_BURST_TWO_WIRE_SERIAL_INTERFACE_ACCESS, MT9D111_REG_DESC_PRESENT | MT9D111_REG_DESC_VOLATILE, 0xFFFF, 0x0000, "MICROCONTROLLER_VARIABLE_DATA_USING_BURST_TWO_WIRE_SERIAL_INTERFACE_ACCESS"},
+    {MT9D111_REG_PAGE_1, MT9D111_REG_PAGE_REGISTER, MT9D111_REG_DESC_PRESENT, 0x0007, 0x0000, "PAGE_REGISTER"},
+    {MT9D111_REG_PAGE_2, MT9D111_REG_JPEG_CONTROL, MT9D111_REG_DESC_PRESENT, 0xFFFF, 0x0000, "JPEG_CONTROL"},
+    {MT9D111_REG_PAGE_2, MT9D111_REG_JPEG_STATUS_0, MT9D111_REG_DESC_PRESENT | MT9D111_REG_DESC_VOLATILE, 0xFFFF, 0x0000, "JPEG_STATUS_0"},
+    {MT9D111_REG_PAGE_2, MT9D111_REG_JPEG_STATUS_1, MT9D111_REG_DESC_PRESENT | MT9D111_REG_DESC_VOLATILE, 0xFFFF, 0x0000, "JPEG_STATUS_1"},
+    {MT9D111_REG_PAGE_2, MT9D111_REG_JPEG_STATUS_2, MT9D111_REG_DESC_PRESENT | MT9D111_REG_DESC_VOLATILE, 0xFFFF, 0x0000, "JPEG_STATUS_2"},
+    {MT9D111_REG_PAGE_2, MT9D111_REG_JPEG_FRONT_END_CONFIG, MT9D111_REG_DESC_PRESENT, 0x0003, 0x0000, "JPEG_FRONT_END_CONFIG"},
+    {MT9D111_REG_PAGE_2, MT9D111_REG_JPEG_CORE_CONFIG, MT9D111_REG_DESC_PRESENT, 0xFFFF, 0x0000, "JPEG_CORE_CONFIG"},
+    {MT9D111_REG_PAGE_2, MT9D111_REG_JPEG_ENCODER_BYPASS, MT9D111_REG_DESC_PRESENT, 0xFFFF, 0x0000, "JPEG_ENCODER_BYPASS"},
+    {MT9D111_REG_PAGE_2, MT9D111_REG_OUTPUT_CONFIG, MT9D111_REG_DESC_PRESENT, 0x0FFF, 0x0000, "OUTPUT_CONFIG"},
+    {MT9D111_REG_PAGE_2, MT9D111_REG_OUTPUT_PCLK1_AND_PCLK2_CONFIG, MT9D111_REG_DESC_PRESENT, 0xFFFF, 0x0000, "OUTPUT_PCLK1_AND_PCLK2_CONFIG"},
+    {MT9D111_REG_PAGE_2, MT9D111_REG_OUTPUT_PCLK3_CONFIG, MT9D111_REG_DESC_PRESENT, 0x00FF, 0x0000, "OUTPUT_PCLK3_CONFIG"},
+    {MT9D111_REG_PAGE_2, MT9D111_REG_SPOOF_FRAME_WIDTH, MT9D111_REG_DESC_PRESENT, 0xFFFF, 0x0000, "SPOOF_FRAME_WIDTH"},
+    {MT9D111_REG_PAGE_2, MT9D111_REG_SPOOF_FRAME_HEIGHT, MT9D111_REG_DESC_PRESENT, 0xFFFF, 0x0000, "SPOOF_FRAME_HEIGHT"},
+    {MT9D111_REG_PAGE_2, MT9D111_REG_SPOOF_FRAME_LINE_TIMING, MT9D111_REG_DESC_PRESENT, 0xFFFF, 0x0000, "SPOOF_FRAME_LINE_TIMING"},
+    {MT9D111_REG_PAGE_2, MT9D111_REG_JPEG_RAM_TEST_CONTROL_REGISTER, MT9D111_REG_DESC_PRESENT, 0xFFFF, 0x0000, "JPEG_RAM_TEST_CONTROL_REGISTER"},
+    {MT9D111_REG_PAGE_2, MT9D111_REG_JPEG_INDIRECT_ACCESS_CONTROL, MT9D111_REG_DESC_PRESENT, 0xFFFF, 0x0000, "JPEG_INDIRECT_ACCESS_CONTROL"},
+    {MT9D111_REG_PAGE_2, MT9D111_REG_JPEG_INDIRECT_ACCESS_DATA, MT9D111_REG_DESC_PRESENT | MT9D111_REG_DESC_VOLATILE, 0xFFFF, 0x0000, "JPEG_INDIRECT_ACCESS_DATA"},
+    {MT9D111_REG_PAGE_2, MT9D111_REG_BOUNDARIES_OF_FIRST_AF_MEASUREMENT_WINDOW_TOP_LEFT, MT9D111_REG_DESC_PRESENT, 0xFFFF, 0x0000, "BOUNDARIES_OF_FIRST_AF_MEASUREMENT_WINDOW_TOP_LEFT"},
+    {MT9D111_REG_PAGE_2, MT9D111_REG_BOUNDARIES_OF_FIRST_AF_MEASUREMENT_WINDOW_HEIGHT_WIDTH, MT9D111_REG_DESC_PRESENT, 0xFFFF, 0x0000, "BOUNDARIES_OF_FIRST_AF_MEASUREMENT_WINDOW_HEIGHT_WIDTH"},
+    {MT9D111_REG_PAGE_2, MT9D111_REG_AF_MEASUREMENT_WINDOW_SIZE, MT9D111_REG_DESC_PRESENT, 0xFFFF, 0x0000, "AF_MEASUREMENT_WINDOW_SIZE"},
+    {MT9D111_REG_PAGE_2, MT9D111_REG_AVERAGE_LUMINANCE_IN_AF_WINDOWS_W12_AND_W11, MT9D111_REG_DESC_PRESENT | MT9D111_REG_DESC_VOLATILE, 0xFFFF, 0x0000, "AVERAGE_LUMINANCE_IN_AF_WINDOWS_W12_AND_W11"},
+    {MT9D111_REG_PAGE_2, MT9D111_REG_AVERAGE_LUMINANCE_IN_AF_WINDOWS_W14_AND_W13, MT9D111_REG_DESC_PRESENT | MT9D111_REG_DESC_VOLATILE, 0xFFFF, 0x0000, "AVERAGE_LUMINANCE_IN_AF_WINDOWS_W14_AND_W13"},
+    {MT9D111_REG_PAGE_2, MT9D111_REG_AVERAGE_LUMINANCE_IN_AF_WINDOWS_W22_AND_W21, MT9D111_REG_DESC_PRESENT | MT9D111_REG_DESC_VOLATILE, 0xFFFF, 0x0000, "AVERAGE_LUMINANCE_IN_AF_WINDOWS_W22_AND_W21"},
+    {MT9D111_REG_PAGE_2, MT9D111_REG_AVERAGE_LUMINANCE_IN_AF_WINDOWS_W24_AND_W23, MT9D111_REG_DESC_PRESENT | MT9D111_REG_DESC_VOLATILE, 0xFFFF, 0x0000, "AVERAGE_LUMINANCE_IN_AF_WINDOWS_W24_AND_W23"},
+    {MT9D111_REG_PAGE_2, MT9D111_REG_AVERAGE_LUMINANCE_IN_AF_WINDOWS_W32_AND_W31, MT9D111_REG_DESC_PRESENT | MT9D111_REG_DESC_VOLATILE, 0xFFFF, 0x0000, "AVERAGE_LUMINANCE_IN_AF_WINDOWS_W32_AND_W31"},
+    {MT9D111_REG_PAGE_2, MT9D111_REG_AVERAGE_LUMINANCE_IN_AF_WINDOWS_W34_AND_W33, MT9D111_REG_DESC_PRESENT | MT9D111_REG_DESC_VOLATILE, 0xFFFF, 0x0000, "AVERAGE_LUMINANCE_IN_AF_WINDOWS_W34_AND_W33"},
+    {MT9D111_REG_PAGE_2, MT9D111_REG_AVERAGE_LUMINANCE_IN_AF_WINDOWS_W42_AND_W41, MT9D111_REG_DESC_PRESENT | MT9D111_REG_DESC_VOLATILE, 0xFFFF, 0x0000, "AVERAGE_LUMINANCE_IN_AF_WINDOWS_W42_AND_W41"},
+    {MT9D111_REG_PAGE_2, MT9D111_REG_AVERAGE_LUMINANCE_IN_AF_WINDOWS_W44_AND_W43, MT9D111_REG_DESC_PRESENT | MT9D111_REG_DESC_VOLATILE, 0xFFFF, 0x0000, "AVERAGE_LUMINANCE_IN_AF_WINDOWS_W44_AND_W43"},
+    {MT9D111_REG_PAGE_2, MT9D111_REG_AF_FILTER_1_COEFFICIENTS, MT9D111_REG_DESC_PRESENT, 0xFFFF, 0x0000, "AF_FILTER_1_COEFFICIENTS"},
+    {MT9D111_REG_PAGE_2, MT9D111_REG_AF_FILTER_1_CONFIG, MT9D111_REG_DESC_PRESENT, 0xFFFF, 0x0000, "AF_FILTER_1_CONFIG"},
+    {MT9D111_REG_PAGE_2, MT9D111_REG_AF_FILTER_1_AVERAGE_SHARPNESS_MEASURE_FOR_AF_WINDOWS_W12_AND_W11, MT9D111_REG_DESC_PRESENT | MT9D111_REG_DESC_VOLATILE, 0xFFFF, 0x0000, "AF_FILTER_1_AVERAGE_SHARPNESS_MEASURE_FOR_AF_WINDOWS_W12_AND_W11"},
+    {MT9D111_REG_PAGE_2, MT9D111_REG_AF_FILTER_1_AVERAGE_SHARPNESS_MEASURE_FOR_AF_WINDOWS_W14_AND_W13, MT9D111_REG_DESC_PRESENT | MT9D111_REG_DESC_VOLATILE, 0xFFFF, 0x0000, "AF_FILTER_1_AVERAGE_SHARPNESS_MEASURE_FOR_AF_WINDOWS_W14_AND_W13"},
+    {MT9D111_REG_PAGE_2, MT9D111_REG_AF_FILTER_1_AVERAGE_SHARPNESS_MEASURE_FOR_AF_WINDOWS_W22_AND_W21, MT9D111_REG_DESC_PRESENT | MT9D111_REG_DESC_VOLATILE, 0xFFFF, 0x0000, "AF_FILTER_1_AVERAGE_SHARPNESS_MEASURE_FOR_AF_WINDOWS_W22_AND_W21"},
+    {MT9D111_REG_PAGE_2, MT9D111_REG_AF_FILTER_1_AVERAGE_SHARPNESS_MEASURE_FOR_AF_WINDOWS_W24_AND_W23, MT9D111_REG_DESC_PRESENT | MT9D111_REG_DESC_VOLATILE, 0xFFFF, 0x0000, "AF_FILTER_1_AVERAGE_SHARPNESS_MEASURE_FOR_AF_WINDOWS_W24_AND_W23"},
+    {MT9D111_REG_PAGE_2, MT9D111_REG_AF_FILTER_1_AVERAGE_SHARPNESS_MEASURE_FOR_AF_WINDOWS_W32_AND_W31, MT9D111_REG_DESC_PRESENT | MT9D111_REG_DESC_VOLATILE, 0xFFFF, 0x0000, "AF_FILTER_1_AVERAGE_SHARPNESS_MEASURE_FOR_AF_WINDOWS_W32_AND_W31"},
+    {MT9D111_REG_PAGE_2, MT9D111_REG_AF_FILTER_1_AVERAGE_SHARPNESS_MEASURE_FOR_AF_WINDOWS_W34_AND_W33, MT9D111_REG_DESC_PRESENT | MT9D111_REG_DESC_VOLATILE, 0xFFFF, 0x0000, "AF_FILTER_1_AVERAGE_SHARPNESS_MEASURE_FOR_AF_WINDOWS_W34_AND_W33"},
+    {MT9D111_REG_PAGE_2, MT9D111_REG_AF_FILTER_1_AVERAGE_SHARPNESS_MEASURE_FOR_AF_WINDOWS_W42_AND_W41, MT9D111_REG_DESC_PRESENT | MT9D111_REG_DESC_VOLATILE, 0xFFFF, 0x0000, "AF_FILTER_1_AVERAGE_SHARPNESS_MEASURE_FOR_AF_WINDOWS_W42_AND_W41"},
+    {MT9D111_REG_PAGE_2, MT9D111_REG_AF_FILTER_1_AVERAGE_SHARPNESS_MEASURE_FOR_AF_WINDOWS_W44_AND_W43, MT9D111_REG_DESC_PRESENT | MT9D111_REG_DESC_VOLATILE, 0xFFFF, 0x0000, "AF_FILTER_1_AVERAGE_SHARPNESS_MEASURE_FOR_AF_WINDOWS_W44_AND_W43"},
+    {MT9D111_REG_PAGE_2, MT9D111_REG_AF_FILTER_2_COEFFICIENTS, MT9D111_REG_DESC_PRESENT, 0xFFFF, 0x0000, "AF_FILTER_2_COEFFICIENTS"},
+    {MT9D111_REG_PAGE_2, MT9D111_REG_AF_FILTER_2_CONFIG, MT9D111_REG_DESC_PRESENT, 0xFFFF, 0x0000, "AF_FILTER_2_CONFIG"},
+    {MT9D111_REG_PAGE_2, MT9D111_REG_AF_FILTER_2_AVERAGE_SHARPNESS_MEASURE_FOR_AF_WINDOWS_W12_AND_W11, MT9D111_REG_DESC_PRESENT | MT9D111_REG_DESC_VOLATILE, 0xFFFF, 0x0000, "AF_FILTER_2_AVERAGE_SHARPNESS_MEASURE_FOR_AF_WINDOWS_W12_AND_W11"},
+    {MT9D111_REG_PAGE_2, MT9D111_REG_AF_FILTER_2_AVERAGE_SHARPNESS_MEASURE_FOR_AF_WINDOWS_W14_AND_W13, MT9D111_REG_DESC_PRESENT | MT9D111_REG_DESC_VOLATILE, 0xFFFF, 0x0000, "AF_FILTER_2_AVERAGE_SHARPNESS_MEASURE_FOR_AF_WINDOWS_W14_AND_W13"},
+    {MT9D111_REG_PAGE_2, MT9D111_REG_AF_FILTER_2_AVERAGE_SHARPNESS_MEASURE_FOR_AF_WINDOWS_W22_AND_W21, MT9D111_REG_DESC_PRESENT | MT9D111_REG_DESC_VOLATILE, 0xFFFF, 0x0000, "AF_FILTER_2_AVERAGE_SHARPNESS_MEASURE_FOR_AF_WINDOWS_W22_AND_W21"},
+    {MT9D111_REG_PAGE_2, MT9D111_REG_AF_FILTER_2_AVERAGE_SHARPNESS_MEASURE_FOR_AF_WINDOWS_W24_AND_W23, MT9D111_REG_DESC_PRESENT | MT9D111_REG_DESC_VOLATILE, 0xFFFF, 0x0000, "AF_FILTER_2_AVERAGE_SHARPNESS_MEASURE_FOR_AF_WINDOWS_W24_AND_W23"},
+    {MT9D111_REG_PAGE_2, MT9D111_REG_AF_FILTER_2_AVERAGE_SHARPNESS_MEASURE_FOR_AF_WINDOWS_W32_AND_W31, MT9D111_REG_DESC_PRESENT | MT9D111_REG_DESC_VOLATILE, 0xFFFF, 0x0000, "AF_FILTER_2_AVERAGE_SHARPNESS_MEASURE_FOR_AF_WINDOWS_W32_AND_W31"},
+    {MT9D111_REG_PAGE_2, MT9D111_REG_AF_FILTER_2_AVERAGE_SHARPNESS_MEASURE_FOR_AF_WINDOWS_W34_AND_W33, MT9D111_REG_DESC_PRESENT | MT9D111_REG_DESC_VOLATILE, 0xFFFF, 0x0000, "AF_FILTER_2_AVERAGE_SHARPNESS_MEASURE_FOR_AF_WINDOWS_W34_AND_W33"},
+    {MT9D111_REG_PAGE_2, MT9D111_REG_AF_FILTER_2_AVERAGE_SHARPNESS_MEASURE_FOR_AF_WINDOWS_W42_AND_W41, MT9D111_REG_DESC_PRESENT | MT9D111_REG_DESC_VOLATILE, 0xFFFF, 0x0000, "AF_FILTER_2_AVERAGE_SHARPNESS_MEASURE_FOR_AF_WINDOWS_W42_AND_W41"},
+    {MT9D111_REG_PAGE_2, MT9D111_REG_AF_FILTER_2_AVERAGE_SHARPNESS_MEASURE_FOR_AF_WINDOWS_W44_AND_W43, MT9D111_REG_DESC_PRESENT | MT9D111_REG_DESC_VOLATILE, 0xFFFF, 0x0000, "AF_FILTER_2_AVERAGE_SHARPNESS_MEASURE_FOR_AF_WINDOWS_W44_AND_W43"},
+    {MT9D111_REG_PAGE_2, MT9D111_REG_LENS_CORRECTION_CONTROL, MT9D111_REG_DESC_PRESENT, 0x07FF, 0x0000, "LENS_CORRECTION_CONTROL"},
+    {MT9D111_REG_PAGE_2, MT9D111_REG_ZONE_BOUNDARIES_X1_AND_X2, MT9D111_REG_DESC_PRESENT, 0xFFFF, 0x0000, "ZONE_BOUNDARIES_X1_AND_X2"},
+    {MT9D111_REG_PAGE_2, MT9D111_REG_ZONE_BOUNDARIES_X0_AND_X3, MT9D111_REG_DESC_PRESENT, 0xFFFF, 0x0000, "ZONE_BOUNDARIES_X0_AND_X3"},
+    {MT9D111_REG_PAGE_2, MT9D111_REG_ZONE_BOUNDARIES_X4_AND_X5, MT9D111_REG_DESC_PRESENT, 0xFFFF, 0x0000, "ZONE_BOUNDARIES_X4_AND_X5"},
+    {MT9D111_REG_PAGE_2, MT9D111_REG_ZONE_BOUNDARIES_Y1_AND_Y2, MT9D111_REG_DESC_PRESENT, 0xFFFF, 0x0000, "ZONE_BOUNDARIES_Y1_AND_Y2"},
+    {MT9D111_REG_PAGE_2, MT9D111_REG_ZONE_BOUNDARIES_Y0_AND_Y3, MT9D111_REG_DESC_PRESENT, 0xFFFF, 0x0000, "ZONE_BOUNDARIES_Y0_AND_Y3"},
+    {MT9D111_REG_PAGE_2, MT9D111_REG_ZONE_BOUNDARIES_Y4_AND_Y5, MT9D111_REG_DESC_PRESENT, 0xFFFF, 0x0000, "ZONE_BOUNDARIES_Y4_AND_Y5"},
+    {MT9D111_REG_PAGE_2, MT9D111_REG_CENTER_OFFSET, MT9D111_REG_DESC_PRESENT, 0xFFFF, 0x0000, "CENTER_OFFSET"},
+    {MT9D111_REG_PAGE_2, MT9D111_REG_FX_FOR_RED_COLOR_AT_THE_FIRST_PIXEL_OF_THE_ARRAY, MT9D111_REG_DESC_PRESENT, 0xFFFF, 0x0000, "FX_FOR_RED_COLOR_AT_THE_FIRST_PIXEL_OF_THE_ARRAY"},
+    {MT9D111_REG_PAGE_2, MT9D111_REG_FX_FOR_GREEN_COLOR_AT_THE_FIRST_PIXEL_OF_THE_ARRAY, MT9D111_REG_DESC_PRESENT, 0xFFFF, 0x0000, "FX_FOR_GREEN_COLOR_AT_THE_FIRST_PIXEL_OF_THE_ARRAY"},
+    {MT9D111_REG_PAGE_2, MT9D111_REG_FX_FOR_BLUE_COLOR_AT_THE_FIRST_PIXEL_OF_THE_ARRAY, MT9D111_REG_DESC_PRESENT, 0xFFFF, 0x0000, "FX_FOR_BLUE_COLOR_AT_THE_FIRST_PIXEL_OF_THE_ARRAY"},
+    {MT9D111_REG_PAGE_2, MT9D111_REG_FY_FOR_RED_COLOR_AT_THE_FIRST_PIXEL_OF_THE_ARRAY, MT9D111_REG_DESC_PRESENT, 0xFFFF, 0x0000, "FY_FOR_RED_COLOR_AT_THE_FIRST_PIXEL_OF_THE_ARRAY"},
+    {MT9D111_REG_PAGE_2, MT9D111_REG_FY_FOR_GREEN_COLOR_AT_THE_FIRST_PIXEL_OF_THE_ARRAY, MT9D111_REG_DESC_PRESENT, 0xFFFF, 0x0000, "FY_FOR_GREEN_COLOR_AT_THE_FIRST_PIXEL_OF_THE_ARRAY"},
+    {MT9D111_REG_PAGE_2, MT9D111_REG_FY_FOR_BLUE_COLOR_AT_THE_FIRST_PIXEL_OF_THE_ARRAY, MT9D111_REG_DESC_PRESENT, 0xFFFF, 0x0000, "FY_FOR_BLUE_COLOR_AT_THE_FIRST_PIXEL_OF_THE_ARRAY"},
+    {MT9D111_REG_PAGE_2, MT9D111_REG_DF_DX_FOR_RED_COLOR_AT_THE_FIRST_PIXEL_OF_THE_ARRAY, MT9D111_REG_DESC_PRESENT, 0xFFFF, 0x0000, "DF_DX_FOR_RED_COLOR_AT_THE_FIRST_PIXEL_OF_THE_ARRAY"},
+    {MT9D111_REG_PAGE_2, MT9D111_REG_DF_DX_FOR_GREEN_COLOR_AT_THE_FIRST_PIXEL_OF_THE_ARRAY, MT9D111_REG_DESC_PRESENT, 0xFFFF, 0x0000, "DF_DX_FOR_GREEN_COLOR_AT_THE_FIRST_PIXEL_OF_THE_ARRAY"},
+    {MT9D111_REG_PAGE_2, MT9D111_REG_DF_DX_FOR_BLUE_COLOR_AT_THE_FIRST_PIXEL_OF_THE_ARRAY, MT9D111_REG_DESC_PRESENT, 0xFFFF, 0x0000, "DF_DX_FOR_BLUE_COLOR_AT_THE_FIRST_PIXEL_OF_THE_ARRAY"},
+    {MT9D111_REG_PAGE_2, MT9D111_REG_DF_DY_FOR_RED_COLOR_AT_THE_FIRST_PIXEL_OF_THE_ARRAY, MT9D111_REG_DESC_PRESENT, 0xFFFF, 0x0000, "DF_DY_FOR_RED_COLOR_AT_THE_FIRST_PIXEL_OF_THE_ARRAY"},
+    {MT9D111_REG_PAGE_2, MT9D111_REG_DF_DY_FOR_GREEN_COLOR_AT_THE_FIRST_PIXEL_OF_THE_ARRAY, MT9D111_REG_DESC_PRESENT, 0xFFFF, 0x0000, "DF_DY_FOR_GREEN_COLOR_AT_THE_FIRST_PIXEL_OF_THE_ARRAY"},
+    {MT9D111_REG_PAGE_2, MT9D111_REG_DF_DY_FOR_BLUE_COLOR_AT_THE_FIRST_PIXEL_OF_THE_ARRAY, MT9D111_REG_DESC_PRESENT, 0xFFFF, 0x0000, "DF_DY_FOR_BLUE_COLOR_AT_THE_FIRST_PIXEL_OF_THE_ARRAY"},
+    {MT9D111_REG_PAGE_2, MT9D111_REG_SECOND_DERIVATIVE_FOR_ZONE_0_RED_COLOR, MT9D111_REG_DESC_PRESENT, 0xFFFF, 0x0000, "SECOND_DERIVATIVE_FOR_ZONE_0_RED_COLOR"},
+    {MT9D111_REG_PAGE_2, MT9D111_REG_SECOND_DERIVATIVE_FOR_ZONE_0_GREEN_COLOR, MT9D111_REG_DESC_PRESENT, 0xFFFF, 0x0000, "SECOND_DERIVATIVE_FOR_ZONE_0_GREEN_COLOR"},
+    {MT9D111_REG_PAGE_2, MT9D111_REG_SECOND_DERIVATIVE_FOR_ZONE_0_BLUE_COLOR, MT9D111_REG_DESC_PRESENT, 0xFFFF, 0x0000, "SECOND_DERIVATIVE_FOR_ZONE_0_BLUE_COLOR"},
+    {MT9D111_REG_PAGE_2, MT9D111_REG_SECOND_DERIVATIVE_FOR_ZONE_1_RED_COLOR, MT9D111_REG_DESC_PRESENT, 0xFFFF, 0x0000, "SECOND_DERIVATIVE_FOR_ZONE_1_RED_COLOR"},
+    {MT9D111_REG_PAGE_2, MT9D111_REG_SECOND_DERIVATIVE_FOR_ZONE_1_GREEN_COLOR, MT9D111_REG_DESC_PRESENT, 0xFFFF, 0x0000, "SECOND_DERIVATIVE_FOR_ZONE_1_GREEN_COLOR"},
+    {MT9D111_REG_PAGE_2, MT9D111_REG_SECOND_DERIVATIVE_FOR_ZONE_1_BLUE_COLOR, MT9D111_REG_DESC_PRESENT, 0xFFFF, 0x0000, "SECOND_DERIVATIVE_FOR_ZONE_1_BLUE_COLOR"},
+    {MT9D111_REG_PAGE_2, MT9D111_REG_SECOND_DERIVATIVE_FOR_ZONE_2_RED_COLOR, MT9D111_REG_DESC_PRESENT, 0xFFFF, 0x0000, "SECOND_DERIVATIVE_FOR_ZONE_2_RED_COLOR"},
+    {MT9D111_REG_PAGE_2, MT9D111_REG_SECOND_DERIVATIVE_FOR_ZONE_2_GREEN_COLOR, MT9D111_REG_DESC_PRESENT, 0xFFFF, 0x0000, "SECOND_DERIVATIVE_FOR_ZONE_2_GREEN_COLOR"},
+    {MT9D111_REG_PAGE_2, MT9D111_REG_SECOND_DERIVATIVE_FOR_ZONE_2_BLUE_COLOR, MT9D111_REG_DESC_PRESENT, 0xFFFF, 0x0000, "SECOND_DERIVATIVE_FOR_ZONE_2_BLUE_COLOR"},
+    {MT9D111_REG_PAGE_2, MT9D111_REG_SECOND_DERIVATIVE_FOR_ZONE_3_RED_COLOR, MT9D111_REG_DESC_PRESENT, 0xFFFF, 0x0000, "SECOND_DERIVATIVE_FOR_ZONE_3_RED_COLOR"},
+    {MT9D111_REG_PAGE_2, MT9D111_REG_SECOND_DERIVATIVE_FOR_ZONE_3_GREEN_COLOR, MT9D111_REG_DESC_PRESENT, 0xFFFF, 0x0000, "SECOND_DERIVATIVE_FOR_ZONE_3_GREEN_COLOR"},
+    {MT9D111_REG_PAGE_2, MT9D111_REG_SECOND_DERIVATIVE_FOR_ZONE_3_BLUE_COLOR, MT9D111_REG_DESC_PRESENT, 0xFFFF, 0x0000, "SECOND_DERIVATIVE_FOR_ZONE_3_BLUE_COLOR"},
+    {MT9D111_REG_PAGE_2, MT9D111_REG_SECOND_DERIVATIVE_FOR_ZONE_4_RED_COLOR, MT9D111_REG_DESC_PRESENT, 0xFFFF, 0x0000, "SECOND_DERIVATIVE_FOR_ZONE_4_RED_COLOR"},
+    {MT9D111_REG_PAGE_2, MT9D111_REG_SECOND_DERIVATIVE_FOR_ZONE_4_GREEN_COLOR, MT9D111_REG_DESC_PRESENT, 0xFFFF, 0x0000, "SECOND_DERIVATIVE_FOR_ZONE_4_GREEN_COLOR"},
+    {MT9D111_REG_PAGE_2, MT9D111_REG_SECOND_DERIVATIVE_FOR_ZONE_4_BLUE_COLOR, MT9D111_REG_DESC_PRESENT, 0xFFFF, 0x0000, "SECOND_DERIVATIVE_FOR_ZONE_4_BLUE_COLOR"},
+    {MT9D111_REG_PAGE_2, MT9D111_REG_SECOND_DERIVATIVE_FOR_ZONE_5_RED_COLOR, MT9D111_REG_DESC_PRESENT, 0xFFFF, 0x0000, "SECOND_DERIVATIVE_FOR_ZONE_5_RED_COLOR"},
+    {MT9D111_REG_PAGE_2, MT9D111_REG_SECOND_DERIVATIVE_FOR_ZONE_5_GREEN_COLOR, MT9D111_REG_DESC_PRESENT, 0xFFFF, 0x0000, "SECOND_DERIVATIVE_FOR_ZONE_5_GREEN_COLOR"},
+    {MT9D111_REG_PAGE_2, MT9D111_REG_SECOND_DERIVATIVE_FOR_ZONE_5_BLUE_COLOR, MT9D111_REG_DESC_PRESENT, 0xFFFF, 0x0000, "SECOND_DERIVATIVE_FOR_ZONE_5_BLUE_COLOR"},
+    {MT9D111_REG_PAGE_2, MT9D111_REG_SECOND_DERIVATIVE_FOR_ZONE_6_RED_COLOR, MT9D111_REG_DESC_PRESENT, 0xFFFF, 0x0000, "SECOND_DERIVATIVE_FOR_ZONE_6_RED_COLOR"},
+    {MT9D111_REG_PAGE_2, MT9D111_REG_SECOND_DERIVATIVE_FOR_ZONE_6_GREEN_COLOR, MT9D111_REG_DESC_PRESENT, 0xFFFF, 0x0000, "SECOND_DERIVATIVE_FOR_ZONE_6_GREEN_COLOR"},
+    {MT9D111_REG_PAGE_2, MT9D111_REG_SECOND_DERIVATIVE_FOR_ZONE_6_BLUE_COLOR, MT9D111_REG_DESC_PRESENT, 0xFFFF, 0x0000, "SECOND_DERIVATIVE_FOR_ZONE_6_BLUE_COLOR"},
+    {MT9D111_REG_PAGE_2, MT9D111_REG_SECOND_DERIVATIVE_FOR_ZONE_7_RED_COLOR, MT9D111_REG_DESC_PRESENT, 0xFFFF, 0x0000, "SECOND_DERIVATIVE_FOR_ZONE_7_RED_COLOR"},
+    {MT9D111_REG_PAGE_2, MT9D111_REG_SECOND_DERIVATIVE_FOR_ZONE_7_GREEN_COLOR, MT9D111_REG_DESC_PRESENT, 0xFFFF, 0x0000, "SECOND_DERIVATIVE_FOR_ZONE_7_GREEN_COLOR"},
+    {MT9D111_REG_PAGE_2, MT9D111_REG_SECOND_DERIVATIVE_FOR_ZONE_7_BLUE_COLOR, MT9D111_REG_DESC_PRESENT, 0xFFFF, 0x0000, "SECOND_DERIVATIVE_FOR_ZONE_7_BLUE_COLOR"},
+    {MT9D111_REG_PAGE_2, MT9D111_REG_X2_FACTORS, MT9D111_REG_DESC_PRESENT, 0xFFFF, 0x0000, "X2_FACTORS"},
+    {MT9D111_REG_PAGE_2, MT9D111_REG_GLOBAL_OFFSET_OF_FXY_FUNCTION, MT9D111_REG_DESC_PRESENT, 0xFFFF, 0x0000, "GLOBAL_OFFSET_OF_FXY_FUNCTION"},
+    {MT9D111_REG_PAGE_2, MT9D111_REG_K_FACTOR_IN_K_FX_FY, MT9D111_REG_DESC_PRESENT, 0xFFFF, 0x0000, "K_FACTOR_IN_K_FX_FY"},
+    {MT9D111_REG_PAGE_2, MT9D111_REG_BOUNDARIES_OF_FIRST_AE_MEASUREMENT_WINDOW_TOP_LEFT, MT9D111_REG_DESC_PRESENT, 0xFFFF, 0x0000, "BOUNDARIES_OF_FIRST_AE_MEASUREMENT_WINDOW_TOP_LEFT"},
+    {MT9D111_REG_PAGE_2, MT9D111_REG_BOUNDARIES_OF_FIRST_AE_MEASUREMENT_WINDOW_HEIGHT_WIDTH, MT9D111_REG_DESC_PRESENT, 0xFFFF, 0x0000, "BOUNDARIES_OF_FIRST_AE_MEASUREMENT_WINDOW_HEIGHT_WIDTH"},
+    {MT9D111_REG_PAGE_2, MT9D111_REG_AE_MEASUREMENT_WINDOW_SIZE_LSW, MT9D111_REG_DESC_PRESENT, 0xFFFF, 0x0000, "AE_MEASUREMENT_WINDOW_SIZE_LSW"},
+    {MT9D111_REG_PAGE_2, MT9D111_REG_AE_AF_MEASUREMENT_ENABLE, MT9D111_REG_DESC_PRESENT, 0xFFFF, 0x0000, "AE_AF_MEASUREMENT_ENABLE"},
+    {MT9D111_REG_PAGE_2, MT9D111_REG_AVERAGE_LUMINANCE_IN_AE_WINDOWS_W12_AND_W11, MT9D111_REG_DESC_PRESENT | MT9D111_REG_DESC_VOLATILE, 0xFFFF, 0x0000, "AVERAGE_LUMINANCE_IN_AE_WINDOWS_W12_AND_W11"},
+    {MT9D111_REG_PAGE_2, MT9D111_REG_AVERAGE_LUMINANCE_IN_AE_WINDOWS_W14_AND_W13, MT9D111_REG_DESC_PRESENT | MT9D111_REG_DESC_VOLATILE, 0xFFFF, 0x0000, "AVERAGE_LUMINANCE_IN_AE_WINDOWS_W14_AND_W13"},
+    {MT9D111_REG_PAGE_2, MT9D111_REG_AVERAGE_LUMINANCE_IN_AE_WINDOWS_W22_AND_W21, MT9D111_REG_DESC_PRESENT | MT9D111_REG_DESC_VOLATILE, 0xFFFF, 0x0000, "AVERAGE_LUMINANCE_IN_AE_WINDOWS_W22_AND_W21"},
+    {MT9D111_REG_PAGE_2, MT9D111_REG_AVERAGE_LUMINANCE_IN_AE_WINDOWS_W24_AND_W23, MT9D111_REG_DESC_PRESENT | MT9D111_REG_DESC_VOLATILE, 0xFFFF, 0x0000, "AVERAGE_LUMINANCE_IN_AE_WINDOWS_W24_AND_W23"},
+    {MT9D111_REG_PAGE_2, MT9D111_REG_AVERAGE_LUMINANCE_IN_AE_WINDOWS_W32_AND_W31, MT9D111_REG_DESC_PRESENT | MT9D111_REG_DESC_VOLATILE, 0xFFFF, 0x0000, "AVERAGE_LUMINANCE_IN_AE_WINDOWS_W32_AND_W31"},
+    {MT9D111_REG_PAGE_2, MT9D111_REG_AVERAGE_LUMINANCE_IN_AE_WINDOWS_W34_AND_W33, MT9D111_REG_DESC_PRESENT | MT9D111_REG_DESC_VOLATILE, 0xFFFF, 0x0000, "AVERAGE_LUMINANCE_IN_AE_WINDOWS_W34_AND_W33"},
+    {MT9D111_REG_PAGE_2, MT9D111_REG_AVERAGE_LUMINANCE_IN_AE_WINDOWS_W42_AND_W41, MT9D111_REG_DESC_PRESENT | MT9D111_REG_DESC_VOLATILE, 0xFFFF, 0x0000, "AVERAGE_LUMINANCE_IN_AE_WINDOWS_W42_AND_W41"},
+    {MT9D111_REG_PAGE_2, MT9D111_REG_AVERAGE_LUMINANCE_IN_AE_WINDOWS_W44_AND_W43, MT9D111_REG_DESC_PRESENT | MT9D111_REG_DESC_VOLATILE, 0xFFFF, 0x0000, "AVERAGE_LUMINANCE_IN_AE_WINDOWS_W44_AND_W43"},
+    {MT9D111_REG_PAGE_2, MT9D111_REG_SATURATION_AND_COLOR_KILL, MT9D111_REG_DESC_PRESENT, 0xFFFF, 0x0000, "SATURATION_AND_COLOR_KILL"},
+    {MT9D111_REG_PAGE_2, MT9D111_REG_HISTOGRAM_WINDOW_LOWER_BOUNDARIES, MT9D111_REG_DESC_PRESENT, 0xFFFF, 0x0000, "HISTOGRAM_WINDOW_LOWER_BOUNDARIES"},
+    {MT9D111_REG_PAGE_2, MT9D111_REG_HISTOGRAM_WINDOW_UPPER_BOUNDARIES, MT9D111_REG_DESC_PRESENT, 0xFFFF, 0x0000, "HISTOGRAM_WINDOW_UPPER_BOUNDARIES"},
+    {MT9D111_REG_PAGE_2, MT9D111_REG_FIRST_SET_OF_BIN_DEFINITIONS, MT9D111_REG_DESC_PRESENT, 0xFFFF, 0x0000, "FIRST_SET_OF_BIN_DEFINITIONS"},
+    {MT9D111_REG_PAGE_2, MT9D111_REG_SECONDS_SET_OF_BIN_DEFINITIONS, MT9D111_REG_DESC_PRESENT, 0xFFFF, 0x0000, "SECONDS_SET_OF_BIN_DEFINITIONS"},
+    {MT9D111_REG_PAGE_2, MT9D111_REG_HISTOGRAM_WINDOW_SIZE, MT9D111_REG_DESC_PRESENT, 0xFFFF, 0x0000, "HISTOGRAM_WINDOW_SIZE"},
+    {MT9D111_REG_PAGE_2, MT9D111_REG_PIXEL_COUNTS_FOR_BIN0_AND_BIN1, MT9D111_REG_DESC_PRESENT | MT9D111_REG_DESC_VOLATILE, 0xFFFF, 0x0000, "PIXEL_COUNTS_FOR_BIN0_AND_BIN1"},
+    {MT9D111_REG_PAGE_2, MT9D111_REG_PIXEL_COUNTS_FOR_BIN2_AND_BIN3, MT9D111_REG_DESC_PRESENT | MT9D111_REG_DESC_VOLATILE, 0xFFFF, 0x0000, "PIXEL_COUNTS_FOR_BIN2_AND_BIN3"},
+    {MT9D111_REG_PAGE_2, MT9D111_REG_PAGE_REGISTER, MT9D111_REG_DESC_PRESENT, 0x0007, 0x0000, "PAGE_REGISTER"},
+};
+
+/**
+ * \brief Index of the descriptors by page and address (built at compile time).
+ */
+struct RegDescIndex
+{
+    int16_t idx[MT9D111_REG_PAGES][MT9D111_REG_PAGE_SIZE];  /**< Position in mt9d111_reg_desc_list (-1 if undocumented). */
+
+    /**
+     * \brief Constructor.
+     *
+     * \return None.
+     */
+    constexpr RegDescIndex() : idx()
+    {
+        for(size_t p=0; p<MT9D111_REG_PAGES; p++)
+        {
+            for(size_t a=0; a<MT9D111_REG_PAGE_SIZE; a++)
+            {
+                idx[p][a] = -1;
+            }
+        }
+
+        for(size_t i=0; i<MT9D111_REG_DESC_LEN; i++)
+        {
+            idx[mt9d111_reg_desc_list[i].page][mt9d111_reg_desc_list[i].address] = i;
+        }
+    }
+};
+
+constexpr RegDescIndex mt9d111_reg_desc_index;
+
+/**
+ * \brief Descriptor of the undocumented registers.
+ */
+constexpr RegDesc mt9d111_reg_desc_unknown = {MT9D111_REG_PAGE_UNKNOWN, 0x00, 0, 0xFFFF, 0x0000, "UNKNOWN"};
+
+/**
+ * \brief Gets the descriptor of a register.
+ *
+ * \param[in] page is the register page.
+ * \param[in] adr is the register address.
+ *
+ * \return The descriptor of the register (flags = 0 if the register is undocumented).
+ */
+constexpr const RegDesc& RegGetDesc(uint8_t page, uint8_t adr)
+{
+    return ((page < MT9D111_REG_PAGES) and (mt9d111_reg_desc_index.idx[page][adr] >= 0))?
+           mt9d111_reg_desc_list[mt9d111_reg_desc_index.idx[page][adr]] : mt9d111_reg_desc_unknown;
+}
+
+/**
+ * \brief Checks if the value of a register can be kept in a shadow copy.
+ *
+ * The undocumented registers of the valid pages are cacheable (the driver only writes registers it knows).
+ *
+ * \param[in] page is the register page.
+ * \param[in] adr is the register address.
+ *
+ * \return TRUE/FALSE if the register is cacheable or not.
+ */
+constexpr bool RegIsCacheable(uint8_t page, uint8_t adr)
+{
+    return (page < MT9D111_REG_PAGES) and
+           !(RegGetDesc(page, adr).flags & (MT9D111_REG_DESC_READ_ONLY | MT9D111_REG_DESC_SELF_CLEARING | MT9D111_REG_DESC_VOLATILE));
+}
+
+/**
+ * \brief Checks if a write to a register can be verified by reading it back.
+ *
+ * \param[in] page is the register page.
+ * \param[in] adr is the register address.
+ *
+ * \return TRUE/FALSE if the register can be verified or not.
+ */
+constexpr bool RegIsVerifiable(uint8_t page, uint8_t adr)
+{
+    return RegIsCacheable(page, adr);
+}
+
+#endif // MT9D111_REG_DESC_H_
+
+//! \} End of registers group
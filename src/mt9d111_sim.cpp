@@ -0,0 +1,628 @@
+/*
+ * mt9d111_sim.cpp
+ * 
+ * Copyright (C) 2018, Gabriel Mariano Marcelino <gabriel.mm8@gmail.com>
+ * 
+ * This file is part of MT9D111-Driver.
+ * 
+ * MT9D111-Driver is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ * 
+ * MT9D111-Driver is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ * 
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with MT9D111-Driver. If not, see <http://www.gnu.org/licenses/>.
+ * 
+ */
+
+/**
+ * \brief In-process MT9D111 simulator implementation.
+ * 
+ * \author Gabriel Mariano Marcelino <gabriel.mm8@gmail.com>
+ * 
+ * \version 1.0-dev
+ * 
+ * \date 17/10/2026
+ * 
+ * \addtogroup sim
+ * \{
+ */
+
+#include <string.h>
+#include <errno.h>
+#include <time.h>
+
+#include "mt9d111_sim.h"
+#include "mt9d111_config.h"
+#include "mt9d111_reg_desc.h"
+
+using namespace std;
+
+MT9D111SimPin::MT9D111SimPin(MT9D111Sim *s, uint8_t p)
+{
+    this->sim = s;
+    this->pin = p;
+}
+
+bool MT9D111SimPin::Set(bool s)
+{
+    this->sim->SetPin(this->pin, s);
+
+    return true;
+}
+
+bool MT9D111SimPin::Get(bool &s)
+{
+    s = this->sim->GetPin(this->pin);
+
+    return true;
+}
+
+bool MT9D111SimPin::WaitEdge(uint8_t, int, GPIOEvent*)
+{
+    // There are no edges to wait for in the simulator
+    return false;
+}
+
+MT9D111Sim::MT9D111Sim(uint8_t id)
+    : reset(this, MT9D111_SIM_PIN_RESET), standby(this, MT9D111_SIM_PIN_STANDBY)
+{
+    this->slave_id = id;
+
+    this->reset_pin = true;
+    this->standby_pin = false;
+
+    this->seq_latency_us = MT9D111_SIM_DEFAULT_SEQ_LATENCY_US;
+
+    this->transaction_us = MT9D111_SIM_DEFAULT_TRANSACTION_US;
+    this->byte_ns = MT9D111_SIM_DEFAULT_BYTE_NS;
+
+    this->fail_count = 0;
+    this->fail_error = 0;
+    this->last_error = 0;
+
+    this->transactions = 0;
+    this->bytes = 0;
+
+    this->page = MT9D111_REG_PAGE_0;
+    this->pointer = 0;
+
+    this->LoadDefaults(true, true);
+}
+
+void MT9D111Sim::LoadDefaults(bool core, bool soc)
+{
+    for(uint8_t pg=MT9D111_REG_PAGE_0; pg<MT9D111_REG_PAGES; pg++)
+    {
+        if ((pg == MT9D111_REG_PAGE_0)? !core : !soc)
+        {
+            continue;
+        }
+
+        memset(this->regs[pg], 0, sizeof(this->regs[pg]));
+
+        // Documented power-up values (as the chip version)
+        for(size_t i=0; i<MT9D111_REG_DESC_LEN; i++)
+        {
+            if ((mt9d111_reg_desc_list[i].page == pg) and (mt9d111_reg_desc_list[i].flags & MT9D111_REG_DESC_DEFAULT_KNOWN))
+            {
+                this->regs[pg][mt9d111_reg_desc_list[i].address] = mt9d111_reg_desc_list[i].value;
+            }
+        }
+
+        // The values assumed by the driver after a hard reset
+        for(size_t i=0; i<sizeof(reg_default_vals)/sizeof(Register); i++)
+        {
+            if (reg_default_vals[i].page == pg)
+            {
+                this->regs[pg][reg_default_vals[i].address] = reg_default_vals[i].value;
+            }
+        }
+
+        this->regs[pg][MT9D111_REG_PAGE_REGISTER] = this->page;
+    }
+
+    if (soc)
+    {
+        memset(this->vars, 0, sizeof(this->vars));
+
+        // The firmware starts in preview
+        this->vars[MT9D111_DRIVER_ID_SEQUENCER >> 8][MT9D111_DRIVER_VAR_SEQUENCER_STATE] = MT9D111_STATE_PREVIEW;
+
+        this->seq_pending = false;
+        this->seq_done = 0;
+    }
+}
+
+int MT9D111Sim::Begin(uint16_t addr, size_t len)
+{
+    this->transactions++;
+    this->bytes += len;
+
+    Wait((uint64_t)this->transaction_us*1000 + (uint64_t)this->byte_ns*len);
+
+    this->UpdateSequencer();
+
+    if (this->fail_count > 0)
+    {
+        this->fail_count--;
+
+        return this->fail_error;
+    }
+
+    if (addr != this->slave_id)
+    {
+        return ENXIO;
+    }
+
+    // No acknowledge in reset or in hard standby
+    if (!this->reset_pin or this->standby_pin)
+    {
+        return EREMOTEIO;
+    }
+
+    return 0;
+}
+
+void MT9D111Sim::Wait(uint64_t ns)
+{
+    if (ns == 0)
+    {
+        return;
+    }
+
+    uint64_t end = I2CStats::Now() + ns;
+
+    // The sleeps are not precise enough for the short transactions
+    if (ns > MT9D111_SIM_SPIN_NS)
+    {
+        struct timespec t;
+        t.tv_sec    = (ns - MT9D111_SIM_SPIN_NS)/1000000000ULL;
+        t.tv_nsec   = (ns - MT9D111_SIM_SPIN_NS)%1000000000ULL;
+
+        nanosleep(&t, NULL);
+    }
+
+    while(I2CStats::Now() < end)
+    {
+    }
+}
+
+void MT9D111Sim::UpdateSequencer()
+{
+    if (!this->seq_pending or (I2CStats::Now() < this->seq_done))
+    {
+        return;
+    }
+
+    uint8_t *seq = this->vars[MT9D111_DRIVER_ID_SEQUENCER >> 8];
+    uint8_t *mode = this->vars[MT9D111_DRIVER_ID_MODE >> 8];
+
+    switch(seq[MT9D111_DRIVER_VAR_SEQUENCER_CMD])
+    {
+        case MT9D111_DRIVER_VAR_SEQUENCER_CMD_DO_PREVIEW:
+            seq[MT9D111_DRIVER_VAR_SEQUENCER_STATE] = MT9D111_STATE_PREVIEW;
+            mode[MT9D111_DRIVER_VAR_MODE_CONTEXT] = MT9D111_MODE_PREVIEW;
+            break;
+        case MT9D111_DRIVER_VAR_SEQUENCER_CMD_DO_CAPTURE:
+            seq[MT9D111_DRIVER_VAR_SEQUENCER_STATE] = MT9D111_STATE_CAPTURE;
+            mode[MT9D111_DRIVER_VAR_MODE_CONTEXT] = MT9D111_MODE_CAPTURE;
+            break;
+        case MT9D111_DRIVER_VAR_SEQUENCER_CMD_DO_STANDBY:
+            seq[MT9D111_DRIVER_VAR_SEQUENCER_STATE] = MT9D111_STATE_STANDBY;
+            break;
+        default:
+            // Run, lock and refreshes keep the current state
+            break;
+    }
+
+    seq[MT9D111_DRIVER_VAR_SEQUENCER_CMD] = 0;
+
+    this->seq_pending = false;
+}
+
+void MT9D111Sim::WriteRegister(uint8_t adr, uint16_t val)
+{
+    // The page register is available in all pages
+    if (adr == MT9D111_REG_PAGE_REGISTER)
+    {
+        this->page = val;
+
+        for(unsigned int i=0; i<MT9D111_REG_PAGES; i++)
+        {
+            this->regs[i][adr] = val;
+        }
+
+        return;
+    }
+
+    if (this->page >= MT9D111_REG_PAGES)
+    {
+        return;
+    }
+
+    if ((RegGetDesc(this->page, adr).flags & MT9D111_REG_DESC_READ_ONLY) or
+        ((this->page == MT9D111_REG_PAGE_0) and (adr == MT9D111_REG_RESERVED)))
+    {
+        return;
+    }
+
+    if ((this->page == MT9D111_REG_PAGE_1) and (adr == MT9D111_REG_MICROCONTROLLER_VARIABLE_DATA))
+    {
+        uint16_t var_adr = this->regs[MT9D111_REG_PAGE_1][MT9D111_REG_MICROCONTROLLER_VARIABLE_ADDRESS];
+
+        // 8-bit access: only the LSB is used
+        if (var_adr & MT9D111_DRIVER_VARIABLE_8_BIT_ACCESS)
+        {
+            this->WriteVar(val & 0xFF);
+        }
+        else
+        {
+            this->WriteVar(val >> 8);
+            this->WriteVar(val & 0xFF);
+        }
+
+        // The data register does not increment the address
+        this->regs[MT9D111_REG_PAGE_1][MT9D111_REG_MICROCONTROLLER_VARIABLE_ADDRESS] = var_adr;
+
+        return;
+    }
+
+    if ((this->page == MT9D111_REG_PAGE_0) and (adr == MT9D111_REG_RESET))
+    {
+        // Bit 0: sensor core reset, bit 5: SOC reset
+        this->LoadDefaults(val & (1 << 0), val & (1 << 5));
+
+        // Bit 1 (restart) is cleared by the sensor
+        this->regs[MT9D111_REG_PAGE_0][adr] = val & ~(1 << 1);
+
+        return;
+    }
+
+    this->regs[this->page][adr] = val;
+}
+
+uint16_t MT9D111Sim::ReadRegister(uint8_t adr)
+{
+    if (adr == MT9D111_REG_PAGE_REGISTER)
+    {
+        return this->page;
+    }
+
+    if (this->page >= MT9D111_REG_PAGES)
+    {
+        return 0;
+    }
+
+    if (this->page == MT9D111_REG_PAGE_1)
+    {
+        switch(adr)
+        {
+            case MT9D111_REG_MICROCONTROLLER_VARIABLE_DATA:
+            {
+                uint16_t var_adr = this->regs[MT9D111_REG_PAGE_1][MT9D111_REG_MICROCONTROLLER_VARIABLE_ADDRESS];
+                uint16_t val;
+
+                if (var_adr & MT9D111_DRIVER_VARIABLE_8_BIT_ACCESS)
+                {
+                    val = this->ReadVar();
+                }
+                else
+                {
+                    val = this->ReadVar() << 8;
+                    val |= this->ReadVar();
+                }
+
+                // The data register does not increment the address
+                this->regs[MT9D111_REG_PAGE_1][MT9D111_REG_MICROCONTROLLER_VARIABLE_ADDRESS] = var_adr;
+
+                return val;
+            }
+            case MT9D111_REG_MIRRORS_SENSOR_REGISTER_0x20:
+                return this->regs[MT9D111_REG_PAGE_0][MT9D111_REG_READ_MODE_B];
+            case MT9D111_REG_MIRRORS_SENSOR_REGISTER_0xF2:
+                return this->regs[MT9D111_REG_PAGE_0][MT9D111_REG_CONTEXT_CONTROL];
+            case MT9D111_REG_MIRRORS_SENSOR_REGISTER_0x21:
+                return this->regs[MT9D111_REG_PAGE_0][MT9D111_REG_READ_MODE_A];
+        }
+    }
+
+    return this->regs[this->page][adr];
+}
+
+void MT9D111Sim::WriteVar(uint8_t val)
+{
+    uint16_t &var_adr = this->regs[MT9D111_REG_PAGE_1][MT9D111_REG_MICROCONTROLLER_VARIABLE_ADDRESS];
+
+    uint8_t driver = (var_adr >> 8) & (MT9D111_SIM_DRIVERS - 1);
+    uint8_t offset = var_adr & 0xFF;
+
+    // Only the logical access is simulated
+    if ((var_adr & (3 << 13)) == MT9D111_DRIVER_PHYSICAL_ACCESS_ADDRESS_LOGICAL)
+    {
+        this->vars[driver][offset] = val;
+
+        if ((driver == (MT9D111_DRIVER_ID_SEQUENCER >> 8)) and (offset == MT9D111_DRIVER_VAR_SEQUENCER_CMD))
+        {
+            this->seq_pending = true;
+            this->seq_done = I2CStats::Now() + (uint64_t)this->seq_latency_us*1000;
+        }
+    }
+
+    var_adr = (var_adr & 0xFF00) | ((offset + 1) & 0xFF);
+}
+
+uint8_t MT9D111Sim::ReadVar()
+{
+    uint16_t &var_adr = this->regs[MT9D111_REG_PAGE_1][MT9D111_REG_MICROCONTROLLER_VARIABLE_ADDRESS];
+
+    uint8_t driver = (var_adr >> 8) & (MT9D111_SIM_DRIVERS - 1);
+    uint8_t offset = var_adr & 0xFF;
+
+    uint8_t val = 0;
+
+    if ((var_adr & (3 << 13)) == MT9D111_DRIVER_PHYSICAL_ACCESS_ADDRESS_LOGICAL)
+    {
+        val = this->vars[driver][offset];
+    }
+
+    var_adr = (var_adr & 0xFF00) | ((offset + 1) & 0xFF);
+
+    return val;
+}
+
+bool MT9D111Sim::IsBurst()
+{
+    return (this->page == MT9D111_REG_PAGE_1) and
+           (this->pointer == MT9D111_REG_MICROCONTROLLER_VARIABLE_DATA_USING_BURST_TWO_WIRE_SERIAL_INTERFACE_ACCESS);
+}
+
+I2CResult<uint16_t> MT9D111Sim::Read16(uint8_t adr)
+{
+    lock_guard<mutex> lock(this->state_mutex);
+
+    I2CResult<uint16_t> res;
+
+    // Address + register, address + 2 bytes
+    res.error = this->Begin(this->slave_id, 5);
+    res.value = 0xFFFF;
+
+    if (res.error == 0)
+    {
+        this->pointer = adr;
+
+        res.value = this->ReadRegister(adr);
+    }
+
+    this->last_error = res.error;
+
+    return res;
+}
+
+bool MT9D111Sim::Write16(uint8_t adr, uint16_t val)
+{
+    lock_guard<mutex> lock(this->state_mutex);
+
+    // Address + register + 2 bytes
+    this->last_error = this->Begin(this->slave_id, 4);
+
+    if (this->last_error == 0)
+    {
+        this->pointer = adr;
+
+        this->WriteRegister(adr, val);
+    }
+
+    return this->last_error == 0;
+}
+
+bool MT9D111Sim::Transfer(I2C_Msg *msgs, unsigned int len)
+{
+    lock_guard<mutex> lock(this->state_mutex);
+
+    size_t n = 0;
+    for(unsigned int i=0; i<len; i++)
+    {
+        n += 1 + msgs[i].len;
+    }
+
+    this->last_error = this->Begin(len > 0? msgs[0].addr : this->slave_id, n);
+
+    // All messages of a combined transfer must address the sensor
+    for(unsigned int i=0; (i<len) and (this->last_error == 0); i++)
+    {
+        if (msgs[i].addr != this->slave_id)
+        {
+            this->last_error = ENXIO;
+        }
+    }
+
+    if (this->last_error != 0)
+    {
+        return false;
+    }
+
+    for(unsigned int i=0; i<len; i++)
+    {
+        uint8_t *buf = msgs[i].buf;
+        unsigned int j = 0;
+
+        if (msgs[i].flags & I2C_M_RD)
+        {
+            while(j < msgs[i].len)
+            {
+                if (this->IsBurst())
+                {
+                    buf[j++] = this->ReadVar();
+
+                    continue;
+                }
+
+                // Registers are read MSB first, and the address is incremented after each word
+                uint16_t val = this->ReadRegister(this->pointer);
+
+                buf[j++] = val >> 8;
+
+                if (j < msgs[i].len)
+                {
+                    buf[j++] = val & 0xFF;
+                }
+
+                this->pointer++;
+            }
+        }
+        else
+        {
+            if (msgs[i].len == 0)
+            {
+                continue;
+            }
+
+            this->pointer = buf[j++];
+
+            while(j < msgs[i].len)
+            {
+                if (this->IsBurst())
+                {
+                    this->WriteVar(buf[j++]);
+
+                    continue;
+                }
+
+                // An incomplete word is ignored
+                if (j + 1 >= msgs[i].len)
+                {
+                    break;
+                }
+
+                this->WriteRegister(this->pointer, (buf[j] << 8) | buf[j + 1]);
+
+                j += 2;
+
+                this->pointer++;
+            }
+        }
+    }
+
+    return true;
+}
+
+uint8_t MT9D111Sim::GetSlaveID()
+{
+    return this->slave_id;
+}
+
+int MT9D111Sim::GetLastError()
+{
+    lock_guard<mutex> lock(this->state_mutex);
+
+    return this->last_error;
+}
+
+Pin* MT9D111Sim::GetResetPin()
+{
+    return &this->reset;
+}
+
+Pin* MT9D111Sim::GetStandbyPin()
+{
+    return &this->standby;
+}
+
+void MT9D111Sim::SetPin(uint8_t p, bool s)
+{
+    lock_guard<mutex> lock(this->state_mutex);
+
+    if (p == MT9D111_SIM_PIN_RESET)
+    {
+        // Leaving the reset restores the power-up values
+        if (!this->reset_pin and s)
+        {
+            this->page = MT9D111_REG_PAGE_0;
+            this->pointer = 0;
+
+            this->LoadDefaults(true, true);
+        }
+
+        this->reset_pin = s;
+    }
+    else
+    {
+        this->standby_pin = s;
+    }
+}
+
+bool MT9D111Sim::GetPin(uint8_t p)
+{
+    lock_guard<mutex> lock(this->state_mutex);
+
+    return (p == MT9D111_SIM_PIN_RESET)? this->reset_pin : this->standby_pin;
+}
+
+void MT9D111Sim::SetLatency(uint32_t transaction_us, uint32_t byte_ns)
+{
+    lock_guard<mutex> lock(this->state_mutex);
+
+    this->transaction_us = transaction_us;
+    this->byte_ns = byte_ns;
+}
+
+void MT9D111Sim::SetSequencerLatency(uint32_t us)
+{
+    lock_guard<mutex> lock(this->state_mutex);
+
+    this->seq_latency_us = us;
+}
+
+void MT9D111Sim::FailNext(unsigned int n, int err)
+{
+    lock_guard<mutex> lock(this->state_mutex);
+
+    this->fail_count = n;
+    this->fail_error = err;
+}
+
+unsigned long MT9D111Sim::GetTransactions()
+{
+    lock_guard<mutex> lock(this->state_mutex);
+
+    return this->transactions;
+}
+
+unsigned long MT9D111Sim::GetBytes()
+{
+    lock_guard<mutex> lock(this->state_mutex);
+
+    return this->bytes;
+}
+
+void MT9D111Sim::ResetCounters()
+{
+    lock_guard<mutex> lock(this->state_mutex);
+
+    this->transactions = 0;
+    this->bytes = 0;
+}
+
+uint16_t MT9D111Sim::GetReg(uint8_t pg, uint8_t adr)
+{
+    lock_guard<mutex> lock(this->state_mutex);
+
+    return (pg < MT9D111_REG_PAGES)? this->regs[pg][adr] : 0;
+}
+
+uint8_t MT9D111Sim::GetVar(uint16_t driver_id, uint8_t offset)
+{
+    lock_guard<mutex> lock(this->state_mutex);
+
+    this->UpdateSequencer();
+
+    return this->vars[(driver_id >> 8) & (MT9D111_SIM_DRIVERS - 1)][offset];
+}
+
+//! \} End of sim group
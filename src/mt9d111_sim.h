@@ -0,0 +1,356 @@
+/*
+ * mt9d111_sim.h
+ * 
+ * Copyright (C) 2018, Gabriel Mariano Marcelino <gabriel.mm8@gmail.com>
+ * 
+ * This file is part of MT9D111-Driver.
+ * 
+ * MT9D111-Driver is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ * 
+ * MT9D111-Driver is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ * 
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with MT9D111-Driver. If not, see <http://www.gnu.org/licenses/>.
+ * 
+ */
+
+/**
+ * \brief In-process MT9D111 simulator.
+ * 
+ * The simulator is a Transport, so it can replace the I2C device of the driver to run it without hardware:
+ * 
+ * \code
+ *      MT9D111Sim sim;
+ *      MT9D111 cam(&sim, sim.GetResetPin(), sim.GetStandbyPin());
+ * \endcode
+ * 
+ * It models:
+ *      - The three registers pages and the page register (R0xF0), with the power-up values of the sensor.
+ *      - The auto-increment of the register address in multi-word transfers.
+ *      - The read-only registers (writes are ignored) and the soft reset register (R0x0D:0).
+ *      - The driver variables, accessed by R0xC6:1 (address), R0xC8:1 (8/16-bit data) and R0xC9:1 (burst).
+ *      - The sequencer: a command written to seq.cmd is executed after a configurable delay, updating seq.state
+ *        and mode.context and clearing seq.cmd.
+ *      - The RESET (active low) and STANDBY (active high) pins. No transaction is acknowledged while the sensor
+ *        is in reset or in hard standby, and leaving the reset restores the power-up values.
+ *      - A configurable latency per transaction and per byte on the bus.
+ *      .
+ * 
+ * \author Gabriel Mariano Marcelino <gabriel.mm8@gmail.com>
+ * 
+ * \version 1.0-dev
+ * 
+ * \date 17/10/2026
+ * 
+ * \defgroup sim Simulator
+ * \ingroup mt9d111
+ * \{
+ */
+
+#ifndef MT9D111_SIM_H_
+#define MT9D111_SIM_H_
+
+#include <stdint.h>
+#include <stddef.h>
+#include <mutex>
+
+#include "transport.h"
+#include "mt9d111.h"
+
+#define MT9D111_SIM_DRIVERS                         32          /**< Number of driver IDs (5 bits). */
+#define MT9D111_SIM_DRIVER_SIZE                     256         /**< Number of variables offsets per driver. */
+
+#define MT9D111_SIM_BYTE_NS_100KHZ                  90000       /**< Time of a byte (9 bits) at 100 kHz. */
+#define MT9D111_SIM_BYTE_NS_400KHZ                  22500       /**< Time of a byte (9 bits) at 400 kHz. */
+
+#define MT9D111_SIM_DEFAULT_TRANSACTION_US          0           /**< Default fixed cost of a transaction. */
+#define MT9D111_SIM_DEFAULT_BYTE_NS                 0           /**< Default cost of a byte. */
+#define MT9D111_SIM_DEFAULT_SEQ_LATENCY_US          0           /**< Default execution time of a sequencer command. */
+
+#define MT9D111_SIM_SPIN_NS                         100000      /**< Last part of a wait done with busy-waiting. */
+
+// Pins
+#define MT9D111_SIM_PIN_RESET                       0
+#define MT9D111_SIM_PIN_STANDBY                     1
+
+class MT9D111Sim;
+
+/**
+ * \brief Control pin of the simulator.
+ */
+class MT9D111SimPin: public Pin
+{
+    private:
+        MT9D111Sim *sim;    /**< Simulator. */
+        uint8_t pin;        /**< Pin (MT9D111_SIM_PIN_RESET or MT9D111_SIM_PIN_STANDBY). */
+
+    public:
+        /**
+         * \brief Constructor.
+         *
+         * \param[in] s is the simulator.
+         * \param[in] p is the pin (MT9D111_SIM_PIN_RESET or MT9D111_SIM_PIN_STANDBY).
+         *
+         * \return None.
+         */
+        MT9D111SimPin(MT9D111Sim *s, uint8_t p);
+
+        bool Set(bool s);
+
+        bool Get(bool &s);
+
+        /**
+         * \brief Edges are not generated by the simulated pins.
+         *
+         * \return FALSE.
+         */
+        bool WaitEdge(uint8_t e, int timeout_ms, GPIOEvent *event=NULL);
+};
+
+/**
+ * \brief Simulated MT9D111 sensor.
+ */
+class MT9D111Sim: public Transport
+{
+    private:
+        std::mutex state_mutex;                                         /**< Lock of the sensor state. */
+
+        uint8_t slave_id;                                               /**< 7-bit slave address. */
+        uint16_t regs[MT9D111_REG_PAGES][MT9D111_REG_PAGE_SIZE];        /**< Registers values. */
+        uint16_t page;                                                  /**< Page register value. */
+        uint8_t pointer;                                                /**< Current register address. */
+        uint8_t vars[MT9D111_SIM_DRIVERS][MT9D111_SIM_DRIVER_SIZE];     /**< Driver variables. */
+
+        bool reset_pin;                                                 /**< RESET pin level (active low). */
+        bool standby_pin;                                               /**< STANDBY pin level (active high). */
+        MT9D111SimPin reset;                                            /**< RESET pin. */
+        MT9D111SimPin standby;                                          /**< STANDBY pin. */
+
+        bool seq_pending;                                               /**< A sequencer command is running. */
+        uint64_t seq_done;                                              /**< End time of the running command (ns). */
+        uint32_t seq_latency_us;                                        /**< Execution time of a command. */
+
+        uint32_t transaction_us;                                        /**< Fixed cost of a transaction. */
+        uint32_t byte_ns;                                               /**< Cost of a byte on the bus. */
+
+        unsigned int fail_count;                                        /**< Number of transactions to fail. */
+        int fail_error;                                                 /**< errno of the failed transactions. */
+        int last_error;                                                 /**< errno of the last transaction. */
+
+        unsigned long transactions;                                     /**< Number of transactions. */
+        unsigned long bytes;                                            /**< Number of bytes on the bus. */
+
+        /**
+         * \brief Loads the power-up values of the registers and of the driver variables.
+         *
+         * \param[in] core is TRUE to reset the sensor core registers (page 0).
+         * \param[in] soc is TRUE to reset the IFP registers (pages 1 and 2), the driver variables and the sequencer.
+         *
+         * \return None.
+         */
+        void LoadDefaults(bool core, bool soc);
+
+        /**
+         * \brief Starts a transaction (latency, injected errors, pins and sequencer).
+         *
+         * \param[in] addr is the slave address of the transaction.
+         * \param[in] len is the number of bytes of the transaction (slave addresses included).
+         *
+         * \return 0 if the sensor acknowledges the transaction, or the errno value.
+         */
+        int Begin(uint16_t addr, size_t len);
+
+        /**
+         * \brief Waits a number of nanoseconds (sleeps and busy-waits the last MT9D111_SIM_SPIN_NS).
+         *
+         * \param[in] ns is the waiting time.
+         *
+         * \return None.
+         */
+        static void Wait(uint64_t ns);
+
+        /**
+         * \brief Executes the running sequencer command if its time has elapsed.
+         *
+         * \return None.
+         */
+        void UpdateSequencer();
+
+        /**
+         * \brief Writes a register of the current page.
+         *
+         * \param[in] adr is the register address.
+         * \param[in] val is the new value.
+         *
+         * \return None.
+         */
+        void WriteRegister(uint8_t adr, uint16_t val);
+
+        /**
+         * \brief Reads a register of the current page.
+         *
+         * \param[in] adr is the register address.
+         *
+         * \return The register value.
+         */
+        uint16_t ReadRegister(uint8_t adr);
+
+        /**
+         * \brief Writes the driver variable selected by R0xC6:1 and increments the address.
+         *
+         * \param[in] val is the new value (8-bit).
+         *
+         * \return None.
+         */
+        void WriteVar(uint8_t val);
+
+        /**
+         * \brief Reads the driver variable selected by R0xC6:1 and increments the address.
+         *
+         * \return The variable value (8-bit).
+         */
+        uint8_t ReadVar();
+
+        /**
+         * \brief Checks if R0xC9:1 (burst) is the current register.
+         *
+         * \return TRUE/FALSE if the data bytes are driver variables or not.
+         */
+        bool IsBurst();
+
+    public:
+        /**
+         * \brief Constructor (the sensor is powered-up, out of reset and out of standby).
+         *
+         * \param[in] id is the 7-bit slave address.
+         *
+         * \return None.
+         */
+        MT9D111Sim(uint8_t id=MT9D111_CONFIG_I2C_ID);
+
+        I2CResult<uint16_t> Read16(uint8_t adr);
+
+        bool Write16(uint8_t adr, uint16_t val);
+
+        bool Transfer(I2C_Msg *msgs, unsigned int len);
+
+        uint8_t GetSlaveID();
+
+        int GetLastError();
+
+        /**
+         * \brief Gets the RESET pin.
+         *
+         * \return A pointer to the RESET pin.
+         */
+        Pin* GetResetPin();
+
+        /**
+         * \brief Gets the STANDBY pin.
+         *
+         * \return A pointer to the STANDBY pin.
+         */
+        Pin* GetStandbyPin();
+
+        /**
+         * \brief Sets the level of a pin.
+         *
+         * \param[in] p is the pin (MT9D111_SIM_PIN_RESET or MT9D111_SIM_PIN_STANDBY).
+         * \param[in] s is the new level (TRUE = high).
+         *
+         * \return None.
+         */
+        void SetPin(uint8_t p, bool s);
+
+        /**
+         * \brief Gets the level of a pin.
+         *
+         * \param[in] p is the pin (MT9D111_SIM_PIN_RESET or MT9D111_SIM_PIN_STANDBY).
+         *
+         * \return The pin level (TRUE = high).
+         */
+        bool GetPin(uint8_t p);
+
+        /**
+         * \brief Sets the latency of the bus.
+         *
+         * The time of a transaction is "transaction_us" plus "byte_ns" for each byte (slave addresses included). A
+         * 400 kHz bus can be simulated with MT9D111_SIM_BYTE_NS_400KHZ.
+         *
+         * \param[in] transaction_us is the fixed cost of a transaction in microseconds.
+         * \param[in] byte_ns is the cost of each byte in nanoseconds.
+         *
+         * \return None.
+         */
+        void SetLatency(uint32_t transaction_us, uint32_t byte_ns);
+
+        /**
+         * \brief Sets the execution time of the sequencer commands.
+         *
+         * \param[in] us is the execution time in microseconds.
+         *
+         * \return None.
+         */
+        void SetSequencerLatency(uint32_t us);
+
+        /**
+         * \brief Makes the next transactions fail (error injection).
+         *
+         * \param[in] n is the number of transactions to fail.
+         * \param[in] err is the errno value of the failures (ex.: EREMOTEIO).
+         *
+         * \return None.
+         */
+        void FailNext(unsigned int n, int err);
+
+        /**
+         * \brief Gets the number of transactions since the last "ResetCounters".
+         *
+         * \return The number of transactions (failed ones included).
+         */
+        unsigned long GetTransactions();
+
+        /**
+         * \brief Gets the number of bytes on the bus since the last "ResetCounters".
+         *
+         * \return The number of bytes (slave addresses included).
+         */
+        unsigned long GetBytes();
+
+        /**
+         * \brief Clears the transactions and bytes counters.
+         *
+         * \return None.
+         */
+        void ResetCounters();
+
+        /**
+         * \brief Gets the value of a register (without a bus transaction).
+         *
+         * \param[in] pg is the register page.
+         * \param[in] adr is the register address.
+         *
+         * \return The register value.
+         */
+        uint16_t GetReg(uint8_t pg, uint8_t adr);
+
+        /**
+         * \brief Gets the value of a driver variable (without a bus transaction).
+         *
+         * \param[in] driver_id is the driver ID (MT9D111_DRIVER_ID_MONITOR, MT9D111_DRIVER_ID_SEQUENCER, etc.).
+         * \param[in] offset is the variable offset.
+         *
+         * \return The variable value (8-bit).
+         */
+        uint8_t GetVar(uint16_t driver_id, uint8_t offset);
+};
+
+#endif // MT9D111_SIM_H_
+
+//! \} End of sim group
@@ -0,0 +1,105 @@
+/*
+ * transport.cpp
+ * 
+ * Copyright (C) 2018, Gabriel Mariano Marcelino <gabriel.mm8@gmail.com>
+ * 
+ * This file is part of MT9D111-Driver.
+ * 
+ * MT9D111-Driver is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ * 
+ * MT9D111-Driver is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ * 
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with MT9D111-Driver. If not, see <http://www.gnu.org/licenses/>.
+ * 
+ */
+
+/**
+ * \brief Linux I2C and GPIO transports implementation.
+ * 
+ * \author Gabriel Mariano Marcelino <gabriel.mm8@gmail.com>
+ * 
+ * \version 1.0-dev
+ * 
+ * \date 17/10/2026
+ * 
+ * \addtogroup transport
+ * \{
+ */
+
+#include "transport.h"
+
+using namespace std;
+
+bool I2CTransport::Open(const char *dev_adr, uint8_t dev_id, bool shared)
+{
+    if (shared)
+    {
+        return this->i2c.SetupShared(dev_adr, dev_id);
+    }
+
+    return this->i2c.Setup(dev_adr, dev_id);
+}
+
+I2CResult<uint16_t> I2CTransport::Read16(uint8_t adr)
+{
+    I2CResult<uint16_t> res = this->i2c.TryReadReg16(adr);
+
+    // SMBus words are LSB first
+    res.value = ((res.value & 0xFF00) >> 8) | ((res.value & 0x00FF) << 8);
+
+    return res;
+}
+
+bool I2CTransport::Write16(uint8_t adr, uint16_t val)
+{
+    return this->i2c.WriteReg16(adr, ((val & 0xFF00) >> 8) | ((val & 0x00FF) << 8));
+}
+
+bool I2CTransport::Transfer(I2C_Msg *msgs, unsigned int len)
+{
+    return this->i2c.Transfer(msgs, len);
+}
+
+uint8_t I2CTransport::GetSlaveID()
+{
+    return this->i2c.GetSlaveID();
+}
+
+int I2CTransport::GetLastError()
+{
+    return this->i2c.GetLastError();
+}
+
+bool GPIOPin::Open(uint8_t p, bool d, uint8_t b, const char *chip)
+{
+    return this->gpio.Open(p, d, b, chip);
+}
+
+GPIO* GPIOPin::GetGPIO()
+{
+    return &this->gpio;
+}
+
+bool GPIOPin::Set(bool s)
+{
+    return this->gpio.Set(s);
+}
+
+bool GPIOPin::Get(bool &s)
+{
+    return this->gpio.Get(s);
+}
+
+bool GPIOPin::WaitEdge(uint8_t e, int timeout_ms, GPIOEvent *event)
+{
+    return this->gpio.WaitEdge(e, timeout_ms, event);
+}
+
+//! \} End of transport group
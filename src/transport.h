@@ -0,0 +1,216 @@
+/*
+ * transport.h
+ * 
+ * Copyright (C) 2018, Gabriel Mariano Marcelino <gabriel.mm8@gmail.com>
+ * 
+ * This file is part of MT9D111-Driver.
+ * 
+ * MT9D111-Driver is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ * 
+ * MT9D111-Driver is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ * 
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with MT9D111-Driver. If not, see <http://www.gnu.org/licenses/>.
+ * 
+ */
+
+/**
+ * \brief Bus transport and control pins interfaces.
+ * 
+ * The sensor driver only talks to the hardware through these interfaces, so the Linux I2C and GPIO drivers can be
+ * replaced (ex.: by a simulator).
+ * 
+ * \author Gabriel Mariano Marcelino <gabriel.mm8@gmail.com>
+ * 
+ * \version 1.0-dev
+ * 
+ * \date 17/10/2026
+ * 
+ * \defgroup transport Transport
+ * \{
+ */
+
+#ifndef TRANSPORT_H_
+#define TRANSPORT_H_
+
+#include <stdint.h>
+
+#include "i2c.h"
+#include "gpio.h"
+
+/**
+ * \brief Registers bus of a device (16-bit registers with 8-bit addresses).
+ */
+class Transport
+{
+    public:
+        /**
+         * \brief Destructor.
+         *
+         * \return None.
+         */
+        virtual ~Transport() {}
+
+        /**
+         * \brief Reads a 16-bit register (MSB first on the bus).
+         *
+         * \param[in] adr is the register address.
+         *
+         * \return The register value and the error (errno) of the transaction.
+         */
+        virtual I2CResult<uint16_t> Read16(uint8_t adr) = 0;
+
+        /**
+         * \brief Writes a 16-bit register (MSB first on the bus).
+         *
+         * \param[in] adr is the register address.
+         * \param[in] val is the register value.
+         *
+         * \return TRUE/FALSE if successful or not.
+         */
+        virtual bool Write16(uint8_t adr, uint16_t val) = 0;
+
+        /**
+         * \brief Executes a combined transfer (messages separated by repeated starts).
+         *
+         * \param[in,out] msgs is the list of messages.
+         * \param[in] len is the number of messages.
+         *
+         * \return TRUE/FALSE if successful or not.
+         */
+        virtual bool Transfer(I2C_Msg *msgs, unsigned int len) = 0;
+
+        /**
+         * \brief Gets the slave address of the device.
+         *
+         * \return The 7-bit slave address.
+         */
+        virtual uint8_t GetSlaveID() = 0;
+
+        /**
+         * \brief Gets the error of the last transaction.
+         *
+         * \return The errno value (0 if successful).
+         */
+        virtual int GetLastError() = 0;
+};
+
+/**
+ * \brief Control pin of a device.
+ */
+class Pin
+{
+    public:
+        /**
+         * \brief Destructor.
+         *
+         * \return None.
+         */
+        virtual ~Pin() {}
+
+        /**
+         * \brief Sets the state of the pin.
+         *
+         * \param[in] s is the new state (TRUE = high).
+         *
+         * \return TRUE/FALSE if successful or not.
+         */
+        virtual bool Set(bool s) = 0;
+
+        /**
+         * \brief Gets the state of the pin.
+         *
+         * \param[in,out] s is the current state (TRUE = high).
+         *
+         * \return TRUE/FALSE if successful or not.
+         */
+        virtual bool Get(bool &s) = 0;
+
+        /**
+         * \brief Waits for an edge on the pin.
+         *
+         * \param[in] e is the expected edge (GPIO_EDGE_RISING, GPIO_EDGE_FALLING or GPIO_EDGE_BOTH).
+         * \param[in] timeout_ms is the timeout in milliseconds (-1 to wait forever).
+         * \param[in,out] event is a pointer to store the event (can be NULL).
+         *
+         * \return TRUE if the edge was detected or FALSE on timeout/error.
+         */
+        virtual bool WaitEdge(uint8_t e, int timeout_ms, GPIOEvent *event=NULL) = 0;
+};
+
+/**
+ * \brief Transport over a Linux I2C adapter.
+ */
+class I2CTransport: public Transport
+{
+    private:
+        I2C i2c;    /**< I2C device. */
+
+    public:
+        /**
+         * \brief Opens the I2C device.
+         *
+         * \param[in] dev_adr is the I2C adapter (ex.: "/dev/i2c-1").
+         * \param[in] dev_id is the 7-bit slave address.
+         * \param[in] shared is TRUE to share the adapter with the other devices of the same bus (I2C_RDWR accesses), or
+         *            FALSE to open a dedicated file descriptor (I2C_SLAVE and I2C_SMBUS accesses).
+         *
+         * \return TRUE/FALSE if successful or not.
+         */
+        bool Open(const char *dev_adr, uint8_t dev_id, bool shared=true);
+
+        I2CResult<uint16_t> Read16(uint8_t adr);
+
+        bool Write16(uint8_t adr, uint16_t val);
+
+        bool Transfer(I2C_Msg *msgs, unsigned int len);
+
+        uint8_t GetSlaveID();
+
+        int GetLastError();
+};
+
+/**
+ * \brief Pin over a Linux GPIO.
+ */
+class GPIOPin: public Pin
+{
+    private:
+        GPIO gpio;  /**< GPIO pin. */
+
+    public:
+        /**
+         * \brief Opens the GPIO pin.
+         *
+         * \param[in] p is the GPIO pin number.
+         * \param[in] d is the GPIO direction (GPIO_DIR_OUTPUT or GPIO_DIR_INPUT).
+         * \param[in] b is the GPIO backend (GPIO_BACKEND_SYSFS or GPIO_BACKEND_CHARDEV).
+         * \param[in] chip is the GPIO chip device (only used by the chardev backend).
+         *
+         * \return TRUE/FALSE if successful or not.
+         */
+        bool Open(uint8_t p, bool d, uint8_t b=GPIO_BACKEND_SYSFS, const char *chip=GPIO_DEFAULT_CHIP);
+
+        /**
+         * \brief Gets the GPIO pin (for the GPIO specific settings, as the edges).
+         *
+         * \return A pointer to the GPIO pin.
+         */
+        GPIO* GetGPIO();
+
+        bool Set(bool s);
+
+        bool Get(bool &s);
+
+        bool WaitEdge(uint8_t e, int timeout_ms, GPIOEvent *event=NULL);
+};
+
+#endif // TRANSPORT_H_
+
+//! \} End of transport group
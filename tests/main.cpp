@@ -0,0 +1,346 @@
+/*
+ * main.cpp
+ *
+ * Copyright (C) 2018, Gabriel Mariano Marcelino <gabriel.mm8@gmail.com>
+ *
+ * This file is part of MT9D111-Driver.
+ *
+ * MT9D111-Driver is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * MT9D111-Driver is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with MT9D111-Driver. If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+/**
+ * \brief Driver tests against the simulated sensor (MT9D111Sim).
+ *
+ * Each test runs on a fresh simulator and checks the sensor state (registers and driver variables) after the
+ * driver calls. The program returns 0 if all tests pass.
+ *
+ * \author Gabriel Mariano Marcelino <gabriel.mm8@gmail.com>
+ *
+ * \version 1.0-dev
+ *
+ * \date 17/10/2026
+ */
+
+#include <stdio.h>
+#include <errno.h>
+#include <string.h>
+#include <stdint.h>
+
+#include <mt9d111.h>
+#include <mt9d111_sim.h>
+#include <mt9d111_config.h>
+#include <mt9d111_reg_desc.h>
+#include <logger.h>
+
+using namespace std;
+
+static unsigned int checks = 0;     /**< Number of executed checks. */
+static unsigned int failures = 0;   /**< Number of failed checks. */
+
+#define TEST_CHECK(cond)                                                            \
+    do                                                                              \
+    {                                                                               \
+        checks++;                                                                   \
+        if (!(cond))                                                                \
+        {                                                                           \
+            failures++;                                                             \
+            printf("    %s:%d: check failed: %s\n", __FILE__, __LINE__, #cond);     \
+        }                                                                           \
+    } while(0)
+
+/**
+ * \brief Simulated sensor whose volatile registers are updated by the firmware.
+ *
+ * The reads of the registers that are not cacheable (see mt9d111_reg_desc.h) return a different value than the last
+ * write, as the gains, shutter width and averages of a real sensor.
+ */
+class FirmwareTransport: public Transport
+{
+    private:
+        MT9D111Sim *sim;    /**< Simulated sensor. */
+
+        /**
+         * \brief Changes the value of a read register if it is volatile.
+         *
+         * \param[in] adr is the register address.
+         * \param[in] val is the read value.
+         *
+         * \return The value seen by the driver.
+         */
+        uint16_t Update(uint8_t adr, uint16_t val)
+        {
+            if (adr == MT9D111_REG_PAGE_REGISTER)
+            {
+                return val;
+            }
+
+            I2CResult<uint16_t> page = this->sim->Read16(MT9D111_REG_PAGE_REGISTER);
+
+            if (page.Ok() and (page.value < MT9D111_REG_PAGES) and !RegIsCacheable(page.value, adr))
+            {
+                return val ^ 0x0001;
+            }
+
+            return val;
+        }
+
+    public:
+        FirmwareTransport(MT9D111Sim *s)
+        {
+            this->sim = s;
+        }
+
+        I2CResult<uint16_t> Read16(uint8_t adr)
+        {
+            I2CResult<uint16_t> res = this->sim->Read16(adr);
+
+            if (res.Ok())
+            {
+                res.value = this->Update(adr, res.value);
+            }
+
+            return res;
+        }
+
+        bool Write16(uint8_t adr, uint16_t val)
+        {
+            return this->sim->Write16(adr, val);
+        }
+
+        bool Transfer(I2C_Msg *msgs, unsigned int len)
+        {
+            if (!this->sim->Transfer(msgs, len))
+            {
+                return false;
+            }
+
+            // Single register reads (address message followed by a 2 bytes read)
+            for(unsigned int i=1; i<len; i++)
+            {
+                if ((msgs[i].flags & I2C_M_RD) and (msgs[i].len == 2) and !(msgs[i - 1].flags & I2C_M_RD) and
+                    (msgs[i - 1].len == 1))
+                {
+                    uint16_t val = this->Update(msgs[i - 1].buf[0], (msgs[i].buf[0] << 8) | msgs[i].buf[1]);
+
+                    msgs[i].buf[0] = val >> 8;
+                    msgs[i].buf[1] = val & 0xFF;
+                }
+            }
+
+            return true;
+        }
+
+        uint8_t GetSlaveID()
+        {
+            return this->sim->GetSlaveID();
+        }
+
+        int GetLastError()
+        {
+            return this->sim->GetLastError();
+        }
+};
+
+/**
+ * \brief Config writes the default table: the last value of each register must be in the sensor.
+ *
+ * \return None.
+ */
+static void TestConfig()
+{
+    MT9D111Sim sim;
+    MT9D111 cam(&sim, sim.GetResetPin(), sim.GetStandbyPin());
+
+    TEST_CHECK(cam.Config());
+
+    size_t len = sizeof(reg_default_vals)/sizeof(Register);
+
+    for(size_t i=0; i<len; i++)
+    {
+        const Register &reg = reg_default_vals[i];
+
+        if ((reg.page >= MT9D111_REG_PAGES) or OpIsDropped(reg) or !OpIsDedupable(reg) or
+            !RegIsCacheable(reg.page, reg.address))
+        {
+            continue;
+        }
+
+        // Only the last write of each register is checked
+        bool last = true;
+        for(size_t j=i+1; j<len; j++)
+        {
+            if ((reg_default_vals[j].page == reg.page) and (reg_default_vals[j].address == reg.address))
+            {
+                last = false;
+                break;
+            }
+        }
+
+        if (last)
+        {
+            TEST_CHECK(sim.GetReg(reg.page, reg.address) == reg.value);
+        }
+    }
+}
+
+/**
+ * \brief A failed Config batch is written again register by register, without reading back the volatile registers.
+ *
+ * \return None.
+ */
+static void TestConfigFallback()
+{
+    MT9D111Sim sim;
+    FirmwareTransport bus(&sim);
+    MT9D111 cam(&bus, sim.GetResetPin(), sim.GetStandbyPin());
+
+    // With the page already selected, the injected error hits the batch transfer
+    TEST_CHECK(cam.WriteReg(MT9D111_REG_PAGE_REGISTER, MT9D111_REG_PAGE_0));
+
+    sim.FailNext(1, EREMOTEIO);
+
+    TEST_CHECK(cam.Config());
+    TEST_CHECK(sim.GetReg(MT9D111_REG_PAGE_0, MT9D111_REG_ROW_START) == reg_default_vals[0].value);
+}
+
+/**
+ * \brief SetMode waits for the sequencer and leaves the requested context selected.
+ *
+ * \return None.
+ */
+static void TestSetMode()
+{
+    MT9D111Sim sim;
+    MT9D111 cam(&sim, sim.GetResetPin(), sim.GetStandbyPin());
+
+    uint8_t mode = 0xFF;
+
+    TEST_CHECK(cam.SetMode(MT9D111_MODE_CAPTURE));
+    TEST_CHECK(cam.GetMode(&mode) and (mode == MT9D111_MODE_CAPTURE));
+    TEST_CHECK(sim.GetVar(MT9D111_DRIVER_ID_SEQUENCER, MT9D111_DRIVER_VAR_SEQUENCER_STATE) == MT9D111_STATE_CAPTURE);
+
+    TEST_CHECK(cam.SetMode(MT9D111_MODE_PREVIEW));
+    TEST_CHECK(cam.GetMode(&mode) and (mode == MT9D111_MODE_PREVIEW));
+    TEST_CHECK(sim.GetVar(MT9D111_DRIVER_ID_SEQUENCER, MT9D111_DRIVER_VAR_SEQUENCER_STATE) == MT9D111_STATE_PREVIEW);
+
+    // The standby mode must return to the previous mode
+    TEST_CHECK(cam.SetMode(MT9D111_MODE_CAPTURE));
+    TEST_CHECK(cam.EnterStandby());
+    TEST_CHECK(cam.LeaveStandby());
+    TEST_CHECK(cam.GetMode(&mode) and (mode == MT9D111_MODE_CAPTURE));
+
+    TEST_CHECK(!cam.SetMode(0xFF));
+}
+
+/**
+ * \brief Driver variables blocks: round trip, odd lengths and the bounds of the variables window.
+ *
+ * \return None.
+ */
+static void TestDriverVars()
+{
+    MT9D111Sim sim;
+    MT9D111 cam(&sim, sim.GetResetPin(), sim.GetStandbyPin());
+
+    uint8_t data[MT9D111_DRIVER_VARS_SIZE];
+    uint8_t read[MT9D111_DRIVER_VARS_SIZE];
+
+    for(unsigned int i=0; i<MT9D111_DRIVER_VARS_SIZE; i++)
+    {
+        data[i] = i*7 + 1;
+    }
+
+    // Odd length (last byte through R0xC8:1)
+    TEST_CHECK(cam.WriteDriverVars(MT9D111_DRIVER_ID_MONITOR, 20, data, 201));
+
+    bool equal = true;
+    for(unsigned int i=0; i<201; i++)
+    {
+        equal = equal and (sim.GetVar(MT9D111_DRIVER_ID_MONITOR, 20 + i) == data[i]);
+    }
+
+    TEST_CHECK(equal);
+
+    memset(read, 0, sizeof(read));
+
+    TEST_CHECK(cam.ReadDriverVars(MT9D111_DRIVER_ID_MONITOR, 20, read, 201));
+    TEST_CHECK(memcmp(read, data, 201) == 0);
+
+    // The end of the window
+    TEST_CHECK(cam.WriteDriverVars(MT9D111_DRIVER_ID_MONITOR, 250, data, 6));
+    TEST_CHECK(!cam.WriteDriverVars(MT9D111_DRIVER_ID_MONITOR, 250, data, 7));
+    TEST_CHECK(!cam.ReadDriverVars(MT9D111_DRIVER_ID_MONITOR, 250, read, 7));
+
+    TEST_CHECK(cam.WriteDriverVars(MT9D111_DRIVER_ID_MONITOR, 0, data, 0));
+}
+
+/**
+ * \brief Writing a driver structure must not write back the command and status variables.
+ *
+ * \return None.
+ */
+static void TestWriteDriver()
+{
+    MT9D111Sim sim;
+    MT9D111 cam(&sim, sim.GetResetPin(), sim.GetStandbyPin());
+
+    Sequencer seq;
+
+    TEST_CHECK(cam.ReadDriver(seq));
+
+    seq.cmd         = MT9D111_DRIVER_VAR_SEQUENCER_CMD_DO_CAPTURE;
+    seq.state       = MT9D111_STATE_STANDBY;
+    seq.stepMode    = 1;
+
+    uint8_t cmd = sim.GetVar(MT9D111_DRIVER_ID_SEQUENCER, MT9D111_DRIVER_VAR_SEQUENCER_CMD);
+    uint8_t state = sim.GetVar(MT9D111_DRIVER_ID_SEQUENCER, MT9D111_DRIVER_VAR_SEQUENCER_STATE);
+
+    TEST_CHECK(cam.WriteDriver(seq));
+
+    TEST_CHECK(sim.GetVar(MT9D111_DRIVER_ID_SEQUENCER, MT9D111_DRIVER_VAR_SEQUENCER_CMD) == cmd);
+    TEST_CHECK(sim.GetVar(MT9D111_DRIVER_ID_SEQUENCER, MT9D111_DRIVER_VAR_SEQUENCER_STATE) == state);
+    TEST_CHECK(sim.GetVar(MT9D111_DRIVER_ID_SEQUENCER, offsetof(Sequencer, stepMode)) == 1);
+}
+
+int main()
+{
+    static const struct
+    {
+        const char *name;
+        void (*func)();
+    } tests[] =
+    {
+        {"config",          TestConfig},
+        {"config_fallback", TestConfigFallback},
+        {"set_mode",        TestSetMode},
+        {"driver_vars",     TestDriverVars},
+        {"write_driver",    TestWriteDriver},
+    };
+
+    for(size_t i=0; i<sizeof(tests)/sizeof(tests[0]); i++)
+    {
+        unsigned int prev = failures;
+
+        tests[i].func();
+
+        Logger::Instance().Drain();
+
+        printf("%-20s %s\n", tests[i].name, (failures == prev)? "PASS" : "FAIL");
+    }
+
+    printf("%u checks, %u failures\n", checks, failures);
+
+    return (failures == 0)? 0 : 1;
+}
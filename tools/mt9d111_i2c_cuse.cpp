@@ -0,0 +1,1122 @@
+/*
+ * mt9d111_i2c_cuse.cpp
+ * 
+ * Copyright (C) 2018, Gabriel Mariano Marcelino <gabriel.mm8@gmail.com>
+ * 
+ * This file is part of MT9D111-Driver.
+ * 
+ * MT9D111-Driver is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ * 
+ * MT9D111-Driver is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ * 
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with MT9D111-Driver. If not, see <http://www.gnu.org/licenses/>.
+ * 
+ */
+
+/**
+ * \brief Fake I2C adapter (/dev/<name>) backed by the MT9D111 simulator, implemented as a CUSE device.
+ * 
+ * The device answers the I2C_SLAVE, I2C_SMBUS and I2C_RDWR ioctls as a Linux I2C adapter with a single MT9D111
+ * connected to it, so the real ioctl path of the I2C class is used without hardware. The SMBus transactions are
+ * converted into I2C messages as the kernel does for adapters without native SMBus support. The kernel i2c-stub
+ * module is not used, because it only emulates a plain SMBus memory (no I2C_RDWR, pages or driver variables).
+ * 
+ * Usage (root and the cuse module are required):
+ *      - mt9d111_i2c_cuse serve [name]: creates /dev/<name> (default "i2c-mt9d111") and serves it until killed.
+ *      - mt9d111_i2c_cuse bench [name]: runs the same configuration sequence over the device (I2C_RDWR), over a
+ *        second device "<name>-smbus" (I2C_SLAVE and I2C_SMBUS) and over an in-process simulator, compares the final
+ *        state of the sensors byte by byte and measures the cost of each ioctl.
+ *      .
+ * 
+ * \author Gabriel Mariano Marcelino <gabriel.mm8@gmail.com>
+ * 
+ * \version 1.0-dev
+ * 
+ * \date 17/10/2026
+ * 
+ * \addtogroup sim
+ * \{
+ */
+
+#include <stdio.h>
+#include <string.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/stat.h>
+#include <sys/uio.h>
+#include <linux/fuse.h>
+#include <thread>
+
+#include "i2c.h"
+#include "transport.h"
+#include "mt9d111.h"
+#include "mt9d111_sim.h"
+#include "mt9d111_config.h"
+#include "logger.h"
+
+using namespace std;
+
+#define CUSE_DEV                    "/dev/cuse"
+#define CUSE_DEFAULT_NAME           "i2c-mt9d111"
+#define CUSE_MAX_IO                 65536                   /**< Max. read/write size of the device. */
+#define CUSE_BUFFER_SIZE            (CUSE_MAX_IO + 4096)    /**< Requests buffer (data + headers). */
+#define CUSE_MAX_FILES              16                      /**< Max. number of simultaneously opened files. */
+#define CUSE_WAIT_DEV_MS            2000                    /**< Max. time for the device node to appear. */
+
+#define I2C_SLAVE_FORCE             0x0706
+
+#define BENCH_ITERATIONS            2000
+
+/**
+ * \brief CUSE server of the fake I2C adapter.
+ */
+class I2CCuse
+{
+    private:
+        int fd;                             /**< /dev/cuse file descriptor. */
+        MT9D111Sim *sim;                    /**< Device connected to the adapter. */
+        bool used[CUSE_MAX_FILES];          /**< Opened files. */
+        uint8_t slave[CUSE_MAX_FILES];      /**< I2C_SLAVE address of each file (SMBus transactions). */
+        uint8_t buf[CUSE_BUFFER_SIZE];      /**< Request buffer. */
+
+        /**
+         * \brief Sends a reply.
+         *
+         * \param[in] unique is the ID of the request.
+         * \param[in] error is the errno value (0 if successful).
+         * \param[in] iov is the payload of the reply.
+         * \param[in] iov_len is the number of entries of iov.
+         *
+         * \return None.
+         */
+        void Reply(uint64_t unique, int error, const struct iovec *iov=NULL, unsigned int iov_len=0);
+
+        /**
+         * \brief Replies an ioctl.
+         *
+         * \param[in] unique is the ID of the request.
+         * \param[in] result is the return value of the ioctl.
+         * \param[in] out is the data to copy to the output buffers of the caller (can be NULL).
+         * \param[in] out_len is the number of bytes of "out".
+         *
+         * \return None.
+         */
+        void ReplyIOCtl(uint64_t unique, int result, const void *out=NULL, size_t out_len=0);
+
+        /**
+         * \brief Asks the kernel to repeat an ioctl with the given buffers of the caller (unrestricted ioctls).
+         *
+         * \param[in] unique is the ID of the request.
+         * \param[in] iov is the list of input buffers followed by the list of output buffers.
+         * \param[in] in_iovs is the number of input buffers.
+         * \param[in] out_iovs is the number of output buffers.
+         *
+         * \return None.
+         */
+        void Retry(uint64_t unique, const struct fuse_ioctl_iovec *iov, unsigned int in_iovs, unsigned int out_iovs);
+
+        /**
+         * \brief Handles an I2C_SMBUS ioctl.
+         *
+         * \param[in] unique is the ID of the request.
+         * \param[in] in is the ioctl request.
+         * \param[in] data is the content of the input buffers.
+         *
+         * \return None.
+         */
+        void SMBusIOCtl(uint64_t unique, const struct fuse_ioctl_in *in, const uint8_t *data);
+
+        /**
+         * \brief Handles an I2C_RDWR ioctl.
+         *
+         * \param[in] unique is the ID of the request.
+         * \param[in] in is the ioctl request.
+         * \param[in] data is the content of the input buffers.
+         *
+         * \return None.
+         */
+        void RDWRIOCtl(uint64_t unique, const struct fuse_ioctl_in *in, const uint8_t *data);
+
+        /**
+         * \brief Executes a SMBus transaction as I2C messages.
+         *
+         * \param[in] adr is the slave address.
+         * \param[in] args is the SMBus transaction.
+         * \param[in,out] data is the transaction data.
+         *
+         * \return 0 if successful or the errno value.
+         */
+        int SMBus(uint8_t adr, const I2C_SMBus_IOCtl_Data &args, I2C_SMBus_Data *data);
+
+    public:
+        /**
+         * \brief Constructor.
+         *
+         * \param[in] s is the device connected to the adapter.
+         *
+         * \return None.
+         */
+        I2CCuse(MT9D111Sim *s);
+
+        /**
+         * \brief Destructor (removes the device).
+         *
+         * \return None.
+         */
+        ~I2CCuse();
+
+        /**
+         * \brief Creates the device.
+         *
+         * \param[in] name is the device name (/dev/<name>).
+         *
+         * \return TRUE/FALSE if successful or not.
+         */
+        bool Start(const char *name);
+
+        /**
+         * \brief Serves the requests of the device (until the device is removed).
+         *
+         * \return None.
+         */
+        void Serve();
+};
+
+/**
+ * \brief Transport over the I2C_SLAVE and I2C_SMBUS ioctls only.
+ *
+ * The register accesses of the driver (I2C_Msg lists) are split into SMBus word transactions through the
+ * I2CTransport word accesses, so their byte order is checked against the SMBus emulation of the adapter. Only
+ * register writes (address and word) and register reads (address followed by a word read) are supported.
+ */
+class SMBusTransport: public I2CTransport
+{
+    private:
+        int last_error;     /**< errno of the last transaction (0 if successful). */
+
+    public:
+        /**
+         * \brief Constructor.
+         *
+         * \return None.
+         */
+        SMBusTransport();
+
+        /**
+         * \brief Opens the I2C device with a dedicated file descriptor (I2C_SLAVE).
+         *
+         * \param[in] dev_adr is the I2C adapter.
+         * \param[in] dev_id is the 7-bit slave address.
+         *
+         * \return TRUE/FALSE if successful or not.
+         */
+        bool Open(const char *dev_adr, uint8_t dev_id);
+
+        I2CResult<uint16_t> Read16(uint8_t adr);
+
+        bool Write16(uint8_t adr, uint16_t val);
+
+        bool Transfer(I2C_Msg *msgs, unsigned int len);
+
+        int GetLastError();
+};
+
+I2CCuse::I2CCuse(MT9D111Sim *s)
+{
+    this->fd = -1;
+    this->sim = s;
+
+    memset(this->used, 0, sizeof(this->used));
+    memset(this->slave, 0, sizeof(this->slave));
+}
+
+I2CCuse::~I2CCuse()
+{
+    if (this->fd >= 0)
+    {
+        close(this->fd);
+    }
+}
+
+bool I2CCuse::Start(const char *name)
+{
+    this->fd = open(CUSE_DEV, O_RDWR | O_CLOEXEC);
+
+    if (this->fd < 0)
+    {
+        return false;
+    }
+
+    // The first request is always CUSE_INIT
+    ssize_t len = read(this->fd, this->buf, sizeof(this->buf));
+
+    const struct fuse_in_header *hdr = (const struct fuse_in_header*)this->buf;
+
+    if ((len < (ssize_t)(sizeof(struct fuse_in_header) + sizeof(struct cuse_init_in))) or (hdr->opcode != CUSE_INIT))
+    {
+        return false;
+    }
+
+    const struct cuse_init_in *init = (const struct cuse_init_in*)(this->buf + sizeof(struct fuse_in_header));
+
+    struct cuse_init_out out;
+    memset(&out, 0, sizeof(out));
+
+    out.major       = FUSE_KERNEL_VERSION;
+    out.minor       = (init->minor < FUSE_KERNEL_MINOR_VERSION)? init->minor : FUSE_KERNEL_MINOR_VERSION;
+    out.flags       = CUSE_UNRESTRICTED_IOCTL;
+    out.max_read    = CUSE_MAX_IO;
+    out.max_write   = CUSE_MAX_IO;
+
+    char info[64];
+    int info_len = snprintf(info, sizeof(info), "DEVNAME=%s", name) + 1;
+
+    struct iovec iov[2];
+    iov[0].iov_base = &out;
+    iov[0].iov_len  = sizeof(out);
+    iov[1].iov_base = info;
+    iov[1].iov_len  = info_len;
+
+    this->Reply(hdr->unique, 0, iov, 2);
+
+    return true;
+}
+
+void I2CCuse::Serve()
+{
+    while(true)
+    {
+        ssize_t len = read(this->fd, this->buf, sizeof(this->buf));
+
+        if (len < 0)
+        {
+            // Interrupted request or signal
+            if ((errno == ENOENT) or (errno == EINTR) or (errno == EAGAIN))
+            {
+                continue;
+            }
+
+            return;
+        }
+
+        if (len < (ssize_t)sizeof(struct fuse_in_header))
+        {
+            continue;
+        }
+
+        const struct fuse_in_header *hdr = (const struct fuse_in_header*)this->buf;
+        const uint8_t *arg = this->buf + sizeof(struct fuse_in_header);
+
+        switch(hdr->opcode)
+        {
+            case FUSE_OPEN:
+            {
+                struct fuse_open_out out;
+                memset(&out, 0, sizeof(out));
+
+                out.fh = CUSE_MAX_FILES;
+
+                for(unsigned int i=0; i<CUSE_MAX_FILES; i++)
+                {
+                    if (!this->used[i])
+                    {
+                        this->used[i] = true;
+                        this->slave[i] = 0;
+
+                        out.fh = i;
+
+                        break;
+                    }
+                }
+
+                if (out.fh == CUSE_MAX_FILES)
+                {
+                    this->Reply(hdr->unique, EMFILE);
+
+                    break;
+                }
+
+                struct iovec iov;
+                iov.iov_base    = &out;
+                iov.iov_len     = sizeof(out);
+
+                this->Reply(hdr->unique, 0, &iov, 1);
+
+                break;
+            }
+            case FUSE_RELEASE:
+            {
+                const struct fuse_release_in *in = (const struct fuse_release_in*)arg;
+
+                if (in->fh < CUSE_MAX_FILES)
+                {
+                    this->used[in->fh] = false;
+                }
+
+                this->Reply(hdr->unique, 0);
+
+                break;
+            }
+            case FUSE_FLUSH:
+                this->Reply(hdr->unique, 0);
+
+                break;
+            case FUSE_IOCTL:
+            {
+                const struct fuse_ioctl_in *in = (const struct fuse_ioctl_in*)arg;
+                const uint8_t *data = arg + sizeof(struct fuse_ioctl_in);
+
+                if ((in->fh >= CUSE_MAX_FILES) or !this->used[in->fh])
+                {
+                    this->Reply(hdr->unique, EBADF);
+
+                    break;
+                }
+
+                switch(in->cmd)
+                {
+                    case I2C_SLAVE:
+                    case I2C_SLAVE_FORCE:
+                        if (in->arg > 0x7F)
+                        {
+                            this->Reply(hdr->unique, EINVAL);
+                        }
+                        else
+                        {
+                            this->slave[in->fh] = in->arg;
+
+                            this->ReplyIOCtl(hdr->unique, 0);
+                        }
+
+                        break;
+                    case I2C_SMBUS:
+                        this->SMBusIOCtl(hdr->unique, in, data);
+
+                        break;
+                    case I2C_RDWR:
+                        this->RDWRIOCtl(hdr->unique, in, data);
+
+                        break;
+                    default:
+                        this->Reply(hdr->unique, ENOTTY);
+
+                        break;
+                }
+
+                break;
+            }
+            case FUSE_INTERRUPT:
+                // No reply, the transactions are never interrupted
+                break;
+            case FUSE_DESTROY:
+                return;
+            default:
+                this->Reply(hdr->unique, ENOSYS);
+
+                break;
+        }
+    }
+}
+
+void I2CCuse::Reply(uint64_t unique, int error, const struct iovec *iov, unsigned int iov_len)
+{
+    struct fuse_out_header out;
+    struct iovec vec[4];
+
+    out.len     = sizeof(out);
+    out.error   = -error;
+    out.unique  = unique;
+
+    vec[0].iov_base = &out;
+    vec[0].iov_len  = sizeof(out);
+
+    for(unsigned int i=0; (i<iov_len) and (i<3); i++)
+    {
+        vec[1 + i] = iov[i];
+        out.len += iov[i].iov_len;
+    }
+
+    if (writev(this->fd, vec, 1 + ((iov_len < 3)? iov_len : 3)) < 0)
+    {
+        LOG_ERROR("CUSE", "Error replying request %u! (errno=%u)", (unsigned int)unique, errno);
+    }
+}
+
+void I2CCuse::ReplyIOCtl(uint64_t unique, int result, const void *out, size_t out_len)
+{
+    struct fuse_ioctl_out res;
+    memset(&res, 0, sizeof(res));
+
+    res.result = result;
+
+    struct iovec iov[2];
+    iov[0].iov_base = &res;
+    iov[0].iov_len  = sizeof(res);
+    iov[1].iov_base = (void*)out;
+    iov[1].iov_len  = out_len;
+
+    this->Reply(unique, 0, iov, (out_len > 0)? 2 : 1);
+}
+
+void I2CCuse::Retry(uint64_t unique, const struct fuse_ioctl_iovec *iov, unsigned int in_iovs, unsigned int out_iovs)
+{
+    struct fuse_ioctl_out res;
+    memset(&res, 0, sizeof(res));
+
+    res.flags       = FUSE_IOCTL_RETRY;
+    res.in_iovs     = in_iovs;
+    res.out_iovs    = out_iovs;
+
+    struct iovec vec[2];
+    vec[0].iov_base = &res;
+    vec[0].iov_len  = sizeof(res);
+    vec[1].iov_base = (void*)iov;
+    vec[1].iov_len  = (in_iovs + out_iovs)*sizeof(struct fuse_ioctl_iovec);
+
+    this->Reply(unique, 0, vec, 2);
+}
+
+void I2CCuse::SMBusIOCtl(uint64_t unique, const struct fuse_ioctl_in *in, const uint8_t *data)
+{
+    struct fuse_ioctl_iovec iov[3];
+
+    // 1st pass: the arguments structure
+    iov[0].base = in->arg;
+    iov[0].len  = sizeof(I2C_SMBus_IOCtl_Data);
+
+    if (in->in_size < sizeof(I2C_SMBus_IOCtl_Data))
+    {
+        this->Retry(unique, iov, 1, 0);
+
+        return;
+    }
+
+    I2C_SMBus_IOCtl_Data args;
+    memcpy(&args, data, sizeof(args));
+
+    bool read = (args.read_write == I2C_SMBUS_READ) or (args.size == I2C_SMBUS_PROC_CALL);
+
+    if ((args.data == NULL) and !((args.size == I2C_SMBUS_QUICK) or
+                                  ((args.size == I2C_SMBUS_BYTE) and (args.read_write == I2C_SMBUS_WRITE))))
+    {
+        this->Reply(unique, EINVAL);
+
+        return;
+    }
+
+    // 2nd pass: the data union (input and output)
+    unsigned int in_iovs = 1;
+    unsigned int out_iovs = 0;
+    size_t in_len = sizeof(I2C_SMBus_IOCtl_Data);
+    size_t out_len = 0;
+
+    if (args.data != NULL)
+    {
+        iov[1].base = (uint64_t)args.data;
+        iov[1].len  = sizeof(I2C_SMBus_Data);
+        in_len += sizeof(I2C_SMBus_Data);
+        in_iovs++;
+
+        if (read)
+        {
+            iov[2] = iov[1];
+            out_len += sizeof(I2C_SMBus_Data);
+            out_iovs++;
+        }
+    }
+
+    if ((in->in_size < in_len) or (in->out_size < out_len))
+    {
+        this->Retry(unique, iov, in_iovs, out_iovs);
+
+        return;
+    }
+
+    I2C_SMBus_Data smbus_data;
+    memset(&smbus_data, 0, sizeof(smbus_data));
+
+    if (args.data != NULL)
+    {
+        memcpy(&smbus_data, data + sizeof(I2C_SMBus_IOCtl_Data), sizeof(smbus_data));
+    }
+
+    int err = this->SMBus(this->slave[in->fh], args, &smbus_data);
+
+    if (err != 0)
+    {
+        this->Reply(unique, err);
+    }
+    else
+    {
+        this->ReplyIOCtl(unique, 0, &smbus_data, out_len);
+    }
+}
+
+void I2CCuse::RDWRIOCtl(uint64_t unique, const struct fuse_ioctl_in *in, const uint8_t *data)
+{
+    struct fuse_ioctl_iovec iov[2 + 2*I2C_RDWR_IOCTL_MAX_MSGS];
+
+    // 1st pass: the arguments structure
+    iov[0].base = in->arg;
+    iov[0].len  = sizeof(I2C_RDWR_IOCtl_Data);
+
+    if (in->in_size < sizeof(I2C_RDWR_IOCtl_Data))
+    {
+        this->Retry(unique, iov, 1, 0);
+
+        return;
+    }
+
+    I2C_RDWR_IOCtl_Data args;
+    memcpy(&args, data, sizeof(args));
+
+    if ((args.nmsgs == 0) or (args.nmsgs > I2C_RDWR_IOCTL_MAX_MSGS))
+    {
+        this->Reply(unique, EINVAL);
+
+        return;
+    }
+
+    // 2nd pass: the messages
+    iov[1].base = (uint64_t)args.msgs;
+    iov[1].len  = args.nmsgs*sizeof(I2C_Msg);
+
+    size_t in_len = iov[0].len + iov[1].len;
+
+    if (in->in_size < in_len)
+    {
+        this->Retry(unique, iov, 2, 0);
+
+        return;
+    }
+
+    I2C_Msg msgs[I2C_RDWR_IOCTL_MAX_MSGS];
+    memcpy(msgs, data + sizeof(I2C_RDWR_IOCtl_Data), args.nmsgs*sizeof(I2C_Msg));
+
+    // 3rd pass: the buffers of the messages (written ones as input, read ones as output)
+    unsigned int in_iovs = 2;
+    unsigned int out_iovs = 0;
+    size_t out_len = 0;
+
+    for(unsigned int i=0; i<args.nmsgs; i++)
+    {
+        if (!(msgs[i].flags & I2C_M_RD) and (msgs[i].len > 0))
+        {
+            iov[in_iovs].base   = (uint64_t)msgs[i].buf;
+            iov[in_iovs].len    = msgs[i].len;
+            in_len += msgs[i].len;
+            in_iovs++;
+        }
+    }
+
+    for(unsigned int i=0; i<args.nmsgs; i++)
+    {
+        if ((msgs[i].flags & I2C_M_RD) and (msgs[i].len > 0))
+        {
+            iov[in_iovs + out_iovs].base    = (uint64_t)msgs[i].buf;
+            iov[in_iovs + out_iovs].len     = msgs[i].len;
+            out_len += msgs[i].len;
+            out_iovs++;
+        }
+    }
+
+    if ((in->in_size < in_len) or (in->out_size < out_len))
+    {
+        this->Retry(unique, iov, in_iovs, out_iovs);
+
+        return;
+    }
+
+    // The buffers are replaced by the copies of the request and by a contiguous output buffer
+    uint8_t *out = new uint8_t[out_len + 1];
+
+    const uint8_t *wr = data + sizeof(I2C_RDWR_IOCtl_Data) + args.nmsgs*sizeof(I2C_Msg);
+    uint8_t *rd = out;
+
+    for(unsigned int i=0; i<args.nmsgs; i++)
+    {
+        if (msgs[i].flags & I2C_M_RD)
+        {
+            msgs[i].buf = rd;
+            rd += msgs[i].len;
+        }
+        else
+        {
+            msgs[i].buf = (uint8_t*)wr;
+            wr += msgs[i].len;
+        }
+    }
+
+    if (this->sim->Transfer(msgs, args.nmsgs))
+    {
+        // I2C_RDWR returns the number of executed messages
+        this->ReplyIOCtl(unique, args.nmsgs, out, out_len);
+    }
+    else
+    {
+        this->Reply(unique, this->sim->GetLastError());
+    }
+
+    delete[] out;
+}
+
+int I2CCuse::SMBus(uint8_t adr, const I2C_SMBus_IOCtl_Data &args, I2C_SMBus_Data *data)
+{
+    uint8_t wr[2 + I2C_SMBUS_BLOCK_MAX];
+    uint8_t rd[I2C_SMBUS_BLOCK_MAX];
+    I2C_Msg msgs[2];
+    unsigned int n = 2;
+    bool read = args.read_write == I2C_SMBUS_READ;
+
+    wr[0] = args.command;
+
+    msgs[0].addr    = adr;
+    msgs[0].flags   = 0;
+    msgs[0].len     = 1;
+    msgs[0].buf     = wr;
+
+    msgs[1].addr    = adr;
+    msgs[1].flags   = I2C_M_RD;
+    msgs[1].len     = 0;
+    msgs[1].buf     = rd;
+
+    // Same messages as the kernel emulation of SMBus over I2C
+    switch(args.size)
+    {
+        case I2C_SMBUS_QUICK:
+            msgs[0].flags   = read? I2C_M_RD : 0;
+            msgs[0].len     = 0;
+            n = 1;
+
+            break;
+        case I2C_SMBUS_BYTE:
+            if (read)
+            {
+                msgs[0] = msgs[1];
+                msgs[0].len = 1;
+            }
+
+            n = 1;
+
+            break;
+        case I2C_SMBUS_BYTE_DATA:
+            if (read)
+            {
+                msgs[1].len = 1;
+            }
+            else
+            {
+                wr[1] = data->byte;
+                msgs[0].len = 2;
+                n = 1;
+            }
+
+            break;
+        case I2C_SMBUS_WORD_DATA:
+            // SMBus words are LSB first
+            if (read)
+            {
+                msgs[1].len = 2;
+            }
+            else
+            {
+                wr[1] = data->word & 0xFF;
+                wr[2] = data->word >> 8;
+                msgs[0].len = 3;
+                n = 1;
+            }
+
+            break;
+        case I2C_SMBUS_PROC_CALL:
+            wr[1] = data->word & 0xFF;
+            wr[2] = data->word >> 8;
+            msgs[0].len = 3;
+            msgs[1].len = 2;
+
+            break;
+        case I2C_SMBUS_I2C_BLOCK_BROKEN:
+        case I2C_SMBUS_I2C_BLOCK_DATA:
+            if ((data->block[0] == 0) or (data->block[0] > I2C_SMBUS_I2C_BLOCK_MAX))
+            {
+                return EINVAL;
+            }
+
+            if (read)
+            {
+                msgs[1].len = data->block[0];
+            }
+            else
+            {
+                memcpy(&wr[1], &data->block[1], data->block[0]);
+                msgs[0].len = 1 + data->block[0];
+                n = 1;
+            }
+
+            break;
+        default:
+            // The SMBus block transfers need a length byte from the device
+            return EOPNOTSUPP;
+    }
+
+    if (!this->sim->Transfer(msgs, n))
+    {
+        return this->sim->GetLastError();
+    }
+
+    if (read)
+    {
+        switch(args.size)
+        {
+            case I2C_SMBUS_BYTE:
+            case I2C_SMBUS_BYTE_DATA:
+                data->byte = rd[0];
+
+                break;
+            case I2C_SMBUS_WORD_DATA:
+            case I2C_SMBUS_PROC_CALL:
+                data->word = rd[0] | (rd[1] << 8);
+
+                break;
+            case I2C_SMBUS_I2C_BLOCK_BROKEN:
+            case I2C_SMBUS_I2C_BLOCK_DATA:
+                memcpy(&data->block[1], rd, data->block[0]);
+
+                break;
+        }
+    }
+
+    return 0;
+}
+
+SMBusTransport::SMBusTransport()
+{
+    this->last_error = 0;
+}
+
+bool SMBusTransport::Open(const char *dev_adr, uint8_t dev_id)
+{
+    return I2CTransport::Open(dev_adr, dev_id, false);
+}
+
+I2CResult<uint16_t> SMBusTransport::Read16(uint8_t adr)
+{
+    I2CResult<uint16_t> res = I2CTransport::Read16(adr);
+
+    this->last_error = res.error;
+
+    return res;
+}
+
+bool SMBusTransport::Write16(uint8_t adr, uint16_t val)
+{
+    bool res = I2CTransport::Write16(adr, val);
+
+    this->last_error = res? 0 : I2CTransport::GetLastError();
+
+    return res;
+}
+
+bool SMBusTransport::Transfer(I2C_Msg *msgs, unsigned int len)
+{
+    this->last_error = 0;
+
+    for(unsigned int i=0; i<len; i++)
+    {
+        bool read = (msgs[i].flags & I2C_M_RD) != 0;
+
+        if (!read and (msgs[i].len == 3))
+        {
+            // Register write (address and word, MSB first)
+            if (!this->Write16(msgs[i].buf[0], (msgs[i].buf[1] << 8) | msgs[i].buf[2]))
+            {
+                return false;
+            }
+        }
+        else if (!read and (msgs[i].len == 1) and (i + 1 < len) and (msgs[i + 1].flags & I2C_M_RD) and
+                 (msgs[i + 1].len == 2))
+        {
+            // Register read (address followed by a word, MSB first)
+            I2CResult<uint16_t> res = this->Read16(msgs[i].buf[0]);
+            if (!res.Ok())
+            {
+                return false;
+            }
+
+            msgs[i + 1].buf[0] = res.value >> 8;
+            msgs[i + 1].buf[1] = res.value & 0xFF;
+
+            i++;
+        }
+        else
+        {
+            this->last_error = EOPNOTSUPP;
+
+            return false;
+        }
+    }
+
+    return true;
+}
+
+int SMBusTransport::GetLastError()
+{
+    return this->last_error;
+}
+
+/**
+ * \brief Waits for the device node to be created.
+ *
+ * \param[in] path is the path of the device.
+ *
+ * \return TRUE/FALSE if the device exists or not.
+ */
+static bool WaitDevice(const char *path)
+{
+    struct stat st;
+
+    for(unsigned int i=0; i<CUSE_WAIT_DEV_MS; i++)
+    {
+        if (stat(path, &st) == 0)
+        {
+            return true;
+        }
+
+        usleep(1000);
+    }
+
+    return false;
+}
+
+/**
+ * \brief Creates a device and serves it in a background thread (until the process exits).
+ *
+ * \param[in] sim is the device connected to the adapter.
+ * \param[in] name is the device name (/dev/<name>).
+ * \param[out] path is the path of the created device.
+ * \param[in] path_len is the size of "path".
+ *
+ * \return TRUE/FALSE if the device was created or not.
+ */
+static bool StartDevice(MT9D111Sim *sim, const char *name, char *path, size_t path_len)
+{
+    I2CCuse *cuse = new I2CCuse(sim);
+
+    if (!cuse->Start(name))
+    {
+        fprintf(stderr, "Error creating the CUSE device! (errno=%d, is the cuse module loaded?)\n", errno);
+
+        delete cuse;
+
+        return false;
+    }
+
+    thread server(&I2CCuse::Serve, cuse);
+    server.detach();
+
+    snprintf(path, path_len, "/dev/%s", name);
+
+    if (!WaitDevice(path))
+    {
+        fprintf(stderr, "Device \"%s\" not created!\n", path);
+
+        return false;
+    }
+
+    return true;
+}
+
+/**
+ * \brief Configuration sequence used to compare the two paths.
+ *
+ * \param[in] cam is the sensor.
+ *
+ * \return TRUE/FALSE if successful or not.
+ */
+static bool RunSequence(MT9D111 &cam)
+{
+    return cam.CheckDevice() and cam.Config() and cam.SetMode(MT9D111_MODE_CAPTURE) and
+           cam.SetMode(MT9D111_MODE_PREVIEW) and
+           cam.ApplyProfile(reg_vals_qvga_30fps, sizeof(reg_vals_qvga_30fps)/sizeof(Register));
+}
+
+/**
+ * \brief Compares the registers and the driver variables of two simulated sensors.
+ *
+ * \param[in] a is the first sensor.
+ * \param[in] b is the second sensor.
+ *
+ * \return The number of different registers and variables.
+ */
+static unsigned int Compare(MT9D111Sim &a, MT9D111Sim &b)
+{
+    unsigned int diff = 0;
+
+    for(unsigned int pg=0; pg<MT9D111_REG_PAGES; pg++)
+    {
+        for(unsigned int adr=0; adr<MT9D111_REG_PAGE_SIZE; adr++)
+        {
+            if (a.GetReg(pg, adr) != b.GetReg(pg, adr))
+            {
+                printf("    R0x%02X:%u: 0x%04X != 0x%04X\n", adr, pg, a.GetReg(pg, adr), b.GetReg(pg, adr));
+
+                diff++;
+            }
+        }
+    }
+
+    for(unsigned int drv=0; drv<MT9D111_SIM_DRIVERS; drv++)
+    {
+        for(unsigned int ofs=0; ofs<MT9D111_SIM_DRIVER_SIZE; ofs++)
+        {
+            if (a.GetVar(drv << 8, ofs) != b.GetVar(drv << 8, ofs))
+            {
+                printf("    Var %u:%u: 0x%02X != 0x%02X\n", drv, ofs, a.GetVar(drv << 8, ofs), b.GetVar(drv << 8, ofs));
+
+                diff++;
+            }
+        }
+    }
+
+    return diff;
+}
+
+/**
+ * \brief Runs the end-to-end comparison and the ioctl measurements.
+ *
+ * \param[in] name is the device name.
+ *
+ * \return 0 if all the paths produced the same result or 1 otherwise.
+ */
+static int Bench(const char *name)
+{
+    MT9D111Sim sim_dev;
+    MT9D111Sim sim_smbus;
+    MT9D111Sim sim_ref;
+
+    // One adapter for each ioctl path, so both start from the reset state
+    char smbus_name[64];
+    snprintf(smbus_name, sizeof(smbus_name), "%s-smbus", name);
+
+    char path[80];
+    char smbus_path[80];
+
+    if (!StartDevice(&sim_dev, name, path, sizeof(path)) or
+        !StartDevice(&sim_smbus, smbus_name, smbus_path, sizeof(smbus_path)))
+    {
+        return 1;
+    }
+
+    I2CTransport bus;
+    SMBusTransport smbus;
+
+    if (!bus.Open(path, MT9D111_CONFIG_I2C_ID) or !smbus.Open(smbus_path, MT9D111_CONFIG_I2C_ID))
+    {
+        fprintf(stderr, "Error opening \"%s\" or \"%s\"!\n", path, smbus_path);
+
+        return 1;
+    }
+
+    // Same sequence through the ioctls (I2C_RDWR and I2C_SMBUS) and in-process
+    MT9D111 cam_dev(&bus, sim_dev.GetResetPin(), sim_dev.GetStandbyPin());
+    MT9D111 cam_smbus(&smbus, sim_smbus.GetResetPin(), sim_smbus.GetStandbyPin());
+    MT9D111 cam_ref(&sim_ref, sim_ref.GetResetPin(), sim_ref.GetStandbyPin());
+
+    bool res_dev = RunSequence(cam_dev);
+    bool res_smbus = RunSequence(cam_smbus);
+    bool res_ref = RunSequence(cam_ref);
+
+    Logger::Instance().Drain();
+
+    printf("Sequence: I2C_RDWR %s, I2C_SMBUS %s, in-process %s\n", res_dev? "OK" : "FAILED",
+           res_smbus? "OK" : "FAILED", res_ref? "OK" : "FAILED");
+    printf("I2C_RDWR:   %lu transactions, %lu bytes\n", sim_dev.GetTransactions(), sim_dev.GetBytes());
+    printf("I2C_SMBUS:  %lu transactions, %lu bytes\n", sim_smbus.GetTransactions(), sim_smbus.GetBytes());
+    printf("In-process: %lu transactions, %lu bytes\n", sim_ref.GetTransactions(), sim_ref.GetBytes());
+
+    unsigned int diff = Compare(sim_dev, sim_ref);
+
+    printf("I2C_RDWR state: %u differences\n", diff);
+
+    unsigned int diff_smbus = Compare(sim_smbus, sim_ref);
+
+    printf("I2C_SMBUS state: %u differences\n", diff_smbus);
+
+    bool same = res_dev and res_ref and (diff == 0) and (sim_dev.GetTransactions() == sim_ref.GetTransactions()) and
+                (sim_dev.GetBytes() == sim_ref.GetBytes());
+
+    // The SMBus path splits the batches in one transaction per register, so only the bytes must match
+    same = same and res_smbus and (diff_smbus == 0) and (sim_smbus.GetBytes() == sim_ref.GetBytes());
+
+    // Cost of a register read by each path (the page register is available in all pages)
+    uint64_t start = I2CStats::Now();
+    for(unsigned int i=0; i<BENCH_ITERATIONS; i++)
+    {
+        smbus.Read16(MT9D111_REG_PAGE_REGISTER);
+    }
+    uint64_t smbus_ns = (I2CStats::Now() - start)/BENCH_ITERATIONS;
+
+    start = I2CStats::Now();
+    for(unsigned int i=0; i<BENCH_ITERATIONS; i++)
+    {
+        bus.Read16(MT9D111_REG_PAGE_REGISTER);
+    }
+    uint64_t rdwr_ns = (I2CStats::Now() - start)/BENCH_ITERATIONS;
+
+    start = I2CStats::Now();
+    for(unsigned int i=0; i<BENCH_ITERATIONS; i++)
+    {
+        sim_ref.Read16(MT9D111_REG_PAGE_REGISTER);
+    }
+    uint64_t sim_ns = (I2CStats::Now() - start)/BENCH_ITERATIONS;
+
+    printf("Register read: I2C_SMBUS %lu ns, I2C_RDWR %lu ns, in-process %lu ns\n", (unsigned long)smbus_ns,
+           (unsigned long)rdwr_ns, (unsigned long)sim_ns);
+
+    printf("%s\n", same? "PASS" : "FAIL");
+
+    return same? 0 : 1;
+}
+
+int main(int argc, char **argv)
+{
+    const char *name = (argc > 2)? argv[2] : CUSE_DEFAULT_NAME;
+
+    if ((argc >= 2) and (strcmp(argv[1], "serve") == 0))
+    {
+        MT9D111Sim sim;
+        I2CCuse cuse(&sim);
+
+        if (!cuse.Start(name))
+        {
+            fprintf(stderr, "Error creating the CUSE device! (errno=%d, is the cuse module loaded?)\n", errno);
+
+            return 1;
+        }
+
+        printf("Serving /dev/%s (MT9D111 at 0x%02X)...\n", name, sim.GetSlaveID());
+
+        cuse.Serve();
+
+        return 0;
+    }
+
+    if ((argc >= 2) and (strcmp(argv[1], "bench") == 0))
+    {
+        return Bench(name);
+    }
+
+    fprintf(stderr, "Usage: %s serve [name]\n", argv[0]);
+    fprintf(stderr, "       %s bench [name]\n", argv[0]);
+
+    return 1;
+}
+
+//! \} End of sim group
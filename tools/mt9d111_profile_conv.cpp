@@ -0,0 +1,173 @@
+/*
+ * mt9d111_profile_conv.cpp
+ * 
+ * Copyright (C) 2018, Gabriel Mariano Marcelino <gabriel.mm8@gmail.com>
+ * 
+ * This file is part of MT9D111-Driver.
+ * 
+ * MT9D111-Driver is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ * 
+ * MT9D111-Driver is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ * 
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with MT9D111-Driver. If not, see <http://www.gnu.org/licenses/>.
+ * 
+ */
+
+/**
+ * \brief Converter of the compiled registers tables (mt9d111_config.h) into binary profiles.
+ * 
+ * Usage:
+ *      - mt9d111_profile_conv <table> <file>: writes a table ("default" or "qvga_30fps") as a profile.
+ *      - mt9d111_profile_conv -d <file>: validates a profile and prints its records.
+ *      .
+ * 
+ * \author Gabriel Mariano Marcelino <gabriel.mm8@gmail.com>
+ * 
+ * \version 1.0-dev
+ * 
+ * \date 17/10/2026
+ * 
+ * \addtogroup profile
+ * \{
+ */
+
+#include <stdio.h>
+#include <string.h>
+
+#include "mt9d111_profile.h"
+#include "mt9d111_config.h"
+#include "logger.h"
+
+using namespace std;
+
+/**
+ * \brief Available registers tables.
+ */
+struct ProfileTable
+{
+    const char      *name;  /**< Name of the table (and of the profile). */
+    const Register  *regs;  /**< Registers table. */
+    size_t          len;    /**< Number of entries of the table. */
+};
+
+static const ProfileTable tables[] =
+{
+    {"default",     reg_default_vals,       sizeof(reg_default_vals)/sizeof(Register)},
+    {"qvga_30fps",  reg_vals_qvga_30fps,    sizeof(reg_vals_qvga_30fps)/sizeof(Register)},
+};
+
+/**
+ * \brief Prints the records of a profile.
+ *
+ * \param[in] file is the path of the profile.
+ *
+ * \return 0 if the profile is valid or 1 otherwise.
+ */
+static int Dump(const char *file)
+{
+    MT9D111Profile profile;
+
+    if (!profile.Open(file))
+    {
+        Logger::Instance().Drain();
+
+        fprintf(stderr, "Invalid profile \"%s\"!\n", file);
+
+        return 1;
+    }
+
+    const ProfileHeader *hdr = profile.GetHeader();
+
+    printf("Profile \"%.*s\": version %u, %u records, %u bytes, CRC 0x%08X\n", MT9D111_PROFILE_NAME_MAX_LEN, hdr->name,
+           hdr->version, hdr->records, hdr->size, hdr->crc);
+
+    for(const ProfileRecord *rec=profile.GetRecord(NULL); rec != NULL; rec=profile.GetRecord(rec))
+    {
+        switch(rec->type)
+        {
+            case MT9D111_PROFILE_REC_RUN:
+                printf("    RUN   page %u, %u registers\n", rec->page, rec->len);
+
+                for(unsigned int i=0; i<rec->len; i++)
+                {
+                    const Register &reg = MT9D111Profile::GetRegisters(rec)[i];
+
+                    printf("          0x%02X = 0x%04X\n", reg.address, reg.value);
+                }
+
+                break;
+            case MT9D111_PROFILE_REC_VARS:
+                printf("    VARS  driver %u, offset 0x%02X, %u bytes:", rec->page, rec->offset, rec->len);
+
+                for(unsigned int i=0; i<rec->len; i++)
+                {
+                    printf(" %02X", MT9D111Profile::GetPayload(rec)[i]);
+                }
+
+                printf("\n");
+
+                break;
+            case MT9D111_PROFILE_REC_DELAY:
+                printf("    DELAY %u ms\n", rec->len);
+
+                break;
+            case MT9D111_PROFILE_REC_POLL_VAR:
+                printf("    POLL  driver %u, offset 0x%02X == 0x%02X (timeout %u ms)\n", rec->page, rec->offset,
+                       rec->value, rec->len);
+
+                break;
+        }
+    }
+
+    return 0;
+}
+
+int main(int argc, char **argv)
+{
+    if ((argc == 3) and (strcmp(argv[1], "-d") == 0))
+    {
+        return Dump(argv[2]);
+    }
+
+    if (argc == 3)
+    {
+        for(size_t i=0; i<sizeof(tables)/sizeof(ProfileTable); i++)
+        {
+            if (strcmp(argv[1], tables[i].name) != 0)
+            {
+                continue;
+            }
+
+            if (!MT9D111Profile::Write(argv[2], tables[i].regs, tables[i].len, tables[i].name))
+            {
+                fprintf(stderr, "Error writing \"%s\"!\n", argv[2]);
+
+                return 1;
+            }
+
+            return Dump(argv[2]);
+        }
+    }
+
+    fprintf(stderr, "Usage: %s <table> <file>\n", argv[0]);
+    fprintf(stderr, "       %s -d <file>\n", argv[0]);
+    fprintf(stderr, "Tables:");
+
+    for(size_t i=0; i<sizeof(tables)/sizeof(ProfileTable); i++)
+    {
+        fprintf(stderr, " %s", tables[i].name);
+    }
+
+    fprintf(stderr, "\n");
+
+    return 1;
+}
+
+//! \} End of profile group
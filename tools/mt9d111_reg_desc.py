@@ -0,0 +1,360 @@
+#!/usr/bin/env python3
+#
+# mt9d111_reg_desc.py
+#
+# Copyright (C) 2018, Gabriel Mariano Marcelino <gabriel.mm8@gmail.com>
+#
+# This file is part of MT9D111-Driver.
+#
+# MT9D111-Driver is free software: you can redistribute it and/or modify
+# it under the terms of the GNU Lesser General Public License as published by
+# the Free Software Foundation, either version 3 of the License, or
+# (at your option) any later version.
+#
+# MT9D111-Driver is distributed in the hope that it will be useful,
+# but WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+# GNU Lesser General Public License for more details.
+#
+# You should have received a copy of the GNU Lesser General Public License
+# along with MT9D111-Driver. If not, see <http://www.gnu.org/licenses/>.
+#
+#
+
+"""
+Generates the registers descriptors table (src/mt9d111_reg_desc.h) from the registers addresses (src/mt9d111_reg.h).
+
+For each register, the page is given by the group of the definition, the mask of the used bits by the "Bits X:Y" and
+"Bit X" descriptions and the access type and default value by the text of the description. The registers that are
+updated by the sensor (statistics, AE/AWB outputs) or self-clearing are listed below, since the descriptions do not
+always say it.
+
+Usage: mt9d111_reg_desc.py [src/mt9d111_reg.h] [src/mt9d111_reg_desc.h]
+"""
+
+import os
+import re
+import sys
+
+__author__      = "Gabriel Mariano Marcelino"
+__email__       = "gabriel.mm8@gmail.com"
+__version__     = "1.0-dev"
+
+# Groups of mt9d111_reg.h
+PAGE_GROUPS = [("Sensor Core Registers", 0), ("IFP Registers, Page 1", 1), ("IFP Registers, Page 2", 2)]
+
+# Registers with self-clearing bits (per page)
+SELF_CLEARING = {
+    0: ["RESET", "CONTEXT_CONTROL"],
+    1: [],
+    2: [],
+}
+
+# Registers updated by the sensor or by the firmware drivers (per page). A tuple is an inclusive range of addresses,
+# and "!NAME" removes a register of the previous ranges.
+VOLATILE = {
+    0: ["SHUTTER_WIDTH", "GREEN_1_GAIN", "BLUE_GAIN", "RED_GAIN", "GREEN_2_GAIN", "GLOBAL_GAIN", "DARK_G1_AVERAGE",
+        "DARK_B_AVERAGE", "DARK_R_AVERAGE", "DARK_G2_AVERAGE", "BYTEWISE_ADDRESS"],
+    1: [("COLOR_CORRECTION_MATRIX_EXPONENTS_FOR_C11_C22", "COLOR_CORRECTION_MATRIX_ELEMENT_9_MANTISSA_AND_SIGNS"),
+        ("DIGITAL_GAIN_1_FOR_RED_PIXELS", "DIGITAL_GAIN_1_FOR_ALL_COLORS"),
+        "RED_CHROMIANCE_MEASURE_CALCULATED_BY_AWB", "LUMINANCE_MEASURE_CALCULATED_BY_AWB",
+        "BLUE_CHROMIANCE_MEASURE_CALCULATED_BY_AWB", "DIGITAL_GAIN_2",
+        "MEASURE_OF_AVERAGE_LUMINANCE_IN_FLICKER_MEASUREMENT_WINDOW", "LINE_COUNT", "FRAME_COUNT",
+        "MICROCONTROLLER_VARIABLE_DATA", "MICROCONTROLLER_VARIABLE_DATA_USING_BURST_TWO_WIRE_SERIAL_INTERFACE_ACCESS"],
+    2: [("AVERAGE_LUMINANCE_IN_AF_WINDOWS_W12_AND_W11", "AF_FILTER_2_AVERAGE_SHARPNESS_MEASURE_FOR_AF_WINDOWS_W44_AND_W43"),
+        "!AF_FILTER_1_COEFFICIENTS", "!AF_FILTER_1_CONFIG", "!AF_FILTER_2_COEFFICIENTS", "!AF_FILTER_2_CONFIG",
+        ("AVERAGE_LUMINANCE_IN_AE_WINDOWS_W12_AND_W11", "AVERAGE_LUMINANCE_IN_AE_WINDOWS_W44_AND_W43"),
+        "JPEG_STATUS_0", "JPEG_STATUS_1", "JPEG_STATUS_2", "JPEG_INDIRECT_ACCESS_DATA",
+        "PIXEL_COUNTS_FOR_BIN0_AND_BIN1", "PIXEL_COUNTS_FOR_BIN2_AND_BIN3"],
+}
+
+RE_DEFINE   = re.compile(r"^#define\s+MT9D111_REG_(\w+)\s+(0x[0-9A-Fa-f]+)\s*$")
+RE_BITS     = re.compile(r"\bBits?\s+(\d+)(?:\s*:\s*(\d+))?")
+RE_DEFAULT  = re.compile(r"Default value:\s*(0x[0-9A-Fa-f]+)")
+RE_RO       = re.compile(r"read[ -]only", re.IGNORECASE)
+
+def parse(path):
+    """Returns a list of (page, address, name, description) of all the registers of mt9d111_reg.h."""
+    regs = []
+    page = None
+    comment = []
+    in_comment = False
+
+    with open(path, encoding="utf-8") as f:
+        for line in f:
+            line = line.rstrip("\n")
+
+            if line.startswith("/**"):
+                in_comment = True
+                comment = []
+                continue
+
+            if in_comment:
+                if line.strip().startswith("*/"):
+                    in_comment = False
+
+                    text = " ".join(comment)
+                    for group, p in PAGE_GROUPS:
+                        if "\\brief " + group in text:
+                            page = p
+                            comment = []
+                else:
+                    comment.append(line.strip().lstrip("*").strip())
+                continue
+
+            m = RE_DEFINE.match(line)
+            if m and (page is not None):
+                regs.append((page, int(m.group(2), 16), m.group(1), " ".join(comment)))
+
+            comment = []
+
+    return regs
+
+def mask_of(desc):
+    """Returns the mask of the used bits of a register description (0xFFFF if not described)."""
+    hi = -1
+    for m in RE_BITS.finditer(desc):
+        hi = max(hi, int(m.group(1)), int(m.group(2) or 0))
+
+    return 0xFFFF if (hi < 0) or (hi > 15) else (1 << (hi + 1)) - 1
+
+def resolve(entries, names):
+    """Returns the set of addresses of a list of names/ranges of a page."""
+    adrs = set()
+    for e in entries:
+        if isinstance(e, tuple):
+            adrs |= set(range(names[e[0]], names[e[1]] + 1))
+        elif e.startswith("!"):
+            adrs.discard(names[e[1:]])
+        else:
+            adrs.add(names[e])
+
+    return adrs
+
+def build(regs):
+    """Returns the descriptors of each page ({address: (name, flags, mask, default)})."""
+    pages = [dict(), dict(), dict()]
+
+    names = [dict(), dict(), dict()]
+    for page, adr, name, desc in regs:
+        names[page].setdefault(name, adr)
+
+    for page, adr, name, desc in regs:
+        # Aliases keep the first name
+        if adr in pages[page]:
+            continue
+
+        flags = ["MT9D111_REG_DESC_PRESENT"]
+
+        if RE_RO.search(desc):
+            flags.append("MT9D111_REG_DESC_READ_ONLY")
+
+        default = RE_DEFAULT.search(desc)
+        if default:
+            flags.append("MT9D111_REG_DESC_DEFAULT_KNOWN")
+
+        pages[page][adr] = [name, flags, mask_of(desc), int(default.group(1), 16) if default else 0]
+
+    # The page register is available in all pages
+    page_reg = pages[0][names[0]["PAGE_REGISTER"]]
+    for page in (1, 2):
+        pages[page].setdefault(names[0]["PAGE_REGISTER"], [page_reg[0], list(page_reg[1]), page_reg[2], page_reg[3]])
+        names[page].setdefault("PAGE_REGISTER", names[0]["PAGE_REGISTER"])
+
+    for page in range(3):
+        for adr in resolve(SELF_CLEARING[page], names[page]):
+            if adr in pages[page]:
+                pages[page][adr][1].append("MT9D111_REG_DESC_SELF_CLEARING")
+
+        for adr in resolve(VOLATILE[page], names[page]):
+            if adr in pages[page]:
+                pages[page][adr][1].append("MT9D111_REG_DESC_VOLATILE")
+
+    return pages
+
+def emit(pages, src_name):
+    lines = []
+    for page in range(3):
+        for adr in sorted(pages[page]):
+            name, flags, mask, default = pages[page][adr]
+            lines.append("    {MT9D111_REG_PAGE_%u, MT9D111_REG_%s, %s, 0x%04X, 0x%04X, \"%s\"}," %
+                         (page, name, " | ".join(flags), mask, default, name))
+
+    total = sum(len(p) for p in pages)
+
+    return TEMPLATE.format(src=src_name, total=total, entries="\n".join(lines))
+
+TEMPLATE = """/*
+ * mt9d111_reg_desc.h
+ * 
+ * Copyright (C) 2018, Gabriel Mariano Marcelino <gabriel.mm8@gmail.com>
+ * 
+ * This file is part of MT9D111-Driver.
+ * 
+ * MT9D111-Driver is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ * 
+ * MT9D111-Driver is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ * 
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with MT9D111-Driver. If not, see <http://www.gnu.org/licenses/>.
+ * 
+ */
+
+/**
+ * \\brief MT9D111 registers descriptors (page, used bits, access type, volatility and default value).
+ * 
+ * Generated by tools/mt9d111_reg_desc.py from {src}. Do not edit!
+ * 
+ * \\author Gabriel Mariano Marcelino <gabriel.mm8@gmail.com>
+ * 
+ * \\version 1.0-dev
+ * 
+ * \\date 17/10/2026
+ * 
+ * \\addtogroup registers
+ * \\{{
+ */
+
+#ifndef MT9D111_REG_DESC_H_
+#define MT9D111_REG_DESC_H_
+
+#include <stdint.h>
+#include <stddef.h>
+
+#include "mt9d111_reg.h"
+
+// Descriptor flags
+#define MT9D111_REG_DESC_PRESENT                    (1 << 0)    /**< The register is documented. */
+#define MT9D111_REG_DESC_READ_ONLY                  (1 << 1)    /**< Writes are ignored. */
+#define MT9D111_REG_DESC_SELF_CLEARING              (1 << 2)    /**< Some bits are cleared by the sensor after a write. */
+#define MT9D111_REG_DESC_VOLATILE                   (1 << 3)    /**< The value is updated by the sensor or by the firmware drivers. */
+#define MT9D111_REG_DESC_DEFAULT_KNOWN              (1 << 4)    /**< The default (power-up) value is documented. */
+
+#define MT9D111_REG_DESC_LEN                        {total}
+
+/**
+ * \\brief Descriptor of a register.
+ */
+struct RegDesc
+{{
+    uint8_t     page;       /**< Register page number. */
+    uint8_t     address;    /**< Register address. */
+    uint8_t     flags;      /**< Descriptor flags (MT9D111_REG_DESC_*). */
+    uint16_t    mask;       /**< Used bits. */
+    uint16_t    value;      /**< Default value (if MT9D111_REG_DESC_DEFAULT_KNOWN). */
+    const char  *name;      /**< Register name (without the MT9D111_REG_ prefix). */
+}};
+
+/**
+ * \\brief Descriptors of all the documented registers, sorted by page and address.
+ */
+constexpr RegDesc mt9d111_reg_desc_list[MT9D111_REG_DESC_LEN] =
+{{
+{entries}
+}};
+
+/**
+ * \\brief Index of the descriptors by page and address (built at compile time).
+ */
+struct RegDescIndex
+{{
+    int16_t idx[MT9D111_REG_PAGES][MT9D111_REG_PAGE_SIZE];  /**< Position in mt9d111_reg_desc_list (-1 if undocumented). */
+
+    /**
+     * \\brief Constructor.
+     *
+     * \\return None.
+     */
+    constexpr RegDescIndex() : idx()
+    {{
+        for(size_t p=0; p<MT9D111_REG_PAGES; p++)
+        {{
+            for(size_t a=0; a<MT9D111_REG_PAGE_SIZE; a++)
+            {{
+                idx[p][a] = -1;
+            }}
+        }}
+
+        for(size_t i=0; i<MT9D111_REG_DESC_LEN; i++)
+        {{
+            idx[mt9d111_reg_desc_list[i].page][mt9d111_reg_desc_list[i].address] = i;
+        }}
+    }}
+}};
+
+constexpr RegDescIndex mt9d111_reg_desc_index;
+
+/**
+ * \\brief Descriptor of the undocumented registers.
+ */
+constexpr RegDesc mt9d111_reg_desc_unknown = {{MT9D111_REG_PAGE_UNKNOWN, 0x00, 0, 0xFFFF, 0x0000, "UNKNOWN"}};
+
+/**
+ * \\brief Gets the descriptor of a register.
+ *
+ * \\param[in] page is the register page.
+ * \\param[in] adr is the register address.
+ *
+ * \\return The descriptor of the register (flags = 0 if the register is undocumented).
+ */
+constexpr const RegDesc& RegGetDesc(uint8_t page, uint8_t adr)
+{{
+    return ((page < MT9D111_REG_PAGES) and (mt9d111_reg_desc_index.idx[page][adr] >= 0))?
+           mt9d111_reg_desc_list[mt9d111_reg_desc_index.idx[page][adr]] : mt9d111_reg_desc_unknown;
+}}
+
+/**
+ * \\brief Checks if the value of a register can be kept in a shadow copy.
+ *
+ * The undocumented registers of the valid pages are cacheable (the driver only writes registers it knows).
+ *
+ * \\param[in] page is the register page.
+ * \\param[in] adr is the register address.
+ *
+ * \\return TRUE/FALSE if the register is cacheable or not.
+ */
+constexpr bool RegIsCacheable(uint8_t page, uint8_t adr)
+{{
+    return (page < MT9D111_REG_PAGES) and
+           !(RegGetDesc(page, adr).flags & (MT9D111_REG_DESC_READ_ONLY | MT9D111_REG_DESC_SELF_CLEARING | MT9D111_REG_DESC_VOLATILE));
+}}
+
+/**
+ * \\brief Checks if a write to a register can be verified by reading it back.
+ *
+ * \\param[in] page is the register page.
+ * \\param[in] adr is the register address.
+ *
+ * \\return TRUE/FALSE if the register can be verified or not.
+ */
+constexpr bool RegIsVerifiable(uint8_t page, uint8_t adr)
+{{
+    return RegIsCacheable(page, adr);
+}}
+
+#endif // MT9D111_REG_DESC_H_
+
+//! \\}} End of registers group
+"""
+
+def main():
+    root = os.path.join(os.path.dirname(os.path.abspath(__file__)), "..")
+
+    src = sys.argv[1] if len(sys.argv) > 1 else os.path.join(root, "src", "mt9d111_reg.h")
+    dst = sys.argv[2] if len(sys.argv) > 2 else os.path.join(root, "src", "mt9d111_reg_desc.h")
+
+    pages = build(parse(src))
+
+    with open(dst, "w", encoding="utf-8") as f:
+        f.write(emit(pages, os.path.basename(src)))
+
+    print("%u registers descriptors written to %s" % (sum(len(p) for p in pages), dst))
+
+if __name__ == "__main__":
+    main()